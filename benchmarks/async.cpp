@@ -0,0 +1,297 @@
+// IA-PlatformOps; C++ 20 Async, Process and File Operations.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "bench.hpp"
+
+#include <platform_ops/async.hpp>
+
+#include <algorithm>
+#include <thread>
+
+using namespace ia;
+using namespace ia::bench;
+
+namespace
+{
+  struct SchedulerScope
+  {
+    explicit SchedulerScope(const u8 worker_count)
+    {
+      (void) AsyncOps::initialize_scheduler(worker_count);
+    }
+
+    ~SchedulerScope()
+    {
+      AsyncOps::terminate_scheduler();
+    }
+  };
+
+  auto get_default_worker_count() -> u8
+  {
+    return static_cast<u8>(std::clamp<u32>(std::thread::hardware_concurrency(), 1, 255));
+  }
+
+  auto spin_for_ns(const u64 duration_ns) -> void
+  {
+    const Stopwatch watch;
+    while (watch.elapsed_ns() < static_cast<f64>(duration_ns))
+    {
+    }
+  }
+
+  auto bench_empty_task_throughput(MutRef<State> state) -> void
+  {
+    const SchedulerScope scope(get_default_worker_count());
+    const u32 task_count = 200'000;
+
+    AsyncOps::Schedule schedule;
+    const Stopwatch watch;
+    for (u32 i = 0; i < task_count; ++i)
+    {
+      AsyncOps::schedule_task([](AsyncOps::WorkerId) {}, 0, &schedule);
+    }
+    AsyncOps::wait_for_schedule_completion(&schedule);
+    const f64 elapsed_ns = watch.elapsed_ns();
+
+    state.record("tasks_per_sec", task_count / (elapsed_ns / 1e9), "tasks/s", Better::Higher);
+    state.record("ns_per_task", elapsed_ns / task_count, "ns", Better::Lower);
+  }
+
+  auto bench_submit_latency_single(MutRef<State> state) -> void
+  {
+    const SchedulerScope scope(1);
+    const u32 sample_count = 20'000;
+
+    Vec<f64> samples;
+    samples.reserve(sample_count);
+    for (u32 i = 0; i < sample_count; ++i)
+    {
+      AsyncOps::Schedule schedule;
+      const Stopwatch watch;
+      AsyncOps::schedule_task([](AsyncOps::WorkerId) {}, 0, &schedule);
+      samples.push_back(watch.elapsed_ns());
+      AsyncOps::wait_for_schedule_completion(&schedule);
+    }
+
+    state.record("p50_ns", percentile(samples, 50.0), "ns", Better::Lower);
+    state.record("p99_ns", percentile(samples, 99.0), "ns", Better::Lower);
+  }
+
+  auto bench_submit_latency_batch(MutRef<State> state) -> void
+  {
+    const SchedulerScope scope(1);
+    const u32 batch_size = 1024;
+    const u32 batch_count = 100;
+
+    Vec<f64> samples;
+    samples.reserve(batch_count);
+    for (u32 batch = 0; batch < batch_count; ++batch)
+    {
+      AsyncOps::Schedule schedule;
+      const Stopwatch watch;
+      for (u32 i = 0; i < batch_size; ++i)
+      {
+        AsyncOps::schedule_task([](AsyncOps::WorkerId) {}, 0, &schedule);
+      }
+      samples.push_back(watch.elapsed_ns() / batch_size);
+      AsyncOps::wait_for_schedule_completion(&schedule);
+    }
+
+    state.record("ns_per_submit_p50", percentile(samples, 50.0), "ns", Better::Lower);
+    state.record("ns_per_submit_p99", percentile(samples, 99.0), "ns", Better::Lower);
+  }
+
+  auto bench_future_submit(MutRef<State> state) -> void
+  {
+    const SchedulerScope scope(get_default_worker_count());
+    const u32 task_count = 100'000;
+
+    Vec<Future<u32>> futures;
+    futures.reserve(task_count);
+
+    const Stopwatch watch;
+    for (u32 i = 0; i < task_count; ++i)
+    {
+      futures.push_back(AsyncOps::submit([i] { return i; }));
+    }
+    u64 sum = 0;
+    for (Future<u32> &future : futures)
+    {
+      sum += future.get();
+    }
+    const f64 elapsed_ns = watch.elapsed_ns();
+    do_not_optimize(sum);
+
+    state.record("ns_per_future", elapsed_ns / task_count, "ns", Better::Lower);
+  }
+
+  auto bench_fan_out_fan_in(MutRef<State> state, const bool use_fibers) -> void
+  {
+    (void) AsyncOps::initialize_scheduler(get_default_worker_count(), use_fibers);
+
+    const u32 round_count = 200;
+    const u32 fan_out = 1024;
+
+    Vec<f64> samples;
+    samples.reserve(round_count);
+    for (u32 round = 0; round < round_count; ++round)
+    {
+      AsyncOps::Schedule schedule;
+      const Stopwatch watch;
+      for (u32 i = 0; i < fan_out; ++i)
+      {
+        AsyncOps::schedule_task([](AsyncOps::WorkerId) { spin_for_ns(500); }, 0, &schedule);
+      }
+      AsyncOps::wait_for_schedule_completion(&schedule);
+      samples.push_back(watch.elapsed_ns() / 1000.0);
+    }
+
+    AsyncOps::terminate_scheduler();
+
+    state.record("round_trip_p50_us", percentile(samples, 50.0), "us", Better::Lower);
+    state.record("round_trip_p99_us", percentile(samples, 99.0), "us", Better::Lower);
+  }
+
+  auto bench_cancel_by_queue_depth(MutRef<State> state, const u32 queue_depth) -> void
+  {
+    const SchedulerScope scope(1);
+
+    AsyncOps::Schedule blocker_schedule;
+    std::atomic<bool> blocker_started{false};
+    std::atomic<bool> release_blocker{false};
+    AsyncOps::schedule_task(
+        [&](AsyncOps::WorkerId) {
+          blocker_started = true;
+          while (!release_blocker.load())
+          {
+            std::this_thread::yield();
+          }
+        },
+        0, &blocker_schedule, AsyncOps::Priority::Critical);
+
+    while (!blocker_started.load())
+    {
+      std::this_thread::yield();
+    }
+
+    // Half of the queue is cancelled, spread evenly over the priority levels.
+    AsyncOps::Schedule schedule;
+    for (u32 i = 0; i < queue_depth; ++i)
+    {
+      const auto priority = static_cast<AsyncOps::Priority>(i % AsyncOps::PRIORITY_LEVEL_COUNT);
+      AsyncOps::schedule_task([](AsyncOps::WorkerId) {}, 1 + (i & 1), &schedule, priority);
+    }
+
+    const Stopwatch watch;
+    AsyncOps::cancel_tasks_of_tag(1);
+    const f64 elapsed_ns = watch.elapsed_ns();
+
+    release_blocker = true;
+    AsyncOps::wait_for_schedule_completion(&schedule);
+    AsyncOps::wait_for_schedule_completion(&blocker_schedule);
+
+    state.record("cancel_us", elapsed_ns / 1000.0, "us", Better::Lower);
+    state.record("ns_per_queued_task", elapsed_ns / queue_depth, "ns", Better::Lower);
+  }
+
+  auto bench_wake_up_latency(MutRef<State> state) -> void
+  {
+    const SchedulerScope scope(get_default_worker_count());
+    const u32 sample_count = 500;
+
+    Vec<f64> samples;
+    samples.reserve(sample_count);
+    for (u32 i = 0; i < sample_count; ++i)
+    {
+      // Give the workers time to go back to sleep on the wake condition.
+      std::this_thread::sleep_for(std::chrono::microseconds(200));
+
+      AsyncOps::Schedule schedule;
+      std::atomic<i64> started_ns{0};
+      const auto submitted = Stopwatch::Clock::now();
+      AsyncOps::schedule_task(
+          [&](AsyncOps::WorkerId) {
+            started_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Stopwatch::Clock::now() - submitted)
+                             .count();
+          },
+          0, &schedule);
+
+      while (schedule.counter.load() > 0)
+      {
+        std::this_thread::yield();
+      }
+      samples.push_back(static_cast<f64>(started_ns.load()) / 1000.0);
+    }
+
+    state.record("p50_us", percentile(samples, 50.0), "us", Better::Lower);
+    state.record("p99_us", percentile(samples, 99.0), "us", Better::Lower);
+  }
+
+  auto bench_worker_scaling(MutRef<State> state, const u8 worker_count) -> void
+  {
+    const SchedulerScope scope(worker_count);
+    const u32 task_count = 50'000;
+
+    AsyncOps::Schedule schedule;
+    const Stopwatch watch;
+    for (u32 i = 0; i < task_count; ++i)
+    {
+      AsyncOps::schedule_task([](AsyncOps::WorkerId) { spin_for_ns(1000); }, 0, &schedule);
+    }
+
+    // Block rather than help so only the pool does the work being measured.
+    while (schedule.counter.load() > 0)
+    {
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    const f64 elapsed_ns = watch.elapsed_ns();
+
+    state.record("tasks_per_sec", task_count / (elapsed_ns / 1e9), "tasks/s", Better::Higher);
+  }
+
+  auto register_async_benchmarks() -> bool
+  {
+    Vec<Benchmark> benchmarks = {
+        {"async/empty_task_throughput", bench_empty_task_throughput},
+        {"async/submit_latency/single", bench_submit_latency_single},
+        {"async/submit_latency/batch", bench_submit_latency_batch},
+        {"async/future_submit", bench_future_submit},
+        {"async/fan_out_fan_in/threads", [](MutRef<State> state) { bench_fan_out_fan_in(state, false); }},
+        {"async/fan_out_fan_in/fibers", [](MutRef<State> state) { bench_fan_out_fan_in(state, true); }},
+        {"async/wake_up_latency", bench_wake_up_latency},
+    };
+
+    for (const u32 depth : {1'000u, 10'000u, 100'000u})
+    {
+      benchmarks.push_back({"async/cancel_tasks_of_tag/depth=" + std::to_string(depth),
+                            [depth](MutRef<State> state) { bench_cancel_by_queue_depth(state, depth); }});
+    }
+
+    const u32 max_workers = get_default_worker_count();
+    for (u32 workers = 1;; workers = std::min(workers * 2, max_workers))
+    {
+      benchmarks.push_back({"async/worker_scaling/workers=" + std::to_string(workers),
+                            [workers](MutRef<State> state) { bench_worker_scaling(state, static_cast<u8>(workers)); }});
+      if (workers == max_workers)
+      {
+        break;
+      }
+    }
+
+    return Registry::add(std::move(benchmarks));
+  }
+
+  const bool s_registered = register_async_benchmarks();
+} // namespace
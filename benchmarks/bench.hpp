@@ -0,0 +1,109 @@
+// IA-PlatformOps; C++ 20 Async, Process and File Operations.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <crux/crux.hpp>
+
+#include <chrono>
+#include <functional>
+
+namespace ia::bench
+{
+  enum class Better : u8
+  {
+    Lower,
+    Higher
+  };
+
+  struct Metric
+  {
+    Mut<String> name;
+    Mut<String> unit;
+    Mut<Better> better = Better::Lower;
+    Mut<Vec<f64>> samples;
+  };
+
+  // Collects the metrics of one benchmark across all of its repetitions.
+  class State
+  {
+public:
+    auto record(Ref<String> metric, const f64 value, Ref<String> unit, const Better better) -> void;
+
+    [[nodiscard]] auto get_metrics() const -> Ref<Vec<Metric>>
+    {
+      return m_metrics;
+    }
+
+private:
+    Mut<Vec<Metric>> m_metrics;
+  };
+
+  using BenchmarkFn = std::function<void(MutRef<State>)>;
+
+  struct Benchmark
+  {
+    Mut<String> name;
+    Mut<BenchmarkFn> fn;
+  };
+
+  class Registry
+  {
+public:
+    static auto add(Mut<Vec<Benchmark>> benchmarks) -> bool;
+
+    // Usage: [--filter <substring>] [--repetitions <n>] [--out <file.json>]
+    static auto run_all(const i32 argc, const char *const *argv) -> i32;
+
+private:
+    static auto get_benchmarks() -> MutRef<Vec<Benchmark>>;
+  };
+
+  class Stopwatch
+  {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    Stopwatch() : m_start(Clock::now())
+    {
+    }
+
+    auto restart() -> void
+    {
+      m_start = Clock::now();
+    }
+
+    [[nodiscard]] auto elapsed_ns() const -> f64
+    {
+      return static_cast<f64>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - m_start).count());
+    }
+
+private:
+    Mut<Clock::time_point> m_start;
+  };
+
+  // Nearest-rank percentile (0-100). Reorders `samples`.
+  auto percentile(MutRef<Vec<f64>> samples, const f64 percent) -> f64;
+
+  // Keeps the optimizer from discarding a computed value.
+  template<typename T> auto do_not_optimize(Ref<T> value) -> void
+  {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static_cast<void>(*static_cast<const volatile T *>(&value));
+#endif
+  }
+} // namespace ia::bench
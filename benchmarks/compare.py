@@ -0,0 +1,84 @@
+#!/usr/bin/env python3
+# IA-PlatformOps; C++ 20 Async, Process and File Operations.
+# Copyright (C) 2026 IAS (ias@iasoft.dev)
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Compares two PlatformOps_Bench JSON reports and fails on regressions.
+
+Usage: compare.py <baseline.json> <candidate.json> [--threshold PERCENT] [--filter SUBSTRING]
+"""
+
+import argparse
+import json
+import sys
+
+
+def load_metrics(path):
+    with open(path, encoding="utf-8") as f:
+        report = json.load(f)
+
+    metrics = {}
+    for benchmark in report["benchmarks"]:
+        for name, metric in benchmark["metrics"].items():
+            metrics[(benchmark["name"], name)] = metric
+    return metrics
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("baseline")
+    parser.add_argument("candidate")
+    parser.add_argument("--threshold", type=float, default=10.0,
+                        help="Relative change, in percent, that counts as a regression (default: 10)")
+    parser.add_argument("--filter", default="", help="Only compare benchmarks whose name contains this")
+    args = parser.parse_args()
+
+    baseline = load_metrics(args.baseline)
+    candidate = load_metrics(args.candidate)
+
+    regressions = 0
+    print(f"{'benchmark / metric':<64} {'baseline':>14} {'candidate':>14} {'change':>9}")
+    for key in sorted(baseline.keys() & candidate.keys()):
+        if args.filter not in key[0]:
+            continue
+
+        old = baseline[key]
+        new = candidate[key]
+        if old["value"] == 0:
+            continue
+
+        change = (new["value"] - old["value"]) / abs(old["value"]) * 100.0
+        worse = change > args.threshold if old["better"] == "lower" else change < -args.threshold
+        better = change < -args.threshold if old["better"] == "lower" else change > args.threshold
+
+        marker = "  REGRESSION" if worse else ("  improved" if better else "")
+        regressions += worse
+
+        label = f"{key[0]} / {key[1]}"
+        print(f"{label:<64} {old['value']:>14.2f} {new['value']:>14.2f} {change:>+8.1f}%{marker}")
+
+    for key in sorted(baseline.keys() - candidate.keys()):
+        if args.filter in key[0]:
+            print(f"{key[0]} / {key[1]}: missing from candidate")
+
+    if regressions:
+        print(f"\n{regressions} metric(s) regressed by more than {args.threshold}%")
+        return 1
+
+    print("\nNo regressions")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,154 @@
+// IA-PlatformOps; C++ 20 Async, Process and File Operations.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "bench.hpp"
+
+#include <platform_ops/directory_walker.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+using namespace ia;
+using namespace ia::bench;
+
+namespace
+{
+  // 10 x 10 x 10 directories with 50 small files in each leaf: 51,110 entries.
+  constexpr u32 FAN_OUT = 10;
+  constexpr u32 FILES_PER_LEAF = 50;
+
+  // Built on first use, so runs filtered to other benchmarks skip it. Left in place between runs.
+  auto get_tree_root() -> Ref<Path>
+  {
+    static const Path s_root = [] {
+      const Path root = std::filesystem::temp_directory_path() / "platform_ops_bench_walk";
+      const Path marker = root / "complete";
+      if (std::filesystem::exists(marker))
+      {
+        return root;
+      }
+
+      std::error_code ec;
+      std::filesystem::remove_all(root, ec);
+      for (u32 a = 0; a < FAN_OUT; ++a)
+      {
+        for (u32 b = 0; b < FAN_OUT; ++b)
+        {
+          for (u32 c = 0; c < FAN_OUT; ++c)
+          {
+            const Path leaf = root / std::to_string(a) / std::to_string(b) / std::to_string(c);
+            std::filesystem::create_directories(leaf);
+            for (u32 i = 0; i < FILES_PER_LEAF; ++i)
+            {
+              std::ofstream(leaf / ("file_" + std::to_string(i) + ".dat")) << i;
+            }
+          }
+        }
+      }
+      std::ofstream(marker) << "";
+      return root;
+    }();
+    return s_root;
+  }
+
+  auto walk_with_iterator(Ref<Path> root, const bool with_stat) -> u64
+  {
+    Mut<u64> count = 0;
+    Mut<u64> total_size = 0;
+    for (Ref<std::filesystem::directory_entry> entry : std::filesystem::recursive_directory_iterator(root))
+    {
+      ++count;
+      if (with_stat && entry.is_regular_file())
+      {
+        total_size += entry.file_size();
+        do_not_optimize(entry.last_write_time());
+      }
+    }
+    do_not_optimize(total_size);
+    return count;
+  }
+
+  auto walk_with_walker(Ref<Path> root, const bool with_stat) -> u64
+  {
+    Mut<DirectoryWalker::Options> options;
+    options.stat = with_stat;
+    Mut<std::atomic<u64>> total_size{0};
+    const DirectoryWalker::Stats stats =
+        DirectoryWalker::walk(root, options, [&total_size](const Span<const DirectoryWalker::Entry> entries,
+                                                           const AsyncOps::WorkerId) {
+          Mut<u64> batch_size = 0;
+          for (Ref<DirectoryWalker::Entry> entry : entries)
+          {
+            batch_size += entry.size;
+          }
+          total_size.fetch_add(batch_size, std::memory_order_relaxed);
+        }).value();
+    do_not_optimize(total_size.load());
+    return stats.entry_count;
+  }
+
+  // Walks the tree from a warm dentry cache, so the numbers measure system call count and per-entry overhead.
+  template<typename WalkFn> auto bench_walk(MutRef<State> state, const u32 passes, WalkFn walk_fn) -> void
+  {
+    Ref<Path> root = get_tree_root();
+    Mut<u64> entry_count = walk_fn(root);
+
+    Vec<f64> samples;
+    samples.reserve(passes);
+    for (u32 pass = 0; pass < passes; ++pass)
+    {
+      const Stopwatch watch;
+      entry_count = walk_fn(root);
+      samples.push_back(watch.elapsed_ns());
+    }
+
+    const f64 median_ns = percentile(samples, 50.0);
+    state.record("walk_p50_ms", median_ns / 1e6, "ms", Better::Lower);
+    state.record("entries_per_sec", static_cast<f64>(entry_count) / (median_ns / 1e9), "entries/s", Better::Higher);
+  }
+
+  auto register_walk_benchmarks() -> bool
+  {
+    constexpr u32 PASSES = 7;
+
+    Vec<Benchmark> benchmarks;
+    for (const bool with_stat : {false, true})
+    {
+      const String suffix = with_stat ? "/stat" : "/names";
+      benchmarks.push_back({"walk/recursive_directory_iterator" + suffix, [with_stat](MutRef<State> state) {
+                              bench_walk(state, PASSES,
+                                         [with_stat](Ref<Path> root) { return walk_with_iterator(root, with_stat); });
+                            }});
+      benchmarks.push_back({"walk/walker/serial" + suffix, [with_stat](MutRef<State> state) {
+                              bench_walk(state, PASSES,
+                                         [with_stat](Ref<Path> root) { return walk_with_walker(root, with_stat); });
+                            }});
+      benchmarks.push_back({"walk/walker/parallel" + suffix, [with_stat](MutRef<State> state) {
+                              const u8 worker_count =
+                                  static_cast<u8>(std::clamp<u32>(std::thread::hardware_concurrency(), 1, 255));
+                              (void) AsyncOps::initialize_scheduler(worker_count);
+                              bench_walk(state, PASSES,
+                                         [with_stat](Ref<Path> root) { return walk_with_walker(root, with_stat); });
+                              AsyncOps::terminate_scheduler();
+                            }});
+    }
+    return Registry::add(std::move(benchmarks));
+  }
+
+  const bool s_registered = register_walk_benchmarks();
+} // namespace
@@ -0,0 +1,650 @@
+// IA-PlatformOps; C++ 20 Async, Process and File Operations.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "bench.hpp"
+
+#include <platform_ops/async_file.hpp>
+#include <platform_ops/file.hpp>
+#include <platform_ops/file_stream.hpp>
+#include <platform_ops/mapped_log.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <thread>
+
+#if IA_PLATFORM_UNIX
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <unistd.h>
+#endif
+
+using namespace ia;
+using namespace ia::bench;
+
+namespace
+{
+  constexpr usize KIB = 1024;
+  constexpr usize MIB = 1024 * KIB;
+  constexpr usize GIB = 1024 * MIB;
+
+  // The fopen/fseek/ftell/fread reader that FileOps used before it moved to open/fstat/pread.
+  auto read_binary_file_stdio(Ref<Path> path) -> Vec<u8>
+  {
+    FILE *f = fopen(path.string().c_str(), "rb");
+    if (!f)
+    {
+      return {};
+    }
+    Vec<u8> result;
+    fseek(f, 0, SEEK_END);
+    const long len = ftell(f);
+    if (len > 0)
+    {
+      result.resize(static_cast<usize>(len));
+      fseek(f, 0, SEEK_SET);
+      result.resize(fread(result.data(), 1, result.size(), f));
+    }
+    fclose(f);
+    return result;
+  }
+
+  // Test files are created once per process and removed on exit.
+  class FileCorpus
+  {
+public:
+    ~FileCorpus()
+    {
+      std::error_code ec;
+      std::filesystem::remove_all(get_root(), ec);
+    }
+
+    auto get_files(const usize file_size, const usize file_count) -> Ref<Vec<Path>>
+    {
+      const String key = std::to_string(file_size) + "x" + std::to_string(file_count);
+      auto it = m_sets.find(key);
+      if (it != m_sets.end())
+      {
+        return it->second;
+      }
+
+      const Path directory = get_root() / key;
+      std::filesystem::create_directories(directory);
+
+      Vec<u8> content(file_size);
+      for (usize i = 0; i < content.size(); ++i)
+      {
+        content[i] = static_cast<u8>(i * 31);
+      }
+
+      Vec<Path> files;
+      for (usize i = 0; i < file_count; ++i)
+      {
+        files.push_back(directory / (std::to_string(i) + ".bin"));
+        (void) FileOps::write_binary_file(files.back(), content, true);
+      }
+      return m_sets.emplace(key, std::move(files)).first->second;
+    }
+
+private:
+    static auto get_root() -> Path
+    {
+      return std::filesystem::temp_directory_path() / "platform_ops_bench_files";
+    }
+
+private:
+    HashMap<String, Vec<Path>> m_sets;
+  };
+
+  FileCorpus s_corpus;
+
+  // Reads every file in a warm page cache, so the numbers isolate per-call overhead and copy cost.
+  template<typename ReadFn>
+  auto bench_read(MutRef<State> state, const usize file_size, const usize file_count, const u32 passes,
+                  ReadFn read_fn) -> void
+  {
+    Ref<Vec<Path>> files = s_corpus.get_files(file_size, file_count);
+    for (Ref<Path> path : files)
+    {
+      do_not_optimize(read_fn(path).size());
+    }
+
+    Vec<f64> samples;
+    samples.reserve(files.size() * passes);
+    for (u32 pass = 0; pass < passes; ++pass)
+    {
+      for (Ref<Path> path : files)
+      {
+        const Stopwatch watch;
+        const auto contents = read_fn(path);
+        samples.push_back(watch.elapsed_ns());
+        do_not_optimize(contents.size());
+      }
+    }
+
+    const f64 median_ns = percentile(samples, 50.0);
+    state.record("read_p50_us", median_ns / 1e3, "us", Better::Lower);
+    state.record("throughput", static_cast<f64>(file_size) / MIB / (median_ns / 1e9), "MiB/s", Better::Higher);
+  }
+
+  // Writes a 4 KiB header, a payload and a 4 KiB footer, either joined into one buffer first or gathered in place.
+  auto bench_write_parts(MutRef<State> state, const usize payload_size, const u32 passes, const bool gather) -> void
+  {
+    const Vec<u8> header(4 * KIB, 0x11);
+    const Vec<u8> payload(payload_size, 0x22);
+    const Vec<u8> footer(4 * KIB, 0x33);
+    const Path path = std::filesystem::temp_directory_path() / "platform_ops_bench_write.bin";
+    const usize total = header.size() + payload.size() + footer.size();
+
+    Vec<f64> samples;
+    samples.reserve(passes);
+    for (u32 pass = 0; pass < passes; ++pass)
+    {
+      const Stopwatch watch;
+      if (gather)
+      {
+        const Span<const u8> parts[] = {header, payload, footer};
+        do_not_optimize(FileOps::write_gather(path, parts, true).value());
+      }
+      else
+      {
+        Vec<u8> joined;
+        joined.reserve(total);
+        joined.insert(joined.end(), header.begin(), header.end());
+        joined.insert(joined.end(), payload.begin(), payload.end());
+        joined.insert(joined.end(), footer.begin(), footer.end());
+        do_not_optimize(FileOps::write_binary_file(path, joined, true).value());
+      }
+      samples.push_back(watch.elapsed_ns());
+    }
+
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+
+    const f64 median_ns = percentile(samples, 50.0);
+    state.record("write_p50_us", median_ns / 1e3, "us", Better::Lower);
+    state.record("throughput", static_cast<f64>(total) / MIB / (median_ns / 1e9), "MiB/s", Better::Higher);
+  }
+
+  // Scans a file through FileReader, summing every byte so the consumer has work to overlap with read-ahead.
+  auto bench_stream_read(MutRef<State> state, const usize file_size, const u32 passes, const bool read_ahead) -> void
+  {
+    Ref<Path> path = s_corpus.get_files(file_size, 1).front();
+    if (read_ahead)
+    {
+      (void) AsyncOps::initialize_scheduler(1);
+      (void) AsyncFileOps::initialize();
+    }
+
+    Vec<f64> samples;
+    samples.reserve(passes);
+    for (u32 pass = 0; pass < passes; ++pass)
+    {
+      const Stopwatch watch;
+      FileReader reader;
+      (void) reader.open(path);
+      Mut<u64> sum = 0;
+      while (true)
+      {
+        const Span<const u8> available = reader.peek().value();
+        if (available.empty())
+        {
+          break;
+        }
+        for (const u8 byte : available)
+        {
+          sum += byte;
+        }
+        reader.consume(available.size());
+      }
+      samples.push_back(watch.elapsed_ns());
+      do_not_optimize(sum);
+    }
+
+    if (read_ahead)
+    {
+      AsyncFileOps::terminate();
+      AsyncOps::terminate_scheduler();
+    }
+
+    const f64 median_ns = percentile(samples, 50.0);
+    state.record("scan_p50_us", median_ns / 1e3, "us", Better::Lower);
+    state.record("throughput", static_cast<f64>(file_size) / MIB / (median_ns / 1e9), "MiB/s", Better::Higher);
+  }
+
+#if IA_PLATFORM_UNIX
+  auto evict_from_page_cache(Ref<Path> path) -> void
+  {
+    const int fd = open(path.string().c_str(), O_RDONLY);
+    if (fd != -1)
+    {
+      (void) posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+      close(fd);
+    }
+  }
+
+  // How much of the file sits in the page cache.
+  auto get_cached_size(Ref<Path> path, const usize file_size) -> usize
+  {
+    const int fd = open(path.string().c_str(), O_RDONLY);
+    if (fd == -1)
+    {
+      return 0;
+    }
+    void *address = mmap(nullptr, file_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (address == MAP_FAILED)
+    {
+      return 0;
+    }
+
+    const usize page_size = FileOps::get_system_page_size();
+    Vec<unsigned char> residency((file_size + page_size - 1) / page_size);
+    usize cached = 0;
+    if (mincore(address, file_size, residency.data()) == 0)
+    {
+      cached = static_cast<usize>(std::count_if(residency.begin(), residency.end(),
+                                                [](const unsigned char page) { return (page & 1) != 0; }));
+    }
+    munmap(address, file_size);
+    return cached * page_size;
+  }
+#endif
+
+  // Scans a file that starts out of the page cache, through the cache or around it, and reports how much of the
+  // file the scan left cached. A direct scan should leave none, so it does not evict anything else.
+  auto bench_stream_read_cold(MutRef<State> state, const usize file_size, const u32 passes,
+                              const FileOps::FileCaching caching) -> void
+  {
+#if IA_PLATFORM_UNIX
+    Ref<Path> path = s_corpus.get_files(file_size, 1).front();
+    (void) AsyncOps::initialize_scheduler(1);
+    (void) AsyncFileOps::initialize();
+
+    Vec<f64> samples;
+    samples.reserve(passes);
+    Mut<usize> cached_size = 0;
+    for (u32 pass = 0; pass < passes; ++pass)
+    {
+      evict_from_page_cache(path);
+      const Stopwatch watch;
+      FileReader reader;
+      if (!reader.open(path, FileReader::DEFAULT_BUFFER_SIZE, false, caching))
+      {
+        break;
+      }
+      Mut<u64> sum = 0;
+      while (true)
+      {
+        const Span<const u8> available = reader.peek().value();
+        if (available.empty())
+        {
+          break;
+        }
+        for (const u8 byte : available)
+        {
+          sum += byte;
+        }
+        reader.consume(available.size());
+      }
+      samples.push_back(watch.elapsed_ns());
+      do_not_optimize(sum);
+      reader.close();
+      cached_size = get_cached_size(path, file_size);
+    }
+
+    AsyncFileOps::terminate();
+    AsyncOps::terminate_scheduler();
+    if (samples.empty())
+    {
+      return;
+    }
+
+    const f64 median_ns = percentile(samples, 50.0);
+    state.record("scan_p50_us", median_ns / 1e3, "us", Better::Lower);
+    state.record("throughput", static_cast<f64>(file_size) / MIB / (median_ns / 1e9), "MiB/s", Better::Higher);
+    state.record("cached_after_scan", static_cast<f64>(cached_size) / MIB, "MiB", Better::Lower);
+#else
+    AU_UNUSED(state);
+    AU_UNUSED(file_size);
+    AU_UNUSED(passes);
+    AU_UNUSED(caching);
+#endif
+  }
+
+  enum class AppendTarget : u8
+  {
+    Memory,
+    FileWriter,
+    MappedLog,
+    MappedLogMapAhead
+  };
+
+  // Appends 256 MiB of fixed-size records. Memory copies into a preallocated heap buffer, as the ceiling.
+  auto bench_append(MutRef<State> state, const usize record_size, const u32 passes, const AppendTarget target) -> void
+  {
+    const usize total = 256 * MIB;
+    const Vec<u8> record(record_size, 0x5A);
+    const Path path = std::filesystem::temp_directory_path() / "platform_ops_bench_append.bin";
+    Vec<u8> memory(target == AppendTarget::Memory ? total : 0);
+    if (target == AppendTarget::MappedLogMapAhead)
+    {
+      (void) AsyncOps::initialize_scheduler(1);
+    }
+
+    Vec<f64> samples;
+    samples.reserve(passes);
+    for (u32 pass = 0; pass < passes; ++pass)
+    {
+      std::error_code ec;
+      std::filesystem::remove(path, ec);
+
+      const Stopwatch watch;
+      if (target == AppendTarget::Memory)
+      {
+        for (usize offset = 0; offset + record_size <= total; offset += record_size)
+        {
+          std::memcpy(memory.data() + offset, record.data(), record_size);
+        }
+        do_not_optimize(memory.data());
+      }
+      else if (target == AppendTarget::FileWriter)
+      {
+        FileWriter writer;
+        (void) writer.open(path, true);
+        for (usize offset = 0; offset + record_size <= total; offset += record_size)
+        {
+          (void) writer.write(record);
+        }
+        (void) writer.close();
+      }
+      else
+      {
+        MappedLog log;
+        (void) log.open(path);
+        for (usize offset = 0; offset + record_size <= total; offset += record_size)
+        {
+          do_not_optimize(log.append(record).value());
+        }
+        (void) log.close();
+      }
+      samples.push_back(watch.elapsed_ns());
+    }
+
+    if (target == AppendTarget::MappedLogMapAhead)
+    {
+      AsyncOps::terminate_scheduler();
+    }
+
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+
+    const f64 median_ns = percentile(samples, 50.0);
+    state.record("append_p50_us", median_ns / 1e3, "us", Better::Lower);
+    state.record("throughput", static_cast<f64>(total) / MIB / (median_ns / 1e9), "MiB/s", Better::Higher);
+  }
+
+  enum class CopyTarget : u8
+  {
+    ReadWrite,
+    CopyFile
+  };
+
+  // Copies one file from a warm page cache, either through a heap buffer the size of the file or with copy_file.
+  auto bench_copy(MutRef<State> state, const usize file_size, const u32 passes, const CopyTarget target) -> void
+  {
+    const Path source = s_corpus.get_files(file_size, 1).front();
+    const Path destination = std::filesystem::temp_directory_path() / "platform_ops_bench_copy.bin";
+    (void) FileOps::read_binary_file(source);
+
+    Mut<FileOps::CopyMethod> method = FileOps::CopyMethod::Buffered;
+    Vec<f64> samples;
+    samples.reserve(passes);
+    for (u32 pass = 0; pass < passes; ++pass)
+    {
+      std::error_code ec;
+      std::filesystem::remove(destination, ec);
+
+      const Stopwatch watch;
+      if (target == CopyTarget::ReadWrite)
+      {
+        (void) FileOps::write_binary_file(destination, FileOps::read_binary_file(source).value(), true);
+      }
+      else
+      {
+        method = FileOps::copy_file(source, destination).value().method;
+      }
+      samples.push_back(watch.elapsed_ns());
+    }
+
+    std::error_code ec;
+    std::filesystem::remove(destination, ec);
+
+    const f64 median_ns = percentile(samples, 50.0);
+    state.record("copy_p50_us", median_ns / 1e3, "us", Better::Lower);
+    state.record("throughput", static_cast<f64>(file_size) / MIB / (median_ns / 1e9), "MiB/s", Better::Higher);
+    if (target == CopyTarget::CopyFile)
+    {
+      state.record("method", static_cast<f64>(method), "CopyMethod", Better::Lower);
+    }
+  }
+
+  enum class LoadTarget : u8
+  {
+    ReadBinaryFile, // One read_binary_file call per path, keeping every result
+    LoadFiles,
+    LoadFilesByInode,
+    LoadEachFile
+  };
+
+  // Loads a batch of small files from a warm page cache, with the paths in a shuffled order as a manifest might
+  // list them. `worker_count` 0 runs without a scheduler.
+  auto bench_load(MutRef<State> state, const usize file_size, const usize file_count, const u32 passes,
+                  const u8 worker_count, const LoadTarget target) -> void
+  {
+    Mut<Vec<Path>> paths = s_corpus.get_files(file_size, file_count);
+    Mut<u32> seed = 12345;
+    for (Mut<usize> i = paths.size(); i > 1; --i)
+    {
+      seed = seed * 1664525 + 1013904223;
+      std::swap(paths[i - 1], paths[seed % i]);
+    }
+    if (worker_count > 0)
+    {
+      (void) AsyncOps::initialize_scheduler(worker_count);
+    }
+
+    const auto load = [&]() -> usize {
+      switch (target)
+      {
+      case LoadTarget::ReadBinaryFile: {
+        Vec<Vec<u8>> contents;
+        contents.reserve(paths.size());
+        for (Ref<Path> path : paths)
+        {
+          contents.push_back(FileOps::read_binary_file(path).value_or(Vec<u8>{}));
+        }
+        return contents.size();
+      }
+      case LoadTarget::LoadFiles:
+        return FileOps::load_files(paths).get_total_size();
+      case LoadTarget::LoadFilesByInode: {
+        Mut<FileOps::LoadOptions> options;
+        options.order = FileOps::LoadOrder::Inode;
+        return FileOps::load_files(paths, options).get_total_size();
+      }
+      case LoadTarget::LoadEachFile: {
+        Mut<std::atomic<usize>> total{0};
+        FileOps::load_each_file(paths, [&total](const usize, Result<Span<const u8>> data) {
+          total.fetch_add(data ? data->size() : 0, std::memory_order_relaxed);
+        });
+        return total.load();
+      }
+      }
+      return 0;
+    };
+
+    do_not_optimize(load());
+    Vec<f64> samples;
+    samples.reserve(passes);
+    for (u32 pass = 0; pass < passes; ++pass)
+    {
+      const Stopwatch watch;
+      do_not_optimize(load());
+      samples.push_back(watch.elapsed_ns());
+    }
+
+    if (worker_count > 0)
+    {
+      AsyncOps::terminate_scheduler();
+    }
+
+    const f64 median_ns = percentile(samples, 50.0);
+    state.record("load_p50_ms", median_ns / 1e6, "ms", Better::Lower);
+    state.record("files_per_sec", static_cast<f64>(file_count) / (median_ns / 1e9), "files/s", Better::Higher);
+  }
+
+  auto register_file_benchmarks() -> bool
+  {
+    struct SizeCase
+    {
+      const char *label;
+      usize file_size;
+      usize file_count;
+      u32 passes;
+    };
+
+    const SizeCase cases[] = {
+        {"1KiB", 1 * KIB, 2000, 2},  {"64KiB", 64 * KIB, 200, 4}, {"1MiB", 1 * MIB, 32, 4},
+        {"16MiB", 16 * MIB, 4, 4},  {"256MiB", 256 * MIB, 1, 3}, {"1GiB", 1 * GIB, 1, 2},
+    };
+
+    Vec<Benchmark> benchmarks;
+    for (const SizeCase &size_case : cases)
+    {
+      benchmarks.push_back({String("file/read_binary/stdio/") + size_case.label, [size_case](MutRef<State> state) {
+                              bench_read(state, size_case.file_size, size_case.file_count, size_case.passes,
+                                         read_binary_file_stdio);
+                            }});
+      benchmarks.push_back({String("file/read_binary/native/") + size_case.label, [size_case](MutRef<State> state) {
+                              bench_read(state, size_case.file_size, size_case.file_count, size_case.passes,
+                                         [](Ref<Path> path) { return FileOps::read_binary_file(path).value(); });
+                            }});
+      benchmarks.push_back({String("file/read_text/native/") + size_case.label, [size_case](MutRef<State> state) {
+                              bench_read(state, size_case.file_size, size_case.file_count, size_case.passes,
+                                         [](Ref<Path> path) { return FileOps::read_text_file(path).value(); });
+                            }});
+      // One buffer serves every read, so only the first file of a size pays for an allocation.
+      benchmarks.push_back({String("file/read_into/reused/") + size_case.label, [size_case](MutRef<State> state) {
+                              Vec<u8> buffer;
+                              bench_read(state, size_case.file_size, size_case.file_count, size_case.passes,
+                                         [&buffer](Ref<Path> path) {
+                                           (void) FileOps::read_into(path, buffer);
+                                           return Span<const u8>(buffer);
+                                         });
+                            }});
+    }
+
+    const SizeCase write_cases[] = {
+        {"64KiB", 64 * KIB, 0, 200},
+        {"16MiB", 16 * MIB, 0, 20},
+        {"256MiB", 256 * MIB, 0, 3},
+    };
+    for (const SizeCase &size_case : write_cases)
+    {
+      benchmarks.push_back({String("file/write_parts/concat/") + size_case.label, [size_case](MutRef<State> state) {
+                              bench_write_parts(state, size_case.file_size, size_case.passes, false);
+                            }});
+      benchmarks.push_back({String("file/write_parts/gather/") + size_case.label, [size_case](MutRef<State> state) {
+                              bench_write_parts(state, size_case.file_size, size_case.passes, true);
+                            }});
+    }
+
+    const SizeCase stream_cases[] = {{"256MiB", 256 * MIB, 1, 3}, {"1GiB", 1 * GIB, 1, 2}};
+    for (const SizeCase &size_case : stream_cases)
+    {
+      benchmarks.push_back({String("file/stream_read/sync/") + size_case.label, [size_case](MutRef<State> state) {
+                              bench_stream_read(state, size_case.file_size, size_case.passes, false);
+                            }});
+      benchmarks.push_back({String("file/stream_read/read_ahead/") + size_case.label,
+                            [size_case](MutRef<State> state) {
+                              bench_stream_read(state, size_case.file_size, size_case.passes, true);
+                            }});
+    }
+
+    benchmarks.push_back({"file/stream_read/cold/buffered/256MiB", [](MutRef<State> state) {
+                            bench_stream_read_cold(state, 256 * MIB, 3, FileOps::FileCaching::Buffered);
+                          }});
+    benchmarks.push_back({"file/stream_read/cold/direct/256MiB", [](MutRef<State> state) {
+                            bench_stream_read_cold(state, 256 * MIB, 3, FileOps::FileCaching::Direct);
+                          }});
+
+    const SizeCase append_cases[] = {{"64B", 64, 0, 3}, {"4KiB", 4 * KIB, 0, 3}};
+    for (const SizeCase &size_case : append_cases)
+    {
+      benchmarks.push_back({String("file/append/memory/") + size_case.label, [size_case](MutRef<State> state) {
+                              bench_append(state, size_case.file_size, size_case.passes, AppendTarget::Memory);
+                            }});
+      benchmarks.push_back({String("file/append/file_writer/") + size_case.label, [size_case](MutRef<State> state) {
+                              bench_append(state, size_case.file_size, size_case.passes, AppendTarget::FileWriter);
+                            }});
+      benchmarks.push_back({String("file/append/mapped_log/sync/") + size_case.label,
+                            [size_case](MutRef<State> state) {
+                              bench_append(state, size_case.file_size, size_case.passes, AppendTarget::MappedLog);
+                            }});
+      benchmarks.push_back({String("file/append/mapped_log/map_ahead/") + size_case.label,
+                            [size_case](MutRef<State> state) {
+                              bench_append(state, size_case.file_size, size_case.passes,
+                                           AppendTarget::MappedLogMapAhead);
+                            }});
+    }
+
+    const SizeCase copy_cases[] = {{"16MiB", 16 * MIB, 1, 10}, {"256MiB", 256 * MIB, 1, 3}};
+    for (const SizeCase &size_case : copy_cases)
+    {
+      benchmarks.push_back({String("file/copy/read_write/") + size_case.label, [size_case](MutRef<State> state) {
+                              bench_copy(state, size_case.file_size, size_case.passes, CopyTarget::ReadWrite);
+                            }});
+      benchmarks.push_back({String("file/copy/copy_file/") + size_case.label, [size_case](MutRef<State> state) {
+                              bench_copy(state, size_case.file_size, size_case.passes, CopyTarget::CopyFile);
+                            }});
+    }
+
+    // 20k files of 2 KiB, serially and spread over every core.
+    benchmarks.push_back({"file/load/read_binary_file/20k_2KiB", [](MutRef<State> state) {
+                            bench_load(state, 2 * KIB, 20'000, 5, 0, LoadTarget::ReadBinaryFile);
+                          }});
+    const u8 core_count = static_cast<u8>(std::clamp<u32>(std::thread::hardware_concurrency(), 1, 255));
+    for (const u8 worker_count : {u8(0), core_count})
+    {
+      const String mode = worker_count == 0 ? "serial" : "parallel";
+      benchmarks.push_back({"file/load/load_files/" + mode + "/20k_2KiB", [worker_count](MutRef<State> state) {
+                              bench_load(state, 2 * KIB, 20'000, 5, worker_count, LoadTarget::LoadFiles);
+                            }});
+      benchmarks.push_back({"file/load/load_files_by_inode/" + mode + "/20k_2KiB",
+                            [worker_count](MutRef<State> state) {
+                              bench_load(state, 2 * KIB, 20'000, 5, worker_count, LoadTarget::LoadFilesByInode);
+                            }});
+      benchmarks.push_back({"file/load/load_each_file/" + mode + "/20k_2KiB", [worker_count](MutRef<State> state) {
+                              bench_load(state, 2 * KIB, 20'000, 5, worker_count, LoadTarget::LoadEachFile);
+                            }});
+    }
+    return Registry::add(std::move(benchmarks));
+  }
+
+  const bool s_registered = register_file_benchmarks();
+} // namespace
@@ -0,0 +1,139 @@
+// IA-PlatformOps; C++ 20 Async, Process and File Operations.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "bench.hpp"
+
+#include <platform_ops/line_iterator.hpp>
+
+#include <algorithm>
+#include <thread>
+
+using namespace ia;
+using namespace ia::bench;
+
+namespace
+{
+  constexpr usize MIB = 1024 * 1024;
+
+  // Log-like text: lines of 20 to 200 bytes, mostly "\n" terminated with some "\r\n".
+  auto make_log_text(const usize size) -> String
+  {
+    String text;
+    text.reserve(size + 256);
+    Mut<u32> seed = 12345;
+    while (text.size() < size)
+    {
+      seed = seed * 1664525 + 1013904223;
+      text.append(20 + (seed >> 8) % 181, static_cast<char>('a' + (seed >> 4) % 26));
+      text += (seed % 8 == 0) ? "\r\n" : "\n";
+    }
+    return text;
+  }
+
+  // The byte-by-byte loop the iterator replaces.
+  template<typename Fn> auto for_each_line_bytewise(const StringView text, Mut<Fn> fn) -> void
+  {
+    Mut<usize> start = 0;
+    for (Mut<usize> i = 0; i < text.size(); ++i)
+    {
+      if (text[i] == '\n' || text[i] == '\r')
+      {
+        if (i > start)
+        {
+          fn(text.substr(start, i - start));
+        }
+        start = i + 1;
+      }
+    }
+    if (start < text.size())
+    {
+      fn(text.substr(start));
+    }
+  }
+
+  // Built on first use, so runs filtered to other benchmarks skip it.
+  auto get_log_text() -> Ref<String>
+  {
+    static const String s_text = make_log_text(256 * MIB);
+    return s_text;
+  }
+
+  // One per worker, padded to a cache line so the parallel scan does not measure false sharing.
+  struct alignas(64) WorkerTotal
+  {
+    Mut<usize> value = 0;
+  };
+
+  template<typename ScanFn>
+  auto bench_scan(MutRef<State> state, Ref<String> text, const u32 passes, ScanFn scan_fn) -> void
+  {
+    Vec<f64> samples;
+    samples.reserve(passes);
+    for (u32 pass = 0; pass < passes; ++pass)
+    {
+      const Stopwatch watch;
+      do_not_optimize(scan_fn(text));
+      samples.push_back(watch.elapsed_ns());
+    }
+
+    const f64 median_ns = percentile(samples, 50.0);
+    state.record("scan_p50_us", median_ns / 1e3, "us", Better::Lower);
+    state.record("throughput", static_cast<f64>(text.size()) / MIB / (median_ns / 1e9), "MiB/s", Better::Higher);
+  }
+
+  auto register_line_benchmarks() -> bool
+  {
+    constexpr u32 PASSES = 5;
+
+    Vec<Benchmark> benchmarks;
+    benchmarks.push_back({"lines/scan/bytewise", [](MutRef<State> state) {
+                            bench_scan(state, get_log_text(), PASSES, [](Ref<String> text) {
+                              Mut<usize> total = 0;
+                              for_each_line_bytewise(text, [&total](const StringView line) { total += line.size(); });
+                              return total;
+                            });
+                          }});
+    benchmarks.push_back({"lines/scan/iterator", [](MutRef<State> state) {
+                            bench_scan(state, get_log_text(), PASSES, [](Ref<String> text) {
+                              Mut<usize> total = 0;
+                              LineIterator::for_each_line(text,
+                                                          [&total](const StringView line) { total += line.size(); });
+                              return total;
+                            });
+                          }});
+    benchmarks.push_back({"lines/scan/parallel", [](MutRef<State> state) {
+                            const u8 worker_count =
+                                static_cast<u8>(std::clamp<u32>(std::thread::hardware_concurrency(), 1, 255));
+                            (void) AsyncOps::initialize_scheduler(worker_count);
+                            bench_scan(state, get_log_text(), PASSES, [worker_count](Ref<String> text) {
+                              Vec<WorkerTotal> totals(worker_count + 1);
+                              LineIterator::for_each_line_parallel(
+                                  text, [&totals](const StringView line, const AsyncOps::WorkerId worker_id) {
+                                    totals[worker_id].value += line.size();
+                                  });
+                              Mut<usize> total = 0;
+                              for (Ref<WorkerTotal> worker_total : totals)
+                              {
+                                total += worker_total.value;
+                              }
+                              return total;
+                            });
+                            AsyncOps::terminate_scheduler();
+                          }});
+    return Registry::add(std::move(benchmarks));
+  }
+
+  const bool s_registered = register_line_benchmarks();
+} // namespace
@@ -0,0 +1,191 @@
+// IA-PlatformOps; C++ 20 Async, Process and File Operations.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "bench.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+namespace ia::bench
+{
+  static auto escape_json(Ref<String> value) -> String
+  {
+    Mut<String> result;
+    result.reserve(value.size());
+    for (const char c : value)
+    {
+      if (c == '"' || c == '\\')
+      {
+        result += '\\';
+      }
+      result += c;
+    }
+    return result;
+  }
+
+  static auto get_median(Mut<Vec<f64>> samples) -> f64
+  {
+    return percentile(samples, 50.0);
+  }
+
+  auto State::record(Ref<String> metric, const f64 value, Ref<String> unit, const Better better) -> void
+  {
+    for (MutRef<Metric> existing : m_metrics)
+    {
+      if (existing.name == metric)
+      {
+        existing.samples.push_back(value);
+        return;
+      }
+    }
+    m_metrics.push_back(Metric{metric, unit, better, {value}});
+  }
+
+  auto percentile(MutRef<Vec<f64>> samples, const f64 percent) -> f64
+  {
+    if (samples.empty())
+    {
+      return 0.0;
+    }
+
+    const f64 clamped = std::clamp(percent, 0.0, 100.0);
+    const usize rank = static_cast<usize>(clamped / 100.0 * static_cast<f64>(samples.size() - 1) + 0.5);
+    std::nth_element(samples.begin(), samples.begin() + static_cast<isize>(rank), samples.end());
+    return samples[rank];
+  }
+
+  auto Registry::get_benchmarks() -> MutRef<Vec<Benchmark>>
+  {
+    static Mut<Vec<Benchmark>> benchmarks;
+    return benchmarks;
+  }
+
+  auto Registry::add(Mut<Vec<Benchmark>> benchmarks) -> bool
+  {
+    MutRef<Vec<Benchmark>> registered = get_benchmarks();
+    for (MutRef<Benchmark> benchmark : benchmarks)
+    {
+      registered.push_back(std::move(benchmark));
+    }
+    return true;
+  }
+
+  auto Registry::run_all(const i32 argc, const char *const *argv) -> i32
+  {
+    Mut<String> filter;
+    Mut<String> out_path = "bench_results.json";
+    Mut<u32> repetitions = 5;
+
+    for (Mut<i32> i = 1; i < argc; ++i)
+    {
+      const StringView arg = argv[i];
+      if (arg != "--filter" && arg != "--repetitions" && arg != "--out")
+      {
+        std::cerr << "Unknown argument " << arg << "\n";
+        return 1;
+      }
+      if (i + 1 >= argc)
+      {
+        std::cerr << "Missing value for " << arg << "\n";
+        return 1;
+      }
+
+      const char *value = argv[++i];
+      if (arg == "--filter")
+      {
+        filter = value;
+      }
+      else if (arg == "--repetitions")
+      {
+        repetitions = std::max(1, std::atoi(value));
+      }
+      else
+      {
+        out_path = value;
+      }
+    }
+
+    Mut<Vec<Benchmark>> selected;
+    for (Ref<Benchmark> benchmark : get_benchmarks())
+    {
+      if (filter.empty() || benchmark.name.find(filter) != String::npos)
+      {
+        selected.push_back(benchmark);
+      }
+    }
+    std::sort(selected.begin(), selected.end(),
+              [](Ref<Benchmark> lhs, Ref<Benchmark> rhs) { return lhs.name < rhs.name; });
+
+    Mut<std::ofstream> out(out_path);
+    if (!out)
+    {
+      std::cerr << "Failed to open " << out_path << "\n";
+      return 1;
+    }
+
+    out << std::setprecision(17);
+    out << "{\n  \"suite\": \"PlatformOps\",\n";
+    out << "  \"hardware_concurrency\": " << std::thread::hardware_concurrency() << ",\n";
+    out << "  \"repetitions\": " << repetitions << ",\n";
+    out << "  \"benchmarks\": [";
+
+    std::cout << std::fixed << std::setprecision(2);
+
+    Mut<bool> first_benchmark = true;
+    for (MutRef<Benchmark> benchmark : selected)
+    {
+      Mut<State> state;
+      for (Mut<u32> i = 0; i < repetitions; ++i)
+      {
+        benchmark.fn(state);
+      }
+
+      out << (first_benchmark ? "\n" : ",\n");
+      out << "    {\n      \"name\": \"" << escape_json(benchmark.name) << "\",\n      \"metrics\": {";
+      first_benchmark = false;
+
+      std::cout << benchmark.name << "\n";
+
+      Mut<bool> first_metric = true;
+      for (Ref<Metric> metric : state.get_metrics())
+      {
+        const f64 median = get_median(metric.samples);
+        const auto [min_it, max_it] = std::minmax_element(metric.samples.begin(), metric.samples.end());
+
+        out << (first_metric ? "\n" : ",\n");
+        out << "        \"" << escape_json(metric.name) << "\": {\"value\": " << median << ", \"min\": " << *min_it
+            << ", \"max\": " << *max_it << ", \"unit\": \"" << escape_json(metric.unit) << "\", \"better\": \""
+            << (metric.better == Better::Higher ? "higher" : "lower") << "\"}";
+        first_metric = false;
+
+        std::cout << "  " << std::left << std::setw(32) << metric.name << std::right << std::setw(16) << median
+                  << " " << metric.unit << "\n";
+      }
+      out << "\n      }\n    }";
+    }
+
+    out << "\n  ]\n}\n";
+    std::cout << "\nResults written to " << out_path << "\n";
+    return 0;
+  }
+} // namespace ia::bench
+
+int main(int argc, char *argv[])
+{
+  return ia::bench::Registry::run_all(argc, argv);
+}
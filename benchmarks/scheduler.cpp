@@ -0,0 +1,131 @@
+// IA-PlatformOps; C++ 20 Async, Process and File Operations.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "bench.hpp"
+
+#include <platform_ops/scheduler.hpp>
+
+#include <algorithm>
+#include <thread>
+
+using namespace ia;
+using namespace ia::bench;
+
+namespace
+{
+  // Same policies as AsyncOps, minus its fiber executor.
+  using FullScheduler = BasicScheduler<sched::DeadlineAgingQueue<5>, sched::WithTags, sched::BlockingIdle,
+                                       sched::FunctionTask>;
+  using PriorityScheduler = BasicScheduler<sched::PriorityQueue<3>, sched::NoTags, sched::InlineTask<32>>;
+  using LeanScheduler = BasicScheduler<sched::FifoQueue, sched::NoTags, sched::SpinIdle<>, sched::InlineTask<32>>;
+
+  auto get_default_worker_count() -> u16
+  {
+    return static_cast<u16>(std::clamp<u32>(std::thread::hardware_concurrency(), 1, 255));
+  }
+
+  // Captures three pointers, which is past std::function's inline buffer but fits the inline task storage.
+  struct CountingTask
+  {
+    Mut<std::atomic<u64> *> counter = nullptr;
+    Mut<const u64 *> increment = nullptr;
+    Mut<void *> context = nullptr;
+
+    auto operator()(const sched::WorkerId) const -> void
+    {
+      counter->fetch_add(*increment, std::memory_order_relaxed);
+    }
+  };
+
+  template<typename Scheduler> auto submit_task(MutRef<Scheduler> scheduler, Ref<CountingTask> task,
+                                                Mut<sched::Schedule *> schedule) -> void
+  {
+    if constexpr (Scheduler::HAS_TAGS)
+    {
+      scheduler.submit_tagged(task, 0, schedule);
+    }
+    else
+    {
+      scheduler.submit(task, schedule);
+    }
+  }
+
+  template<typename Scheduler> auto bench_task_throughput(MutRef<State> state) -> void
+  {
+    Scheduler scheduler;
+    (void) scheduler.start(get_default_worker_count());
+
+    const u32 task_count = 200'000;
+    std::atomic<u64> counter{0};
+    const u64 increment = 1;
+    const CountingTask task{&counter, &increment, nullptr};
+
+    sched::Schedule schedule;
+    const Stopwatch watch;
+    for (u32 i = 0; i < task_count; ++i)
+    {
+      submit_task(scheduler, task, &schedule);
+    }
+    scheduler.wait(&schedule);
+    const f64 elapsed_ns = watch.elapsed_ns();
+
+    do_not_optimize(counter.load());
+    state.record("tasks_per_sec", task_count / (elapsed_ns / 1e9), "tasks/s", Better::Higher);
+    state.record("ns_per_task", elapsed_ns / task_count, "ns", Better::Lower);
+  }
+
+  template<typename Scheduler> auto bench_submit_cost(MutRef<State> state) -> void
+  {
+    Scheduler scheduler;
+    (void) scheduler.start(1);
+
+    const u32 batch_size = 1024;
+    const u32 batch_count = 100;
+    std::atomic<u64> counter{0};
+    const u64 increment = 1;
+    const CountingTask task{&counter, &increment, nullptr};
+
+    Vec<f64> samples;
+    samples.reserve(batch_count);
+    for (u32 batch = 0; batch < batch_count; ++batch)
+    {
+      sched::Schedule schedule;
+      const Stopwatch watch;
+      for (u32 i = 0; i < batch_size; ++i)
+      {
+        submit_task(scheduler, task, &schedule);
+      }
+      samples.push_back(watch.elapsed_ns() / batch_size);
+      scheduler.wait(&schedule);
+    }
+
+    state.record("ns_per_submit_p50", percentile(samples, 50.0), "ns", Better::Lower);
+    state.record("ns_per_submit_p99", percentile(samples, 99.0), "ns", Better::Lower);
+  }
+
+  auto register_scheduler_benchmarks() -> bool
+  {
+    return Registry::add({
+        {"scheduler/task_throughput/full", bench_task_throughput<FullScheduler>},
+        {"scheduler/task_throughput/priority", bench_task_throughput<PriorityScheduler>},
+        {"scheduler/task_throughput/lean", bench_task_throughput<LeanScheduler>},
+        {"scheduler/submit_cost/full", bench_submit_cost<FullScheduler>},
+        {"scheduler/submit_cost/priority", bench_submit_cost<PriorityScheduler>},
+        {"scheduler/submit_cost/lean", bench_submit_cost<LeanScheduler>},
+    });
+  }
+
+  const bool s_registered = register_scheduler_benchmarks();
+} // namespace
@@ -0,0 +1,141 @@
+// IA-PlatformOps; C++ 20 Async, Process and File Operations.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "bench.hpp"
+
+#include <platform_ops/shared_channel.hpp>
+
+#include <cstdio>
+#include <thread>
+
+#if IA_PLATFORM_UNIX
+#  include <sys/wait.h>
+#  include <unistd.h>
+#endif
+
+using namespace ia;
+using namespace ia::bench;
+
+namespace
+{
+  constexpr usize KIB = 1024;
+
+  enum class Peer : u8
+  {
+    Thread,
+    Process
+  };
+
+  auto produce(Ref<String> name, const usize message_size, const u32 message_count) -> bool
+  {
+    Mut<Result<SharedChannel>> channel = SharedChannel::open(name);
+    if (!channel)
+    {
+      return false;
+    }
+    const Vec<u8> message(message_size, 0x5A);
+    for (Mut<u32> i = 0; i < message_count; ++i)
+    {
+      if (!channel->send(message))
+      {
+        return false;
+      }
+    }
+    channel->shut_down();
+    return true;
+  }
+
+  // Streams messages from a producer on another thread or process until it shuts the channel down.
+  auto bench_channel(MutRef<State> state, const usize message_size, const u32 message_count, const Peer peer) -> void
+  {
+    const String name = "platform_ops_bench_channel";
+    Mut<SharedChannel> channel = SharedChannel::create(name, SharedChannel::DEFAULT_CAPACITY).value();
+
+    const Stopwatch watch;
+    Mut<std::jthread> producer_thread;
+#if IA_PLATFORM_UNIX
+    Mut<pid_t> child = -1;
+    if (peer == Peer::Process)
+    {
+      std::fflush(nullptr);
+      child = fork();
+      if (child == 0)
+      {
+        _exit(produce(name, message_size, message_count) ? 0 : 1);
+      }
+    }
+#endif
+    if (peer == Peer::Thread)
+    {
+      producer_thread = std::jthread([&name, message_size, message_count]() {
+        (void) produce(name, message_size, message_count);
+      });
+    }
+
+    Mut<u64> received = 0;
+    Mut<u64> checksum = 0;
+    while (const std::optional<Span<const u8>> message = channel.receive())
+    {
+      checksum += message->empty() ? 0 : (*message)[0];
+      ++received;
+      channel.release();
+    }
+    const f64 elapsed_ns = watch.elapsed_ns();
+
+    if (producer_thread.joinable())
+    {
+      producer_thread.join();
+    }
+#if IA_PLATFORM_UNIX
+    if (child > 0)
+    {
+      Mut<int> status = 0;
+      waitpid(child, &status, 0);
+    }
+#endif
+    do_not_optimize(checksum);
+
+    state.record("messages_per_second", static_cast<f64>(received) / (elapsed_ns / 1e9), "msg/s", Better::Higher);
+    state.record("throughput", static_cast<f64>(received * message_size) / (1024.0 * 1024.0) / (elapsed_ns / 1e9),
+                 "MiB/s", Better::Higher);
+  }
+
+  auto register_channel_benchmarks() -> bool
+  {
+    struct SizeCase
+    {
+      const char *label;
+      usize message_size;
+      u32 message_count;
+    };
+    const SizeCase cases[] = {{"64B", 64, 4'000'000}, {"1KiB", 1 * KIB, 1'000'000}};
+
+    Vec<Benchmark> benchmarks;
+    for (const SizeCase &size_case : cases)
+    {
+      benchmarks.push_back({String("ipc/channel/thread/") + size_case.label, [size_case](MutRef<State> state) {
+                              bench_channel(state, size_case.message_size, size_case.message_count, Peer::Thread);
+                            }});
+#if IA_PLATFORM_UNIX
+      benchmarks.push_back({String("ipc/channel/process/") + size_case.label, [size_case](MutRef<State> state) {
+                              bench_channel(state, size_case.message_size, size_case.message_count, Peer::Process);
+                            }});
+#endif
+    }
+    return Registry::add(std::move(benchmarks));
+  }
+
+  const bool s_registered = register_channel_benchmarks();
+} // namespace
@@ -0,0 +1,154 @@
+// IA-PlatformOps; C++ 20 Async, Process and File Operations.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "bench.hpp"
+
+#include <platform_ops/shared_snapshot.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+#if IA_PLATFORM_UNIX
+#  include <sys/wait.h>
+#  include <unistd.h>
+#endif
+
+using namespace ia;
+using namespace ia::bench;
+
+namespace
+{
+  constexpr usize KIB = 1024;
+
+  enum class Peer : u8
+  {
+    Thread,
+    Process
+  };
+
+  auto publish(Ref<String> name, const usize state_size, const u64 version_count) -> bool
+  {
+    Mut<Result<SharedSnapshot>> snapshot = SharedSnapshot::open(name);
+    if (!snapshot)
+    {
+      return false;
+    }
+    for (Mut<u64> version = 1; version <= version_count; ++version)
+    {
+      const Span<u8> slot = snapshot->begin_write();
+      std::memset(slot.data(), static_cast<int>(version), state_size);
+      snapshot->commit(state_size);
+    }
+    return true;
+  }
+
+  // Copies out the newest state as often as it can while a writer on another thread or process keeps
+  // republishing it, until the writer's last version arrives.
+  auto bench_snapshot(MutRef<State> state, const usize state_size, const u64 version_count, const Peer peer) -> void
+  {
+    const String name = "platform_ops_bench_snapshot";
+    Mut<SharedSnapshot> snapshot = SharedSnapshot::create(name, state_size).value();
+
+    const Stopwatch watch;
+    Mut<std::jthread> writer_thread;
+#if IA_PLATFORM_UNIX
+    Mut<pid_t> child = -1;
+    if (peer == Peer::Process)
+    {
+      std::fflush(nullptr);
+      child = fork();
+      if (child == 0)
+      {
+        _exit(publish(name, state_size, version_count) ? 0 : 1);
+      }
+    }
+#endif
+    if (peer == Peer::Thread)
+    {
+      writer_thread = std::jthread([&name, state_size, version_count]() {
+        (void) publish(name, state_size, version_count);
+      });
+    }
+
+    Mut<Vec<u8>> copy(state_size);
+    Mut<u64> read_count = 0;
+    Mut<u64> retry_count = 0;
+    Mut<u64> version = 0;
+    while (version < version_count)
+    {
+      const std::optional<SharedSnapshot::View> view = snapshot.view();
+      if (!view)
+      {
+        continue;
+      }
+      std::memcpy(copy.data(), view->data.data(), view->data.size());
+      if (!snapshot.is_intact(*view))
+      {
+        ++retry_count;
+        continue;
+      }
+      version = view->version;
+      ++read_count;
+    }
+    const f64 elapsed_ns = watch.elapsed_ns();
+
+    if (writer_thread.joinable())
+    {
+      writer_thread.join();
+    }
+#if IA_PLATFORM_UNIX
+    if (child > 0)
+    {
+      Mut<int> status = 0;
+      waitpid(child, &status, 0);
+    }
+#endif
+    do_not_optimize(copy.data());
+
+    state.record("reads_per_second", static_cast<f64>(read_count) / (elapsed_ns / 1e9), "reads/s", Better::Higher);
+    state.record("publishes_per_second", static_cast<f64>(version_count) / (elapsed_ns / 1e9), "versions/s",
+                 Better::Higher);
+    state.record("torn_read_ratio", static_cast<f64>(retry_count) / static_cast<f64>(read_count + retry_count),
+                 "ratio", Better::Lower);
+  }
+
+  auto register_snapshot_benchmarks() -> bool
+  {
+    struct SizeCase
+    {
+      const char *label;
+      usize state_size;
+      u64 version_count;
+    };
+    const SizeCase cases[] = {{"4KiB", 4 * KIB, 2'000'000}, {"64KiB", 64 * KIB, 200'000}};
+
+    Vec<Benchmark> benchmarks;
+    for (const SizeCase &size_case : cases)
+    {
+      benchmarks.push_back({String("ipc/snapshot/thread/") + size_case.label, [size_case](MutRef<State> state) {
+                              bench_snapshot(state, size_case.state_size, size_case.version_count, Peer::Thread);
+                            }});
+#if IA_PLATFORM_UNIX
+      benchmarks.push_back({String("ipc/snapshot/process/") + size_case.label, [size_case](MutRef<State> state) {
+                              bench_snapshot(state, size_case.state_size, size_case.version_count, Peer::Process);
+                            }});
+#endif
+    }
+    return Registry::add(std::move(benchmarks));
+  }
+
+  const bool s_registered = register_snapshot_benchmarks();
+} // namespace
@@ -0,0 +1,157 @@
+// IA-PlatformOps; C++ 20 Async, Process and File Operations.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "bench.hpp"
+
+#include <platform_ops/file.hpp>
+#include <platform_ops/shared_sync.hpp>
+
+#include <cstdio>
+#include <new>
+#include <thread>
+
+#if IA_PLATFORM_UNIX
+#  include <sys/wait.h>
+#  include <time.h>
+#  include <unistd.h>
+#endif
+
+using namespace ia;
+using namespace ia::bench;
+
+namespace
+{
+  enum class Peer : u8
+  {
+    Thread,
+    Process
+  };
+
+  struct PingPong
+  {
+    SharedEvent ping{EventReset::Auto};
+    SharedEvent pong{EventReset::Auto};
+  };
+
+  auto answer(MutRef<PingPong> shared, const u32 rounds) -> void
+  {
+    for (Mut<u32> i = 0; i < rounds; ++i)
+    {
+      shared.ping.wait();
+      shared.pong.set();
+    }
+  }
+
+  // Bounces an auto-reset event pair off a peer thread or process. Each round trip is two wakes.
+  auto bench_ping_pong(MutRef<State> state, const u32 rounds, const Peer peer) -> void
+  {
+    const String name = "platform_ops_bench_sync";
+    Mut<u8 *> segment = FileOps::map_shared_memory(name, sizeof(PingPong), true).value();
+    MutRef<PingPong> shared = *new (segment) PingPong();
+
+    Mut<std::jthread> peer_thread;
+#if IA_PLATFORM_UNIX
+    Mut<pid_t> child = -1;
+    if (peer == Peer::Process)
+    {
+      std::fflush(nullptr);
+      child = fork();
+      if (child == 0)
+      {
+        Mut<Result<u8 *>> mapping = FileOps::map_shared_memory(name, sizeof(PingPong), false);
+        if (!mapping)
+        {
+          _exit(1);
+        }
+        answer(*reinterpret_cast<PingPong *>(*mapping), rounds);
+        _exit(0);
+      }
+    }
+#endif
+    if (peer == Peer::Thread)
+    {
+      peer_thread = std::jthread([&shared, rounds]() { answer(shared, rounds); });
+    }
+
+    Mut<Vec<f64>> samples;
+    samples.reserve(rounds);
+    for (Mut<u32> i = 0; i < rounds; ++i)
+    {
+      const Stopwatch watch;
+      shared.ping.set();
+      shared.pong.wait();
+      samples.push_back(watch.elapsed_ns() / 1000.0);
+    }
+
+    if (peer_thread.joinable())
+    {
+      peer_thread.join();
+    }
+#if IA_PLATFORM_UNIX
+    if (child > 0)
+    {
+      Mut<int> status = 0;
+      waitpid(child, &status, 0);
+    }
+#endif
+    FileOps::unmap_file(segment);
+    FileOps::unlink_shared_memory(name);
+
+    state.record("round_trip_p50_us", percentile(samples, 50.0), "us", Better::Lower);
+    state.record("round_trip_p99_us", percentile(samples, 99.0), "us", Better::Lower);
+  }
+
+#if IA_PLATFORM_UNIX
+  // How much CPU a waiter burns while nothing happens.
+  auto bench_idle_wait(MutRef<State> state) -> void
+  {
+    static constexpr const std::chrono::milliseconds IDLE_TIME{200};
+
+    Mut<SharedEvent> event;
+    Mut<f64> cpu_ns = 0;
+    Mut<std::jthread> waiter([&event, &cpu_ns]() {
+      Mut<struct timespec> before;
+      Mut<struct timespec> after;
+      clock_gettime(CLOCK_THREAD_CPUTIME_ID, &before);
+      event.wait();
+      clock_gettime(CLOCK_THREAD_CPUTIME_ID, &after);
+      cpu_ns = static_cast<f64>(after.tv_sec - before.tv_sec) * 1e9 + static_cast<f64>(after.tv_nsec - before.tv_nsec);
+    });
+    std::this_thread::sleep_for(IDLE_TIME);
+    event.set();
+    waiter.join();
+
+    state.record("idle_cpu_percent", cpu_ns / static_cast<f64>(std::chrono::nanoseconds(IDLE_TIME).count()) * 100.0,
+                 "%", Better::Lower);
+  }
+#endif
+
+  auto register_sync_benchmarks() -> bool
+  {
+    Vec<Benchmark> benchmarks;
+    benchmarks.push_back({"ipc/event/ping_pong/thread", [](MutRef<State> state) {
+                            bench_ping_pong(state, 100'000, Peer::Thread);
+                          }});
+#if IA_PLATFORM_UNIX
+    benchmarks.push_back({"ipc/event/ping_pong/process", [](MutRef<State> state) {
+                            bench_ping_pong(state, 100'000, Peer::Process);
+                          }});
+    benchmarks.push_back({"ipc/event/idle_wait", [](MutRef<State> state) { bench_idle_wait(state); }});
+#endif
+    return Registry::add(std::move(benchmarks));
+  }
+
+  const bool s_registered = register_sync_benchmarks();
+} // namespace
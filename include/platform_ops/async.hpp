@@ -17,39 +17,80 @@
 
 #include <crux/crux.hpp>
 
-#include <deque>
+#include <platform_ops/scheduler.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <memory>
 #include <thread>
+#include <utility>
 #include <functional>
-#include <stop_token>
-#include <condition_variable>
+#include <type_traits>
 
 namespace ia
 {
+  template<typename T> class Future;
+
+  template<typename T> struct WhenAnyResult;
+
+  namespace detail
+  {
+    class FutureStateBase;
+
+    template<typename Fn, typename Arg>
+    using TaskResult = typename std::conditional_t<std::is_invocable_v<Fn, Arg>, std::invoke_result<Fn, Arg>,
+                                                   std::invoke_result<Fn>>::type;
+  } // namespace detail
+
   class AsyncOps
   {
 public:
-    using TaskTag = u64;
-    using WorkerId = u16;
+    using TaskTag = sched::TaskTag;
+    using WorkerId = sched::WorkerId;
+
+    using Clock = sched::Clock;
+    using Deadline = sched::Deadline;
+
+    using Schedule = sched::Schedule;
+    using PriorityStats = sched::PriorityStats;
+
+    static constexpr const WorkerId MAIN_THREAD_WORKER_ID = sched::MAIN_THREAD_WORKER_ID;
+
+    // Reserved for tasks backing a Future, which must not be cancelled.
+    static constexpr const TaskTag FUTURE_TASK_TAG = std::numeric_limits<TaskTag>::max();
 
-    static constexpr const WorkerId MAIN_THREAD_WORKER_ID = 0;
+    static constexpr const Deadline NO_DEADLINE = sched::NO_DEADLINE;
 
+    static constexpr const std::chrono::nanoseconds DEFAULT_AGING_INTERVAL = sched::DEFAULT_AGING_INTERVAL;
+
+    // Ordered from most to least urgent.
     enum class Priority : u8
     {
+      Critical,
       High,
-      Normal
+      Normal,
+      Low,
+      Background
     };
 
-    struct Schedule
-    {
-      Mut<std::atomic<i32>> counter{0};
-    };
+    static constexpr const usize PRIORITY_LEVEL_COUNT = 5;
+
+    static constexpr const usize WAIT_HISTOGRAM_BUCKETS = sched::WAIT_HISTOGRAM_BUCKETS;
+
+    static constexpr const usize FIBER_STACK_SIZE = 256 * 1024;
 
 public:
-    static auto initialize_scheduler(const u8 worker_count = 0) -> Result<void>;
+    // With `use_fibers`, every task runs on a pooled fiber with a fixed-size, guard-paged stack. A task that
+    // waits in wait_for_schedule_completion suspends its fiber, and its worker picks up other work until the
+    // schedule drains. Threads outside the pool then block instead of helping.
+    static auto initialize_scheduler(const u8 worker_count = 0, const bool use_fibers = false) -> Result<void>;
     static auto terminate_scheduler() -> void;
 
+    // Within a priority level, tasks with a deadline run earliest-deadline-first ahead of undated tasks.
     static auto schedule_task(Mut<std::function<void(const WorkerId)>> task, const TaskTag tag,
-                              Mut<Schedule *> schedule, const Priority priority = Priority::Normal) -> void;
+                              Mut<Schedule *> schedule, const Priority priority = Priority::Normal,
+                              const Deadline deadline = NO_DEADLINE) -> void;
 
     static auto cancel_tasks_of_tag(const TaskTag tag) -> void;
 
@@ -57,23 +98,566 @@ public:
 
     static auto run_task(Mut<std::function<void()>> task) -> void;
 
+    // Pops and runs one queued task on the calling thread. Returns false if every queue was empty, and
+    // always in fiber mode, where workers never need help.
+    static auto run_pending_task() -> bool;
+
+    // `fn` may take no arguments or the executing WorkerId. Its result is stored inline in a pooled shared
+    // state, so submitting does not allocate in the common case.
+    template<typename Fn>
+    [[nodiscard]] static auto submit(Mut<Fn> fn, const Priority priority = Priority::Normal,
+                                     const Deadline deadline = NO_DEADLINE)
+        -> Future<detail::TaskResult<Fn, WorkerId>>;
+
+    // Completes once every input has completed. The inputs are handed back ready.
+    template<typename T>
+    [[nodiscard]] static auto when_all(Mut<Vec<Future<T>>> futures) -> Future<Vec<Future<T>>>;
+
+    // Completes once any input has completed, reporting which one.
+    template<typename T>
+    [[nodiscard]] static auto when_any(Mut<Vec<Future<T>>> futures) -> Future<WhenAnyResult<T>>;
+
     [[nodiscard]] static auto get_worker_count() -> WorkerId;
 
+    [[nodiscard]] static auto is_fiber_mode() -> bool;
+
+    [[nodiscard]] static auto is_running_in_fiber() -> bool;
+
+    // A waiting task is treated as one level more urgent for every `interval` it has spent queued, so
+    // sustained traffic on a high level cannot starve the lower ones. A zero interval disables aging.
+    static auto set_aging_interval(const std::chrono::nanoseconds interval) -> void;
+
+    [[nodiscard]] static auto get_priority_stats(const Priority priority) -> PriorityStats;
+
+    static auto reset_priority_stats() -> void;
+
+private:
+    struct TaskFiber;
+
+    // Runs tasks inline, or on pooled fibers in fiber mode.
+    class TaskExecutor;
+
+    // AsyncOps is the full-featured instantiation of BasicScheduler. Everything but the executor is header-only
+    // policy code; the executor lives in async.cpp.
+    using Scheduler = BasicScheduler<sched::DeadlineAgingQueue<PRIORITY_LEVEL_COUNT>, sched::WithTags,
+                                     sched::BlockingIdle, sched::FunctionTask, TaskExecutor>;
+
+    // Drops one unit of work from `schedule`, resuming fibers parked on it once it drains.
+    static auto release_schedule(Mut<Schedule *> schedule) -> void;
+
 private:
-    struct ScheduledTask
+    static Mut<Scheduler> s_scheduler;
+    static thread_local Mut<TaskFiber *> s_current_fiber;
+
+    friend class detail::FutureStateBase;
+    friend class AsyncFileOps;
+  };
+
+  namespace detail
+  {
+    class FutureStatePool
     {
-      Mut<TaskTag> tag{};
-      Mut<Schedule *> schedule_handle{};
-      Mut<std::function<void(const WorkerId)>> task{};
+  public:
+      // Blocks come from a per-thread cache that is refilled from, and spills to, a shared free list in
+      // batches. Requests larger than the biggest size class go to the global allocator.
+      static auto allocate(const usize size) -> void *;
+      static auto release(Mut<void *> block, const usize size) -> void;
+    };
+
+    class FutureContinuation
+    {
+  public:
+      virtual auto on_ready() -> void = 0;
+
+  protected:
+      ~FutureContinuation() = default;
+
+  private:
+      Mut<FutureContinuation *> m_next = nullptr;
+
+      friend class FutureStateBase;
     };
 
-    static auto schedule_worker_loop(Mut<std::stop_token> stop_token, const WorkerId worker_id) -> void;
+    class FutureStateBase
+    {
+  public:
+      FutureStateBase() = default;
+
+      FutureStateBase(Ref<FutureStateBase>) = delete;
+      auto operator=(Ref<FutureStateBase>) -> FutureStateBase & = delete;
+
+      auto add_ref() -> void
+      {
+        m_ref_count.fetch_add(1, std::memory_order_relaxed);
+      }
+
+      auto release() -> void
+      {
+        if (m_ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+          destroy();
+        }
+      }
+
+      [[nodiscard]] auto is_ready() const -> bool
+      {
+        return m_ready.load(std::memory_order_acquire);
+      }
+
+      // Helps the scheduler by running queued tasks while the result is pending. Inside a fiber, the fiber is
+      // suspended instead.
+      auto wait() -> void;
+
+      // Runs `continuation->on_ready()` on the completing thread, or right away if already complete.
+      auto add_continuation(Mut<FutureContinuation *> continuation) -> void;
+
+  protected:
+      virtual ~FutureStateBase() = default;
+
+      auto mark_ready() -> void;
+
+      virtual auto destroy() -> void = 0;
+
+  private:
+      Mut<std::atomic<u32>> m_ref_count{1};
+      Mut<std::atomic<bool>> m_ready{false};
+      Mut<std::atomic<FutureContinuation *>> m_continuations{nullptr};
+    };
+
+    struct FutureVoid
+    {
+    };
+
+    template<typename T> using FutureValue = std::conditional_t<std::is_void_v<T>, FutureVoid, T>;
+
+    template<typename State, typename... Args> auto make_pooled_state(ForwardRef<Args>... args) -> State *
+    {
+      if constexpr (alignof(State) > alignof(std::max_align_t))
+      {
+        return new State(std::forward<Args>(args)...);
+      }
+      else
+      {
+        return new (FutureStatePool::allocate(sizeof(State))) State(std::forward<Args>(args)...);
+      }
+    }
+
+    template<typename State> auto destroy_pooled_state(Mut<State *> state) -> void
+    {
+      if constexpr (alignof(State) > alignof(std::max_align_t))
+      {
+        delete state;
+      }
+      else
+      {
+        state->~State();
+        FutureStatePool::release(state, sizeof(State));
+      }
+    }
+
+    auto schedule_future_task(Mut<std::function<void(const AsyncOps::WorkerId)>> task,
+                              const AsyncOps::Priority priority, const AsyncOps::Deadline deadline) -> void;
+
+    template<typename Fn> auto invoke_task(MutRef<Fn> fn, const AsyncOps::WorkerId worker_id) -> decltype(auto)
+    {
+      if constexpr (std::is_invocable_v<Fn, AsyncOps::WorkerId>)
+      {
+        return fn(worker_id);
+      }
+      else
+      {
+        return fn();
+      }
+    }
+
+    template<typename T> class FutureState : public FutureStateBase
+    {
+  public:
+      FutureState()
+      {
+      }
+
+      template<typename... Args> auto set_value(ForwardRef<Args>... args) -> void
+      {
+        std::construct_at(&m_value, std::forward<Args>(args)...);
+        mark_ready();
+      }
+
+      [[nodiscard]] auto get_value() -> FutureValue<T> &
+      {
+        return m_value;
+      }
+
+  protected:
+      ~FutureState() override
+      {
+        if (is_ready())
+        {
+          std::destroy_at(&m_value);
+        }
+      }
+
+  private:
+      union {
+        Mut<FutureValue<T>> m_value;
+      };
+    };
+
+    template<typename T, typename Fn> class TaskFutureState final : public FutureState<T>
+    {
+  public:
+      explicit TaskFutureState(Mut<Fn> fn) : m_fn(std::move(fn))
+      {
+      }
+
+      auto run(const AsyncOps::WorkerId worker_id) -> void
+      {
+        if constexpr (std::is_void_v<T>)
+        {
+          invoke_task(m_fn, worker_id);
+          this->set_value();
+        }
+        else
+        {
+          this->set_value(invoke_task(m_fn, worker_id));
+        }
+        this->release();
+      }
+
+  protected:
+      auto destroy() -> void override
+      {
+        destroy_pooled_state(this);
+      }
+
+  private:
+      Mut<Fn> m_fn;
+    };
+
+    template<typename T, typename U, typename Fn>
+    class ThenFutureState final : public FutureState<U>, public FutureContinuation
+    {
+  public:
+      ThenFutureState(Mut<FutureState<T> *> parent, Mut<Fn> fn, const AsyncOps::Priority priority)
+          : m_parent(parent), m_fn(std::move(fn)), m_priority(priority)
+      {
+      }
+
+      auto on_ready() -> void override
+      {
+        schedule_future_task([this](const AsyncOps::WorkerId) { run(); }, m_priority, AsyncOps::NO_DEADLINE);
+      }
+
+  protected:
+      auto destroy() -> void override
+      {
+        destroy_pooled_state(this);
+      }
+
+  private:
+      auto run() -> void
+      {
+        if constexpr (std::is_void_v<T> && std::is_void_v<U>)
+        {
+          m_fn();
+          this->set_value();
+        }
+        else if constexpr (std::is_void_v<T>)
+        {
+          this->set_value(m_fn());
+        }
+        else if constexpr (std::is_void_v<U>)
+        {
+          m_fn(std::move(m_parent->get_value()));
+          this->set_value();
+        }
+        else
+        {
+          this->set_value(m_fn(std::move(m_parent->get_value())));
+        }
+
+        m_parent->release();
+        m_parent = nullptr;
+        this->release();
+      }
+
+  private:
+      Mut<FutureState<T> *> m_parent;
+      Mut<Fn> m_fn;
+      const AsyncOps::Priority m_priority;
+    };
+
+    template<typename T> class WhenAllFutureState final : public FutureState<Vec<Future<T>>>
+    {
+  public:
+      WhenAllFutureState(Mut<Vec<Future<T>>> inputs, const usize input_count)
+          : m_inputs(std::move(inputs)), m_nodes(input_count), m_remaining(input_count + 1)
+      {
+        for (MutRef<InputNode> node : m_nodes)
+        {
+          node.owner = this;
+        }
+      }
+
+      auto attach(const usize index, Mut<FutureStateBase *> input) -> void
+      {
+        input->add_continuation(&m_nodes[index]);
+      }
+
+      // Drops the guard count taken at construction, so completion cannot race the attach loop.
+      auto finish_attaching() -> void
+      {
+        on_input_ready();
+      }
+
+  protected:
+      auto destroy() -> void override
+      {
+        destroy_pooled_state(this);
+      }
+
+  private:
+      struct InputNode final : FutureContinuation
+      {
+        Mut<WhenAllFutureState *> owner = nullptr;
+
+        auto on_ready() -> void override
+        {
+          owner->on_input_ready();
+        }
+      };
+
+      auto on_input_ready() -> void
+      {
+        if (m_remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+          this->set_value(std::move(m_inputs));
+          this->release();
+        }
+      }
+
+  private:
+      Mut<Vec<Future<T>>> m_inputs;
+      Mut<Vec<InputNode>> m_nodes;
+      Mut<std::atomic<usize>> m_remaining;
+    };
+
+    template<typename T> class WhenAnyFutureState final : public FutureState<WhenAnyResult<T>>
+    {
+  public:
+      WhenAnyFutureState(Mut<Vec<Future<T>>> inputs, const usize input_count)
+          : m_inputs(std::move(inputs)), m_nodes(input_count)
+      {
+        for (Mut<usize> i = 0; i < input_count; ++i)
+        {
+          m_nodes[i].owner = this;
+          m_nodes[i].index = i;
+        }
+      }
+
+      // Every attached input keeps this state alive until it fires, since losers complete after the result
+      // has been handed out.
+      auto attach(const usize index, Mut<FutureStateBase *> input) -> void
+      {
+        this->add_ref();
+        input->add_continuation(&m_nodes[index]);
+      }
+
+  protected:
+      auto destroy() -> void override
+      {
+        destroy_pooled_state(this);
+      }
+
+  private:
+      struct InputNode final : FutureContinuation
+      {
+        Mut<WhenAnyFutureState *> owner = nullptr;
+        Mut<usize> index = 0;
+
+        auto on_ready() -> void override
+        {
+          owner->on_input_ready(index);
+        }
+      };
+
+      auto on_input_ready(const usize index) -> void
+      {
+        if (!m_has_winner.exchange(true, std::memory_order_acq_rel))
+        {
+          this->set_value(WhenAnyResult<T>{index, std::move(m_inputs)});
+        }
+        this->release();
+      }
+
+  private:
+      Mut<Vec<Future<T>>> m_inputs;
+      Mut<Vec<InputNode>> m_nodes;
+      Mut<std::atomic<bool>> m_has_winner{false};
+    };
+  } // namespace detail
+
+  template<typename T> class Future
+  {
+public:
+    Future() = default;
+
+    ~Future()
+    {
+      reset();
+    }
+
+    Future(Ref<Future>) = delete;
+    auto operator=(Ref<Future>) -> Future & = delete;
+
+    Future(ForwardRef<Future> other) noexcept : m_state(std::exchange(other.m_state, nullptr))
+    {
+    }
+
+    auto operator=(ForwardRef<Future> other) noexcept -> Future &
+    {
+      if (this != &other)
+      {
+        reset();
+        m_state = std::exchange(other.m_state, nullptr);
+      }
+      return *this;
+    }
+
+    [[nodiscard]] auto is_valid() const -> bool
+    {
+      return m_state != nullptr;
+    }
+
+    [[nodiscard]] auto is_ready() const -> bool
+    {
+      return m_state && m_state->is_ready();
+    }
+
+    auto wait() const -> void
+    {
+      ensure(is_valid(), "Cannot wait on an empty Future");
+      m_state->wait();
+    }
+
+    // Moves the result out, so it may be called only once.
+    auto get() -> T
+    {
+      wait();
+      if constexpr (!std::is_void_v<T>)
+      {
+        return std::move(m_state->get_value());
+      }
+    }
+
+    // Consumes this future. `fn` receives the result (nothing for void) and runs as a task on the pool.
+    template<typename Fn>
+    [[nodiscard]] auto then(Mut<Fn> fn, const AsyncOps::Priority priority = AsyncOps::Priority::Normal)
+    {
+      ensure(is_valid(), "Cannot chain onto an empty Future");
+
+      using U = typename std::conditional_t<std::is_void_v<T>, std::invoke_result<Fn>,
+                                            std::invoke_result<Fn, detail::FutureValue<T>>>::type;
+      using State = detail::ThenFutureState<T, U, Fn>;
+
+      Mut<detail::FutureState<T> *> parent = std::exchange(m_state, nullptr);
+      Mut<State *> state = detail::make_pooled_state<State>(parent, std::move(fn), priority);
+      state->add_ref();
+
+      Mut<Future<U>> result(state);
+      parent->add_continuation(state);
+      return result;
+    }
 
 private:
-    static Mut<std::mutex> s_queue_mutex;
-    static Mut<std::condition_variable> s_wake_condition;
-    static Mut<Vec<std::jthread>> s_schedule_workers;
-    static Mut<std::deque<ScheduledTask>> s_high_priority_queue;
-    static Mut<std::deque<ScheduledTask>> s_normal_priority_queue;
+    explicit Future(Mut<detail::FutureState<T> *> state) : m_state(state)
+    {
+    }
+
+    auto reset() -> void
+    {
+      if (m_state)
+      {
+        m_state->release();
+        m_state = nullptr;
+      }
+    }
+
+private:
+    Mut<detail::FutureState<T> *> m_state = nullptr;
+
+    template<typename> friend class Future;
+    friend class AsyncOps;
+  };
+
+  template<typename T> struct WhenAnyResult
+  {
+    Mut<usize> index{};
+    Mut<Vec<Future<T>>> futures;
   };
+
+  template<typename Fn>
+  auto AsyncOps::submit(Mut<Fn> fn, const Priority priority, const Deadline deadline)
+      -> Future<detail::TaskResult<Fn, WorkerId>>
+  {
+    using T = detail::TaskResult<Fn, WorkerId>;
+    using State = detail::TaskFutureState<T, Fn>;
+
+    Mut<State *> state = detail::make_pooled_state<State>(std::move(fn));
+    state->add_ref();
+
+    Mut<Future<T>> result(state);
+    detail::schedule_future_task([state](const WorkerId worker_id) { state->run(worker_id); }, priority, deadline);
+    return result;
+  }
+
+  template<typename T> auto AsyncOps::when_all(Mut<Vec<Future<T>>> futures) -> Future<Vec<Future<T>>>
+  {
+    using State = detail::WhenAllFutureState<T>;
+
+    const usize count = futures.size();
+    Mut<Vec<detail::FutureStateBase *>> inputs;
+    inputs.reserve(count);
+    for (Ref<Future<T>> future : futures)
+    {
+      ensure(future.is_valid(), "Cannot combine an empty Future");
+      inputs.push_back(future.m_state);
+    }
+
+    Mut<State *> state = detail::make_pooled_state<State>(std::move(futures), count);
+    state->add_ref();
+
+    Mut<Future<Vec<Future<T>>>> result(state);
+    for (Mut<usize> i = 0; i < count; ++i)
+    {
+      state->attach(i, inputs[i]);
+    }
+    state->finish_attaching();
+    return result;
+  }
+
+  template<typename T> auto AsyncOps::when_any(Mut<Vec<Future<T>>> futures) -> Future<WhenAnyResult<T>>
+  {
+    using State = detail::WhenAnyFutureState<T>;
+
+    ensure(!futures.empty(), "when_any requires at least one Future");
+
+    const usize count = futures.size();
+    Mut<Vec<detail::FutureStateBase *>> inputs;
+    inputs.reserve(count);
+    for (Ref<Future<T>> future : futures)
+    {
+      ensure(future.is_valid(), "Cannot combine an empty Future");
+      inputs.push_back(future.m_state);
+    }
+
+    Mut<State *> state = detail::make_pooled_state<State>(std::move(futures), count);
+
+    Mut<Future<WhenAnyResult<T>>> result(state);
+    for (Mut<usize> i = 0; i < count; ++i)
+    {
+      state->attach(i, inputs[i]);
+    }
+    return result;
+  }
 } // namespace ia
\ No newline at end of file
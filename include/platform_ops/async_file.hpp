@@ -0,0 +1,140 @@
+// IA-PlatformOps; C++ 20 Async, Process and File Operations.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <crux/crux.hpp>
+
+#include <platform_ops/async.hpp>
+#include <platform_ops/file.hpp>
+
+#include <functional>
+
+namespace ia
+{
+  // Asynchronous positional file I/O. On Linux it runs on io_uring; elsewhere, or when io_uring is unavailable,
+  // operations run on a small pool of threads that make blocking calls, so AsyncOps workers never do.
+  class AsyncFileOps
+  {
+public:
+    using Completion = std::function<void(Result<usize>)>;
+
+    static constexpr const u32 DEFAULT_QUEUE_DEPTH = 256;
+
+    static constexpr const u32 BLOCKING_POOL_WORKER_COUNT = 4;
+
+    static constexpr const i32 NO_INDEX = -1;
+
+    enum class Backend : u8
+    {
+      None,
+      IoUring,
+      BlockingPool
+    };
+
+    enum class Operation : u8
+    {
+      Read,
+      Write,
+      Sync,    // fsync
+      DataSync // fdatasync
+    };
+
+    // One operation for `submit`. Reads and writes may transfer fewer bytes than asked, like pread/pwrite.
+    // Its completion is delivered in one of two ways. With `on_complete` set, it runs as an AsyncOps task.
+    // Otherwise `*result` is filled in, if set, and `schedule` is decremented.
+    struct Request
+    {
+      Mut<Operation> operation = Operation::Read;
+      Mut<NativeFileHandle> handle = INVALID_FILE_HANDLE;
+      Mut<i32> file_index = NO_INDEX; // Slot from register_files, used instead of `handle`
+      Mut<u8 *> buffer = nullptr;
+      Mut<usize> size = 0;
+      Mut<u64> offset = 0;
+      Mut<i32> buffer_index = NO_INDEX; // Slot from register_buffers that contains `buffer`
+
+      Mut<Completion> on_complete;
+      Mut<AsyncOps::Priority> priority = AsyncOps::Priority::Normal;
+
+      Mut<AsyncOps::Schedule *> schedule = nullptr;
+      Mut<Result<usize> *> result = nullptr;
+    };
+
+public:
+    // Prefers io_uring unless `allow_io_uring` is false. Completion callbacks need the AsyncOps scheduler.
+    static auto initialize(const u32 queue_depth = DEFAULT_QUEUE_DEPTH, const bool allow_io_uring = true)
+        -> Result<void>;
+
+    // Waits for every in-flight operation to complete first.
+    static auto terminate() -> void;
+
+    [[nodiscard]] static auto get_backend() -> Backend;
+
+    static auto read_at(const NativeFileHandle handle, const Span<u8> buffer, const u64 offset,
+                        Mut<Completion> on_complete, const AsyncOps::Priority priority = AsyncOps::Priority::Normal)
+        -> void;
+
+    static auto read_at(const NativeFileHandle handle, const Span<u8> buffer, const u64 offset,
+                        Mut<AsyncOps::Schedule *> schedule, Mut<Result<usize> *> result = nullptr) -> void;
+
+    static auto write_at(const NativeFileHandle handle, const Span<const u8> data, const u64 offset,
+                         Mut<Completion> on_complete, const AsyncOps::Priority priority = AsyncOps::Priority::Normal)
+        -> void;
+
+    static auto write_at(const NativeFileHandle handle, const Span<const u8> data, const u64 offset,
+                         Mut<AsyncOps::Schedule *> schedule, Mut<Result<usize> *> result = nullptr) -> void;
+
+    static auto fsync(const NativeFileHandle handle, const bool data_only, Mut<Completion> on_complete,
+                      const AsyncOps::Priority priority = AsyncOps::Priority::Normal) -> void;
+
+    static auto fsync(const NativeFileHandle handle, const bool data_only, Mut<AsyncOps::Schedule *> schedule,
+                      Mut<Result<usize> *> result = nullptr) -> void;
+
+    // FileOps::copy_file on the blocking pool, which is started on first use under io_uring. The completion gets
+    // the byte count.
+    static auto copy_file(Ref<Path> source, Ref<Path> destination, Ref<FileOps::CopyOptions> options,
+                          Mut<Completion> on_complete, const AsyncOps::Priority priority = AsyncOps::Priority::Normal)
+        -> void;
+
+    static auto copy_file(Ref<Path> source, Ref<Path> destination, Ref<FileOps::CopyOptions> options,
+                          Mut<AsyncOps::Schedule *> schedule, Mut<Result<usize> *> result = nullptr) -> void;
+
+    // Queues every request and, on io_uring, hands the whole batch to the kernel in one system call.
+    static auto submit(const Span<Request> requests) -> void;
+
+    // Pins the buffers so reads and writes into them skip per-call page mapping. Replaces earlier ones.
+    static auto register_buffers(const Span<const Span<u8>> buffers) -> Result<void>;
+    static auto unregister_buffers() -> void;
+
+    // Lets requests name files by slot, skipping the per-call descriptor lookup. Replaces earlier ones.
+    static auto register_files(const Span<const NativeFileHandle> handles) -> Result<void>;
+    static auto unregister_files() -> void;
+
+private:
+    struct PendingOperation;
+
+    static auto complete(Mut<PendingOperation *> operation, Mut<Result<usize>> result) -> void;
+    static auto run_on_blocking_pool(Mut<PendingOperation *> operation) -> void;
+
+    // io_uring operations are tracked from submission to completion, so that they can still be completed if the
+    // ring stops working. Tracking fails once it has.
+    static auto track_in_flight(Mut<PendingOperation *> operation) -> bool;
+    static auto untrack_in_flight(Mut<PendingOperation *> operation) -> void;
+    static auto fail_in_flight(Ref<String> reason) -> void;
+    static auto run_copy(Mut<Request> request, Ref<Path> source, Ref<Path> destination,
+                         Ref<FileOps::CopyOptions> options) -> void;
+    static auto run_blocking(Ref<Request> request) -> Result<usize>;
+  };
+} // namespace ia
@@ -0,0 +1,95 @@
+// IA-PlatformOps; C++ 20 Async, Process and File Operations.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <crux/crux.hpp>
+
+#include <platform_ops/async.hpp>
+
+#include <functional>
+#include <limits>
+
+namespace ia
+{
+  // Recursive directory traversal that reads each directory with one descriptor and stats entries relative to it
+  // (getdents64 and statx on Linux), so no full path is resolved more than once. Directories are spread across
+  // the AsyncOps workers, and entries stream out in batches, one per directory read. Symlinks are reported but
+  // never followed.
+  class DirectoryWalker
+  {
+public:
+    static constexpr const u32 UNLIMITED_DEPTH = std::numeric_limits<u32>::max();
+
+    enum class EntryType : u8
+    {
+      File,
+      Directory,
+      Symlink,
+      Other // Devices, sockets and pipes
+    };
+
+    // The views stay valid only for the duration of the callback that receives the entry.
+    struct Entry
+    {
+      Mut<StringView> directory; // The containing directory: the root as given, joined with the path below it
+      Mut<StringView> name;
+      Mut<EntryType> type = EntryType::Other;
+      Mut<u32> depth = 0; // 0 for entries directly in the root
+      Mut<u64> inode = 0; // 0 where the platform has none (Windows)
+
+      // Only filled in when Options::stat is set. A file that vanished before its stat keeps them at 0.
+      Mut<u64> size = 0;
+      Mut<i64> modified_ns = 0; // Since the Unix epoch
+
+      [[nodiscard]] auto get_path() const -> Path;
+    };
+
+    // Returning false drops the entry and, for a directory, everything below it. Runs concurrently.
+    using Filter = std::function<bool(Ref<Entry>)>;
+
+    // Receives the entries of one directory read. Batches from different directories arrive concurrently.
+    using Callback = std::function<void(Span<const Entry>, AsyncOps::WorkerId)>;
+
+    struct Options
+    {
+      Mut<bool> stat = false;                   // Fill in size and modified_ns, one statx per entry
+      Mut<u32> max_depth = UNLIMITED_DEPTH;     // Directories at this depth are reported but not entered
+      Mut<Filter> filter;                       // Applied before an entry is reported or entered
+      Mut<bool> parallel = true;                // Without a running scheduler the walk is serial anyway
+    };
+
+    struct Stats
+    {
+      Mut<u64> directory_count = 0; // Directories read, including the root
+      Mut<u64> entry_count = 0;     // Entries passed to the callback
+      Mut<u64> error_count = 0;     // Directories that could not be read and entries that could not be stat'ed
+    };
+
+public:
+    // Fails only when `root` itself cannot be opened. Later errors are counted and the walk carries on.
+    static auto walk(Ref<Path> root, Ref<Options> options, Ref<Callback> on_entries) -> Result<Stats>;
+
+    // Collects every path below `root`, in no particular order.
+    static auto list(Ref<Path> root) -> Result<Vec<Path>>;
+    static auto list(Ref<Path> root, Ref<Options> options) -> Result<Vec<Path>>;
+
+private:
+    struct Context;
+
+    static auto walk_directory(MutRef<Context> context, Mut<String> directory, const u32 depth,
+                               const AsyncOps::WorkerId worker_id, const isize handle = -1) -> void;
+  };
+} // namespace ia
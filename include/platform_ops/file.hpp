@@ -17,6 +17,8 @@
 
 #include <crux/crux.hpp>
 
+#include <functional>
+
 #if IA_PLATFORM_WINDOWS
 #  define NOMINMAX
 #  define WIN32_LEAN_AND_MEAN
@@ -35,6 +37,8 @@ namespace ia
   {
 public:
     class MemoryMappedRegion;
+    class MappedFile;
+    class LoadedFiles;
 
     enum class FileAccess : u8
     {
@@ -52,41 +56,227 @@ public:
       TruncateExisting // Opens existing and clears it
     };
 
+    // Whether transfers on a handle go through the page cache.
+    enum class FileCaching : u8
+    {
+      Buffered, // Through the page cache
+      Direct    // Straight between the device and the caller's memory (O_DIRECT, FILE_FLAG_NO_BUFFERING). Buffer
+                // addresses, offsets and sizes must follow get_direct_io_alignment
+    };
+
+    // What direct I/O on a file needs: buffer addresses aligned to `memory`, file offsets and transfer sizes to
+    // `offset`.
+    struct DirectIoAlignment
+    {
+      Mut<usize> memory = 0;
+      Mut<usize> offset = 0;
+    };
+
+    enum class HugePages : u8
+    {
+      None,        // Normal pages
+      Transparent, // Ask the kernel to back the mapping with huge pages where it can (MADV_HUGEPAGE)
+      Explicit2M,  // Reserved 2 MiB pages from a hugetlbfs mount, falling back to Transparent
+      Explicit1G   // Reserved 1 GiB pages, falling back to Explicit2M
+    };
+
+    // How a mapping is about to be used, so the kernel can tune read-ahead and caching for it.
+    enum class AccessHint : u8
+    {
+      Normal,     // No particular pattern
+      Sequential, // Front to back: read ahead aggressively, free pages soon after use
+      Random,     // Scattered: skip read-ahead
+      WillNeed,   // Start reading the range in now, in the background
+      DontNeed    // Drop the range's pages; they are read in again if touched
+    };
+
+    // Paying for page faults when a mapping is made, instead of on first access.
+    enum class Prefault : u8
+    {
+      None,     // Fault pages in lazily
+      Populate, // Read every page in before map returns
+      Lock      // Populate and lock the pages in memory (mlock). Falls back to Populate if the lock limit is too low
+    };
+
+    // How MemoryMappedRegion::map treats the file blocks under the region.
+    enum class FileGrowth : u8
+    {
+      Sparse,     // Only extend the file size. Blocks are allocated when pages are first written back
+      Preallocate // Reserve blocks for the whole region first, filling its holes. Running out of space fails map,
+                  // not a later write through the mapping (SIGBUS)
+    };
+
+    // Which handle a MemoryMappedRegion flushes through.
+    enum class RegionHandle : u8
+    {
+      Duplicate, // A duplicate of the caller's, so the caller may close theirs at any time
+      Borrow     // The caller's own, which must stay open until the region is unmapped. Saves a descriptor per
+                 // region when many regions map one file
+    };
+
+    // How copy_file moved the data, from cheapest to most expensive.
+    enum class CopyMethod : u8
+    {
+      Clone,     // The copy shares the source's blocks until either is written (FICLONE reflink)
+      CopyRange, // In-kernel copy (copy_file_range), which some filesystems turn into a clone or server-side copy
+      SendFile,  // In-kernel copy through the page cache (sendfile)
+      Buffered,  // pread/pwrite through a small buffer
+      System     // The platform's own copy routine (CopyFileExW)
+    };
+
+    struct CopyOptions
+    {
+      Mut<bool> overwrite = false;
+      Mut<bool> allow_clone = true;    // Off to give the copy blocks of its own now, rather than on first write
+      Mut<bool> preserve_holes = true; // Skip the source's holes (SEEK_DATA/SEEK_HOLE), so the copy stays sparse
+    };
+
+    struct CopyResult
+    {
+      Mut<u64> size = 0;
+      Mut<CopyMethod> method = CopyMethod::Buffered; // The most expensive method any part of the file needed
+    };
+
+    enum class LoadOrder : u8
+    {
+      AsGiven, // Each file is opened, read and closed in turn. Cheapest when the files are cached
+      Inode    // Each window of files is opened first, then read in inode order, which roughly follows placement
+               // on disk. Pays off on cold caches and rotational disks
+    };
+
+    struct LoadOptions
+    {
+      Mut<LoadOrder> order = LoadOrder::AsGiven;
+      Mut<bool> no_access_time = false;
+    };
+
+    // Direct caching fails here, not on the first transfer, when the filesystem does not support it.
     static auto native_open_file(Ref<Path> path, const FileAccess access, const FileMode mode,
-                                 const u32 permissions = 0644) -> Result<NativeFileHandle>;
+                                 const u32 permissions = 0644, const FileCaching caching = FileCaching::Buffered)
+        -> Result<NativeFileHandle>;
 
     static auto native_close_file(const NativeFileHandle handle) -> void;
 
+    static auto get_file_size(const NativeFileHandle handle) -> Result<u64>;
+
+    // Truncates or extends the file, leaving the file position alone.
+    static auto set_file_size(const NativeFileHandle handle, const u64 size) -> Result<void>;
+
+    // Asks the filesystem (STATX_DIOALIGN, FileStorageInfo) rather than assuming 4 KiB. Kernels too old to report
+    // it get the filesystem block size, which is always safe. Fails if the file cannot be used for direct I/O.
+    static auto get_direct_io_alignment(const NativeFileHandle handle) -> Result<DirectIoAlignment>;
+
+    // Reserves disk blocks for the first `size` bytes of the file, so later writes neither allocate nor fail for
+    // lack of space. The filesystem gets to lay the blocks out in one go, which keeps them contiguous. The file
+    // grows to `size` unless `keep_size` is set, and never shrinks.
+    static auto preallocate(const NativeFileHandle handle, const u64 size, const bool keep_size = false)
+        -> Result<void>;
+
+    // The same for [offset, offset + size) only, leaving holes before `offset` alone. The file grows to
+    // offset + size unless `keep_size` is set. Windows can only reserve from the start of the file, and macOS from
+    // the current end.
+    static auto preallocate(const NativeFileHandle handle, const u64 offset, const u64 size,
+                            const bool keep_size = false) -> Result<void>;
+
 public:
     static auto normalize_executable_path(Ref<Path> path) -> Path;
 
 public:
+    // map_file and map_shared_memory keep track of their mappings for unmap_file. Both are safe to call from
+    // any thread. MappedFile skips that bookkeeping entirely.
     static auto unmap_file(const u8 *mapped_ptr) -> void;
 
     static auto map_file(Ref<Path> path, MutRef<usize> size) -> Result<const u8 *>;
 
-    // @param `is_owner` true to allocate/truncate. false to just open.
+    static auto map_file(Ref<Path> path, MutRef<usize> size, const AccessHint hint,
+                         const Prefault prefault = Prefault::None) -> Result<const u8 *>;
+
+    // Page-granular hints for any mapped range. The range is widened to whole pages.
+    static auto advise_range(const void *address, const usize size, const AccessHint hint) -> void;
+
+    // Starts reading the range in without waiting, so later accesses do not stall on the disk.
+    static auto prefetch_range(const void *address, const usize size) -> void;
+
+    // @param `is_owner` true to allocate/truncate. false to just open, which fails while the segment is smaller
+    // than `size`.
     static auto map_shared_memory(Ref<String> name, const usize size, const bool is_owner) -> Result<u8 *>;
 
+    // `page_size` receives the page size the segment actually got. Explicit huge pages come from a hugetlbfs mount
+    // with free reserved pages (and SeLockMemoryPrivilege on Windows). Everything else falls back to normal shared
+    // memory, with MADV_HUGEPAGE unless `huge_pages` is None. Owner and consumers must ask for the same option.
+    static auto map_shared_memory(Ref<String> name, const usize size, const bool is_owner, const HugePages huge_pages,
+                                  MutRef<usize> page_size) -> Result<u8 *>;
+
     static auto unlink_shared_memory(Ref<String> name) -> void;
 
-    static auto read_text_file(Ref<Path> path) -> Result<String>;
+    // How many bytes of the range are currently backed by huge pages, explicit or transparent. Transparent huge
+    // pages are assigned lazily, so this is only meaningful once the memory has been touched. Always 0 off Linux.
+    static auto get_huge_page_backed_size(const void *address, const usize size) -> usize;
+
+    [[nodiscard]] static auto get_system_page_size() -> usize;
+
+    // Files at least this large are copied out of a temporary memory mapping instead of read with pread.
+    static constexpr const usize MAPPED_READ_THRESHOLD = 64 * 1024 * 1024;
+
+    // `no_access_time` skips the access time update (O_NOATIME) where the platform and file ownership allow.
+    static auto read_text_file(Ref<Path> path, const bool no_access_time = false) -> Result<String>;
+
+    static auto read_binary_file(Ref<Path> path, const bool no_access_time = false) -> Result<Vec<u8>>;
+
+    // Replace the buffer's contents with the whole file and return its size. The buffer's capacity is reused,
+    // so re-reading a file no larger than the last one does not allocate.
+    static auto read_into(Ref<Path> path, MutRef<Vec<u8>> buffer, const bool no_access_time = false) -> Result<usize>;
+    static auto read_into(Ref<Path> path, MutRef<String> buffer, const bool no_access_time = false) -> Result<usize>;
+
+    // Reads at most `buffer.size()` bytes from the start of the file and returns how many were read.
+    static auto read_into(Ref<Path> path, const Span<u8> buffer, const bool no_access_time = false) -> Result<usize>;
+
+    // Writes the parts back to back, as if concatenated, and returns the total byte count.
+    static auto write_from(Ref<Path> path, const Span<const Span<const u8>> parts, const bool overwrite = false)
+        -> Result<usize>;
+
+    // Vectored I/O (preadv/pwritev on Unix) that resumes after partial transfers and returns the total byte count.
+    // Writes complete in full or fail; reads stop early only at end of file. Pipes and FIFOs ignore the offset.
+    static auto write_gather(Ref<Path> path, const Span<const Span<const u8>> parts, const bool overwrite = false)
+        -> Result<usize>;
+    static auto write_gather(const NativeFileHandle handle, const Span<const Span<const u8>> parts, const u64 offset)
+        -> Result<usize>;
 
-    static auto read_binary_file(Ref<Path> path) -> Result<Vec<u8>>;
+    static auto read_scatter(Ref<Path> path, const Span<const Span<u8>> parts, const bool no_access_time = false)
+        -> Result<usize>;
+    static auto read_scatter(const NativeFileHandle handle, const Span<const Span<u8>> parts, const u64 offset)
+        -> Result<usize>;
 
     static auto write_text_file(Ref<Path> path, Ref<String> contents, const bool overwrite = false) -> Result<usize>;
 
     static auto write_binary_file(Ref<Path> path, const Span<const u8> contents, const bool overwrite = false)
         -> Result<usize>;
 
-private:
-    static Mut<HashMap<const u8 *, std::tuple<void *, void *, void *>>> s_mapped_files;
+    // Copies a file without pulling it through user space where the platform allows, trying each CopyMethod in
+    // order and falling back whenever one is unsupported for these files. The copy gets the source's permission
+    // bits, less the umask. A failed copy removes what it wrote.
+    static auto copy_file(Ref<Path> source, Ref<Path> destination) -> Result<CopyResult>;
+    static auto copy_file(Ref<Path> source, Ref<Path> destination, Ref<CopyOptions> options) -> Result<CopyResult>;
+
+    // Receives one file from load_each_file: its index in `paths`, and its contents or why it could not be read.
+    // The contents are only valid for the duration of the call.
+    using LoadCallback = std::function<void(const usize, Result<Span<const u8>>)>;
+
+    // Reads a batch of files, packing them into large arenas rather than one allocation per file. The batch is
+    // split into windows that run on the AsyncOps workers when a scheduler is running.
+    static auto load_files(const Span<const Path> paths) -> LoadedFiles;
+    static auto load_files(const Span<const Path> paths, Ref<LoadOptions> options) -> LoadedFiles;
+
+    // The same reads, handing each file to `on_loaded` instead of keeping it. Calls arrive concurrently.
+    static auto load_each_file(const Span<const Path> paths, Ref<LoadCallback> on_loaded) -> void;
+    static auto load_each_file(const Span<const Path> paths, Ref<LoadOptions> options, Ref<LoadCallback> on_loaded)
+        -> void;
   };
 
   class FileOps::MemoryMappedRegion
   {
 public:
-    MemoryMappedRegion() = default;
+    MemoryMappedRegion();
     ~MemoryMappedRegion();
 
     MemoryMappedRegion(Ref<MemoryMappedRegion>) = delete;
@@ -95,11 +285,41 @@ public:
     MemoryMappedRegion(ForwardRef<MemoryMappedRegion> other) noexcept;
     auto operator=(ForwardRef<MemoryMappedRegion> other) noexcept -> MemoryMappedRegion &;
 
-    auto map(const NativeFileHandle handle, const u64 offset, const usize size) -> Result<void>;
+    // Files on hugetlbfs are always mapped with their huge pages. For other files, any `huge_pages` other than None
+    // asks for transparent huge pages, which the kernel may or may not provide depending on the filesystem.
+    auto map(const NativeFileHandle handle, const u64 offset, const usize size,
+             const HugePages huge_pages = HugePages::None, const AccessHint hint = AccessHint::Sequential,
+             const Prefault prefault = Prefault::None, const FileGrowth growth = FileGrowth::Sparse,
+             const RegionHandle region_handle = RegionHandle::Duplicate) -> Result<void>;
 
     auto unmap() -> void;
+
+    // Synchronously writes the whole region back, and clears anything marked dirty.
     auto flush() -> void;
 
+    // `offset` and `size` are relative to the region and clamped to it.
+    auto advise_range(const usize offset, const usize size, const AccessHint hint) const -> void;
+    auto prefetch_range(const usize offset, const usize size) const -> void;
+
+    // Writes back only the pages covering [offset, offset + size). With `async`, the writeback is started but not
+    // waited for. On Linux that goes through sync_file_range, since MS_ASYNC does not start any I/O there.
+    auto flush_range(const usize offset, const usize size, const bool async = false) -> Result<void>;
+
+    // Records that [offset, offset + size) was written, so flush_dirty can skip the pages that were not. Call it
+    // after the write. Any number of threads may mark ranges at once, and while a flush is running.
+    auto mark_dirty(const usize offset, const usize size) -> void;
+
+    // Writes back the pages marked dirty since they were last flushed. Also reports a failed background flush.
+    auto flush_dirty(const bool async = false) -> Result<void>;
+
+    // Bytes in pages currently marked dirty.
+    [[nodiscard]] auto get_dirty_size() const -> usize;
+
+    // Once more than `max_dirty_bytes` are marked dirty, mark_dirty queues a synchronous flush_dirty on an AsyncOps
+    // worker at background priority, so the dirty set stays bounded without writers waiting on the disk. Requires
+    // the AsyncOps scheduler, which must outlive the mapping. Zero turns it off.
+    auto set_background_flush(const usize max_dirty_bytes) -> void;
+
     [[nodiscard]] auto get_ptr() const -> u8 *
     {
       return m_ptr;
@@ -110,17 +330,160 @@ public:
       return m_size;
     }
 
+    // The page size the mapping is guaranteed to use. Transparent huge pages do not count, since the kernel may
+    // split them at any time; see get_huge_page_backed_size.
+    [[nodiscard]] auto get_page_size() const -> usize
+    {
+      return m_page_size;
+    }
+
     [[nodiscard]] auto is_valid() const -> bool
     {
       return m_ptr != nullptr;
     }
 
+    // Whether Prefault::Lock managed to lock the pages.
+    [[nodiscard]] auto is_locked() const -> bool
+    {
+      return m_is_locked;
+    }
+
 private:
     Mut<u8 *> m_ptr = nullptr;
     Mut<usize> m_size = 0;
+    Mut<usize> m_page_size = 0;
+    Mut<bool> m_is_locked = false;
+
+    // Dirty pages and the file handle flushes go through. Kept off the object so a queued background flush does
+    // not care where the region is moved to.
+    class FlushState;
+    Mut<Box<FlushState>> m_flush_state;
+
+#if IA_PLATFORM_WINDOWS
+    Mut<HANDLE> m_map_handle = NULL;
+#endif
+  };
+
+  // A read-only mapping of a whole file that is released when the object is destroyed.
+  class FileOps::MappedFile
+  {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(Ref<MappedFile>) = delete;
+    auto operator=(Ref<MappedFile>) -> MappedFile & = delete;
+
+    MappedFile(ForwardRef<MappedFile> other) noexcept;
+    auto operator=(ForwardRef<MappedFile> other) noexcept -> MappedFile &;
+
+    // Fails for empty files, like map_file.
+    auto map(Ref<Path> path, const AccessHint hint = AccessHint::Sequential, const Prefault prefault = Prefault::None)
+        -> Result<void>;
+
+    auto unmap() -> void;
+
+    // `offset` and `size` are relative to the file and clamped to it.
+    auto advise_range(const usize offset, const usize size, const AccessHint hint) const -> void;
+    auto prefetch_range(const usize offset, const usize size) const -> void;
+
+    [[nodiscard]] auto get_data() const -> const u8 *
+    {
+      return m_data;
+    }
+
+    [[nodiscard]] auto get_size() const -> usize
+    {
+      return m_size;
+    }
+
+    [[nodiscard]] auto get_span() const -> Span<const u8>
+    {
+      return Span<const u8>(m_data, m_size);
+    }
+
+    [[nodiscard]] auto is_valid() const -> bool
+    {
+      return m_data != nullptr;
+    }
+
+    // Whether Prefault::Lock managed to lock the pages.
+    [[nodiscard]] auto is_locked() const -> bool
+    {
+      return m_is_locked;
+    }
+
+private:
+    Mut<const u8 *> m_data = nullptr;
+    Mut<usize> m_size = 0;
+    Mut<bool> m_is_locked = false;
 
 #if IA_PLATFORM_WINDOWS
+    Mut<HANDLE> m_file_handle = INVALID_HANDLE_VALUE;
     Mut<HANDLE> m_map_handle = NULL;
 #endif
   };
-} // namespace ia
\ No newline at end of file
+
+  // The result of load_files: each file's contents, packed back to back into arenas of ARENA_SIZE or more, with
+  // every file starting ALIGNMENT-aligned. Indices are those of the paths passed in.
+  class FileOps::LoadedFiles
+  {
+public:
+    static constexpr const usize ALIGNMENT = 16;
+
+    static constexpr const usize ARENA_SIZE = 1024 * 1024;
+
+    [[nodiscard]] auto get_count() const -> usize
+    {
+      return m_slots.size();
+    }
+
+    [[nodiscard]] auto is_loaded(const usize index) const -> bool
+    {
+      return m_slots[index].error.empty();
+    }
+
+    // Empty for files that failed to load.
+    [[nodiscard]] auto get_data(const usize index) const -> Span<const u8>
+    {
+      return Span<const u8>(m_slots[index].data, m_slots[index].size);
+    }
+
+    [[nodiscard]] auto get_text(const usize index) const -> StringView
+    {
+      return StringView(reinterpret_cast<const char *>(m_slots[index].data), m_slots[index].size);
+    }
+
+    // Empty for files that loaded.
+    [[nodiscard]] auto get_error(const usize index) const -> StringView
+    {
+      return m_slots[index].error;
+    }
+
+    [[nodiscard]] auto get_failed_count() const -> usize
+    {
+      return m_failed_count;
+    }
+
+    // The bytes loaded across all files, not counting alignment padding.
+    [[nodiscard]] auto get_total_size() const -> usize
+    {
+      return m_total_size;
+    }
+
+private:
+    friend class FileOps;
+
+    struct Slot
+    {
+      Mut<const u8 *> data = nullptr;
+      Mut<usize> size = 0;
+      Mut<String> error;
+    };
+
+    Mut<Vec<Box<u8[]>>> m_arenas;
+    Mut<Vec<Slot>> m_slots;
+    Mut<usize> m_failed_count = 0;
+    Mut<usize> m_total_size = 0;
+  };
+} // namespace ia
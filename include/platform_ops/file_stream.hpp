@@ -0,0 +1,284 @@
+// IA-PlatformOps; C++ 20 Async, Process and File Operations.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <crux/crux.hpp>
+
+#include <platform_ops/async.hpp>
+#include <platform_ops/file.hpp>
+
+#include <mutex>
+
+namespace ia
+{
+  // A heap block whose start is aligned for direct I/O and vector loads.
+  class AlignedBuffer
+  {
+public:
+    static constexpr const usize DEFAULT_ALIGNMENT = 4096;
+
+    AlignedBuffer() = default;
+    ~AlignedBuffer();
+
+    AlignedBuffer(Ref<AlignedBuffer>) = delete;
+    auto operator=(Ref<AlignedBuffer>) -> AlignedBuffer & = delete;
+
+    AlignedBuffer(ForwardRef<AlignedBuffer> other) noexcept;
+    auto operator=(ForwardRef<AlignedBuffer> other) noexcept -> AlignedBuffer &;
+
+    // Drops the current block first. The contents of the new one are uninitialized.
+    auto allocate(const usize size, const usize alignment = DEFAULT_ALIGNMENT) -> void;
+
+    auto release() -> void;
+
+    [[nodiscard]] auto get_data() const -> u8 *
+    {
+      return m_data;
+    }
+
+    [[nodiscard]] auto get_size() const -> usize
+    {
+      return m_size;
+    }
+
+    [[nodiscard]] auto get_span() const -> Span<u8>
+    {
+      return Span<u8>(m_data, m_size);
+    }
+
+    [[nodiscard]] auto get_alignment() const -> usize
+    {
+      return m_alignment;
+    }
+
+private:
+    Mut<u8 *> m_data = nullptr;
+    Mut<usize> m_size = 0;
+    Mut<usize> m_alignment = 0;
+  };
+
+  // Recycles equally sized AlignedBuffers, so a loop doing direct I/O does not allocate for every transfer. Safe
+  // to use from any thread.
+  class AlignedBufferPool
+  {
+public:
+    static constexpr const usize DEFAULT_MAX_CACHED = 16;
+
+    // `buffer_size` is rounded up to a multiple of `alignment`.
+    explicit AlignedBufferPool(const usize buffer_size, const usize alignment = AlignedBuffer::DEFAULT_ALIGNMENT,
+                               const usize max_cached = DEFAULT_MAX_CACHED);
+
+    // Buffers fit for direct I/O on files with this alignment (see FileOps::get_direct_io_alignment), in sizes
+    // that are whole multiples of the offset alignment.
+    AlignedBufferPool(const usize buffer_size, Ref<FileOps::DirectIoAlignment> alignment,
+                      const usize max_cached = DEFAULT_MAX_CACHED);
+
+    AlignedBufferPool(Ref<AlignedBufferPool>) = delete;
+    auto operator=(Ref<AlignedBufferPool>) -> AlignedBufferPool & = delete;
+
+    // A cached buffer if there is one, otherwise a new one. The contents are uninitialized.
+    auto acquire() -> AlignedBuffer;
+
+    // Keeps the buffer for a later acquire. Buffers of another size or alignment, and any beyond `max_cached`, are
+    // freed instead.
+    auto release(ForwardRef<AlignedBuffer> buffer) -> void;
+
+    [[nodiscard]] auto get_buffer_size() const -> usize
+    {
+      return m_buffer_size;
+    }
+
+    [[nodiscard]] auto get_alignment() const -> usize
+    {
+      return m_alignment;
+    }
+
+    [[nodiscard]] auto get_cached_count() -> usize;
+
+private:
+    Mut<usize> m_buffer_size = 0;
+    Mut<usize> m_alignment = 0;
+    Mut<usize> m_max_cached = 0;
+    Mut<std::mutex> m_mutex;
+    Mut<Vec<AlignedBuffer>> m_free;
+  };
+
+  namespace detail
+  {
+    // One of the two buffers a stream alternates between, with the bookkeeping for its outstanding I/O.
+    struct StreamSlot
+    {
+      Mut<AlignedBuffer> buffer;
+      Mut<usize> length = 0;
+      Mut<u64> offset = 0;
+      Mut<bool> is_pending = false;
+      Mut<bool> is_async = false;
+      Mut<AsyncOps::Schedule> schedule;
+      Mut<Result<usize>> result = 0;
+    };
+  } // namespace detail
+
+  // Streams a file front to back through two aligned buffers, so memory use stays fixed however large the file
+  // is. While one buffer is being consumed, AsyncFileOps reads ahead into the other. If AsyncFileOps is not
+  // initialized when the reader opens, each buffer is filled synchronously when it is needed instead.
+  //
+  // With FileCaching::Direct the file is read around the page cache. Reads start at the block holding the
+  // requested offset, and the bytes before it are skipped, so any offset works.
+  class FileReader
+  {
+public:
+    static constexpr const usize DEFAULT_BUFFER_SIZE = 4 * 1024 * 1024;
+
+    FileReader() = default;
+    ~FileReader();
+
+    // Pending reads point into this object, so it can be neither copied nor moved.
+    FileReader(Ref<FileReader>) = delete;
+    auto operator=(Ref<FileReader>) -> FileReader & = delete;
+
+    // `buffer_size` is per buffer and is rounded up to the buffer alignment. With `drop_behind`, pages already
+    // consumed are dropped from the page cache, which keeps a one-pass scan from evicting everything else.
+    auto open(Ref<Path> path, const usize buffer_size = DEFAULT_BUFFER_SIZE, const bool drop_behind = false,
+              const FileOps::FileCaching caching = FileOps::FileCaching::Buffered) -> Result<void>;
+
+    // Streams from `offset` in a handle the caller keeps ownership of. `caching` must match how it was opened.
+    auto open(const NativeFileHandle handle, const u64 offset, const usize buffer_size = DEFAULT_BUFFER_SIZE,
+              const bool drop_behind = false, const FileOps::FileCaching caching = FileOps::FileCaching::Buffered)
+        -> Result<void>;
+
+    // Waits for any read in flight, then closes the file if this reader opened it.
+    auto close() -> void;
+
+    // Returns the buffered bytes without copying, refilling first if none are left. Empty only at end of file.
+    // The bytes stay valid until the next call that consumes past them.
+    auto peek() -> Result<Span<const u8>>;
+
+    // Marks `count` bytes of the last peek as used.
+    auto consume(const usize count) -> void;
+
+    // Copies up to `out.size()` bytes and returns how many. Fewer means end of file.
+    auto read(const Span<u8> out) -> Result<usize>;
+
+    [[nodiscard]] auto is_open() const -> bool
+    {
+      return m_handle != INVALID_FILE_HANDLE;
+    }
+
+    // File offset of the next byte peek would return.
+    [[nodiscard]] auto get_position() const -> u64
+    {
+      return m_slots[m_current].offset + m_cursor + m_head_skip;
+    }
+
+    [[nodiscard]] auto get_handle() const -> NativeFileHandle
+    {
+      return m_handle;
+    }
+
+private:
+    auto start_fill(MutRef<detail::StreamSlot> slot) -> void;
+    auto finish_fill(MutRef<detail::StreamSlot> slot) -> Result<void>;
+    auto advance() -> Result<void>;
+
+private:
+    Mut<NativeFileHandle> m_handle = INVALID_FILE_HANDLE;
+    Mut<bool> m_owns_handle = false;
+    Mut<bool> m_read_ahead = false;
+    Mut<bool> m_drop_behind = false;
+    Mut<bool> m_end_reached = false;
+    Mut<usize> m_block_size = 0; // Direct I/O offset alignment, 0 when buffered
+    Mut<usize> m_head_skip = 0;  // Bytes of the first block before the requested offset
+    Mut<u64> m_next_offset = 0;
+    Mut<usize> m_current = 0;
+    Mut<usize> m_cursor = 0;
+    Mut<Array<detail::StreamSlot, 2>> m_slots;
+  };
+
+  // Appends to a file through two aligned buffers. A full buffer is handed to AsyncFileOps and written behind
+  // while the other one fills. If AsyncFileOps is not initialized when the writer opens, full buffers are
+  // written synchronously. Data is only guaranteed to be in the file after flush or close succeeds.
+  //
+  // With FileCaching::Direct only whole blocks are written. A partial block at the start offset is read in and
+  // completed first. On flush the partial last block is padded with what the file already holds there, written
+  // whole, and the file size trimmed back; its bytes stay buffered so the next flush rewrites the block. This
+  // needs read access to the handle.
+  class FileWriter
+  {
+public:
+    static constexpr const usize DEFAULT_BUFFER_SIZE = 4 * 1024 * 1024;
+
+    FileWriter() = default;
+
+    // Closes the file, discarding any error. Call close first to see it.
+    ~FileWriter();
+
+    // Pending writes point into this object, so it can be neither copied nor moved.
+    FileWriter(Ref<FileWriter>) = delete;
+    auto operator=(Ref<FileWriter>) -> FileWriter & = delete;
+
+    auto open(Ref<Path> path, const bool overwrite = false, const usize buffer_size = DEFAULT_BUFFER_SIZE,
+              const FileOps::FileCaching caching = FileOps::FileCaching::Buffered) -> Result<void>;
+
+    // Writes from `offset` in a handle the caller keeps ownership of. `caching` must match how it was opened.
+    auto open(const NativeFileHandle handle, const u64 offset, const usize buffer_size = DEFAULT_BUFFER_SIZE,
+              const FileOps::FileCaching caching = FileOps::FileCaching::Buffered) -> Result<void>;
+
+    // Flushes, then closes the file if this writer opened it.
+    auto close() -> Result<void>;
+
+    auto write(const Span<const u8> data) -> Result<void>;
+
+    // Returns at least `min_size` bytes of buffer space to fill in place. Call commit with how many were used.
+    // `min_size` may not exceed the buffer size, less one block in direct mode.
+    auto reserve(const usize min_size) -> Result<Span<u8>>;
+
+    auto commit(const usize count) -> void;
+
+    // Writes out everything buffered and waits until it is in the file.
+    auto flush() -> Result<void>;
+
+    [[nodiscard]] auto is_open() const -> bool
+    {
+      return m_handle != INVALID_FILE_HANDLE;
+    }
+
+    // File offset the next written byte will land at.
+    [[nodiscard]] auto get_position() const -> u64
+    {
+      return m_next_offset + m_slots[m_current].length;
+    }
+
+    [[nodiscard]] auto get_handle() const -> NativeFileHandle
+    {
+      return m_handle;
+    }
+
+private:
+    auto start_write(MutRef<detail::StreamSlot> slot) -> void;
+    auto finish_write(MutRef<detail::StreamSlot> slot) -> Result<void>;
+    auto rotate() -> Result<void>;
+    auto flush_direct() -> Result<void>;
+
+private:
+    Mut<NativeFileHandle> m_handle = INVALID_FILE_HANDLE;
+    Mut<bool> m_owns_handle = false;
+    Mut<bool> m_write_behind = false;
+    Mut<usize> m_block_size = 0; // Direct I/O offset alignment, 0 when buffered
+    Mut<u64> m_next_offset = 0;
+    Mut<usize> m_current = 0;
+    Mut<Array<detail::StreamSlot, 2>> m_slots;
+  };
+} // namespace ia
@@ -0,0 +1,72 @@
+// IA-PlatformOps; C++ 20 Async, Process and File Operations.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <crux/crux.hpp>
+
+#include <platform_ops/async.hpp>
+
+#include <functional>
+
+namespace ia
+{
+  // Splits text into lines the same way ProcessOps splits child output: "\n", "\r" and "\r\n" each end a line,
+  // empty lines are skipped, and a last line without a terminator is still returned. The terminator scan uses
+  // SSE2/AVX2 or NEON where available. Meant for text from map_file or a MemoryMappedRegion.
+  class LineIterator
+  {
+public:
+    using Finder = const char *(*) (const char *, const char *);
+
+    // Inputs smaller than this are never split for for_each_line_parallel.
+    static constexpr const usize PARALLEL_MIN_CHUNK_SIZE = 1024 * 1024;
+
+    explicit LineIterator(const StringView text);
+    explicit LineIterator(const Span<const u8> data);
+
+    // Sets `line` to the next non-empty line and returns true, or returns false once the text is exhausted.
+    auto next(MutRef<StringView> line) -> bool;
+
+    // Returns the first '\n' or '\r' in [begin, end), or `end` if there is none.
+    [[nodiscard]] static auto find_line_break(const char *begin, const char *end) -> const char *;
+
+    template<typename Fn> static auto for_each_line(const StringView text, Mut<Fn> fn) -> void
+    {
+      Mut<LineIterator> it(text);
+      Mut<StringView> line;
+      while (it.next(line))
+      {
+        fn(line);
+      }
+    }
+
+    // Cuts `text` into at most `max_parts` contiguous pieces of similar size. Every cut falls right after a line
+    // terminator, so each piece splits into exactly the lines it would contribute to a scan of the whole text.
+    [[nodiscard]] static auto split(const StringView text, const usize max_parts) -> Vec<StringView>;
+
+    // Runs `fn` for every line, with pieces of the text spread across the AsyncOps workers. Lines within a piece
+    // arrive in order, but pieces run concurrently, so `fn` must be thread-safe. Without a running scheduler the
+    // calling thread does all the work.
+    static auto for_each_line_parallel(const StringView text,
+                                       Ref<std::function<void(StringView, AsyncOps::WorkerId)>> fn,
+                                       const usize min_chunk_size = PARALLEL_MIN_CHUNK_SIZE) -> void;
+
+private:
+    Mut<const char *> m_cursor;
+    Mut<const char *> m_end;
+    Mut<Finder> m_find_line_break;
+  };
+} // namespace ia
@@ -0,0 +1,111 @@
+// IA-PlatformOps; C++ 20 Async, Process and File Operations.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <crux/crux.hpp>
+
+#include <platform_ops/async.hpp>
+#include <platform_ops/file.hpp>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+namespace ia
+{
+  // An append-only file written through memory mappings. Any number of threads may append at once: each append
+  // claims its byte range with one atomic compare-exchange and copies straight into the mapping, so the only
+  // locking is when the log reaches an extent that is not mapped yet. The file grows an extent at a time, each
+  // preallocated on disk and mapped as its own MemoryMappedRegion, so nothing already mapped ever moves. If the
+  // AsyncOps scheduler is running when the log opens, the next extent is mapped and faulted in on a worker while
+  // the current one fills. Close trims the file to the bytes actually appended.
+  class MappedLog
+  {
+public:
+    static constexpr const usize DEFAULT_EXTENT_SIZE = 64 * 1024 * 1024;
+    static constexpr const u64 DEFAULT_MAX_SIZE = u64{256} * 1024 * 1024 * 1024;
+
+    MappedLog() = default;
+
+    // Closes the log, discarding any error. Call close first to see it.
+    ~MappedLog();
+
+    // Appenders hold on to this object, so it can be neither copied nor moved.
+    MappedLog(Ref<MappedLog>) = delete;
+    auto operator=(Ref<MappedLog>) -> MappedLog & = delete;
+
+    // Appends after any existing content. `extent_size` is rounded up to a multiple of 64 KiB, which suits both
+    // page sizes and Windows' mapping granularity. `max_size` caps the file, and sizes a table of one pointer per
+    // extent. A log that was never closed still has its preallocated tail, which reads as zeros.
+    auto open(Ref<Path> path, const usize extent_size = DEFAULT_EXTENT_SIZE, const u64 max_size = DEFAULT_MAX_SIZE)
+        -> Result<void>;
+
+    // Unmaps the extents and trims the file to get_size. Every append and write must have returned.
+    auto close() -> Result<void>;
+
+    // Returns the offset `data` was written at.
+    auto append(const Span<const u8> data) -> Result<u64>;
+
+    // Claims `size` bytes without writing them, for a record that is filled in pieces with write. Returns its offset.
+    auto reserve(const usize size) -> Result<u64>;
+
+    // Fills part of a reserved range.
+    auto write(const u64 offset, const Span<const u8> data) -> Result<void>;
+
+    // Writes back every mapped extent. With `async`, the writeback is only started.
+    auto flush(const bool async = false) -> Result<void>;
+
+    [[nodiscard]] auto is_open() const -> bool
+    {
+      return m_handle != INVALID_FILE_HANDLE;
+    }
+
+    // Bytes appended or reserved so far, including what was in the file when it was opened.
+    [[nodiscard]] auto get_size() const -> u64
+    {
+      return m_size.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] auto get_extent_size() const -> usize
+    {
+      return m_extent_size;
+    }
+
+private:
+    // The mapped start of extent `index`, mapping it and any before it that are still missing.
+    auto get_extent(const usize index) -> Result<u8 *>;
+
+    auto map_extents_through(const usize index) -> Result<void>;
+
+private:
+    Mut<NativeFileHandle> m_handle = INVALID_FILE_HANDLE;
+    Mut<usize> m_extent_size = 0;
+    Mut<u64> m_max_size = 0;
+    Mut<std::atomic<u64>> m_size = 0;
+
+    // Written under m_grow_mutex and published with release, so appenders can read it without the lock.
+    Mut<std::unique_ptr<std::atomic<u8 *>[]>> m_extent_data;
+    Mut<usize> m_extent_capacity = 0;
+
+    Mut<std::mutex> m_grow_mutex;
+    Mut<Vec<FileOps::MemoryMappedRegion>> m_extents;
+    Mut<std::atomic<usize>> m_mapped_count = 0;
+
+    Mut<bool> m_map_ahead = false;
+    Mut<std::atomic<bool>> m_is_mapping_ahead = false;
+    Mut<AsyncOps::Schedule> m_schedule;
+  };
+} // namespace ia
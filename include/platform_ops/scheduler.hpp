@@ -0,0 +1,883 @@
+// IA-PlatformOps; C++ 20 Async, Process and File Operations.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <crux/crux.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <new>
+#include <stop_token>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace ia
+{
+  namespace sched
+  {
+    using WorkerId = u16;
+    using TaskTag = u64;
+    using Clock = std::chrono::steady_clock;
+    using Deadline = Clock::time_point;
+
+    static constexpr const WorkerId MAIN_THREAD_WORKER_ID = 0;
+
+    static constexpr const Deadline NO_DEADLINE = Deadline::max();
+
+    static constexpr const std::chrono::nanoseconds DEFAULT_AGING_INTERVAL = std::chrono::milliseconds(50);
+
+    static constexpr const usize WAIT_HISTOGRAM_BUCKETS = 32;
+
+    struct Schedule
+    {
+      Mut<std::atomic<i32>> counter{0};
+    };
+
+    struct PriorityStats
+    {
+      Mut<u64> executed_count{};
+      Mut<u64> promoted_count{}; // Ran ahead of pending work of a more urgent level because of aging
+      Mut<u64> total_wait_ns{};
+      Mut<u64> max_wait_ns{};
+
+      // Bucket 0 counts waits below 1us, bucket `i` counts waits in [2^(i-1), 2^i) us.
+      Mut<Array<u64, WAIT_HISTOGRAM_BUCKETS>> wait_histogram{};
+
+      [[nodiscard]] auto get_mean_wait_ns() const -> u64;
+
+      // Upper bound of the histogram bucket holding the given percentile (0-100).
+      [[nodiscard]] auto get_wait_percentile_ns(const f64 percentile) const -> u64;
+
+      auto record_wait(const u64 wait_ns, const bool promoted) -> void;
+    };
+
+    // Policies are passed to BasicScheduler in any order and are told apart by their `PolicyKind`.
+    struct QueuePolicyKind
+    {
+    };
+
+    struct TagPolicyKind
+    {
+    };
+
+    struct IdlePolicyKind
+    {
+    };
+
+    struct TaskPolicyKind
+    {
+    };
+
+    struct ExecutorPolicyKind
+    {
+    };
+
+    // ------------------------------------------------------------------------------------------------------
+    // Queue policies. `Queue<Item>` is only touched with the scheduler lock held.
+    // ------------------------------------------------------------------------------------------------------
+
+    // A single FIFO. Priority levels and deadlines are ignored.
+    struct FifoQueue
+    {
+      using PolicyKind = QueuePolicyKind;
+
+      static constexpr const usize PRIORITY_LEVELS = 1;
+
+      template<typename Item> class Queue
+      {
+    public:
+        auto push(ForwardRef<Item> item, const u8 level, const Deadline deadline) -> void
+        {
+          AU_UNUSED(level);
+          AU_UNUSED(deadline);
+          m_items.push_back(std::move(item));
+        }
+
+        auto pop(MutRef<Item> out_item) -> bool
+        {
+          if (m_items.empty())
+          {
+            return false;
+          }
+          out_item = std::move(m_items.front());
+          m_items.pop_front();
+          return true;
+        }
+
+        template<typename Pred> auto remove_if(Mut<Pred> pred) -> usize
+        {
+          return std::erase_if(m_items, pred);
+        }
+
+    private:
+        Mut<std::deque<Item>> m_items;
+      };
+    };
+
+    // Strict priority: the most urgent (lowest) non-empty level always goes first. Deadlines are ignored.
+    template<usize Levels> struct PriorityQueue
+    {
+      using PolicyKind = QueuePolicyKind;
+
+      static constexpr const usize PRIORITY_LEVELS = Levels;
+
+      template<typename Item> class Queue
+      {
+    public:
+        auto push(ForwardRef<Item> item, const u8 level, const Deadline deadline) -> void
+        {
+          AU_UNUSED(deadline);
+          m_levels[level].push_back(std::move(item));
+        }
+
+        auto pop(MutRef<Item> out_item) -> bool
+        {
+          for (MutRef<std::deque<Item>> level : m_levels)
+          {
+            if (!level.empty())
+            {
+              out_item = std::move(level.front());
+              level.pop_front();
+              return true;
+            }
+          }
+          return false;
+        }
+
+        template<typename Pred> auto remove_if(Mut<Pred> pred) -> usize
+        {
+          Mut<usize> removed = 0;
+          for (MutRef<std::deque<Item>> level : m_levels)
+          {
+            removed += std::erase_if(level, pred);
+          }
+          return removed;
+        }
+
+    private:
+        Mut<Array<std::deque<Item>, Levels>> m_levels;
+      };
+    };
+
+    // Multi-level queue with earliest-deadline-first ordering inside a level, anti-starvation aging across
+    // levels and per-level wait statistics.
+    template<usize Levels> struct DeadlineAgingQueue
+    {
+      using PolicyKind = QueuePolicyKind;
+
+      static constexpr const usize PRIORITY_LEVELS = Levels;
+
+      template<typename Item> class Queue
+      {
+    public:
+        auto push(ForwardRef<Item> item, const u8 level, const Deadline deadline) -> void
+        {
+          MutRef<LevelQueue> queue = m_levels[level];
+          Mut<Entry> entry{std::move(item), deadline, Clock::now(), level};
+          if (deadline == NO_DEADLINE)
+          {
+            queue.undated_entries.push_back(std::move(entry));
+          }
+          else
+          {
+            queue.deadline_heap.push_back(std::move(entry));
+            std::push_heap(queue.deadline_heap.begin(), queue.deadline_heap.end(), deadline_heap_compare);
+          }
+        }
+
+        // Each level offers one candidate: its earliest deadline, unless its oldest undated entry has already
+        // waited a full aging interval. With aging, candidates compete on `enqueue_time + level * interval`,
+        // so every interval spent waiting is worth one level of urgency.
+        auto pop(MutRef<Item> out_item) -> bool
+        {
+          const Clock::time_point now = Clock::now();
+          const bool aging_enabled = m_aging_interval.count() > 0;
+
+          Mut<LevelQueue *> best_queue = nullptr;
+          Mut<bool> best_is_dated = false;
+          Mut<Clock::time_point> best_rank{};
+          Mut<usize> first_non_empty_level = Levels;
+
+          for (Mut<usize> level = 0; level < Levels; ++level)
+          {
+            MutRef<LevelQueue> queue = m_levels[level];
+            if (queue.undated_entries.empty() && queue.deadline_heap.empty())
+            {
+              continue;
+            }
+
+            if (first_non_empty_level == Levels)
+            {
+              first_non_empty_level = level;
+              if (!aging_enabled)
+              {
+                best_queue = &queue;
+                best_is_dated = !queue.deadline_heap.empty();
+                break;
+              }
+            }
+
+            Mut<bool> is_dated = !queue.deadline_heap.empty();
+            if (is_dated && !queue.undated_entries.empty() &&
+                now - queue.undated_entries.front().enqueue_time >= m_aging_interval)
+            {
+              is_dated = false;
+            }
+
+            Ref<Entry> candidate = is_dated ? queue.deadline_heap.front() : queue.undated_entries.front();
+            const Clock::time_point rank = candidate.enqueue_time + m_aging_interval * static_cast<i64>(level);
+            if (best_queue == nullptr || rank < best_rank)
+            {
+              best_queue = &queue;
+              best_is_dated = is_dated;
+              best_rank = rank;
+            }
+          }
+
+          if (best_queue == nullptr)
+          {
+            return false;
+          }
+
+          Mut<Entry> entry;
+          if (best_is_dated)
+          {
+            std::pop_heap(best_queue->deadline_heap.begin(), best_queue->deadline_heap.end(), deadline_heap_compare);
+            entry = std::move(best_queue->deadline_heap.back());
+            best_queue->deadline_heap.pop_back();
+          }
+          else
+          {
+            entry = std::move(best_queue->undated_entries.front());
+            best_queue->undated_entries.pop_front();
+          }
+
+          const u64 wait_ns = static_cast<u64>(
+              std::chrono::duration_cast<std::chrono::nanoseconds>(now - entry.enqueue_time).count());
+          m_stats[entry.level].record_wait(wait_ns, entry.level > first_non_empty_level);
+
+          out_item = std::move(entry.item);
+          return true;
+        }
+
+        template<typename Pred> auto remove_if(Mut<Pred> pred) -> usize
+        {
+          const auto entry_pred = [&pred](MutRef<Entry> entry) -> bool { return pred(entry.item); };
+
+          Mut<usize> removed = 0;
+          for (MutRef<LevelQueue> queue : m_levels)
+          {
+            removed += std::erase_if(queue.undated_entries, entry_pred);
+
+            const usize removed_dated = std::erase_if(queue.deadline_heap, entry_pred);
+            if (removed_dated != 0)
+            {
+              std::make_heap(queue.deadline_heap.begin(), queue.deadline_heap.end(), deadline_heap_compare);
+            }
+            removed += removed_dated;
+          }
+          return removed;
+        }
+
+        // A zero interval disables aging.
+        auto set_aging_interval(const std::chrono::nanoseconds interval) -> void
+        {
+          m_aging_interval = interval;
+        }
+
+        [[nodiscard]] auto get_stats(const usize level) const -> PriorityStats
+        {
+          return m_stats[level];
+        }
+
+        auto reset_stats() -> void
+        {
+          m_stats.fill(PriorityStats{});
+        }
+
+    private:
+        struct Entry
+        {
+          Mut<Item> item{};
+          Mut<Deadline> deadline{NO_DEADLINE};
+          Mut<Clock::time_point> enqueue_time{};
+          Mut<u8> level{};
+        };
+
+        struct LevelQueue
+        {
+          Mut<std::deque<Entry>> undated_entries;
+          Mut<Vec<Entry>> deadline_heap; // Min-heap on deadline
+        };
+
+        static auto deadline_heap_compare(Ref<Entry> lhs, Ref<Entry> rhs) -> bool
+        {
+          return lhs.deadline > rhs.deadline;
+        }
+
+    private:
+        Mut<Array<LevelQueue, Levels>> m_levels;
+        Mut<Array<PriorityStats, Levels>> m_stats{};
+        Mut<std::chrono::nanoseconds> m_aging_interval = DEFAULT_AGING_INTERVAL;
+      };
+    };
+
+    // ------------------------------------------------------------------------------------------------------
+    // Tag policies
+    // ------------------------------------------------------------------------------------------------------
+
+    struct WithTags
+    {
+      using PolicyKind = TagPolicyKind;
+
+      static constexpr const bool ENABLED = true;
+    };
+
+    // Tasks carry no tag and cannot be cancelled.
+    struct NoTags
+    {
+      using PolicyKind = TagPolicyKind;
+
+      static constexpr const bool ENABLED = false;
+    };
+
+    // ------------------------------------------------------------------------------------------------------
+    // Idle policies
+    // ------------------------------------------------------------------------------------------------------
+
+    // Idle workers sleep on a condition variable straight away.
+    struct BlockingIdle
+    {
+      using PolicyKind = IdlePolicyKind;
+
+      static constexpr const u32 SPIN_COUNT = 0;
+    };
+
+    // Idle workers poll the pending count before sleeping, trading CPU for wake-up latency.
+    template<u32 SpinCount = 4096> struct SpinIdle
+    {
+      using PolicyKind = IdlePolicyKind;
+
+      static constexpr const u32 SPIN_COUNT = SpinCount;
+    };
+
+    // ------------------------------------------------------------------------------------------------------
+    // Task storage policies
+    // ------------------------------------------------------------------------------------------------------
+
+    // Move-only callable stored in a fixed inline buffer. Oversized callables fail to compile.
+    template<usize Capacity> class InlineFunction
+    {
+  public:
+      InlineFunction() = default;
+
+      template<typename Fn>
+        requires(!std::is_same_v<std::decay_t<Fn>, InlineFunction>)
+      InlineFunction(ForwardRef<Fn> fn)
+      {
+        using Stored = std::decay_t<Fn>;
+        static_assert(sizeof(Stored) <= Capacity, "Task does not fit the scheduler's inline task storage");
+        static_assert(alignof(Stored) <= alignof(std::max_align_t), "Task is over-aligned for inline storage");
+
+        new (m_storage) Stored(std::forward<Fn>(fn));
+        m_ops = &OPS<Stored>;
+      }
+
+      ~InlineFunction()
+      {
+        reset();
+      }
+
+      InlineFunction(Ref<InlineFunction>) = delete;
+      auto operator=(Ref<InlineFunction>) -> InlineFunction & = delete;
+
+      InlineFunction(ForwardRef<InlineFunction> other) noexcept
+      {
+        take(other);
+      }
+
+      auto operator=(ForwardRef<InlineFunction> other) noexcept -> InlineFunction &
+      {
+        if (this != &other)
+        {
+          reset();
+          take(other);
+        }
+        return *this;
+      }
+
+      auto operator()(const WorkerId worker_id) -> void
+      {
+        m_ops->invoke(m_storage, worker_id);
+      }
+
+      explicit operator bool() const
+      {
+        return m_ops != nullptr;
+      }
+
+  private:
+      struct Ops
+      {
+        void (*invoke)(Mut<void *> storage, const WorkerId worker_id);
+        void (*relocate)(Mut<void *> destination, Mut<void *> source);
+        void (*destroy)(Mut<void *> storage);
+      };
+
+      template<typename Stored>
+      static constexpr const Ops OPS = {
+          [](Mut<void *> storage, const WorkerId worker_id) { (*static_cast<Stored *>(storage))(worker_id); },
+          [](Mut<void *> destination, Mut<void *> source) {
+            new (destination) Stored(std::move(*static_cast<Stored *>(source)));
+            static_cast<Stored *>(source)->~Stored();
+          },
+          [](Mut<void *> storage) { static_cast<Stored *>(storage)->~Stored(); },
+      };
+
+      auto take(MutRef<InlineFunction> other) -> void
+      {
+        if (other.m_ops)
+        {
+          other.m_ops->relocate(m_storage, other.m_storage);
+          m_ops = std::exchange(other.m_ops, nullptr);
+        }
+      }
+
+      auto reset() -> void
+      {
+        if (m_ops)
+        {
+          m_ops->destroy(m_storage);
+          m_ops = nullptr;
+        }
+      }
+
+  private:
+      alignas(std::max_align_t) Mut<std::byte> m_storage[Capacity];
+      Mut<const Ops *> m_ops = nullptr;
+    };
+
+    // Type-erased std::function; heap-allocates captures that exceed its small buffer.
+    struct FunctionTask
+    {
+      using PolicyKind = TaskPolicyKind;
+
+      using Storage = std::function<void(const WorkerId)>;
+    };
+
+    template<usize Capacity = 48> struct InlineTask
+    {
+      using PolicyKind = TaskPolicyKind;
+
+      using Storage = InlineFunction<Capacity>;
+    };
+
+    // ------------------------------------------------------------------------------------------------------
+    // Executor policies. The executor runs popped items and may take over waiting, e.g. to run tasks on
+    // fibers. `ItemData` is extra per-item state the executor can attach to items it injects itself.
+    // ------------------------------------------------------------------------------------------------------
+
+    struct InlineExecutor
+    {
+      using PolicyKind = ExecutorPolicyKind;
+
+      struct ItemData
+      {
+      };
+
+      template<typename Scheduler> auto on_worker_start(MutRef<Scheduler> scheduler) -> void
+      {
+        AU_UNUSED(scheduler);
+      }
+
+      template<typename Scheduler> auto on_worker_stop(MutRef<Scheduler> scheduler) -> void
+      {
+        AU_UNUSED(scheduler);
+      }
+
+      // Whether workers may exit once the queue is empty and a stop was requested.
+      [[nodiscard]] auto can_stop() const -> bool
+      {
+        return true;
+      }
+
+      [[nodiscard]] auto allows_helping() const -> bool
+      {
+        return true;
+      }
+
+      template<typename Scheduler, typename Item>
+      auto execute(MutRef<Scheduler> scheduler, MutRef<Item> item, const WorkerId worker_id) -> void
+      {
+        item.task(worker_id);
+        scheduler.release_schedule(item.schedule);
+      }
+
+      template<typename Scheduler>
+      auto on_schedule_drained(MutRef<Scheduler> scheduler, Mut<Schedule *> schedule) -> void
+      {
+        AU_UNUSED(scheduler);
+        AU_UNUSED(schedule);
+      }
+
+      // Returns true if the executor handled the wait itself.
+      template<typename Scheduler> auto wait(MutRef<Scheduler> scheduler, Mut<Schedule *> schedule) -> bool
+      {
+        AU_UNUSED(scheduler);
+        AU_UNUSED(schedule);
+        return false;
+      }
+    };
+
+    template<typename Kind, typename Default, typename... Policies> struct SelectPolicy
+    {
+      using Type = Default;
+    };
+
+    template<typename Kind, typename Default, typename First, typename... Rest>
+    struct SelectPolicy<Kind, Default, First, Rest...>
+    {
+      using Type = std::conditional_t<std::is_same_v<typename First::PolicyKind, Kind>, First,
+                                      typename SelectPolicy<Kind, Default, Rest...>::Type>;
+    };
+
+    struct NoTag
+    {
+    };
+  } // namespace sched
+
+  // A worker pool whose features are chosen at compile time. Policies may be given in any order; any kind that
+  // is left out uses its default: FifoQueue, NoTags, BlockingIdle, FunctionTask and InlineExecutor.
+  template<typename... Policies> class BasicScheduler
+  {
+public:
+    using QueuePolicy = typename sched::SelectPolicy<sched::QueuePolicyKind, sched::FifoQueue, Policies...>::Type;
+    using TagPolicy = typename sched::SelectPolicy<sched::TagPolicyKind, sched::NoTags, Policies...>::Type;
+    using IdlePolicy = typename sched::SelectPolicy<sched::IdlePolicyKind, sched::BlockingIdle, Policies...>::Type;
+    using TaskPolicy = typename sched::SelectPolicy<sched::TaskPolicyKind, sched::FunctionTask, Policies...>::Type;
+    using Executor =
+        typename sched::SelectPolicy<sched::ExecutorPolicyKind, sched::InlineExecutor, Policies...>::Type;
+
+    using WorkerId = sched::WorkerId;
+    using TaskTag = sched::TaskTag;
+    using Deadline = sched::Deadline;
+    using Schedule = sched::Schedule;
+    using Task = typename TaskPolicy::Storage;
+
+    static constexpr const bool HAS_TAGS = TagPolicy::ENABLED;
+    static constexpr const usize PRIORITY_LEVELS = QueuePolicy::PRIORITY_LEVELS;
+    static constexpr const u8 DEFAULT_LEVEL = static_cast<u8>(PRIORITY_LEVELS / 2);
+
+    struct Item
+    {
+      Mut<Task> task{};
+      Mut<Schedule *> schedule{};
+      [[no_unique_address]] Mut<std::conditional_t<HAS_TAGS, TaskTag, sched::NoTag>> tag{};
+      [[no_unique_address]] Mut<typename Executor::ItemData> executor_data{};
+    };
+
+    using Queue = typename QueuePolicy::template Queue<Item>;
+
+public:
+    BasicScheduler() = default;
+
+    ~BasicScheduler()
+    {
+      stop();
+    }
+
+    BasicScheduler(Ref<BasicScheduler>) = delete;
+    auto operator=(Ref<BasicScheduler>) -> BasicScheduler & = delete;
+
+    auto start(const WorkerId worker_count) -> Result<void>
+    {
+      if (!m_workers.empty())
+      {
+        return fail("Scheduler is already running");
+      }
+
+      for (Mut<u32> i = 0; i < worker_count; ++i)
+      {
+        m_workers.emplace_back([this, i](Mut<std::stop_token> stop_token) {
+          worker_loop(stop_token, static_cast<WorkerId>(i + 1));
+        });
+      }
+      return {};
+    }
+
+    auto stop() -> void
+    {
+      for (MutRef<std::jthread> worker : m_workers)
+      {
+        worker.request_stop();
+      }
+
+      wake_workers();
+
+      for (MutRef<std::jthread> worker : m_workers)
+      {
+        if (worker.joinable())
+        {
+          worker.join();
+        }
+      }
+      m_workers.clear();
+    }
+
+    [[nodiscard]] auto is_running() const -> bool
+    {
+      return !m_workers.empty();
+    }
+
+    [[nodiscard]] auto get_worker_count() const -> WorkerId
+    {
+      return static_cast<WorkerId>(m_workers.size());
+    }
+
+    template<typename Fn>
+    auto submit(ForwardRef<Fn> fn, Mut<Schedule *> schedule, const u8 level = DEFAULT_LEVEL,
+                const Deadline deadline = sched::NO_DEADLINE) -> void
+    {
+      enqueue(Item{Task(std::forward<Fn>(fn)), schedule}, level, deadline);
+    }
+
+    template<typename Fn>
+      requires HAS_TAGS
+    auto submit_tagged(ForwardRef<Fn> fn, const TaskTag tag, Mut<Schedule *> schedule, const u8 level = DEFAULT_LEVEL,
+                       const Deadline deadline = sched::NO_DEADLINE) -> void
+    {
+      enqueue(Item{Task(std::forward<Fn>(fn)), schedule, tag}, level, deadline);
+    }
+
+    // Queues an item ahead of everything in the queue policy, bypassing it. Meant for executors that need to
+    // continue work they already started, such as resuming a fiber.
+    auto submit_urgent(Mut<Item> item) -> void
+    {
+      Mut<bool> should_wake = false;
+      {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        m_urgent_items.push_back(std::move(item));
+        m_pending_count.fetch_add(1, std::memory_order_relaxed);
+        should_wake = m_sleeping_workers > 0;
+      }
+      if (should_wake)
+      {
+        m_wake_condition.notify_one();
+      }
+    }
+
+    auto cancel(const TaskTag tag) -> void
+      requires HAS_TAGS
+    {
+      Mut<Vec<Schedule *>> drained_schedules;
+      {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        const usize removed = m_queue.remove_if([tag, &drained_schedules](MutRef<Item> item) -> bool {
+          if (item.tag != tag)
+          {
+            return false;
+          }
+          if (item.schedule && item.schedule->counter.fetch_sub(1) == 1)
+          {
+            item.schedule->counter.notify_all();
+            drained_schedules.push_back(item.schedule);
+          }
+          return true;
+        });
+        m_pending_count.fetch_sub(removed, std::memory_order_relaxed);
+      }
+
+      for (Mut<Schedule *> schedule : drained_schedules)
+      {
+        m_executor.on_schedule_drained(*this, schedule);
+      }
+    }
+
+    // Helps by running queued tasks until `schedule` drains, unless the executor takes the wait over.
+    auto wait(Mut<Schedule *> schedule) -> void
+    {
+      if (m_executor.wait(*this, schedule))
+      {
+        return;
+      }
+
+      while (schedule->counter.load() > 0)
+      {
+        if (!try_run_one())
+        {
+          const i32 current_val = schedule->counter.load();
+          if (current_val > 0)
+          {
+            schedule->counter.wait(current_val);
+          }
+        }
+      }
+    }
+
+    // Pops and runs one queued task on the calling thread. Returns false if nothing ran.
+    auto try_run_one() -> bool
+    {
+      if (!m_executor.allows_helping())
+      {
+        return false;
+      }
+
+      Mut<Item> item;
+      {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        if (!pop_item(item))
+        {
+          return false;
+        }
+      }
+
+      m_executor.execute(*this, item, sched::MAIN_THREAD_WORKER_ID);
+      return true;
+    }
+
+    // Drops one unit of work from `schedule` and lets the executor react once it drains.
+    auto release_schedule(Mut<Schedule *> schedule) -> void
+    {
+      if (!schedule || schedule->counter.fetch_sub(1) != 1)
+      {
+        return;
+      }
+
+      schedule->counter.notify_all();
+      m_executor.on_schedule_drained(*this, schedule);
+    }
+
+    // Makes every idle worker re-check for work and for a pending stop.
+    auto wake_workers() -> void
+    {
+      // Taking the lock orders whatever changed before any worker's next predicate check.
+      {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+      }
+      m_wake_condition.notify_all();
+    }
+
+    // Runs `fn(queue)` with the scheduler lock held, for policy-specific controls such as statistics.
+    template<typename Fn> auto with_queue(ForwardRef<Fn> fn) -> decltype(auto)
+    {
+      const std::lock_guard<std::mutex> lock(m_mutex);
+      return fn(m_queue);
+    }
+
+    [[nodiscard]] auto get_executor() -> Executor &
+    {
+      return m_executor;
+    }
+
+private:
+    auto enqueue(Mut<Item> item, const u8 level, const Deadline deadline) -> void
+    {
+      ensure(level < PRIORITY_LEVELS, "Invalid task priority level");
+
+      if (item.schedule)
+      {
+        item.schedule->counter.fetch_add(1);
+      }
+
+      Mut<bool> should_wake = false;
+      {
+        const std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.push(std::move(item), level, deadline);
+        m_pending_count.fetch_add(1, std::memory_order_relaxed);
+        should_wake = m_sleeping_workers > 0;
+      }
+      if (should_wake)
+      {
+        m_wake_condition.notify_one();
+      }
+    }
+
+    // Requires `m_mutex` to be held.
+    auto pop_item(MutRef<Item> out_item) -> bool
+    {
+      if (!m_urgent_items.empty())
+      {
+        out_item = std::move(m_urgent_items.front());
+        m_urgent_items.pop_front();
+      }
+      else if (!m_queue.pop(out_item))
+      {
+        return false;
+      }
+
+      m_pending_count.fetch_sub(1, std::memory_order_relaxed);
+      return true;
+    }
+
+    auto worker_loop(Ref<std::stop_token> stop_token, const WorkerId worker_id) -> void
+    {
+      m_executor.on_worker_start(*this);
+
+      while (true)
+      {
+        if constexpr (IdlePolicy::SPIN_COUNT > 0)
+        {
+          for (Mut<u32> i = 0; i < IdlePolicy::SPIN_COUNT; ++i)
+          {
+            if (m_pending_count.load(std::memory_order_relaxed) != 0 || stop_token.stop_requested())
+            {
+              break;
+            }
+          }
+        }
+
+        Mut<Item> item;
+        {
+          Mut<std::unique_lock<std::mutex>> lock(m_mutex);
+
+          m_sleeping_workers++;
+          m_wake_condition.wait(lock, [this, &stop_token] {
+            return m_pending_count.load(std::memory_order_relaxed) != 0 ||
+                   (stop_token.stop_requested() && m_executor.can_stop());
+          });
+          m_sleeping_workers--;
+
+          if (!pop_item(item))
+          {
+            break;
+          }
+        }
+
+        m_executor.execute(*this, item, worker_id);
+      }
+
+      m_executor.on_worker_stop(*this);
+    }
+
+private:
+    Mut<std::mutex> m_mutex;
+    Mut<std::condition_variable> m_wake_condition;
+    Mut<Queue> m_queue;
+    Mut<std::deque<Item>> m_urgent_items;
+    Mut<std::atomic<usize>> m_pending_count{0};
+    Mut<usize> m_sleeping_workers = 0;
+    Mut<Executor> m_executor;
+    Mut<Vec<std::jthread>> m_workers;
+  };
+} // namespace ia
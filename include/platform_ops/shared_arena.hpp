@@ -0,0 +1,743 @@
+// IA-PlatformOps; C++ 20 Async, Process and File Operations.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <crux/crux.hpp>
+
+#include <platform_ops/file.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace ia
+{
+  // A pointer stored as the distance from itself to its target, so a structure built in a shared segment stays
+  // valid in every process that maps the segment, wherever it lands. Copying one re-measures the distance from
+  // the copy, so it must never be copied with memcpy, and it only makes sense between two places in the same
+  // segment (or both in ordinary memory).
+  template<typename T> class OffsetPtr
+  {
+public:
+    OffsetPtr() = default;
+
+    OffsetPtr(std::nullptr_t)
+    {
+    }
+
+    OffsetPtr(Mut<T *> pointer)
+    {
+      set(pointer);
+    }
+
+    OffsetPtr(Ref<OffsetPtr> other)
+    {
+      set(other.get());
+    }
+
+    auto operator=(Ref<OffsetPtr> other) -> OffsetPtr &
+    {
+      set(other.get());
+      return *this;
+    }
+
+    auto operator=(Mut<T *> pointer) -> OffsetPtr &
+    {
+      set(pointer);
+      return *this;
+    }
+
+    auto operator=(std::nullptr_t) -> OffsetPtr &
+    {
+      m_offset = NULL_OFFSET;
+      return *this;
+    }
+
+    [[nodiscard]] auto get() const -> T *
+    {
+      if (m_offset == NULL_OFFSET)
+      {
+        return nullptr;
+      }
+      return reinterpret_cast<T *>(reinterpret_cast<std::uintptr_t>(this) + static_cast<std::uintptr_t>(m_offset));
+    }
+
+    auto operator->() const -> T *
+    {
+      return get();
+    }
+
+    auto operator*() const -> T &
+    {
+      return *get();
+    }
+
+    auto operator[](const usize index) const -> T &
+    {
+      return get()[index];
+    }
+
+    explicit operator bool() const
+    {
+      return m_offset != NULL_OFFSET;
+    }
+
+    friend auto operator==(Ref<OffsetPtr> left, Ref<OffsetPtr> right) -> bool
+    {
+      return left.get() == right.get();
+    }
+
+private:
+    // Zero would mean the pointer points at itself, which a pointer to a T member of the same object can do. One
+    // lands inside the pointer's own bytes, where no other object can be.
+    static constexpr const isize NULL_OFFSET = 1;
+
+    auto set(Mut<T *> pointer) -> void
+    {
+      m_offset = pointer ? static_cast<isize>(reinterpret_cast<std::uintptr_t>(pointer) -
+                                              reinterpret_cast<std::uintptr_t>(this))
+                         : NULL_OFFSET;
+    }
+
+private:
+    Mut<isize> m_offset = NULL_OFFSET;
+  };
+
+  // The allocator at the start of a shared arena segment. Its state is all offsets, so every process that maps
+  // the segment allocates from it and frees into it, at once and without locks: blocks come in power-of-two
+  // sizes, each size has a lock-free free list, and fresh blocks are carved off the end of the used space. Freed
+  // memory is only reused for blocks of the same size. Nothing here can deadlock on a peer that died holding it.
+  class SharedAllocator
+  {
+public:
+    // Every allocation is aligned to this.
+    static constexpr const usize ALIGNMENT = 16;
+
+    // Free lists address blocks by 32-bit granule index, which bounds an arena at 64 GiB.
+    static constexpr const u64 MAX_CAPACITY = u64{1} << 36;
+
+    static constexpr const u32 CLASS_COUNT = 32;
+
+    SharedAllocator(Ref<SharedAllocator>) = delete;
+    auto operator=(Ref<SharedAllocator>) -> SharedAllocator & = delete;
+
+    // Fails once the arena has no room for a block of this size.
+    auto allocate(const usize size) -> Result<u8 *>;
+
+    // Frees memory from allocate. The size is recorded with the block.
+    auto deallocate(Mut<void *> pointer) -> void;
+
+    template<typename T, typename... Args> auto create(ForwardRef<Args>... args) -> Result<T *>
+    {
+      static_assert(alignof(T) <= ALIGNMENT, "Type is over-aligned for a shared arena");
+
+      Mut<Result<u8 *>> memory = allocate(sizeof(T));
+      if (!memory)
+      {
+        return fail(std::move(memory.error()));
+      }
+      return new (*memory) T(std::forward<Args>(args)...);
+    }
+
+    template<typename T> auto destroy(Mut<T *> object) -> void
+    {
+      if (object)
+      {
+        object->~T();
+        deallocate(object);
+      }
+    }
+
+    // Publishes the object peers find with get_root. Whatever was written to the arena before this is visible to
+    // a peer that then sees the new root.
+    template<typename T> auto set_root(Mut<T *> object) -> void
+    {
+      set_root_offset(object ? reinterpret_cast<std::uintptr_t>(object) - reinterpret_cast<std::uintptr_t>(this)
+                             : 0);
+    }
+
+    template<typename T> [[nodiscard]] auto get_root() const -> T *
+    {
+      const u64 offset = get_root_offset();
+      if (offset == 0)
+      {
+        return nullptr;
+      }
+      return reinterpret_cast<T *>(reinterpret_cast<std::uintptr_t>(this) + offset);
+    }
+
+    // Bytes in live blocks, counting each block's header and rounding.
+    [[nodiscard]] auto get_used_size() const -> u64
+    {
+      return m_used_size.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] auto get_capacity() const -> u64
+    {
+      return m_capacity;
+    }
+
+private:
+    friend class SharedArena;
+
+    static constexpr const u32 MAGIC = 0x49414152; // "IAAR"
+    static constexpr const u32 VERSION = 1;
+
+    explicit SharedAllocator(const u64 capacity);
+
+    auto set_root_offset(const u64 offset) -> void;
+    [[nodiscard]] auto get_root_offset() const -> u64;
+
+private:
+    Mut<std::atomic<u32>> m_magic = 0;
+    Mut<u32> m_version = VERSION;
+    Mut<u64> m_capacity = 0;
+
+    // Offset of the first byte no block has been carved from yet.
+    Mut<std::atomic<u64>> m_end = 0;
+    Mut<std::atomic<u64>> m_used_size = 0;
+    Mut<std::atomic<u64>> m_root = 0;
+
+    // Per size class, the first free block's granule index in the low half and a counter in the high half, so a
+    // list head that was popped and pushed back in between is not mistaken for an unchanged one.
+    Mut<std::atomic<u64>> m_free_lists[CLASS_COUNT] = {};
+  };
+
+  // A shared memory segment holding a SharedAllocator, mapped into this process. The segment cannot grow, since
+  // peers have it mapped at its original size, so size it for the largest structure it will hold.
+  class SharedArena
+  {
+public:
+    static constexpr const usize DEFAULT_CAPACITY = 64 * 1024 * 1024;
+
+    // Bytes before the first block, reserved for the allocator.
+    static constexpr const usize HEADER_SIZE = 512;
+
+    // Creates and initializes the segment. It is unlinked when the creating arena is destroyed; peers that
+    // already opened it keep working.
+    static auto create(Ref<String> name, const usize capacity = DEFAULT_CAPACITY) -> Result<SharedArena>;
+
+    // Opens a segment another process created. Fails if it is not initialized yet, so retry until it is.
+    static auto open(Ref<String> name) -> Result<SharedArena>;
+
+    SharedArena() = default;
+    ~SharedArena();
+
+    SharedArena(Ref<SharedArena>) = delete;
+    auto operator=(Ref<SharedArena>) -> SharedArena & = delete;
+
+    SharedArena(ForwardRef<SharedArena> other) noexcept;
+    auto operator=(ForwardRef<SharedArena> other) noexcept -> SharedArena &;
+
+    [[nodiscard]] auto get_allocator() const -> SharedAllocator &
+    {
+      ensure(is_valid(), "SharedArena is not open");
+      return *m_allocator;
+    }
+
+    [[nodiscard]] auto is_valid() const -> bool
+    {
+      return m_allocator != nullptr;
+    }
+
+private:
+    auto close() -> void;
+
+private:
+    Mut<SharedAllocator *> m_allocator = nullptr;
+    Mut<String> m_name;
+    Mut<bool> m_is_owner = false;
+  };
+
+  // A growable array that lives in a shared arena and allocates from it. Build it with its allocator, in the
+  // arena, and then any process can read it in place. It is not synchronized: have one process or thread write
+  // it, and publish it to readers with set_root or another release store.
+  template<typename T> class SharedVec
+  {
+public:
+    static_assert(alignof(T) <= SharedAllocator::ALIGNMENT, "Type is over-aligned for a shared arena");
+
+    explicit SharedVec(MutRef<SharedAllocator> allocator) : m_allocator(&allocator)
+    {
+    }
+
+    ~SharedVec()
+    {
+      release();
+    }
+
+    SharedVec(Ref<SharedVec>) = delete;
+    auto operator=(Ref<SharedVec>) -> SharedVec & = delete;
+
+    // Only within one arena, as the buffer moves with it.
+    SharedVec(ForwardRef<SharedVec> other) noexcept
+        : m_allocator(other.m_allocator), m_data(other.m_data), m_size(other.m_size), m_capacity(other.m_capacity)
+    {
+      other.m_data = nullptr;
+      other.m_size = 0;
+      other.m_capacity = 0;
+    }
+
+    auto operator=(ForwardRef<SharedVec> other) noexcept -> SharedVec &
+    {
+      if (this != &other)
+      {
+        release();
+        m_allocator = other.m_allocator;
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+        m_capacity = std::exchange(other.m_capacity, 0);
+      }
+      return *this;
+    }
+
+    auto reserve(const usize capacity) -> Result<void>
+    {
+      if (capacity <= m_capacity)
+      {
+        return {};
+      }
+
+      Mut<Result<u8 *>> memory = m_allocator->allocate(capacity * sizeof(T));
+      if (!memory)
+      {
+        return fail(std::move(memory.error()));
+      }
+      Mut<T *> data = reinterpret_cast<T *>(*memory);
+      for (Mut<usize> i = 0; i < m_size; ++i)
+      {
+        new (&data[i]) T(std::move(m_data[i]));
+        m_data[i].~T();
+      }
+      if (m_data)
+      {
+        m_allocator->deallocate(m_data.get());
+      }
+      m_data = data;
+      m_capacity = capacity;
+      return {};
+    }
+
+    template<typename... Args> auto emplace(ForwardRef<Args>... args) -> Result<T *>
+    {
+      if (m_size == m_capacity)
+      {
+        Mut<Result<void>> grown = reserve(m_capacity ? m_capacity * 2 : 4);
+        if (!grown)
+        {
+          return fail(std::move(grown.error()));
+        }
+      }
+      Mut<T *> element = new (&m_data[m_size]) T(std::forward<Args>(args)...);
+      ++m_size;
+      return element;
+    }
+
+    auto push(Ref<T> value) -> Result<void>
+    {
+      Mut<Result<T *>> element = emplace(value);
+      if (!element)
+      {
+        return fail(std::move(element.error()));
+      }
+      return {};
+    }
+
+    auto push(ForwardRef<T> value) -> Result<void>
+    {
+      Mut<Result<T *>> element = emplace(std::move(value));
+      if (!element)
+      {
+        return fail(std::move(element.error()));
+      }
+      return {};
+    }
+
+    auto pop() -> void
+    {
+      ensure(m_size != 0, "Cannot pop an empty SharedVec");
+      m_data[--m_size].~T();
+    }
+
+    // Destroys the elements but keeps the buffer.
+    auto clear() -> void
+    {
+      while (m_size != 0)
+      {
+        pop();
+      }
+    }
+
+    auto operator[](const usize index) -> T &
+    {
+      return m_data[index];
+    }
+
+    auto operator[](const usize index) const -> const T &
+    {
+      return m_data[index];
+    }
+
+    auto begin() -> T *
+    {
+      return m_data.get();
+    }
+
+    auto end() -> T *
+    {
+      return m_data.get() + m_size;
+    }
+
+    auto begin() const -> const T *
+    {
+      return m_data.get();
+    }
+
+    auto end() const -> const T *
+    {
+      return m_data.get() + m_size;
+    }
+
+    [[nodiscard]] auto as_span() const -> Span<const T>
+    {
+      return Span<const T>(m_data.get(), m_size);
+    }
+
+    [[nodiscard]] auto get_size() const -> usize
+    {
+      return m_size;
+    }
+
+    [[nodiscard]] auto get_capacity() const -> usize
+    {
+      return m_capacity;
+    }
+
+    [[nodiscard]] auto is_empty() const -> bool
+    {
+      return m_size == 0;
+    }
+
+private:
+    auto release() -> void
+    {
+      clear();
+      if (m_data)
+      {
+        m_allocator->deallocate(m_data.get());
+        m_data = nullptr;
+        m_capacity = 0;
+      }
+    }
+
+private:
+    Mut<OffsetPtr<SharedAllocator>> m_allocator;
+    Mut<OffsetPtr<T>> m_data;
+    Mut<usize> m_size = 0;
+    Mut<usize> m_capacity = 0;
+  };
+
+  // A hash map that lives in a shared arena, with the same rules as SharedVec. It uses open addressing with
+  // linear probing and keeps each key's hash, so lookups compare hashes before keys. Every process using it must
+  // hash keys the same way, which std::hash only promises within one build of one program.
+  template<typename K, typename V, typename Hash = std::hash<K>> class SharedHashMap
+  {
+public:
+    static_assert(alignof(K) <= SharedAllocator::ALIGNMENT && alignof(V) <= SharedAllocator::ALIGNMENT,
+                  "Type is over-aligned for a shared arena");
+
+    explicit SharedHashMap(MutRef<SharedAllocator> allocator) : m_allocator(&allocator)
+    {
+    }
+
+    ~SharedHashMap()
+    {
+      release();
+    }
+
+    SharedHashMap(Ref<SharedHashMap>) = delete;
+    auto operator=(Ref<SharedHashMap>) -> SharedHashMap & = delete;
+
+    SharedHashMap(ForwardRef<SharedHashMap> other) noexcept
+        : m_allocator(other.m_allocator), m_slots(other.m_slots), m_size(other.m_size),
+          m_used_count(other.m_used_count), m_slot_count(other.m_slot_count)
+    {
+      other.m_slots = nullptr;
+      other.m_size = 0;
+      other.m_used_count = 0;
+      other.m_slot_count = 0;
+    }
+
+    auto operator=(ForwardRef<SharedHashMap> other) noexcept -> SharedHashMap &
+    {
+      if (this != &other)
+      {
+        release();
+        m_allocator = other.m_allocator;
+        m_slots = std::exchange(other.m_slots, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+        m_used_count = std::exchange(other.m_used_count, 0);
+        m_slot_count = std::exchange(other.m_slot_count, 0);
+      }
+      return *this;
+    }
+
+    [[nodiscard]] auto find(Ref<K> key) -> V *
+    {
+      Mut<Slot *> slot = find_slot(key, hash_key(key));
+      return slot ? slot->value() : nullptr;
+    }
+
+    [[nodiscard]] auto find(Ref<K> key) const -> const V *
+    {
+      return const_cast<SharedHashMap *>(this)->find(key);
+    }
+
+    [[nodiscard]] auto contains(Ref<K> key) const -> bool
+    {
+      return find(key) != nullptr;
+    }
+
+    // Returns the value for `key`, constructing it from `args` first if the key is new, and whether it was.
+    template<typename... Args> auto try_emplace(Ref<K> key, ForwardRef<Args>... args) -> Result<std::pair<V *, bool>>
+    {
+      const u64 hash = hash_key(key);
+      Mut<Slot *> existing = find_slot(key, hash);
+      if (existing)
+      {
+        return std::pair<V *, bool>(existing->value(), false);
+      }
+
+      if ((m_used_count + 1) * 4 > m_slot_count * 3)
+      {
+        // Tombstones count towards the load, so a map that mostly churns rehashes at the same size.
+        Mut<Result<void>> grown = rehash(m_size * 2 >= m_slot_count ? m_slot_count * 2 : m_slot_count);
+        if (!grown)
+        {
+          return fail(std::move(grown.error()));
+        }
+      }
+
+      Mut<Slot *> slot = find_free_slot(hash);
+      if (slot->hash == EMPTY)
+      {
+        ++m_used_count;
+      }
+      new (slot->key()) K(key);
+      new (slot->value()) V(std::forward<Args>(args)...);
+      slot->hash = hash;
+      ++m_size;
+      return std::pair<V *, bool>(slot->value(), true);
+    }
+
+    auto insert_or_assign(Ref<K> key, ForwardRef<V> value) -> Result<V *>
+    {
+      Mut<Result<std::pair<V *, bool>>> entry = try_emplace(key, std::move(value));
+      if (!entry)
+      {
+        return fail(std::move(entry.error()));
+      }
+      if (!entry->second)
+      {
+        *entry->first = std::move(value);
+      }
+      return entry->first;
+    }
+
+    // Returns whether the key was there.
+    auto erase(Ref<K> key) -> bool
+    {
+      Mut<Slot *> slot = find_slot(key, hash_key(key));
+      if (!slot)
+      {
+        return false;
+      }
+      slot->destroy();
+      slot->hash = TOMBSTONE;
+      --m_size;
+      return true;
+    }
+
+    // Destroys every entry but keeps the slots.
+    auto clear() -> void
+    {
+      for (Mut<usize> i = 0; i < m_slot_count; ++i)
+      {
+        if (m_slots[i].hash >= FIRST_HASH)
+        {
+          m_slots[i].destroy();
+        }
+        m_slots[i].hash = EMPTY;
+      }
+      m_size = 0;
+      m_used_count = 0;
+    }
+
+    // Calls `fn(key, value)` for every entry, in no particular order.
+    template<typename Fn> auto for_each(Mut<Fn> fn) const -> void
+    {
+      for (Mut<usize> i = 0; i < m_slot_count; ++i)
+      {
+        if (m_slots[i].hash >= FIRST_HASH)
+        {
+          fn(static_cast<const K &>(*m_slots[i].key()), *m_slots[i].value());
+        }
+      }
+    }
+
+    [[nodiscard]] auto get_size() const -> usize
+    {
+      return m_size;
+    }
+
+    [[nodiscard]] auto is_empty() const -> bool
+    {
+      return m_size == 0;
+    }
+
+private:
+    // Stored hashes are never below FIRST_HASH, which frees the values below it to mark empty and erased slots.
+    static constexpr const u64 EMPTY = 0;
+    static constexpr const u64 TOMBSTONE = 1;
+    static constexpr const u64 FIRST_HASH = 2;
+
+    static constexpr const usize MIN_SLOT_COUNT = 16;
+
+    struct Slot
+    {
+      Mut<u64> hash;
+      alignas(K) Mut<u8> key_storage[sizeof(K)];
+      alignas(V) Mut<u8> value_storage[sizeof(V)];
+
+      auto key() -> K *
+      {
+        return std::launder(reinterpret_cast<K *>(key_storage));
+      }
+
+      auto value() -> V *
+      {
+        return std::launder(reinterpret_cast<V *>(value_storage));
+      }
+
+      auto destroy() -> void
+      {
+        key()->~K();
+        value()->~V();
+      }
+    };
+
+    static auto hash_key(Ref<K> key) -> u64
+    {
+      const u64 hash = static_cast<u64>(Hash{}(key));
+      return hash < FIRST_HASH ? hash + FIRST_HASH : hash;
+    }
+
+    auto find_slot(Ref<K> key, const u64 hash) const -> Slot *
+    {
+      if (m_slot_count == 0)
+      {
+        return nullptr;
+      }
+      for (Mut<usize> i = hash & (m_slot_count - 1);; i = (i + 1) & (m_slot_count - 1))
+      {
+        MutRef<Slot> slot = m_slots[i];
+        if (slot.hash == EMPTY)
+        {
+          return nullptr;
+        }
+        if (slot.hash == hash && *slot.key() == key)
+        {
+          return &slot;
+        }
+      }
+    }
+
+    // The first empty or erased slot on `hash`'s probe sequence. The load limit guarantees there is one.
+    auto find_free_slot(const u64 hash) -> Slot *
+    {
+      for (Mut<usize> i = hash & (m_slot_count - 1);; i = (i + 1) & (m_slot_count - 1))
+      {
+        if (m_slots[i].hash < FIRST_HASH)
+        {
+          return &m_slots[i];
+        }
+      }
+    }
+
+    auto release() -> void
+    {
+      clear();
+      if (m_slots)
+      {
+        m_allocator->deallocate(m_slots.get());
+        m_slots = nullptr;
+        m_slot_count = 0;
+      }
+    }
+
+    auto rehash(const usize slot_count) -> Result<void>
+    {
+      const usize new_count = std::max(slot_count, MIN_SLOT_COUNT);
+      Mut<Result<u8 *>> memory = m_allocator->allocate(new_count * sizeof(Slot));
+      if (!memory)
+      {
+        return fail(std::move(memory.error()));
+      }
+
+      Mut<OffsetPtr<Slot>> old_slots = m_slots;
+      const usize old_count = m_slot_count;
+      m_slots = reinterpret_cast<Slot *>(*memory);
+      m_slot_count = new_count;
+      for (Mut<usize> i = 0; i < new_count; ++i)
+      {
+        m_slots[i].hash = EMPTY;
+      }
+
+      for (Mut<usize> i = 0; i < old_count; ++i)
+      {
+        MutRef<Slot> old_slot = old_slots[i];
+        if (old_slot.hash < FIRST_HASH)
+        {
+          continue;
+        }
+        Mut<Slot *> slot = find_free_slot(old_slot.hash);
+        new (slot->key()) K(std::move(*old_slot.key()));
+        new (slot->value()) V(std::move(*old_slot.value()));
+        slot->hash = old_slot.hash;
+        old_slot.destroy();
+      }
+      m_used_count = m_size;
+
+      if (old_slots)
+      {
+        m_allocator->deallocate(old_slots.get());
+      }
+      return {};
+    }
+
+private:
+    Mut<OffsetPtr<SharedAllocator>> m_allocator;
+    Mut<OffsetPtr<Slot>> m_slots;
+    Mut<usize> m_size = 0;
+
+    // Slots that are full or erased. Only rehashing frees erased ones.
+    Mut<usize> m_used_count = 0;
+    Mut<usize> m_slot_count = 0;
+  };
+} // namespace ia
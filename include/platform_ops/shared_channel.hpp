@@ -0,0 +1,165 @@
+// IA-PlatformOps; C++ 20 Async, Process and File Operations.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <crux/crux.hpp>
+
+#include <platform_ops/file.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <optional>
+
+namespace ia
+{
+  namespace detail
+  {
+    // The layout at the start of the shared segment, which both processes must agree on. Each side's position and
+    // wake word sit on their own cache line, so the producer and consumer never write to the same line.
+    struct SharedChannelHeader
+    {
+      static constexpr const u32 MAGIC = 0x49414348; // "IACH"
+      static constexpr const u32 VERSION = 1;
+
+      Mut<std::atomic<u32>> magic;
+      Mut<u32> version;
+      Mut<u64> capacity;
+      Mut<std::atomic<u32>> is_shut_down;
+
+      // Bytes ever written, and the producer's wake word.
+      alignas(64) Mut<std::atomic<u64>> head;
+      Mut<std::atomic<u32>> data_signal;
+      Mut<std::atomic<u32>> is_consumer_waiting;
+
+      // Bytes ever released, and the consumer's wake word.
+      alignas(64) Mut<std::atomic<u64>> tail;
+      Mut<std::atomic<u32>> space_signal;
+      Mut<std::atomic<u32>> is_producer_waiting;
+    };
+  } // namespace detail
+
+  // A single-producer, single-consumer queue of variable-length messages in shared memory, for talking to another
+  // process (or thread) without a pipe or socket. Messages are copied into the ring once and read in place. A side
+  // that runs out of data or space spins briefly and then sleeps on a futex in the segment, and the other side
+  // only makes a wake call when it knows somebody is asleep.
+  //
+  // Exactly one thread may send and one may receive at a time, whichever channel object they use. For several
+  // producers, give each its own channel.
+  class SharedChannel
+  {
+public:
+    static constexpr const usize DEFAULT_CAPACITY = 4 * 1024 * 1024;
+
+    // Bytes before the first record, which also keeps records cache-line aligned.
+    static constexpr const usize HEADER_SIZE = 256;
+
+    // Every record starts with its payload size, and records are padded to this alignment.
+    static constexpr const usize RECORD_ALIGNMENT = 8;
+
+    // Creates and initializes the segment. `capacity` is rounded up to a power of two. The segment is unlinked
+    // when the creating channel is destroyed; peers that already opened it keep working.
+    static auto create(Ref<String> name, const usize capacity = DEFAULT_CAPACITY) -> Result<SharedChannel>;
+
+    // Opens a segment another process created. Fails if it is not initialized yet, so retry until it is.
+    static auto open(Ref<String> name) -> Result<SharedChannel>;
+
+    SharedChannel() = default;
+    ~SharedChannel();
+
+    SharedChannel(Ref<SharedChannel>) = delete;
+    auto operator=(Ref<SharedChannel>) -> SharedChannel & = delete;
+
+    SharedChannel(ForwardRef<SharedChannel> other) noexcept;
+    auto operator=(ForwardRef<SharedChannel> other) noexcept -> SharedChannel &;
+
+    // Largest payload a message can have: half the capacity, less its size field, so a message always fits
+    // whatever room is left before the end of the ring.
+    [[nodiscard]] auto get_max_message_size() const -> usize
+    {
+      return m_capacity / 2 - RECORD_ALIGNMENT;
+    }
+
+    // Waits for room. Fails for oversized messages and once the channel is shut down.
+    auto send(const Span<const u8> message) -> Result<void>;
+
+    // Like send, but gives up after `timeout`, returning false.
+    auto send_for(const Span<const u8> message, const std::chrono::nanoseconds timeout) -> Result<bool>;
+
+    // Returns false at once if there is no room.
+    auto try_send(const Span<const u8> message) -> Result<bool>;
+
+    // Waits for room for a `size` byte message and returns it to be filled in place. Call commit to send it.
+    auto reserve(const usize size) -> Result<Span<u8>>;
+
+    // Sends the reserved message, trimmed to `size` bytes.
+    auto commit(const usize size) -> void;
+
+    // Waits for the next message and returns it in place. It stays valid, and is the message returned again,
+    // until release is called. Empty only once the channel is shut down and drained.
+    auto receive() -> std::optional<Span<const u8>>;
+
+    // Like receive, but also empty once `timeout` passes.
+    auto receive_for(const std::chrono::nanoseconds timeout) -> std::optional<Span<const u8>>;
+
+    auto try_receive() -> std::optional<Span<const u8>>;
+
+    // Frees the message last returned by receive, making room for the producer.
+    auto release() -> void;
+
+    // Wakes and fails every waiter on both sides. Messages already sent can still be received.
+    auto shut_down() -> void;
+
+    [[nodiscard]] auto is_shut_down() const -> bool;
+
+    [[nodiscard]] auto is_valid() const -> bool
+    {
+      return m_header != nullptr;
+    }
+
+    [[nodiscard]] auto get_capacity() const -> usize
+    {
+      return m_capacity;
+    }
+
+private:
+    auto close() -> void;
+
+    // Returns the ring offset of a record with room for `size` payload bytes, or nothing if it does not fit now.
+    auto try_claim(const usize size) -> std::optional<u64>;
+
+    auto wait_for_space(const usize size, const std::chrono::steady_clock::time_point deadline) -> Result<bool>;
+    auto wait_for_data(const std::chrono::steady_clock::time_point deadline) -> bool;
+
+private:
+    Mut<detail::SharedChannelHeader *> m_header = nullptr;
+    Mut<u8 *> m_ring = nullptr;
+    Mut<usize> m_capacity = 0;
+    Mut<String> m_name;
+    Mut<bool> m_is_owner = false;
+
+    // Each side's copy of the other's position. Refreshed only when the stale one says the ring is full or empty,
+    // so the hot path stays off the peer's cache line.
+    Mut<u64> m_cached_tail = 0;
+    Mut<u64> m_cached_head = 0;
+
+    // The producer's reservation, and the end of the message the consumer holds.
+    Mut<u64> m_reserved_at = 0;
+    Mut<usize> m_reserved_size = 0;
+    Mut<bool> m_has_reservation = false;
+    Mut<u64> m_received_end = 0;
+    Mut<bool> m_has_received = false;
+  };
+} // namespace ia
@@ -0,0 +1,172 @@
+// IA-PlatformOps; C++ 20 Async, Process and File Operations.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <crux/crux.hpp>
+
+#include <platform_ops/file.hpp>
+
+#include <atomic>
+#include <optional>
+
+namespace ia
+{
+  namespace detail
+  {
+    // The layout at the start of the shared segment, which both processes must agree on.
+    struct SharedSnapshotHeader
+    {
+      static constexpr const u32 MAGIC = 0x4941534E; // "IASN"
+      static constexpr const u32 VERSION = 1;
+
+      Mut<std::atomic<u32>> magic;
+      Mut<u32> version;
+      Mut<u64> slot_size;
+      Mut<u32> slot_count;
+
+      // The newest complete version, or zero before the first publish. It lives in slot `latest % slot_count`.
+      alignas(64) Mut<std::atomic<u64>> latest;
+    };
+
+    // Precedes each slot's data. The sequence is twice the version the slot holds, plus one while it is being
+    // rewritten.
+    struct SharedSnapshotSlot
+    {
+      Mut<std::atomic<u64>> sequence;
+      Mut<std::atomic<u64>> size;
+    };
+  } // namespace detail
+
+  // A blob that one process keeps republishing and any number of others read, in shared memory. Versions rotate
+  // through a few slots, each guarded by a sequence counter: the writer never waits for readers, and a reader
+  // looks at the newest version in place and afterwards checks that the writer did not start reusing its slot
+  // meanwhile, retrying if it did. A reader only has to retry if the writer gets slot_count versions ahead of it
+  // while it is still reading.
+  //
+  // One writer at a time, in any process. Readers never write to the segment.
+  class SharedSnapshot
+  {
+public:
+    static constexpr const usize DEFAULT_SLOT_COUNT = 3;
+
+    // Bytes before the first slot.
+    static constexpr const usize HEADER_SIZE = 128;
+
+    // Bytes before each slot's data, which also keeps every slot cache-line aligned.
+    static constexpr const usize SLOT_HEADER_SIZE = 64;
+
+    // A version as read in place. The data may be overwritten at any time, so use it only once is_intact says
+    // it was not.
+    struct View
+    {
+      Mut<Span<const u8>> data;
+      Mut<u64> version = 0;
+    };
+
+    // Creates and initializes the segment, with room for snapshots of up to `max_size` bytes. It is unlinked when
+    // the creating object is destroyed; peers that already opened it keep working.
+    static auto create(Ref<String> name, const usize max_size, const usize slot_count = DEFAULT_SLOT_COUNT)
+        -> Result<SharedSnapshot>;
+
+    // Opens a segment another process created. Fails if it is not initialized yet, so retry until it is.
+    static auto open(Ref<String> name) -> Result<SharedSnapshot>;
+
+    SharedSnapshot() = default;
+    ~SharedSnapshot();
+
+    SharedSnapshot(Ref<SharedSnapshot>) = delete;
+    auto operator=(Ref<SharedSnapshot>) -> SharedSnapshot & = delete;
+
+    SharedSnapshot(ForwardRef<SharedSnapshot> other) noexcept;
+    auto operator=(ForwardRef<SharedSnapshot> other) noexcept -> SharedSnapshot &;
+
+    // Copies `data` in as the next version and returns that version.
+    auto publish(const Span<const u8> data) -> Result<u64>;
+
+    // Returns the next version's slot, to be filled in place. Readers skip it until commit publishes it.
+    auto begin_write() -> Span<u8>;
+
+    // Publishes the slot from begin_write, trimmed to `size` bytes, and returns its version.
+    auto commit(const usize size) -> u64;
+
+    // The newest version, in place, or empty if nothing was published yet.
+    [[nodiscard]] auto view() const -> std::optional<View>;
+
+    // Whether `view`'s data was left alone since view returned it, so that what was read from it is consistent.
+    [[nodiscard]] auto is_intact(Ref<View> view) const -> bool;
+
+    // Calls `fn(data)` on the newest version until it runs on data that stayed intact, and returns the version.
+    // `fn` must cope with being handed a torn copy that is then discarded: it may look at the bytes, but should
+    // not act on them or trust sizes and offsets found in them. Returns zero, without calling `fn`, if nothing
+    // was published yet.
+    template<typename Fn> auto read(Mut<Fn> fn) const -> u64
+    {
+      while (true)
+      {
+        const std::optional<View> latest = view();
+        if (!latest)
+        {
+          return 0;
+        }
+        fn(latest->data);
+        if (is_intact(*latest))
+        {
+          return latest->version;
+        }
+      }
+    }
+
+    // Copies the newest version into `out` and returns it, or zero if nothing was published yet.
+    auto read_into(MutRef<Vec<u8>> out) const -> u64;
+
+    // The newest published version, zero before the first.
+    [[nodiscard]] auto get_version() const -> u64
+    {
+      return m_header->latest.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] auto get_max_size() const -> usize
+    {
+      return m_slot_size;
+    }
+
+    [[nodiscard]] auto get_slot_count() const -> usize
+    {
+      return m_slot_count;
+    }
+
+    [[nodiscard]] auto is_valid() const -> bool
+    {
+      return m_header != nullptr;
+    }
+
+private:
+    auto close() -> void;
+
+    [[nodiscard]] auto get_slot(const u64 version) const -> detail::SharedSnapshotSlot *;
+
+private:
+    Mut<detail::SharedSnapshotHeader *> m_header = nullptr;
+    Mut<usize> m_slot_size = 0;
+    Mut<usize> m_slot_stride = 0;
+    Mut<usize> m_slot_count = 0;
+    Mut<String> m_name;
+    Mut<bool> m_is_owner = false;
+
+    // The version begin_write started, while it is being written.
+    Mut<u64> m_writing_version = 0;
+  };
+} // namespace ia
@@ -0,0 +1,100 @@
+// IA-PlatformOps; C++ 20 Async, Process and File Operations.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <crux/crux.hpp>
+
+#include <atomic>
+#include <chrono>
+
+namespace ia
+{
+  // SharedEvent and SharedSemaphore hold nothing but 32-bit atomics, so they can be placed anywhere in a shared
+  // memory segment, by placement new or as members of a struct that lives there, and used by every process that
+  // maps it. Construct each one once, in the process that sets the segment up. Waiters spin briefly on machines
+  // with more than one core and then sleep on a futex, so an idle waiter costs no CPU and a wake takes a few
+  // microseconds. Outside Linux there is no cross-process futex, and sleepers poll every 100 microseconds instead.
+  //
+  // A process that dies while waiting leaves itself counted as a waiter, which only costs its peers a wake call
+  // they did not need.
+
+  enum class EventReset : u8
+  {
+    // Stays set, waking every waiter, until reset.
+    Manual,
+
+    // Each set lets exactly one wait return, and that wait clears it again.
+    Auto
+  };
+
+  class SharedEvent
+  {
+public:
+    explicit SharedEvent(const EventReset reset_mode = EventReset::Manual, const bool is_set = false);
+
+    SharedEvent(Ref<SharedEvent>) = delete;
+    auto operator=(Ref<SharedEvent>) -> SharedEvent & = delete;
+
+    auto set() -> void;
+    auto reset() -> void;
+
+    [[nodiscard]] auto is_set() const -> bool
+    {
+      return m_state.load(std::memory_order_acquire) != 0;
+    }
+
+    auto wait() -> void;
+
+    // Returns false if `timeout` passed before the event was set.
+    auto wait_for(const std::chrono::nanoseconds timeout) -> bool;
+
+    // Returns at once. For an auto-reset event, a true result consumes the set.
+    auto try_wait() -> bool;
+
+private:
+    Mut<std::atomic<u32>> m_state;
+    Mut<std::atomic<u32>> m_waiter_count = 0;
+    Mut<EventReset> m_reset_mode;
+  };
+
+  class SharedSemaphore
+  {
+public:
+    explicit SharedSemaphore(const u32 initial_count = 0);
+
+    SharedSemaphore(Ref<SharedSemaphore>) = delete;
+    auto operator=(Ref<SharedSemaphore>) -> SharedSemaphore & = delete;
+
+    // Adds `count` and wakes as many waiters as can now proceed.
+    auto release(const u32 count = 1) -> void;
+
+    auto acquire() -> void;
+
+    // Returns false if `timeout` passed before a count was available.
+    auto acquire_for(const std::chrono::nanoseconds timeout) -> bool;
+
+    auto try_acquire() -> bool;
+
+    [[nodiscard]] auto get_count() const -> u32
+    {
+      return m_count.load(std::memory_order_acquire);
+    }
+
+private:
+    Mut<std::atomic<u32>> m_count;
+    Mut<std::atomic<u32>> m_waiter_count = 0;
+  };
+} // namespace ia
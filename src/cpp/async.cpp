@@ -15,219 +15,599 @@
 
 #include <platform_ops/async.hpp>
 
+#include <fiber.hpp>
+
+#include <algorithm>
+#include <bit>
+
 namespace ia
 {
-  Mut<std::mutex> AsyncOps::s_queue_mutex;
-  Mut<std::condition_variable> AsyncOps::s_wake_condition;
-  Mut<Vec<std::jthread>> AsyncOps::s_schedule_workers;
-  Mut<std::deque<AsyncOps::ScheduledTask>> AsyncOps::s_high_priority_queue;
-  Mut<std::deque<AsyncOps::ScheduledTask>> AsyncOps::s_normal_priority_queue;
+  static constexpr const usize MAX_IDLE_FIBERS = 64;
 
-  auto AsyncOps::run_task(Mut<std::function<void()>> task) -> void
+  enum class TaskFiberState : u8
   {
-    std::jthread(std::move(task)).detach();
-  }
+    Running,
+    Waiting,
+    Finished
+  };
 
-  auto AsyncOps::initialize_scheduler(Mut<u8> worker_count) -> Result<void>
+  class AsyncOps::TaskExecutor
   {
-    if (worker_count == 0)
+public:
+    using PolicyKind = sched::ExecutorPolicyKind;
+
+    struct ItemData
     {
-      const u32 hw_concurrency = std::thread::hardware_concurrency();
-      Mut<u32> threads = 2;
-      if (hw_concurrency > 2)
-      {
-        threads = hw_concurrency - 2;
-      }
+      Mut<TaskFiber *> resumed_fiber = nullptr;
+    };
 
-      if (threads > 255)
-      {
-        threads = 255;
-      }
-      worker_count = static_cast<u8>(threads);
+    auto on_worker_start(MutRef<Scheduler> scheduler) -> void;
+    auto on_worker_stop(MutRef<Scheduler> scheduler) -> void;
+
+    // Parked fibers keep the pool alive past a stop request, since only workers can resume them.
+    [[nodiscard]] auto can_stop() const -> bool
+    {
+      return m_suspended_fiber_count.load() == 0;
     }
 
-    for (Mut<u32> i = 0; i < worker_count; ++i)
+    // Threads outside the pool must not run tasks in fiber mode, since tasks may suspend.
+    [[nodiscard]] auto allows_helping() const -> bool
     {
-      s_schedule_workers.emplace_back(schedule_worker_loop, static_cast<WorkerId>(i + 1));
+      return !m_use_fibers;
     }
 
-    return {};
-  }
+    // Templated on the item so that this class is complete before the scheduler it configures.
+    template<typename Item>
+    auto execute(MutRef<Scheduler> scheduler, MutRef<Item> item, const WorkerId worker_id) -> void;
+    auto on_schedule_drained(MutRef<Scheduler> scheduler, Mut<Schedule *> schedule) -> void;
+    auto wait(MutRef<Scheduler> scheduler, Mut<Schedule *> schedule) -> bool;
 
-  auto AsyncOps::terminate_scheduler() -> void
-  {
-    for (MutRef<std::jthread> worker : s_schedule_workers)
+    // Only valid while no workers are running.
+    auto set_use_fibers(const bool use_fibers) -> void
     {
-      worker.request_stop();
+      m_use_fibers = use_fibers;
     }
 
-    s_wake_condition.notify_all();
+    [[nodiscard]] auto is_using_fibers() const -> bool
+    {
+      return m_use_fibers;
+    }
+
+    auto release_idle_fibers() -> void;
+
+private:
+    // Parks a fiber that came back to the worker waiting on a schedule, or recycles a finished one.
+    auto retire_fiber(MutRef<Scheduler> scheduler, Mut<TaskFiber *> fiber) -> void;
+
+    static auto resume_later(MutRef<Scheduler> scheduler, Mut<TaskFiber *> fiber) -> void;
+
+private:
+    Mut<bool> m_use_fibers = false;
+    Mut<std::mutex> m_fiber_mutex;
+    Mut<Vec<TaskFiber *>> m_idle_fibers;
+    Mut<HashMap<Schedule *, Vec<TaskFiber *>>> m_fiber_waiters;
+    Mut<std::atomic<usize>> m_suspended_fiber_count{0};
+  };
+
+  Mut<AsyncOps::Scheduler> AsyncOps::s_scheduler;
+  thread_local Mut<AsyncOps::TaskFiber *> AsyncOps::s_current_fiber = nullptr;
+
+  static thread_local Mut<bool> t_is_fiber_worker = false;
 
-    for (MutRef<std::jthread> worker : s_schedule_workers)
+  struct AsyncOps::TaskFiber
+  {
+    Mut<Box<Fiber>> fiber;
+    Mut<Scheduler::Item> item;
+    Mut<WorkerId> worker_id{};
+    Mut<TaskFiberState> state = TaskFiberState::Finished;
+    Mut<Schedule *> waiting_on = nullptr;
+
+    static auto entry(Mut<Fiber *> fiber) -> void
     {
-      if (worker.joinable())
+      Mut<TaskFiber *> self = static_cast<TaskFiber *>(fiber->get_user_data());
+      while (true)
       {
-        worker.join();
+        self->item.task(self->worker_id);
+        s_scheduler.release_schedule(self->item.schedule);
+        self->item = {};
+        self->state = TaskFiberState::Finished;
+        fiber->suspend();
       }
     }
+  };
 
-    s_schedule_workers.clear();
+  auto AsyncOps::TaskExecutor::on_worker_start(MutRef<Scheduler> scheduler) -> void
+  {
+    AU_UNUSED(scheduler);
+    t_is_fiber_worker = m_use_fibers && Fiber::prepare_thread();
   }
 
-  auto AsyncOps::schedule_task(Mut<std::function<void(WorkerId worker_id)>> task, const TaskTag tag, Schedule *schedule,
-                               const Priority priority) -> void
+  auto AsyncOps::TaskExecutor::on_worker_stop(MutRef<Scheduler> scheduler) -> void
   {
-    ensure(!s_schedule_workers.empty(), "Scheduler must be initialized before calling schedule_task");
-
-    schedule->counter.fetch_add(1);
+    AU_UNUSED(scheduler);
+    if (t_is_fiber_worker)
     {
-      const std::lock_guard<std::mutex> lock(s_queue_mutex);
-      if (priority == Priority::High)
-      {
-        s_high_priority_queue.emplace_back(ScheduledTask{tag, schedule, std::move(task)});
-      }
-      else
-      {
-        s_normal_priority_queue.emplace_back(ScheduledTask{tag, schedule, std::move(task)});
-      }
+      Fiber::release_thread();
+      t_is_fiber_worker = false;
     }
-    s_wake_condition.notify_one();
   }
 
-  auto AsyncOps::cancel_tasks_of_tag(const TaskTag tag) -> void
+  template<typename Item>
+  auto AsyncOps::TaskExecutor::execute(MutRef<Scheduler> scheduler, MutRef<Item> item, const WorkerId worker_id) -> void
   {
-    const std::lock_guard<std::mutex> lock(s_queue_mutex);
+    Mut<TaskFiber *> fiber = item.executor_data.resumed_fiber;
+    if (!t_is_fiber_worker)
+    {
+      if (fiber)
+      {
+        // This worker could not become a fiber host; leave the fiber to one that could.
+        resume_later(scheduler, fiber);
+        return;
+      }
+      item.task(worker_id);
+      scheduler.release_schedule(item.schedule);
+      return;
+    }
 
+    if (!fiber)
     {
-      MutRef<std::deque<ScheduledTask>> queue = s_high_priority_queue;
-      for (Mut<std::deque<ScheduledTask>::iterator> it = queue.begin(); it != queue.end();
-           /* no incr */)
       {
-        if (it->tag == tag)
+        const std::lock_guard<std::mutex> lock(m_fiber_mutex);
+        if (!m_idle_fibers.empty())
         {
-          if (it->schedule_handle->counter.fetch_sub(1) == 1)
-          {
-            it->schedule_handle->counter.notify_all();
-          }
-          it = queue.erase(it);
+          fiber = m_idle_fibers.back();
+          m_idle_fibers.pop_back();
         }
-        else
+      }
+
+      if (!fiber)
+      {
+        Mut<Box<TaskFiber>> created = make_box<TaskFiber>();
+        Mut<Result<Box<Fiber>>> new_fiber = Fiber::create(FIBER_STACK_SIZE, TaskFiber::entry, created.get());
+        if (!new_fiber)
         {
-          ++it;
+          item.task(worker_id);
+          scheduler.release_schedule(item.schedule);
+          return;
         }
+        created->fiber = std::move(*new_fiber);
+        fiber = created.release();
       }
+
+      fiber->item = std::move(item);
+      fiber->worker_id = worker_id;
     }
 
+    fiber->state = TaskFiberState::Running;
+    s_current_fiber = fiber;
+    fiber->fiber->resume();
+    s_current_fiber = nullptr;
+
+    retire_fiber(scheduler, fiber);
+  }
+
+  auto AsyncOps::TaskExecutor::retire_fiber(MutRef<Scheduler> scheduler, Mut<TaskFiber *> fiber) -> void
+  {
+    Mut<TaskFiber *> deleted_fiber = nullptr;
     {
-      MutRef<std::deque<ScheduledTask>> queue = s_normal_priority_queue;
-      for (Mut<std::deque<ScheduledTask>::iterator> it = queue.begin(); it != queue.end();
-           /* no incr */)
+      const std::lock_guard<std::mutex> lock(m_fiber_mutex);
+      if (fiber->state == TaskFiberState::Waiting)
       {
-        if (it->tag == tag)
+        // Draining takes `m_fiber_mutex` before looking for waiters, so the schedule is either already
+        // drained here or will find this fiber registered.
+        if (fiber->waiting_on->counter.load() == 0)
         {
-          if (it->schedule_handle->counter.fetch_sub(1) == 1)
-          {
-            it->schedule_handle->counter.notify_all();
-          }
-          it = queue.erase(it);
+          resume_later(scheduler, fiber);
         }
         else
         {
-          ++it;
+          m_fiber_waiters[fiber->waiting_on].push_back(fiber);
+          m_suspended_fiber_count++;
         }
       }
+      else if (m_idle_fibers.size() < MAX_IDLE_FIBERS)
+      {
+        m_idle_fibers.push_back(fiber);
+      }
+      else
+      {
+        deleted_fiber = fiber;
+      }
     }
+    delete deleted_fiber;
   }
 
-  auto AsyncOps::wait_for_schedule_completion(Schedule *schedule) -> void
+  auto AsyncOps::TaskExecutor::resume_later(MutRef<Scheduler> scheduler, Mut<TaskFiber *> fiber) -> void
   {
-    ensure(!s_schedule_workers.empty(), "Scheduler must be initialized before "
-                                        "calling wait_for_schedule_completion");
+    Mut<Scheduler::Item> item;
+    item.executor_data.resumed_fiber = fiber;
+    scheduler.submit_urgent(std::move(item));
+  }
 
-    while (schedule->counter.load() > 0)
+  auto AsyncOps::TaskExecutor::on_schedule_drained(MutRef<Scheduler> scheduler, Mut<Schedule *> schedule) -> void
+  {
+    if (!m_use_fibers)
+    {
+      return;
+    }
+
+    Mut<bool> last_suspended = false;
     {
-      Mut<ScheduledTask> task;
-      Mut<bool> found_task = false;
+      const std::lock_guard<std::mutex> lock(m_fiber_mutex);
+      Mut<decltype(m_fiber_waiters)::iterator> it = m_fiber_waiters.find(schedule);
+      if (it == m_fiber_waiters.end())
       {
-        Mut<std::unique_lock<std::mutex>> lock(s_queue_mutex);
-        if (!s_high_priority_queue.empty())
-        {
-          task = std::move(s_high_priority_queue.front());
-          s_high_priority_queue.pop_front();
-          found_task = true;
-        }
-        else if (!s_normal_priority_queue.empty())
-        {
-          task = std::move(s_normal_priority_queue.front());
-          s_normal_priority_queue.pop_front();
-          found_task = true;
-        }
+        return;
       }
 
-      if (found_task)
+      // Queue the fibers before dropping the count, so stopping workers always see one or the other.
+      for (Mut<TaskFiber *> fiber : it->second)
       {
-        task.task(MAIN_THREAD_WORKER_ID);
-        if (task.schedule_handle->counter.fetch_sub(1) == 1)
-        {
-          task.schedule_handle->counter.notify_all();
-        }
+        resume_later(scheduler, fiber);
+      }
+      last_suspended = m_suspended_fiber_count.fetch_sub(it->second.size()) == it->second.size();
+      m_fiber_waiters.erase(it);
+    }
+
+    if (last_suspended)
+    {
+      scheduler.wake_workers();
+    }
+  }
+
+  auto AsyncOps::TaskExecutor::wait(MutRef<Scheduler> scheduler, Mut<Schedule *> schedule) -> bool
+  {
+    AU_UNUSED(scheduler);
+    if (!m_use_fibers)
+    {
+      return false;
+    }
+
+    Mut<TaskFiber *> fiber = s_current_fiber;
+    while (schedule->counter.load() > 0)
+    {
+      if (fiber)
+      {
+        // The worker parks us on `schedule` once we are off this stack.
+        fiber->state = TaskFiberState::Waiting;
+        fiber->waiting_on = schedule;
+        fiber->fiber->suspend();
       }
       else
       {
-        const u32 current_val = schedule->counter.load();
+        const i32 current_val = schedule->counter.load();
         if (current_val > 0)
         {
           schedule->counter.wait(current_val);
         }
       }
     }
+    return true;
   }
 
-  auto AsyncOps::get_worker_count() -> WorkerId
+  auto AsyncOps::TaskExecutor::release_idle_fibers() -> void
   {
-    return static_cast<WorkerId>(s_schedule_workers.size());
+    const std::lock_guard<std::mutex> lock(m_fiber_mutex);
+    for (Mut<TaskFiber *> fiber : m_idle_fibers)
+    {
+      delete fiber;
+    }
+    m_idle_fibers.clear();
   }
 
-  auto AsyncOps::schedule_worker_loop(const std::stop_token stop_token, const WorkerId worker_id) -> void
+  static constexpr const usize FUTURE_POOL_MIN_BLOCK_SIZE = 64;
+  static constexpr const usize FUTURE_POOL_SIZE_CLASSES = 4;
+  static constexpr const usize FUTURE_POOL_CACHE_CAPACITY = 64;
+  static constexpr const usize FUTURE_POOL_TRANSFER_BATCH = 32;
+  static constexpr const usize FUTURE_POOL_SHARED_CAPACITY = 4096;
+
+  struct FuturePoolBlock
   {
-    while (!stop_token.stop_requested())
+    Mut<FuturePoolBlock *> next = nullptr;
+  };
+
+  struct FuturePoolSharedList
+  {
+    Mut<std::mutex> mutex;
+    Mut<FuturePoolBlock *> head = nullptr;
+    Mut<usize> count = 0;
+
+    ~FuturePoolSharedList()
     {
-      Mut<ScheduledTask> task;
-      Mut<bool> found_task = false;
+      while (head)
       {
-        Mut<std::unique_lock<std::mutex>> lock(s_queue_mutex);
+        ::operator delete(std::exchange(head, head->next));
+      }
+    }
+  };
 
-        s_wake_condition.wait(lock, [&stop_token] {
-          return !s_high_priority_queue.empty() || !s_normal_priority_queue.empty() || stop_token.stop_requested();
-        });
+  static Mut<Array<FuturePoolSharedList, FUTURE_POOL_SIZE_CLASSES>> s_future_pool_shared;
 
-        if (stop_token.stop_requested() && s_high_priority_queue.empty() && s_normal_priority_queue.empty())
-        {
-          return;
-        }
+  struct FuturePoolThreadCache
+  {
+    Mut<Array<FuturePoolBlock *, FUTURE_POOL_SIZE_CLASSES>> heads{};
+    Mut<Array<usize, FUTURE_POOL_SIZE_CLASSES>> counts{};
 
-        if (!s_high_priority_queue.empty())
-        {
-          task = std::move(s_high_priority_queue.front());
-          s_high_priority_queue.pop_front();
-          found_task = true;
-        }
-        else if (!s_normal_priority_queue.empty())
+    auto spill(const usize size_class, const usize block_count) -> void
+    {
+      MutRef<FuturePoolSharedList> shared = s_future_pool_shared[size_class];
+      const std::lock_guard<std::mutex> lock(shared.mutex);
+      for (Mut<usize> i = 0; i < block_count && heads[size_class]; ++i)
+      {
+        Mut<FuturePoolBlock *> block = std::exchange(heads[size_class], heads[size_class]->next);
+        counts[size_class]--;
+        if (shared.count >= FUTURE_POOL_SHARED_CAPACITY)
         {
-          task = std::move(s_normal_priority_queue.front());
-          s_normal_priority_queue.pop_front();
-          found_task = true;
+          ::operator delete(block);
+          continue;
         }
+        block->next = shared.head;
+        shared.head = block;
+        shared.count++;
+      }
+    }
+
+    ~FuturePoolThreadCache()
+    {
+      for (Mut<usize> i = 0; i < FUTURE_POOL_SIZE_CLASSES; ++i)
+      {
+        spill(i, counts[i]);
+      }
+    }
+  };
+
+  static thread_local Mut<FuturePoolThreadCache> t_future_pool_cache;
+
+  static Mut<AsyncOps::Schedule> s_future_schedule;
+
+  static auto get_future_pool_size_class(const usize size) -> usize
+  {
+    return static_cast<usize>(std::bit_width((size - 1) / FUTURE_POOL_MIN_BLOCK_SIZE));
+  }
+
+  static auto get_completed_continuation_marker() -> detail::FutureContinuation *
+  {
+    return reinterpret_cast<detail::FutureContinuation *>(alignof(detail::FutureContinuation));
+  }
+
+  auto detail::FutureStatePool::allocate(const usize size) -> void *
+  {
+    const usize size_class = get_future_pool_size_class(size);
+    if (size_class >= FUTURE_POOL_SIZE_CLASSES)
+    {
+      return ::operator new(size);
+    }
+
+    MutRef<FuturePoolThreadCache> cache = t_future_pool_cache;
+    if (!cache.heads[size_class])
+    {
+      MutRef<FuturePoolSharedList> shared = s_future_pool_shared[size_class];
+      const std::lock_guard<std::mutex> lock(shared.mutex);
+      for (Mut<usize> i = 0; i < FUTURE_POOL_TRANSFER_BATCH && shared.head; ++i)
+      {
+        Mut<FuturePoolBlock *> block = std::exchange(shared.head, shared.head->next);
+        shared.count--;
+        block->next = cache.heads[size_class];
+        cache.heads[size_class] = block;
+        cache.counts[size_class]++;
       }
+    }
+
+    if (!cache.heads[size_class])
+    {
+      return ::operator new(FUTURE_POOL_MIN_BLOCK_SIZE << size_class);
+    }
 
-      if (found_task)
+    cache.counts[size_class]--;
+    return std::exchange(cache.heads[size_class], cache.heads[size_class]->next);
+  }
+
+  auto detail::FutureStatePool::release(Mut<void *> block, const usize size) -> void
+  {
+    const usize size_class = get_future_pool_size_class(size);
+    if (size_class >= FUTURE_POOL_SIZE_CLASSES)
+    {
+      ::operator delete(block);
+      return;
+    }
+
+    MutRef<FuturePoolThreadCache> cache = t_future_pool_cache;
+    Mut<FuturePoolBlock *> pool_block = new (block) FuturePoolBlock{cache.heads[size_class]};
+    cache.heads[size_class] = pool_block;
+    cache.counts[size_class]++;
+
+    if (cache.counts[size_class] > FUTURE_POOL_CACHE_CAPACITY)
+    {
+      cache.spill(size_class, FUTURE_POOL_TRANSFER_BATCH);
+    }
+  }
+
+  auto detail::FutureStateBase::wait() -> void
+  {
+    if (is_ready())
+    {
+      return;
+    }
+
+    if (AsyncOps::is_running_in_fiber())
+    {
+      // Park the fiber on a one-shot schedule that completing this state drains.
+      struct FiberWaitNode final : FutureContinuation
       {
-        task.task(worker_id);
-        if (task.schedule_handle->counter.fetch_sub(1) == 1)
+        Mut<AsyncOps::Schedule> schedule;
+
+        auto on_ready() -> void override
         {
-          task.schedule_handle->counter.notify_all();
+          AsyncOps::release_schedule(&schedule);
         }
+      };
+
+      Mut<FiberWaitNode> node;
+      node.schedule.counter = 1;
+      add_continuation(&node);
+      AsyncOps::wait_for_schedule_completion(&node.schedule);
+      return;
+    }
+
+    while (!is_ready())
+    {
+      if (!AsyncOps::run_pending_task())
+      {
+        m_ready.wait(false, std::memory_order_acquire);
+      }
+    }
+  }
+
+  auto detail::FutureStateBase::add_continuation(Mut<FutureContinuation *> continuation) -> void
+  {
+    Mut<FutureContinuation *> head = m_continuations.load(std::memory_order_acquire);
+    while (true)
+    {
+      if (head == get_completed_continuation_marker())
+      {
+        continuation->on_ready();
+        return;
+      }
+
+      continuation->m_next = head;
+      if (m_continuations.compare_exchange_weak(head, continuation, std::memory_order_release,
+                                                std::memory_order_acquire))
+      {
+        return;
       }
     }
   }
-} // namespace ia
\ No newline at end of file
+
+  auto detail::FutureStateBase::mark_ready() -> void
+  {
+    m_ready.store(true, std::memory_order_release);
+    m_ready.notify_all();
+
+    // Whoever completes the state holds a reference until this returns, but a fired continuation may free
+    // its own node, so the next link is read first.
+    Mut<FutureContinuation *> continuation =
+        m_continuations.exchange(get_completed_continuation_marker(), std::memory_order_acq_rel);
+    while (continuation)
+    {
+      Mut<FutureContinuation *> next = continuation->m_next;
+      continuation->on_ready();
+      continuation = next;
+    }
+  }
+
+  auto detail::schedule_future_task(Mut<std::function<void(const AsyncOps::WorkerId)>> task,
+                                    const AsyncOps::Priority priority, const AsyncOps::Deadline deadline) -> void
+  {
+    AsyncOps::schedule_task(std::move(task), AsyncOps::FUTURE_TASK_TAG, &s_future_schedule, priority, deadline);
+  }
+
+  auto AsyncOps::run_task(Mut<std::function<void()>> task) -> void
+  {
+    std::jthread(std::move(task)).detach();
+  }
+
+  auto AsyncOps::initialize_scheduler(Mut<u8> worker_count, const bool use_fibers) -> Result<void>
+  {
+    // Fiber mode and the stats belong to the running workers, so leave them alone on a repeated call.
+    if (s_scheduler.is_running())
+    {
+      return fail("Scheduler is already running");
+    }
+
+    if (worker_count == 0)
+    {
+      const u32 hw_concurrency = std::thread::hardware_concurrency();
+      Mut<u32> threads = 2;
+      if (hw_concurrency > 2)
+      {
+        threads = hw_concurrency - 2;
+      }
+
+      if (threads > 255)
+      {
+        threads = 255;
+      }
+      worker_count = static_cast<u8>(threads);
+    }
+
+    reset_priority_stats();
+    s_scheduler.get_executor().set_use_fibers(use_fibers);
+
+    return s_scheduler.start(worker_count);
+  }
+
+  auto AsyncOps::terminate_scheduler() -> void
+  {
+    s_scheduler.stop();
+
+    MutRef<TaskExecutor> executor = s_scheduler.get_executor();
+    executor.release_idle_fibers();
+    executor.set_use_fibers(false);
+  }
+
+  auto AsyncOps::schedule_task(Mut<std::function<void(WorkerId worker_id)>> task, const TaskTag tag, Schedule *schedule,
+                               const Priority priority, const Deadline deadline) -> void
+  {
+    ensure(s_scheduler.is_running(), "Scheduler must be initialized before calling schedule_task");
+
+    s_scheduler.submit_tagged(std::move(task), tag, schedule, static_cast<u8>(priority), deadline);
+  }
+
+  auto AsyncOps::cancel_tasks_of_tag(const TaskTag tag) -> void
+  {
+    ensure(tag != FUTURE_TASK_TAG, "Tasks backing a Future cannot be cancelled");
+
+    s_scheduler.cancel(tag);
+  }
+
+  auto AsyncOps::wait_for_schedule_completion(Schedule *schedule) -> void
+  {
+    ensure(s_scheduler.is_running(), "Scheduler must be initialized before "
+                                     "calling wait_for_schedule_completion");
+
+    s_scheduler.wait(schedule);
+  }
+
+  auto AsyncOps::run_pending_task() -> bool
+  {
+    return s_scheduler.try_run_one();
+  }
+
+  auto AsyncOps::get_worker_count() -> WorkerId
+  {
+    return s_scheduler.get_worker_count();
+  }
+
+  auto AsyncOps::is_fiber_mode() -> bool
+  {
+    return s_scheduler.get_executor().is_using_fibers();
+  }
+
+  auto AsyncOps::is_running_in_fiber() -> bool
+  {
+    return s_current_fiber != nullptr;
+  }
+
+  auto AsyncOps::set_aging_interval(const std::chrono::nanoseconds interval) -> void
+  {
+    s_scheduler.with_queue([interval](MutRef<Scheduler::Queue> queue) { queue.set_aging_interval(interval); });
+  }
+
+  auto AsyncOps::get_priority_stats(const Priority priority) -> PriorityStats
+  {
+    const u8 level = static_cast<u8>(priority);
+    ensure(level < PRIORITY_LEVEL_COUNT, "Invalid task priority");
+
+    return s_scheduler.with_queue([level](MutRef<Scheduler::Queue> queue) { return queue.get_stats(level); });
+  }
+
+  auto AsyncOps::reset_priority_stats() -> void
+  {
+    s_scheduler.with_queue([](MutRef<Scheduler::Queue> queue) { queue.reset_stats(); });
+  }
+
+  auto AsyncOps::release_schedule(Mut<Schedule *> schedule) -> void
+  {
+    s_scheduler.release_schedule(schedule);
+  }
+} // namespace ia
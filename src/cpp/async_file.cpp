@@ -0,0 +1,701 @@
+// IA-PlatformOps; C++ 20 Async, Process and File Operations.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <platform_ops/async_file.hpp>
+
+#include <io_uring.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <utility>
+
+#if IA_PLATFORM_UNIX
+#  include <cerrno>
+#  include <unistd.h>
+#endif
+
+namespace ia
+{
+  using BlockingPool = BasicScheduler<sched::FifoQueue, sched::NoTags, sched::BlockingIdle, sched::FunctionTask>;
+
+  struct AsyncFileOps::PendingOperation
+  {
+    Mut<Request> request;
+
+#if IA_HAS_IO_URING
+    // Links in the list of operations io_uring holds, which starts at `in_flight`.
+    Mut<PendingOperation *> previous = nullptr;
+    Mut<PendingOperation *> next = nullptr;
+
+    static inline Mut<PendingOperation *> in_flight = nullptr;
+#endif
+  };
+
+  static Mut<AsyncFileOps::Backend> s_backend = AsyncFileOps::Backend::None;
+  static Mut<std::mutex> s_submit_mutex;
+  static Mut<Vec<NativeFileHandle>> s_registered_files;
+  static Mut<BlockingPool> s_blocking_pool;
+
+#if IA_HAS_IO_URING
+  // Operation pointers are never null, so a zero user_data marks the wake-up sent by terminate().
+  static constexpr const u64 WAKE_USER_DATA = 0;
+
+  static Mut<Box<IoUring>> s_ring;
+  static Mut<std::jthread> s_reaper;
+  static Mut<std::atomic<u32>> s_in_flight_count{0};
+  static Mut<u32> s_in_flight_limit = 0;
+
+  // Guards the in-flight list and s_is_ring_failed. The reaper takes it for every completion, so it must never wait
+  // on s_submit_mutex while holding it.
+  static Mut<std::mutex> s_in_flight_mutex;
+  static Mut<bool> s_is_ring_failed = false;
+
+  // How many times a full submission queue is flushed before a submission gives up.
+  static constexpr const u32 SUBMIT_ATTEMPTS = 64;
+#endif
+
+  static auto get_operation_name(const AsyncFileOps::Operation operation) -> const char *
+  {
+    switch (operation)
+    {
+    case AsyncFileOps::Operation::Read:
+      return "read";
+    case AsyncFileOps::Operation::Write:
+      return "write";
+    case AsyncFileOps::Operation::Sync:
+      return "fsync";
+    case AsyncFileOps::Operation::DataSync:
+      return "fdatasync";
+    }
+    return "operation";
+  }
+
+  static auto make_request(const AsyncFileOps::Operation operation, const NativeFileHandle handle, Mut<u8 *> buffer,
+                           const usize size, const u64 offset) -> AsyncFileOps::Request
+  {
+    Mut<AsyncFileOps::Request> request;
+    request.operation = operation;
+    request.handle = handle;
+    request.buffer = buffer;
+    request.size = size;
+    request.offset = offset;
+    return request;
+  }
+
+#if IA_HAS_IO_URING
+  // A free submission entry, flushing queued ones to the kernel to make room. Fails if the kernel keeps refusing
+  // them. Call with s_submit_mutex held.
+  static auto acquire_submission_entry() -> Result<io_uring_sqe *>
+  {
+    Mut<String> last_error = "submission queue full";
+    for (Mut<u32> attempt = 0; attempt < SUBMIT_ATTEMPTS; ++attempt)
+    {
+      Mut<io_uring_sqe *> entry = s_ring->get_submission_entry();
+      if (entry)
+      {
+        return entry;
+      }
+
+      Mut<Result<void>> submitted = s_ring->submit();
+      if (!submitted)
+      {
+        last_error = std::move(submitted.error());
+        std::this_thread::yield();
+      }
+    }
+    return fail("No io_uring submission entry after {} attempts: {}", SUBMIT_ATTEMPTS, last_error);
+  }
+
+  // If the wake-up cannot be queued, the reaper still sees the stop request at its next completion.
+  static auto send_reaper_wake_up() -> void
+  {
+    const std::lock_guard<std::mutex> lock(s_submit_mutex);
+    Mut<Result<io_uring_sqe *>> entry = acquire_submission_entry();
+    if (!entry)
+    {
+      return;
+    }
+    (*entry)->opcode = IORING_OP_NOP;
+    (*entry)->user_data = WAKE_USER_DATA;
+    (void) s_ring->submit();
+  }
+#endif
+
+  auto AsyncFileOps::initialize(const u32 queue_depth, const bool allow_io_uring) -> Result<void>
+  {
+    if (s_backend != Backend::None)
+    {
+      return fail("AsyncFileOps is already initialized");
+    }
+
+#if IA_HAS_IO_URING
+    if (allow_io_uring)
+    {
+      Mut<Result<Box<IoUring>>> ring = IoUring::create(queue_depth);
+      if (ring)
+      {
+        s_ring = std::move(*ring);
+        s_is_ring_failed = false;
+        // One completion slot stays free for the wake-up.
+        s_in_flight_limit = s_ring->get_completion_capacity() - 1;
+        s_backend = Backend::IoUring;
+
+        s_reaper = std::jthread([](Mut<std::stop_token> stop_token) {
+          const std::stop_callback wake_on_stop(stop_token, send_reaper_wake_up);
+
+          Mut<bool> stopping = false;
+          while (!(stopping || stop_token.stop_requested()) || s_in_flight_count.load() != 0)
+          {
+            Mut<Result<void>> waited = s_ring->wait_for_completion();
+            if (!waited)
+            {
+              // Nothing will complete through the ring any more.
+              fail_in_flight(waited.error());
+              return;
+            }
+
+            s_ring->drain_completions([&stopping](Ref<IoUring::Completion> completion) {
+              if (completion.user_data == WAKE_USER_DATA)
+              {
+                stopping = true;
+                return;
+              }
+
+              Mut<PendingOperation *> operation = reinterpret_cast<PendingOperation *>(completion.user_data);
+              untrack_in_flight(operation);
+              s_in_flight_count.fetch_sub(1, std::memory_order_acq_rel);
+              s_in_flight_count.notify_all();
+
+              if (completion.result < 0)
+              {
+                complete(operation, fail("Async {} failed: {}", get_operation_name(operation->request.operation),
+                                         -completion.result));
+              }
+              else
+              {
+                complete(operation, static_cast<usize>(completion.result));
+              }
+            });
+          }
+        });
+        return {};
+      }
+    }
+#else
+    AU_UNUSED(queue_depth);
+    AU_UNUSED(allow_io_uring);
+#endif
+
+    Mut<Result<void>> started = s_blocking_pool.start(BLOCKING_POOL_WORKER_COUNT);
+    if (!started)
+    {
+      return started;
+    }
+    s_backend = Backend::BlockingPool;
+    return {};
+  }
+
+  auto AsyncFileOps::terminate() -> void
+  {
+#if IA_HAS_IO_URING
+    if (s_backend == Backend::IoUring)
+    {
+      s_reaper.request_stop();
+      s_reaper.join();
+      s_ring.reset();
+    }
+#endif
+
+    // Under io_uring the pool only runs if copy_file started it.
+    if (s_blocking_pool.is_running())
+    {
+      s_blocking_pool.stop();
+    }
+
+    s_registered_files.clear();
+    s_backend = Backend::None;
+  }
+
+  auto AsyncFileOps::get_backend() -> Backend
+  {
+    return s_backend;
+  }
+
+  auto AsyncFileOps::read_at(const NativeFileHandle handle, const Span<u8> buffer, const u64 offset,
+                             Mut<Completion> on_complete, const AsyncOps::Priority priority) -> void
+  {
+    Mut<Request> request = make_request(Operation::Read, handle, buffer.data(), buffer.size(), offset);
+    request.on_complete = std::move(on_complete);
+    request.priority = priority;
+    submit(Span<Request>(&request, 1));
+  }
+
+  auto AsyncFileOps::read_at(const NativeFileHandle handle, const Span<u8> buffer, const u64 offset,
+                             Mut<AsyncOps::Schedule *> schedule, Mut<Result<usize> *> result) -> void
+  {
+    Mut<Request> request = make_request(Operation::Read, handle, buffer.data(), buffer.size(), offset);
+    request.schedule = schedule;
+    request.result = result;
+    submit(Span<Request>(&request, 1));
+  }
+
+  auto AsyncFileOps::write_at(const NativeFileHandle handle, const Span<const u8> data, const u64 offset,
+                              Mut<Completion> on_complete, const AsyncOps::Priority priority) -> void
+  {
+    Mut<Request> request = make_request(Operation::Write, handle, const_cast<u8 *>(data.data()), data.size(), offset);
+    request.on_complete = std::move(on_complete);
+    request.priority = priority;
+    submit(Span<Request>(&request, 1));
+  }
+
+  auto AsyncFileOps::write_at(const NativeFileHandle handle, const Span<const u8> data, const u64 offset,
+                              Mut<AsyncOps::Schedule *> schedule, Mut<Result<usize> *> result) -> void
+  {
+    Mut<Request> request = make_request(Operation::Write, handle, const_cast<u8 *>(data.data()), data.size(), offset);
+    request.schedule = schedule;
+    request.result = result;
+    submit(Span<Request>(&request, 1));
+  }
+
+  auto AsyncFileOps::fsync(const NativeFileHandle handle, const bool data_only, Mut<Completion> on_complete,
+                           const AsyncOps::Priority priority) -> void
+  {
+    Mut<Request> request = make_request(data_only ? Operation::DataSync : Operation::Sync, handle, nullptr, 0, 0);
+    request.on_complete = std::move(on_complete);
+    request.priority = priority;
+    submit(Span<Request>(&request, 1));
+  }
+
+  auto AsyncFileOps::fsync(const NativeFileHandle handle, const bool data_only, Mut<AsyncOps::Schedule *> schedule,
+                           Mut<Result<usize> *> result) -> void
+  {
+    Mut<Request> request = make_request(data_only ? Operation::DataSync : Operation::Sync, handle, nullptr, 0, 0);
+    request.schedule = schedule;
+    request.result = result;
+    submit(Span<Request>(&request, 1));
+  }
+
+  auto AsyncFileOps::copy_file(Ref<Path> source, Ref<Path> destination, Ref<FileOps::CopyOptions> options,
+                               Mut<Completion> on_complete, const AsyncOps::Priority priority) -> void
+  {
+    Mut<Request> request;
+    request.on_complete = std::move(on_complete);
+    request.priority = priority;
+    run_copy(std::move(request), source, destination, options);
+  }
+
+  auto AsyncFileOps::copy_file(Ref<Path> source, Ref<Path> destination, Ref<FileOps::CopyOptions> options,
+                               Mut<AsyncOps::Schedule *> schedule, Mut<Result<usize> *> result) -> void
+  {
+    Mut<Request> request;
+    request.schedule = schedule;
+    request.result = result;
+    run_copy(std::move(request), source, destination, options);
+  }
+
+  // io_uring has no whole-file copy, and splicing through a pipe would only redo what copy_file_range does in
+  // one call, so copies always block a pool thread.
+  auto AsyncFileOps::run_copy(Mut<Request> request, Ref<Path> source, Ref<Path> destination,
+                              Ref<FileOps::CopyOptions> options) -> void
+  {
+    ensure(s_backend != Backend::None, "AsyncFileOps must be initialized before submitting I/O");
+
+    if (!request.on_complete && request.schedule)
+    {
+      request.schedule->counter.fetch_add(1);
+    }
+
+    const std::lock_guard<std::mutex> lock(s_submit_mutex);
+    if (!s_blocking_pool.is_running())
+    {
+      Mut<Result<void>> started = s_blocking_pool.start(BLOCKING_POOL_WORKER_COUNT);
+      if (!started)
+      {
+        complete(new PendingOperation{std::move(request)}, fail(std::move(started.error())));
+        return;
+      }
+    }
+
+    Mut<PendingOperation *> operation = new PendingOperation{std::move(request)};
+    s_blocking_pool.submit(
+        [operation, source = Path(source), destination = Path(destination), options](const sched::WorkerId) {
+          Mut<Result<FileOps::CopyResult>> copied = FileOps::copy_file(source, destination, options);
+          if (!copied)
+          {
+            complete(operation, fail(std::move(copied.error())));
+            return;
+          }
+          complete(operation, static_cast<usize>(copied->size));
+        },
+        nullptr);
+  }
+
+  auto AsyncFileOps::submit(const Span<Request> requests) -> void
+  {
+    ensure(s_backend != Backend::None, "AsyncFileOps must be initialized before submitting I/O");
+
+    for (Ref<Request> request : requests)
+    {
+      if (!request.on_complete && request.schedule)
+      {
+        request.schedule->counter.fetch_add(1);
+      }
+    }
+
+    const std::lock_guard<std::mutex> lock(s_submit_mutex);
+
+    if (s_backend == Backend::BlockingPool)
+    {
+      for (MutRef<Request> request : requests)
+      {
+        run_on_blocking_pool(new PendingOperation{std::move(request)});
+      }
+      return;
+    }
+
+#if IA_HAS_IO_URING
+    for (MutRef<Request> request : requests)
+    {
+      // Keep in-flight work within the completion ring, flushing our own batch before waiting on it.
+      Mut<u32> in_flight = s_in_flight_count.load();
+      while (in_flight >= s_in_flight_limit)
+      {
+        (void) s_ring->submit();
+        s_in_flight_count.wait(in_flight);
+        in_flight = s_in_flight_count.load();
+      }
+
+      // Once the ring has failed, the blocking pool takes over.
+      Mut<PendingOperation *> operation = new PendingOperation{std::move(request)};
+      if (!track_in_flight(operation))
+      {
+        run_on_blocking_pool(operation);
+        continue;
+      }
+
+      Mut<Result<io_uring_sqe *>> acquired = acquire_submission_entry();
+      if (!acquired)
+      {
+        untrack_in_flight(operation);
+        complete(operation, fail("Async {} could not be queued: {}",
+                                 get_operation_name(operation->request.operation), acquired.error()));
+        continue;
+      }
+
+      Mut<io_uring_sqe *> entry = *acquired;
+      Ref<Request> queued = operation->request;
+
+      entry->user_data = reinterpret_cast<u64>(operation);
+      if (queued.file_index != NO_INDEX)
+      {
+        entry->fd = queued.file_index;
+        entry->flags |= IOSQE_FIXED_FILE;
+      }
+      else
+      {
+        entry->fd = queued.handle;
+      }
+
+      const bool is_fixed = queued.buffer_index != NO_INDEX;
+      switch (queued.operation)
+      {
+      case Operation::Read:
+      case Operation::Write:
+        if (queued.operation == Operation::Read)
+        {
+          entry->opcode = is_fixed ? IORING_OP_READ_FIXED : IORING_OP_READ;
+        }
+        else
+        {
+          entry->opcode = is_fixed ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE;
+        }
+        entry->addr = reinterpret_cast<u64>(queued.buffer);
+        // Larger requests complete short, as pread/pwrite would.
+        entry->len = static_cast<u32>(std::min<usize>(queued.size, std::numeric_limits<u32>::max()));
+        entry->off = queued.offset;
+        entry->buf_index = is_fixed ? static_cast<u16>(queued.buffer_index) : 0;
+        break;
+      case Operation::Sync:
+      case Operation::DataSync:
+        entry->opcode = IORING_OP_FSYNC;
+        entry->fsync_flags = queued.operation == Operation::DataSync ? IORING_FSYNC_DATASYNC : 0;
+        break;
+      }
+
+      // Also publishes the operation to the reaper, which acquires it through its decrement.
+      s_in_flight_count.fetch_add(1, std::memory_order_release);
+    }
+
+    // On failure the entries stay published and go out with the next submission.
+    (void) s_ring->submit();
+#endif
+  }
+
+  auto AsyncFileOps::register_buffers(const Span<const Span<u8>> buffers) -> Result<void>
+  {
+    ensure(s_backend != Backend::None, "AsyncFileOps must be initialized before registering buffers");
+
+#if IA_HAS_IO_URING
+    if (s_backend == Backend::IoUring)
+    {
+      Mut<Vec<iovec>> vectors;
+      vectors.reserve(buffers.size());
+      for (Ref<Span<u8>> buffer : buffers)
+      {
+        vectors.push_back(iovec{buffer.data(), buffer.size()});
+      }
+
+      const std::lock_guard<std::mutex> lock(s_submit_mutex);
+      s_ring->unregister_buffers();
+      return s_ring->register_buffers(vectors);
+    }
+#endif
+
+    // The blocking pool addresses buffers directly, so there is nothing to pin.
+    AU_UNUSED(buffers);
+    return {};
+  }
+
+  auto AsyncFileOps::unregister_buffers() -> void
+  {
+#if IA_HAS_IO_URING
+    if (s_backend == Backend::IoUring)
+    {
+      const std::lock_guard<std::mutex> lock(s_submit_mutex);
+      s_ring->unregister_buffers();
+    }
+#endif
+  }
+
+  auto AsyncFileOps::register_files(const Span<const NativeFileHandle> handles) -> Result<void>
+  {
+    ensure(s_backend != Backend::None, "AsyncFileOps must be initialized before registering files");
+
+    const std::lock_guard<std::mutex> lock(s_submit_mutex);
+    s_registered_files.assign(handles.begin(), handles.end());
+
+#if IA_HAS_IO_URING
+    if (s_backend == Backend::IoUring)
+    {
+      s_ring->unregister_files();
+      return s_ring->register_files(s_registered_files);
+    }
+#endif
+    return {};
+  }
+
+  auto AsyncFileOps::unregister_files() -> void
+  {
+    const std::lock_guard<std::mutex> lock(s_submit_mutex);
+    s_registered_files.clear();
+
+#if IA_HAS_IO_URING
+    if (s_backend == Backend::IoUring)
+    {
+      s_ring->unregister_files();
+    }
+#endif
+  }
+
+  auto AsyncFileOps::complete(Mut<PendingOperation *> operation, Mut<Result<usize>> result) -> void
+  {
+    const Box<PendingOperation> owned(operation);
+    MutRef<Request> request = owned->request;
+
+    if (request.on_complete)
+    {
+      // Completions must not be dropped by cancel_tasks_of_tag, so they run under the reserved Future tag.
+      detail::schedule_future_task(
+          [on_complete = std::move(request.on_complete), result = std::move(result)](const AsyncOps::WorkerId) mutable {
+            on_complete(std::move(result));
+          },
+          request.priority, AsyncOps::NO_DEADLINE);
+      return;
+    }
+
+    if (request.result)
+    {
+      *request.result = std::move(result);
+    }
+    if (request.schedule)
+    {
+      AsyncOps::release_schedule(request.schedule);
+    }
+  }
+
+  // Call with s_submit_mutex held. Under io_uring the pool is started on first use.
+  auto AsyncFileOps::run_on_blocking_pool(Mut<PendingOperation *> operation) -> void
+  {
+    if (!s_blocking_pool.is_running())
+    {
+      Mut<Result<void>> started = s_blocking_pool.start(BLOCKING_POOL_WORKER_COUNT);
+      if (!started)
+      {
+        complete(operation, fail(std::move(started.error())));
+        return;
+      }
+    }
+
+    if (operation->request.file_index != NO_INDEX)
+    {
+      const usize index = static_cast<usize>(operation->request.file_index);
+      if (index >= s_registered_files.size())
+      {
+        complete(operation, fail("Async I/O names unregistered file slot {}", index));
+        return;
+      }
+      operation->request.handle = s_registered_files[index];
+    }
+
+    s_blocking_pool.submit(
+        [operation](const sched::WorkerId) { complete(operation, run_blocking(operation->request)); }, nullptr);
+  }
+
+#if IA_HAS_IO_URING
+  auto AsyncFileOps::track_in_flight(Mut<PendingOperation *> operation) -> bool
+  {
+    const std::lock_guard<std::mutex> lock(s_in_flight_mutex);
+    if (s_is_ring_failed)
+    {
+      return false;
+    }
+
+    operation->next = PendingOperation::in_flight;
+    if (operation->next)
+    {
+      operation->next->previous = operation;
+    }
+    PendingOperation::in_flight = operation;
+    return true;
+  }
+
+  auto AsyncFileOps::untrack_in_flight(Mut<PendingOperation *> operation) -> void
+  {
+    const std::lock_guard<std::mutex> lock(s_in_flight_mutex);
+    if (operation->previous)
+    {
+      operation->previous->next = operation->next;
+    }
+    else
+    {
+      PendingOperation::in_flight = operation->next;
+    }
+    if (operation->next)
+    {
+      operation->next->previous = operation->previous;
+    }
+  }
+
+  // Runs on the reaper once the ring is unusable. Operations it still holds fail, and later ones go to the pool.
+  auto AsyncFileOps::fail_in_flight(Ref<String> reason) -> void
+  {
+    {
+      const std::lock_guard<std::mutex> lock(s_in_flight_mutex);
+      s_is_ring_failed = true;
+    }
+    // Frees a submitter waiting for room. Once it lets go of the submit lock, no tracked entry is still being filled
+    // and nothing counts towards the limit any more.
+    s_in_flight_count.store(0, std::memory_order_release);
+    s_in_flight_count.notify_all();
+
+    Mut<PendingOperation *> operation = nullptr;
+    {
+      const std::lock_guard<std::mutex> submit_lock(s_submit_mutex);
+      const std::lock_guard<std::mutex> lock(s_in_flight_mutex);
+      operation = std::exchange(PendingOperation::in_flight, nullptr);
+      s_in_flight_count.store(0, std::memory_order_release);
+    }
+
+    while (operation)
+    {
+      Mut<PendingOperation *> next = operation->next;
+      complete(operation, fail("Async {} failed: {}", get_operation_name(operation->request.operation), reason));
+      operation = next;
+    }
+  }
+#endif
+
+  auto AsyncFileOps::run_blocking(Ref<Request> request) -> Result<usize>
+  {
+#if IA_PLATFORM_WINDOWS
+    if (request.operation == Operation::Sync || request.operation == Operation::DataSync)
+    {
+      if (!FlushFileBuffers(request.handle))
+      {
+        return fail("Async {} failed: {}", get_operation_name(request.operation), GetLastError());
+      }
+      return 0;
+    }
+
+    Mut<OVERLAPPED> overlapped{};
+    overlapped.Offset = static_cast<DWORD>(request.offset & 0xFFFFFFFF);
+    overlapped.OffsetHigh = static_cast<DWORD>(request.offset >> 32);
+
+    const DWORD size = static_cast<DWORD>(std::min<usize>(request.size, MAXDWORD));
+    Mut<DWORD> transferred = 0;
+    const BOOL succeeded = request.operation == Operation::Read
+                               ? ReadFile(request.handle, request.buffer, size, &transferred, &overlapped)
+                               : WriteFile(request.handle, request.buffer, size, &transferred, &overlapped);
+    if (!succeeded)
+    {
+      const DWORD error = GetLastError();
+      if (error == ERROR_HANDLE_EOF)
+      {
+        return 0;
+      }
+      return fail("Async {} failed: {}", get_operation_name(request.operation), error);
+    }
+    return static_cast<usize>(transferred);
+
+#elif IA_PLATFORM_UNIX
+    while (true)
+    {
+      Mut<isize> transferred = 0;
+      switch (request.operation)
+      {
+      case Operation::Read:
+        transferred = pread(request.handle, request.buffer, request.size, static_cast<off_t>(request.offset));
+        break;
+      case Operation::Write:
+        transferred = pwrite(request.handle, request.buffer, request.size, static_cast<off_t>(request.offset));
+        break;
+      case Operation::Sync:
+        transferred = ::fsync(request.handle);
+        break;
+      case Operation::DataSync:
+#  if defined(__linux__)
+        transferred = fdatasync(request.handle);
+#  else
+        transferred = ::fsync(request.handle);
+#  endif
+        break;
+      }
+
+      if (transferred >= 0)
+      {
+        return static_cast<usize>(transferred);
+      }
+      if (errno != EINTR)
+      {
+        return fail("Async {} failed: {}", get_operation_name(request.operation), errno);
+      }
+    }
+#endif
+  }
+} // namespace ia
@@ -0,0 +1,503 @@
+// IA-PlatformOps; C++ 20 Async, Process and File Operations.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <platform_ops/directory_walker.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+#include <utility>
+
+#if IA_PLATFORM_WINDOWS
+#  include <Windows.h>
+#elif IA_PLATFORM_UNIX
+#  include <dirent.h>
+#  include <fcntl.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#  if defined(__linux__)
+#    include <sys/syscall.h>
+#  endif
+#endif
+
+namespace ia
+{
+  // Room for a few hundred entries per getdents64 call, which is what one batch holds.
+  static constexpr const usize READ_BUFFER_SIZE = 32 * 1024;
+
+  struct DirectoryWalker::Context
+  {
+    Ref<Options> options;
+    Ref<Callback> on_entries;
+    Mut<bool> is_parallel = false;
+
+    Mut<AsyncOps::Schedule> schedule;
+    Mut<Vec<std::pair<String, u32>>> pending; // Directories still to read, for serial walks
+
+    Mut<std::atomic<u64>> directory_count{0};
+    Mut<std::atomic<u64>> entry_count{0};
+    Mut<std::atomic<u64>> error_count{0};
+
+    Context(Ref<Options> options, Ref<Callback> on_entries) : options(options), on_entries(on_entries)
+    {
+    }
+  };
+
+  // Buffers reused across directory reads on one thread. A read takes them for its duration, so a callback that
+  // suspends and lets another read run on this thread leaves that read to allocate its own.
+  struct WalkScratch
+  {
+    Mut<Vec<u8>> buffer;
+    Mut<Vec<DirectoryWalker::Entry>> entries;
+    Mut<Vec<std::pair<String, u32>>> subdirectories;
+#if IA_PLATFORM_WINDOWS
+    Mut<Vec<String>> names;
+#endif
+  };
+
+  static thread_local Mut<Box<WalkScratch>> t_walk_scratch;
+
+  static auto join_path(const StringView directory, const StringView name) -> String
+  {
+    Mut<String> path;
+    path.reserve(directory.size() + name.size() + 1);
+    path.append(directory);
+    if (!directory.empty() && directory.back() != '/' && directory.back() != '\\')
+    {
+      path.push_back(env::IS_WINDOWS ? '\\' : '/');
+    }
+    path.append(name);
+    return path;
+  }
+
+  auto DirectoryWalker::Entry::get_path() const -> Path
+  {
+    return Path(join_path(directory, name));
+  }
+
+#if IA_PLATFORM_UNIX
+  static auto to_entry_type(const mode_t mode) -> DirectoryWalker::EntryType
+  {
+    if (S_ISREG(mode))
+    {
+      return DirectoryWalker::EntryType::File;
+    }
+    if (S_ISDIR(mode))
+    {
+      return DirectoryWalker::EntryType::Directory;
+    }
+    if (S_ISLNK(mode))
+    {
+      return DirectoryWalker::EntryType::Symlink;
+    }
+    return DirectoryWalker::EntryType::Other;
+  }
+
+  // Fills in what the directory listing left out: the type when the filesystem does not store it (DT_UNKNOWN),
+  // and size and modification time when asked for. Only the fields needed go into the statx mask, and no
+  // attribute sync is forced on network filesystems.
+  static auto stat_entry(const int directory_fd, const char *name, const bool need_type, const bool need_stat,
+                         MutRef<DirectoryWalker::Entry> entry) -> bool
+  {
+#  if defined(__linux__) && defined(STATX_TYPE)
+    const unsigned int mask = (need_type ? STATX_TYPE : 0u) | (need_stat ? STATX_SIZE | STATX_MTIME : 0u);
+    Mut<struct statx> extended{};
+    if (::statx(directory_fd, name, AT_SYMLINK_NOFOLLOW | AT_STATX_DONT_SYNC, mask, &extended) == 0)
+    {
+      if (need_type)
+      {
+        entry.type = to_entry_type(extended.stx_mode);
+      }
+      if (need_stat)
+      {
+        entry.size = extended.stx_size;
+        entry.modified_ns = static_cast<i64>(extended.stx_mtime.tv_sec) * 1'000'000'000 + extended.stx_mtime.tv_nsec;
+      }
+      return true;
+    }
+    if (errno != ENOSYS)
+    {
+      return false;
+    }
+#  endif
+    Mut<struct stat> info{};
+    if (::fstatat(directory_fd, name, &info, AT_SYMLINK_NOFOLLOW) != 0)
+    {
+      return false;
+    }
+    if (need_type)
+    {
+      entry.type = to_entry_type(info.st_mode);
+    }
+    if (need_stat)
+    {
+      entry.size = static_cast<u64>(info.st_size);
+#  if defined(__APPLE__)
+      entry.modified_ns = static_cast<i64>(info.st_mtimespec.tv_sec) * 1'000'000'000 + info.st_mtimespec.tv_nsec;
+#  else
+      entry.modified_ns = static_cast<i64>(info.st_mtim.tv_sec) * 1'000'000'000 + info.st_mtim.tv_nsec;
+#  endif
+    }
+    return true;
+  }
+
+  // Turns one listed name into an entry, or returns false when it is skipped: "." and "..", filtered out, or
+  // gone before its stat.
+  static auto make_entry(MutRef<DirectoryWalker::Entry> entry, const int directory_fd, const StringView directory,
+                         const char *name, const unsigned char d_type, const u64 inode, const u32 depth,
+                         Ref<DirectoryWalker::Options> options, MutRef<std::atomic<u64>> error_count) -> bool
+  {
+    if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0')))
+    {
+      return false;
+    }
+
+    entry = DirectoryWalker::Entry{};
+    entry.directory = directory;
+    entry.name = StringView(name);
+    entry.depth = depth;
+    entry.inode = inode;
+
+    Mut<bool> need_type = false;
+    switch (d_type)
+    {
+    case DT_REG:
+      entry.type = DirectoryWalker::EntryType::File;
+      break;
+    case DT_DIR:
+      entry.type = DirectoryWalker::EntryType::Directory;
+      break;
+    case DT_LNK:
+      entry.type = DirectoryWalker::EntryType::Symlink;
+      break;
+    case DT_UNKNOWN:
+      need_type = true;
+      break;
+    default:
+      entry.type = DirectoryWalker::EntryType::Other;
+      break;
+    }
+
+    if ((need_type || options.stat) && !stat_entry(directory_fd, name, need_type, options.stat, entry))
+    {
+      // Removed since the listing was taken; anything else is worth counting.
+      if (errno != ENOENT)
+      {
+        error_count.fetch_add(1, std::memory_order_relaxed);
+      }
+      if (need_type)
+      {
+        return false;
+      }
+    }
+
+    return !options.filter || options.filter(entry);
+  }
+#endif
+
+  auto DirectoryWalker::walk_directory(MutRef<Context> context, Mut<String> directory, const u32 depth,
+                                       const AsyncOps::WorkerId worker_id, const isize handle) -> void
+  {
+    Mut<Box<WalkScratch>> scratch = std::move(t_walk_scratch);
+    if (!scratch)
+    {
+      scratch = make_box<WalkScratch>();
+    }
+    MutRef<Vec<Entry>> entries = scratch->entries;
+    MutRef<Vec<std::pair<String, u32>>> subdirectories = scratch->subdirectories;
+    subdirectories.clear();
+
+    const bool can_descend = depth < context.options.max_depth;
+    const auto deliver = [&]() {
+      if (entries.empty())
+      {
+        return;
+      }
+      for (Ref<Entry> entry : entries)
+      {
+        if (can_descend && entry.type == EntryType::Directory)
+        {
+          subdirectories.emplace_back(join_path(directory, entry.name), depth + 1);
+        }
+      }
+      context.entry_count.fetch_add(entries.size(), std::memory_order_relaxed);
+      context.on_entries(Span<const Entry>(entries), worker_id);
+      entries.clear();
+    };
+
+#if IA_PLATFORM_WINDOWS
+    AU_UNUSED(handle);
+    MutRef<Vec<String>> names = scratch->names;
+
+    Mut<WIN32_FIND_DATAW> data{};
+    const HANDLE find = FindFirstFileExW(Path(join_path(directory, "*")).wstring().c_str(), FindExInfoBasic, &data,
+                                         FindExSearchNameMatch, NULL, FIND_FIRST_EX_LARGE_FETCH);
+    if (find == INVALID_HANDLE_VALUE)
+    {
+      context.error_count.fetch_add(1, std::memory_order_relaxed);
+    }
+    else
+    {
+      context.directory_count.fetch_add(1, std::memory_order_relaxed);
+      // The entry views point into `names`, so a batch is delivered before the vector could reallocate.
+      names.resize(256);
+      do
+      {
+        const wchar_t *w_name = data.cFileName;
+        if (w_name[0] == L'.' && (w_name[1] == L'\0' || (w_name[1] == L'.' && w_name[2] == L'\0')))
+        {
+          continue;
+        }
+
+        MutRef<String> name = names[entries.size()];
+        const int length = WideCharToMultiByte(CP_UTF8, 0, w_name, -1, NULL, 0, NULL, NULL);
+        name.resize(static_cast<usize>(std::max(length, 1)) - 1);
+        WideCharToMultiByte(CP_UTF8, 0, w_name, -1, name.data(), length, NULL, NULL);
+
+        Mut<Entry> entry{};
+        entry.directory = directory;
+        entry.name = name;
+        entry.depth = depth;
+        if (data.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT)
+        {
+          entry.type = EntryType::Symlink;
+        }
+        else if (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+        {
+          entry.type = EntryType::Directory;
+        }
+        else
+        {
+          entry.type = EntryType::File;
+        }
+        // The listing carries these already, so there is no extra call to skip.
+        if (context.options.stat)
+        {
+          entry.size = (static_cast<u64>(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+          const u64 ticks =
+              (static_cast<u64>(data.ftLastWriteTime.dwHighDateTime) << 32) | data.ftLastWriteTime.dwLowDateTime;
+          // FILETIME counts 100 ns ticks since 1601.
+          entry.modified_ns = (static_cast<i64>(ticks) - 116'444'736'000'000'000) * 100;
+        }
+
+        if (!context.options.filter || context.options.filter(entry))
+        {
+          entries.push_back(entry);
+          if (entries.size() == names.size())
+          {
+            deliver();
+          }
+        }
+      } while (FindNextFileW(find, &data));
+
+      if (GetLastError() != ERROR_NO_MORE_FILES)
+      {
+        context.error_count.fetch_add(1, std::memory_order_relaxed);
+      }
+      FindClose(find);
+      deliver();
+    }
+#elif IA_PLATFORM_UNIX
+    Mut<int> fd = static_cast<int>(handle);
+    if (fd < 0)
+    {
+      fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    }
+
+    if (fd < 0)
+    {
+      context.error_count.fetch_add(1, std::memory_order_relaxed);
+    }
+    else
+    {
+      context.directory_count.fetch_add(1, std::memory_order_relaxed);
+#  if defined(__linux__)
+      // Each getdents64 call fills the buffer with as many records as fit, and becomes one batch. The names point
+      // into the buffer, so it is not touched again until the batch is delivered.
+      MutRef<Vec<u8>> buffer = scratch->buffer;
+      buffer.resize(READ_BUFFER_SIZE);
+      while (true)
+      {
+        const long read_size = ::syscall(SYS_getdents64, fd, buffer.data(), buffer.size());
+        if (read_size <= 0)
+        {
+          if (read_size < 0)
+          {
+            context.error_count.fetch_add(1, std::memory_order_relaxed);
+          }
+          break;
+        }
+
+        for (Mut<long> offset = 0; offset < read_size;)
+        {
+          const auto *record = reinterpret_cast<const struct dirent64 *>(buffer.data() + offset);
+          offset += record->d_reclen;
+
+          Mut<Entry> entry;
+          if (make_entry(entry, fd, directory, record->d_name, record->d_type, record->d_ino, depth, context.options,
+                         context.error_count))
+          {
+            entries.push_back(entry);
+          }
+        }
+        deliver();
+      }
+      ::close(fd);
+#  else
+      DIR *stream = ::fdopendir(fd);
+      if (!stream)
+      {
+        context.error_count.fetch_add(1, std::memory_order_relaxed);
+        ::close(fd);
+      }
+      else
+      {
+        // readdir reuses its record, so names are copied out and batches kept small enough not to reallocate.
+        MutRef<Vec<u8>> buffer = scratch->buffer;
+        buffer.resize(READ_BUFFER_SIZE);
+        Mut<usize> used = 0;
+        while (true)
+        {
+          errno = 0;
+          const struct dirent *record = ::readdir(stream);
+          if (!record)
+          {
+            if (errno != 0)
+            {
+              context.error_count.fetch_add(1, std::memory_order_relaxed);
+            }
+            break;
+          }
+
+          const usize name_size = std::strlen(record->d_name) + 1;
+          if (used + name_size > buffer.size())
+          {
+            deliver();
+            used = 0;
+          }
+          char *name = reinterpret_cast<char *>(buffer.data() + used);
+          std::memcpy(name, record->d_name, name_size);
+
+          Mut<Entry> entry;
+          if (make_entry(entry, ::dirfd(stream), directory, name, record->d_type, record->d_ino, depth,
+                         context.options, context.error_count))
+          {
+            entries.push_back(entry);
+            used += name_size;
+          }
+        }
+        deliver();
+        ::closedir(stream);
+      }
+#  endif
+    }
+#endif
+
+    // Directories below are read once this one is closed, which keeps one descriptor open per running read.
+    for (MutRef<std::pair<String, u32>> subdirectory : subdirectories)
+    {
+      if (context.is_parallel)
+      {
+        AsyncOps::schedule_task(
+            [&context, path = std::move(subdirectory.first), child_depth = subdirectory.second](
+                const AsyncOps::WorkerId child_worker_id) mutable {
+              walk_directory(context, std::move(path), child_depth, child_worker_id);
+            },
+            0, &context.schedule);
+      }
+      else
+      {
+        context.pending.push_back(std::move(subdirectory));
+      }
+    }
+    subdirectories.clear();
+
+    t_walk_scratch = std::move(scratch);
+  }
+
+  auto DirectoryWalker::walk(Ref<Path> root, Ref<Options> options, Ref<Callback> on_entries) -> Result<Stats>
+  {
+    Mut<String> root_path = root.string();
+    Mut<isize> handle = -1;
+
+#if IA_PLATFORM_WINDOWS
+    const DWORD attributes = GetFileAttributesW(root.wstring().c_str());
+    if (attributes == INVALID_FILE_ATTRIBUTES || !(attributes & FILE_ATTRIBUTE_DIRECTORY))
+    {
+      return fail("Failed to open directory {}: error {}", root_path, GetLastError());
+    }
+#elif IA_PLATFORM_UNIX
+    const int fd = ::open(root_path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0)
+    {
+      return fail("Failed to open directory {}: {}", root_path, std::strerror(errno));
+    }
+    handle = fd;
+#endif
+
+    Mut<Context> context(options, on_entries);
+    context.is_parallel = options.parallel && AsyncOps::get_worker_count() > 0;
+
+    walk_directory(context, std::move(root_path), 0, AsyncOps::MAIN_THREAD_WORKER_ID, handle);
+    if (context.is_parallel)
+    {
+      AsyncOps::wait_for_schedule_completion(&context.schedule);
+    }
+    else
+    {
+      // Depth-first, so the list of pending directories stays short on wide trees.
+      while (!context.pending.empty())
+      {
+        Mut<std::pair<String, u32>> next = std::move(context.pending.back());
+        context.pending.pop_back();
+        walk_directory(context, std::move(next.first), next.second, AsyncOps::MAIN_THREAD_WORKER_ID);
+      }
+    }
+
+    Mut<Stats> stats;
+    stats.directory_count = context.directory_count.load(std::memory_order_relaxed);
+    stats.entry_count = context.entry_count.load(std::memory_order_relaxed);
+    stats.error_count = context.error_count.load(std::memory_order_relaxed);
+    return stats;
+  }
+
+  auto DirectoryWalker::list(Ref<Path> root) -> Result<Vec<Path>>
+  {
+    return list(root, Options{});
+  }
+
+  auto DirectoryWalker::list(Ref<Path> root, Ref<Options> options) -> Result<Vec<Path>>
+  {
+    Mut<std::mutex> mutex;
+    Mut<Vec<Path>> paths;
+    Mut<Result<Stats>> walked = walk(root, options, [&](const Span<const Entry> entries, const AsyncOps::WorkerId) {
+      Mut<Vec<Path>> batch;
+      batch.reserve(entries.size());
+      for (Ref<Entry> entry : entries)
+      {
+        batch.push_back(entry.get_path());
+      }
+      const std::lock_guard lock(mutex);
+      paths.insert(paths.end(), std::make_move_iterator(batch.begin()), std::make_move_iterator(batch.end()));
+    });
+    if (!walked)
+    {
+      return fail(std::move(walked.error()));
+    }
+    return paths;
+  }
+} // namespace ia
@@ -0,0 +1,145 @@
+// IA-PlatformOps; C++ 20 Async, Process and File Operations.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fiber.hpp>
+
+#if IA_PLATFORM_WINDOWS
+#  define NOMINMAX
+#  define WIN32_LEAN_AND_MEAN
+#  include <Windows.h>
+#elif IA_PLATFORM_UNIX
+#  include <cerrno>
+#  include <sys/mman.h>
+#  include <unistd.h>
+#endif
+
+namespace ia
+{
+  auto Fiber::create(const usize stack_size, const EntryPoint entry, Mut<void *> user_data) -> Result<Box<Fiber>>
+  {
+    Mut<Box<Fiber>> fiber(new Fiber());
+    fiber->m_entry = entry;
+    fiber->m_user_data = user_data;
+
+#if IA_PLATFORM_WINDOWS
+    // Windows reserves fiber stacks with its own guard page.
+    fiber->m_handle = CreateFiberEx(0, stack_size, FIBER_FLAG_FLOAT_SWITCH,
+                                    reinterpret_cast<LPFIBER_START_ROUTINE>(trampoline), fiber.get());
+    if (fiber->m_handle == nullptr)
+    {
+      return fail("CreateFiberEx failed: {}", GetLastError());
+    }
+#elif IA_PLATFORM_UNIX
+    const usize page_size = static_cast<usize>(sysconf(_SC_PAGESIZE));
+    const usize usable_size = (stack_size + page_size - 1) & ~(page_size - 1);
+
+    fiber->m_mapping_size = usable_size + page_size;
+    Mut<void *> mapping =
+        mmap(nullptr, fiber->m_mapping_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0);
+    if (mapping == MAP_FAILED)
+    {
+      return fail("Failed to map fiber stack: {}", errno);
+    }
+    fiber->m_mapping = static_cast<u8 *>(mapping);
+
+    // Stacks grow down, so the guard page sits at the lowest address.
+    if (mprotect(fiber->m_mapping, page_size, PROT_NONE) == -1)
+    {
+      return fail("Failed to protect fiber stack guard page: {}", errno);
+    }
+
+    if (getcontext(&fiber->m_context) == -1)
+    {
+      return fail("getcontext failed: {}", errno);
+    }
+
+    fiber->m_context.uc_stack.ss_sp = fiber->m_mapping + page_size;
+    fiber->m_context.uc_stack.ss_size = usable_size;
+    fiber->m_context.uc_link = nullptr;
+
+    const u64 address = reinterpret_cast<u64>(fiber.get());
+    makecontext(&fiber->m_context, reinterpret_cast<void (*)()>(trampoline), 2, static_cast<u32>(address),
+                static_cast<u32>(address >> 32));
+#endif
+
+    return fiber;
+  }
+
+  auto Fiber::prepare_thread() -> Result<void>
+  {
+#if IA_PLATFORM_WINDOWS
+    if (ConvertThreadToFiberEx(nullptr, FIBER_FLAG_FLOAT_SWITCH) == nullptr)
+    {
+      return fail("ConvertThreadToFiberEx failed: {}", GetLastError());
+    }
+#endif
+    return {};
+  }
+
+  auto Fiber::release_thread() -> void
+  {
+#if IA_PLATFORM_WINDOWS
+    ConvertFiberToThread();
+#endif
+  }
+
+  Fiber::~Fiber()
+  {
+#if IA_PLATFORM_WINDOWS
+    if (m_handle)
+    {
+      DeleteFiber(m_handle);
+    }
+#elif IA_PLATFORM_UNIX
+    if (m_mapping)
+    {
+      munmap(m_mapping, m_mapping_size);
+    }
+#endif
+  }
+
+  auto Fiber::resume() -> void
+  {
+#if IA_PLATFORM_WINDOWS
+    m_return_handle = GetCurrentFiber();
+    SwitchToFiber(m_handle);
+#elif IA_PLATFORM_UNIX
+    swapcontext(&m_return_context, &m_context);
+#endif
+  }
+
+  auto Fiber::suspend() -> void
+  {
+#if IA_PLATFORM_WINDOWS
+    SwitchToFiber(m_return_handle);
+#elif IA_PLATFORM_UNIX
+    swapcontext(&m_context, &m_return_context);
+#endif
+  }
+
+#if IA_PLATFORM_WINDOWS
+  auto __stdcall Fiber::trampoline(Mut<void *> parameter) -> void
+  {
+    Mut<Fiber *> fiber = static_cast<Fiber *>(parameter);
+    fiber->m_entry(fiber);
+  }
+#elif IA_PLATFORM_UNIX
+  auto Fiber::trampoline(const u32 fiber_low, const u32 fiber_high) -> void
+  {
+    Mut<Fiber *> fiber = reinterpret_cast<Fiber *>(static_cast<u64>(fiber_low) | (static_cast<u64>(fiber_high) << 32));
+    fiber->m_entry(fiber);
+  }
+#endif
+} // namespace ia
@@ -13,50 +13,313 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <platform_ops/async.hpp>
 #include <platform_ops/file.hpp>
+#include <platform_ops/line_iterator.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <charconv>
 #include <cerrno>
 #include <cstdio>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 
 #if IA_PLATFORM_UNIX
 #  include <fcntl.h>
 #  include <sys/mman.h>
+#  include <sys/resource.h>
 #  include <sys/stat.h>
+#  include <sys/uio.h>
 #  include <unistd.h>
+#  if defined(__linux__)
+#    include <linux/fs.h>
+#    include <sys/ioctl.h>
+#    include <sys/sendfile.h>
+#    include <sys/vfs.h>
+#  endif
 #endif
 
 namespace ia
 {
-  Mut<HashMap<const u8 *, std::tuple<void *, void *, void *>>> FileOps::s_mapped_files;
+  // What unmap_file needs to release a mapping made by map_file or map_shared_memory. On Unix the descriptor is
+  // closed as soon as the mapping exists, since the mapping keeps the file alive by itself.
+  struct MappingHandles
+  {
+    Mut<void *> address = nullptr;
+    Mut<usize> size = 0;
+#if IA_PLATFORM_WINDOWS
+    Mut<HANDLE> file_handle = INVALID_HANDLE_VALUE;
+    Mut<HANDLE> map_handle = NULL;
+#endif
+  };
+
+  static auto release_mapping(Ref<MappingHandles> handles) -> void
+  {
+#if IA_PLATFORM_WINDOWS
+    ::UnmapViewOfFile(handles.address);
+    ::CloseHandle(handles.map_handle);
+    if (handles.file_handle != INVALID_HANDLE_VALUE)
+    {
+      ::CloseHandle(handles.file_handle);
+    }
+#elif IA_PLATFORM_UNIX
+    ::munmap(handles.address, handles.size);
+#endif
+  }
+
+  // Tracks live map_file and map_shared_memory mappings by address. It is sharded so that threads mapping different
+  // files rarely contend on a lock; the system calls themselves run outside any lock.
+  class MappingRegistry
+  {
+public:
+    auto insert(const u8 *address, Ref<MappingHandles> handles) -> void
+    {
+      MutRef<Shard> shard = get_shard(address);
+      const std::lock_guard lock(shard.mutex);
+      shard.entries[address] = handles;
+    }
+
+    auto remove(const u8 *address) -> std::optional<MappingHandles>
+    {
+      MutRef<Shard> shard = get_shard(address);
+      const std::lock_guard lock(shard.mutex);
+      Mut<decltype(shard.entries)::iterator> it = shard.entries.find(address);
+      if (it == shard.entries.end())
+      {
+        return std::nullopt;
+      }
+      const MappingHandles handles = it->second;
+      shard.entries.erase(it);
+      return handles;
+    }
+
+private:
+    static constexpr const u32 SHARD_BITS = 4;
+    static constexpr const usize SHARD_COUNT = 1 << SHARD_BITS;
+
+    struct alignas(64) Shard
+    {
+      Mut<std::mutex> mutex;
+      Mut<HashMap<const u8 *, MappingHandles>> entries;
+    };
+
+    auto get_shard(const u8 *address) -> MutRef<Shard>
+    {
+      // Mappings are page aligned and tend to sit next to each other, so hash the page number and keep the top
+      // bits, which are the best mixed.
+      const u64 page = static_cast<u64>(reinterpret_cast<uintptr_t>(address)) >> 12;
+      return m_shards[(page * 0x9E3779B97F4A7C15ull) >> (64 - SHARD_BITS)];
+    }
+
+private:
+    Mut<Array<Shard, SHARD_COUNT>> m_shards;
+  };
+
+  static Mut<MappingRegistry> s_mapping_registry;
 
   auto FileOps::unmap_file(const u8 *mapped_ptr) -> void
   {
-    if (!s_mapped_files.contains(mapped_ptr))
+    const std::optional<MappingHandles> handles = s_mapping_registry.remove(mapped_ptr);
+    if (handles)
+    {
+      release_mapping(*handles);
+    }
+  }
+
+  auto FileOps::get_system_page_size() -> usize
+  {
+#if IA_PLATFORM_WINDOWS
+    Mut<SYSTEM_INFO> info;
+    GetSystemInfo(&info);
+    return static_cast<usize>(info.dwPageSize);
+#elif IA_PLATFORM_UNIX
+    static const usize s_page_size = static_cast<usize>(sysconf(_SC_PAGESIZE));
+    return s_page_size;
+#endif
+  }
+
+  static auto round_up_to_page(const usize size, const usize page_size) -> usize
+  {
+    return (size + page_size - 1) / page_size * page_size;
+  }
+
+  static constexpr const usize HUGE_PAGE_2M = 2 * 1024 * 1024;
+  static constexpr const usize HUGE_PAGE_1G = 1024 * 1024 * 1024;
+
+  // Largest first, so each request falls back to the next smaller size.
+  static auto get_huge_page_candidates(const FileOps::HugePages huge_pages) -> Span<const usize>
+  {
+    static constexpr const usize CANDIDATES[] = {HUGE_PAGE_1G, HUGE_PAGE_2M};
+    switch (huge_pages)
+    {
+    case FileOps::HugePages::Explicit1G:
+      return Span<const usize>(CANDIDATES, 2);
+    case FileOps::HugePages::Explicit2M:
+      return Span<const usize>(CANDIDATES + 1, 1);
+    default:
+      return {};
+    }
+  }
+
+  static auto advise_transparent_huge_pages(Mut<void *> address, const usize size) -> void
+  {
+#if IA_PLATFORM_UNIX && defined(MADV_HUGEPAGE)
+    // Only a hint. Shared memory gets huge pages only if shmem_enabled allows it.
+    madvise(address, size, MADV_HUGEPAGE);
+#else
+    AU_UNUSED(address);
+    AU_UNUSED(size);
+#endif
+  }
+
+#if IA_PLATFORM_UNIX && defined(__linux__)
+  static constexpr const long HUGETLBFS_MAGIC_NUMBER = 0x958458f6;
+
+  // Calls `fn(mount_point)` for every hugetlbfs mount whose page size is `page_size`, or for every hugetlbfs mount
+  // when `page_size` is 0.
+  template<typename Fn> static auto for_each_hugetlbfs_mount(const usize page_size, Mut<Fn> fn) -> void
+  {
+    const Result<String> mounts = FileOps::read_text_file("/proc/self/mounts");
+    if (!mounts)
     {
       return;
     }
 
-    Mut<decltype(s_mapped_files)::iterator> it = s_mapped_files.find(mapped_ptr);
-    const std::tuple<void *, void *, void *> handles = it->second;
-    s_mapped_files.erase(it);
+    LineIterator::for_each_line(*mounts, [&](const StringView line) {
+      // "<device> <mount point> <type> <options> 0 0"
+      const usize mount_start = line.find(' ');
+      const usize type_start = line.find(' ', mount_start + 1);
+      if (mount_start == StringView::npos || type_start == StringView::npos ||
+          !line.substr(type_start + 1).starts_with("hugetlbfs "))
+      {
+        return;
+      }
 
-#if IA_PLATFORM_WINDOWS
-    ::UnmapViewOfFile(std::get<1>(handles));
-    ::CloseHandle(static_cast<HANDLE>(std::get<2>(handles)));
+      const String mount_point(line.substr(mount_start + 1, type_start - mount_start - 1));
+      Mut<struct statfs> fs;
+      if (statfs(mount_point.c_str(), &fs) == 0 && fs.f_type == HUGETLBFS_MAGIC_NUMBER &&
+          (page_size == 0 || static_cast<usize>(fs.f_bsize) == page_size))
+      {
+        fn(Path(mount_point));
+      }
+    });
+  }
+
+  static auto get_hugetlbfs_file_name(Ref<String> name) -> String
+  {
+    return name.starts_with('/') ? name.substr(1) : name;
+  }
+
+  // Maps the segment from a hugetlbfs file, or returns nullptr if no mount of that page size could provide it.
+  static auto map_hugetlbfs_segment(Ref<String> name, const usize size, const bool is_owner, const usize page_size)
+      -> u8 *
+  {
+    Mut<u8 *> result = nullptr;
+    for_each_hugetlbfs_mount(page_size, [&](Ref<Path> mount_point) {
+      if (result)
+      {
+        return;
+      }
+
+      const Path file = mount_point / get_hugetlbfs_file_name(name);
+      const int fd = is_owner ? open(file.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0666)
+                              : open(file.c_str(), O_RDWR | O_CLOEXEC);
+      if (fd == -1)
+      {
+        return;
+      }
+
+      // Huge pages are reserved when the mapping is made, so a pool that is too small fails here, not on first touch.
+      const usize mapped_size = round_up_to_page(size, page_size);
+      Mut<void *> addr = MAP_FAILED;
+      Mut<struct stat> sb;
+      const bool is_sized = is_owner ? ftruncate(fd, static_cast<off_t>(mapped_size)) == 0
+                                     : fstat(fd, &sb) == 0 && static_cast<u64>(sb.st_size) >= mapped_size;
+      if (is_sized)
+      {
+        addr = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+      }
+      close(fd);
+
+      if (addr == MAP_FAILED)
+      {
+        if (is_owner)
+        {
+          unlink(file.c_str());
+        }
+        return;
+      }
+
+      Mut<MappingHandles> handles;
+      handles.address = addr;
+      handles.size = mapped_size;
+      s_mapping_registry.insert(static_cast<u8 *>(addr), handles);
+      result = static_cast<u8 *>(addr);
+    });
+    return result;
+  }
+#endif
 
-    const HANDLE handle = static_cast<HANDLE>(std::get<0>(handles));
-    if (handle != INVALID_HANDLE_VALUE)
+  auto FileOps::map_shared_memory(Ref<String> name, const usize size, const bool is_owner, const HugePages huge_pages,
+                                  MutRef<usize> page_size) -> Result<u8 *>
+  {
+#if IA_PLATFORM_WINDOWS
+    const usize large_page_size = GetLargePageMinimum();
+    if (is_owner && large_page_size != 0 && !get_huge_page_candidates(huge_pages).empty())
     {
-      ::CloseHandle(handle);
+      const int wchars_num = MultiByteToWideChar(CP_UTF8, 0, name.c_str(), -1, NULL, 0);
+      Mut<std::wstring> w_name(wchars_num, 0);
+      MultiByteToWideChar(CP_UTF8, 0, name.c_str(), -1, &w_name[0], wchars_num);
+
+      // Needs SeLockMemoryPrivilege, which most processes do not hold.
+      const usize mapped_size = round_up_to_page(size, large_page_size);
+      const HANDLE h_map = CreateFileMappingW(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE | SEC_COMMIT | SEC_LARGE_PAGES,
+                                              (DWORD) (mapped_size >> 32), (DWORD) (mapped_size & 0xFFFFFFFF),
+                                              w_name.c_str());
+      if (h_map != NULL)
+      {
+        Mut<u8 *> result =
+            static_cast<u8 *>(MapViewOfFile(h_map, FILE_MAP_ALL_ACCESS | FILE_MAP_LARGE_PAGES, 0, 0, mapped_size));
+        if (result != NULL)
+        {
+          Mut<MappingHandles> handles;
+          handles.address = result;
+          handles.size = mapped_size;
+          handles.map_handle = h_map;
+          s_mapping_registry.insert(result, handles);
+          page_size = large_page_size;
+          return result;
+        }
+        CloseHandle(h_map);
+      }
     }
-#elif IA_PLATFORM_UNIX
-    ::munmap(std::get<1>(handles), (usize) std::get<2>(handles));
-    const i32 fd = (i32) ((u64) std::get<0>(handles));
-    if (fd != -1)
+#elif IA_PLATFORM_UNIX && defined(__linux__)
+    for (const usize candidate : get_huge_page_candidates(huge_pages))
     {
-      ::close(fd);
+      Mut<u8 *> result = map_hugetlbfs_segment(name, size, is_owner, candidate);
+      if (result)
+      {
+        page_size = candidate;
+        return result;
+      }
     }
 #endif
+
+    Mut<Result<u8 *>> result = map_shared_memory(name, size, is_owner);
+    if (result && huge_pages != HugePages::None)
+    {
+      advise_transparent_huge_pages(*result, size);
+    }
+    page_size = get_system_page_size();
+    return result;
   }
 
   auto FileOps::map_shared_memory(Ref<String> name, const usize size, const bool is_owner) -> Result<u8 *>
@@ -89,7 +352,11 @@ namespace ia
       return fail("Failed to map view of shared memory '{}'", name);
     }
 
-    s_mapped_files[result] = std::make_tuple((void *) INVALID_HANDLE_VALUE, (void *) result, (void *) h_map);
+    Mut<MappingHandles> handles;
+    handles.address = result;
+    handles.size = size;
+    handles.map_handle = h_map;
+    s_mapping_registry.insert(result, handles);
     return result;
 
 #elif IA_PLATFORM_UNIX
@@ -117,16 +384,36 @@ namespace ia
       return fail("Failed to {} shared memory '{}'", is_owner ? "owner" : "consumer", name);
     }
 
+    // The owner may not have sized the segment yet, and touching pages past its end raises SIGBUS.
+    if (!is_owner)
+    {
+      Mut<struct stat> sb;
+      if (fstat(fd, &sb) == -1)
+      {
+        const int error = errno;
+        close(fd);
+        return fail("Failed to get the size of shared memory '{}': {}", name, error);
+      }
+      if (static_cast<u64>(sb.st_size) < size)
+      {
+        close(fd);
+        return fail("Shared memory '{}' holds {} bytes, expected at least {}", name, sb.st_size, size);
+      }
+    }
+
     Mut<void *> addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
     if (addr == MAP_FAILED)
     {
-      close(fd);
       return fail("Failed to mmap shared memory '{}'", name);
     }
 
     Mut<u8 *> result = static_cast<u8 *>(addr);
 
-    s_mapped_files[result] = std::make_tuple((void *) ((u64) fd), (void *) addr, (void *) size);
+    Mut<MappingHandles> handles;
+    handles.address = addr;
+    handles.size = size;
+    s_mapping_registry.insert(result, handles);
     return result;
 #endif
   }
@@ -139,14 +426,176 @@ namespace ia
     }
 #if IA_PLATFORM_UNIX
     shm_unlink(name.c_str());
+#  if defined(__linux__)
+    for_each_hugetlbfs_mount(0, [&name](Ref<Path> mount_point) {
+      unlink((mount_point / get_hugetlbfs_file_name(name)).c_str());
+    });
+#  endif
 #endif
   }
 
-  auto FileOps::map_file(Ref<Path> path, MutRef<usize> size) -> Result<const u8 *>
+  auto FileOps::get_huge_page_backed_size(const void *address, const usize size) -> usize
+  {
+#if IA_PLATFORM_UNIX && defined(__linux__)
+    const Result<String> smaps = read_text_file("/proc/self/smaps");
+    if (!smaps)
+    {
+      return 0;
+    }
+
+    const uintptr_t begin = reinterpret_cast<uintptr_t>(address);
+    const uintptr_t end = begin + size;
+    Mut<bool> in_range = false;
+    Mut<usize> total_kib = 0;
+
+    // Each mapping starts with a "<start>-<end> perms ..." line, followed by "Field:   <n> kB" lines.
+    LineIterator::for_each_line(*smaps, [&](const StringView line) {
+      const char first = line.front();
+      if ((first >= '0' && first <= '9') || (first >= 'a' && first <= 'f'))
+      {
+        Mut<uintptr_t> vma_begin = 0;
+        Mut<uintptr_t> vma_end = 0;
+        const std::from_chars_result parsed = std::from_chars(line.data(), line.data() + line.size(), vma_begin, 16);
+        std::from_chars(parsed.ptr + 1, line.data() + line.size(), vma_end, 16);
+        in_range = vma_begin < end && vma_end > begin;
+        return;
+      }
+
+      if (!in_range)
+      {
+        return;
+      }
+      for (const StringView field : {"AnonHugePages:", "ShmemPmdMapped:", "FilePmdMapped:", "Shared_Hugetlb:",
+                                     "Private_Hugetlb:"})
+      {
+        if (line.starts_with(field))
+        {
+          const usize value_start = line.find_first_not_of(' ', field.size());
+          Mut<usize> value = 0;
+          if (value_start != StringView::npos)
+          {
+            std::from_chars(line.data() + value_start, line.data() + line.size(), value);
+          }
+          total_kib += value;
+        }
+      }
+    });
+    return std::min(total_kib * 1024, size);
+#else
+    AU_UNUSED(address);
+    AU_UNUSED(size);
+    return 0;
+#endif
+  }
+
+  // madvise and friends work on whole pages, so round the start down and the end up.
+  static auto widen_to_pages(const void *address, const usize size) -> std::pair<void *, usize>
+  {
+    const uintptr_t page_size = FileOps::get_system_page_size();
+    const uintptr_t begin = reinterpret_cast<uintptr_t>(address) / page_size * page_size;
+    const uintptr_t end = reinterpret_cast<uintptr_t>(address) + size;
+    return {reinterpret_cast<void *>(begin), static_cast<usize>(end - begin)};
+  }
+
+  static auto apply_access_hint(const void *address, const usize size, const FileOps::AccessHint hint) -> void
+  {
+    if (size == 0)
+    {
+      return;
+    }
+    const auto [begin, length] = widen_to_pages(address, size);
+
+#if IA_PLATFORM_WINDOWS
+    // Windows has no per-range read-ahead policy. Prefetching is the one hint with an equivalent.
+    if (hint == FileOps::AccessHint::WillNeed)
+    {
+      Mut<WIN32_MEMORY_RANGE_ENTRY> entry;
+      entry.VirtualAddress = begin;
+      entry.NumberOfBytes = length;
+      PrefetchVirtualMemory(GetCurrentProcess(), 1, &entry, 0);
+    }
+#elif IA_PLATFORM_UNIX
+    Mut<int> advice = MADV_NORMAL;
+    switch (hint)
+    {
+    case FileOps::AccessHint::Normal:
+      advice = MADV_NORMAL;
+      break;
+    case FileOps::AccessHint::Sequential:
+      advice = MADV_SEQUENTIAL;
+      break;
+    case FileOps::AccessHint::Random:
+      advice = MADV_RANDOM;
+      break;
+    case FileOps::AccessHint::WillNeed:
+      advice = MADV_WILLNEED;
+      break;
+    case FileOps::AccessHint::DontNeed:
+      advice = MADV_DONTNEED;
+      break;
+    }
+    madvise(begin, length, advice);
+#endif
+  }
+
+  // Returns whether the pages ended up locked.
+  static auto prefault_range(Mut<void *> address, const usize size, const FileOps::Prefault prefault) -> bool
+  {
+    if (prefault == FileOps::Prefault::None)
+    {
+      return false;
+    }
+
+    if (prefault == FileOps::Prefault::Lock)
+    {
+#if IA_PLATFORM_WINDOWS
+      if (VirtualLock(address, size))
+      {
+        return true;
+      }
+#elif IA_PLATFORM_UNIX
+      // Locking faults every page in as well. Without privileges it is capped by RLIMIT_MEMLOCK.
+      if (mlock(address, size) == 0)
+      {
+        return true;
+      }
+#endif
+    }
+
+#if IA_PLATFORM_UNIX && defined(MADV_POPULATE_READ)
+    // Linux 5.14 and later fault the whole range in with one call.
+    if (madvise(address, size, MADV_POPULATE_READ) == 0)
+    {
+      return false;
+    }
+#endif
+
+    apply_access_hint(address, size, FileOps::AccessHint::WillNeed);
+    const usize page_size = FileOps::get_system_page_size();
+    const volatile u8 *bytes = static_cast<const volatile u8 *>(address);
+    for (Mut<usize> offset = 0; offset < size; offset += page_size)
+    {
+      (void) bytes[offset];
+    }
+    return false;
+  }
+
+  // Clamps a region-relative range to the region.
+  static auto clamp_range(const usize region_size, const usize offset, const usize size) -> usize
+  {
+    return offset >= region_size ? 0 : std::min(size, region_size - offset);
+  }
+
+  // Maps the whole file read-only.
+  static auto map_whole_file(Ref<Path> path, const FileOps::AccessHint hint, const FileOps::Prefault prefault,
+                             MutRef<MappingHandles> handles, MutRef<bool> is_locked) -> Result<void>
   {
 #if IA_PLATFORM_WINDOWS
+    const DWORD access_flag = hint == FileOps::AccessHint::Random       ? FILE_FLAG_RANDOM_ACCESS
+                              : hint == FileOps::AccessHint::Sequential ? FILE_FLAG_SEQUENTIAL_SCAN
+                                                                        : 0;
     const HANDLE handle = CreateFileA(path.string().c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
-                                      FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+                                      FILE_ATTRIBUTE_NORMAL | access_flag, NULL);
 
     if (handle == INVALID_HANDLE_VALUE)
     {
@@ -159,7 +608,7 @@ namespace ia
       CloseHandle(handle);
       return fail("Failed to get size of {} for memory mapping", path.string());
     }
-    size = static_cast<usize>(file_size.QuadPart);
+    const usize size = static_cast<usize>(file_size.QuadPart);
     if (size == 0)
     {
       CloseHandle(handle);
@@ -173,18 +622,21 @@ namespace ia
       return fail("Failed to memory map {}", path.string());
     }
 
-    const u8 *result = static_cast<const u8 *>(MapViewOfFile(h_map, FILE_MAP_READ, 0, 0, 0));
-    if (result == NULL)
+    Mut<void *> addr = MapViewOfFile(h_map, FILE_MAP_READ, 0, 0, 0);
+    if (addr == NULL)
     {
       CloseHandle(handle);
       CloseHandle(h_map);
       return fail("Failed to memory map {}", path.string());
     }
-    s_mapped_files[result] = std::make_tuple((void *) handle, (void *) const_cast<u8 *>(result), (void *) h_map);
-    return result;
+
+    handles.address = addr;
+    handles.size = size;
+    handles.file_handle = handle;
+    handles.map_handle = h_map;
 
 #elif IA_PLATFORM_UNIX
-    const int handle = open(path.string().c_str(), O_RDONLY);
+    const int handle = open(path.string().c_str(), O_RDONLY | O_CLOEXEC);
     if (handle == -1)
     {
       return fail("Failed to open {} for memory mapping", path.string());
@@ -195,88 +647,132 @@ namespace ia
       close(handle);
       return fail("Failed to get stats of {} for memory mapping", path.string());
     }
-    size = static_cast<usize>(sb.st_size);
+    const usize size = static_cast<usize>(sb.st_size);
     if (size == 0)
     {
       close(handle);
       return fail("Failed to get size of {} for memory mapping", path.string());
     }
     Mut<void *> addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, handle, 0);
+    close(handle);
     if (addr == MAP_FAILED)
     {
-      close(handle);
       return fail("Failed to memory map {}", path.string());
     }
-    const auto result = static_cast<const u8 *>(addr);
-    madvise(addr, size, MADV_SEQUENTIAL);
-    s_mapped_files[result] = std::make_tuple((void *) ((u64) handle), (void *) addr, (void *) size);
-    return result;
+
+    handles.address = addr;
+    handles.size = size;
 #endif
+
+    apply_access_hint(addr, size, hint);
+    is_locked = prefault_range(addr, size, prefault);
+    return {};
+  }
+
+  auto FileOps::map_file(Ref<Path> path, MutRef<usize> size) -> Result<const u8 *>
+  {
+    return map_file(path, size, AccessHint::Sequential);
   }
 
-  auto FileOps::read_text_file(Ref<Path> path) -> Result<String>
+  auto FileOps::map_file(Ref<Path> path, MutRef<usize> size, const AccessHint hint, const Prefault prefault)
+      -> Result<const u8 *>
   {
-    Mut<FILE *> f = fopen(path.string().c_str(), "r");
-    if (!f)
+    Mut<MappingHandles> handles;
+    Mut<bool> is_locked = false;
+    Mut<Result<void>> mapped = map_whole_file(path, hint, prefault, handles, is_locked);
+    if (!mapped)
     {
-      return fail("Failed to open file: {}", path.string());
+      return fail(std::move(mapped.error()));
     }
-    Mut<String> result;
-    fseek(f, 0, SEEK_END);
-    const long len = ftell(f);
-    if (len > 0)
+
+    const u8 *result = static_cast<const u8 *>(handles.address);
+    size = handles.size;
+    s_mapping_registry.insert(result, handles);
+    return result;
+  }
+
+  auto FileOps::advise_range(const void *address, const usize size, const AccessHint hint) -> void
+  {
+    apply_access_hint(address, size, hint);
+  }
+
+  auto FileOps::prefetch_range(const void *address, const usize size) -> void
+  {
+    apply_access_hint(address, size, AccessHint::WillNeed);
+  }
+
+  // Sizes the buffer without zero-filling where the standard library allows it. Vec<u8> has no such
+  // facility, so it is still value-initialized.
+  template<typename Buffer> static auto resize_for_overwrite(MutRef<Buffer> buffer, const usize size) -> void
+  {
+#if defined(__cpp_lib_string_resize_and_overwrite)
+    if constexpr (std::is_same_v<Buffer, String>)
     {
-      result.resize(static_cast<usize>(len));
-      fseek(f, 0, SEEK_SET);
-      const usize read_length = fread(result.data(), 1, result.size(), f);
-      result.resize(read_length);
+      buffer.resize_and_overwrite(size, [](char *, const usize length) { return length; });
+      return;
     }
-    fclose(f);
-    return result;
+#endif
+    buffer.resize(size);
   }
 
-  auto FileOps::read_binary_file(Ref<Path> path) -> Result<Vec<u8>>
+  // Size of the first read, and of each growth step, for files whose size is not known up front.
+  static constexpr const usize UNKNOWN_SIZE_READ_CHUNK = 64 * 1024;
+
+  static auto open_for_reading(Ref<Path> path, const bool no_access_time) -> Result<NativeFileHandle>
   {
-    Mut<FILE *> f = fopen(path.string().c_str(), "rb");
-    if (!f)
+#if IA_PLATFORM_WINDOWS
+    AU_UNUSED(no_access_time);
+
+    const HANDLE handle = CreateFileA(path.string().c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL,
+                                      OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (handle == INVALID_HANDLE_VALUE)
     {
       return fail("Failed to open file: {}", path.string());
     }
-    Mut<Vec<u8>> result;
-    fseek(f, 0, SEEK_END);
-    const long len = ftell(f);
-    if (len > 0)
+    return handle;
+
+#elif IA_PLATFORM_UNIX
+    const int flags = O_RDONLY | O_CLOEXEC;
+    Mut<int> fd = -1;
+#  if defined(O_NOATIME)
+    if (no_access_time)
     {
-      result.resize(static_cast<usize>(len));
-      fseek(f, 0, SEEK_SET);
-      fread(result.data(), 1, result.size(), f);
+      // Only the owner (or CAP_FOWNER) may use O_NOATIME; everyone else falls back to a plain open.
+      fd = open(path.string().c_str(), flags | O_NOATIME);
     }
-    fclose(f);
-    return result;
+#  else
+    AU_UNUSED(no_access_time);
+#  endif
+    if (fd == -1)
+    {
+      fd = open(path.string().c_str(), flags);
+    }
+    if (fd == -1)
+    {
+      return fail("Failed to open file: {}", path.string());
+    }
+    return fd;
+#endif
   }
 
-  auto FileOps::write_text_file(Ref<Path> path, Ref<String> contents, const bool overwrite) -> Result<usize>
+  static auto open_for_writing(Ref<Path> path, const bool overwrite) -> Result<NativeFileHandle>
   {
-    const char *mode = overwrite ? "w" : "wx";
-    Mut<FILE *> f = fopen(path.string().c_str(), mode);
-    if (!f)
+#if IA_PLATFORM_WINDOWS
+    const HANDLE handle = CreateFileA(path.string().c_str(), GENERIC_WRITE, FILE_SHARE_READ, NULL,
+                                      overwrite ? CREATE_ALWAYS : CREATE_NEW, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (handle == INVALID_HANDLE_VALUE)
     {
-      if (!overwrite && errno == EEXIST)
+      if (!overwrite && GetLastError() == ERROR_FILE_EXISTS)
       {
         return fail("File already exists: {}", path.string());
       }
       return fail("Failed to write to file: {}", path.string());
     }
-    const usize result = fwrite(contents.data(), 1, contents.size(), f);
-    fclose(f);
-    return result;
-  }
+    return handle;
 
-  auto FileOps::write_binary_file(Ref<Path> path, const Span<const u8> contents, const bool overwrite) -> Result<usize>
-  {
-    const char *mode = overwrite ? "w" : "wx";
-    Mut<FILE *> f = fopen(path.string().c_str(), mode);
-    if (!f)
+#elif IA_PLATFORM_UNIX
+    const int fd = open(path.string().c_str(), O_WRONLY | O_CREAT | O_CLOEXEC | (overwrite ? O_TRUNC : O_EXCL), 0666);
+    if (fd == -1)
     {
       if (!overwrite && errno == EEXIST)
       {
@@ -284,149 +780,1617 @@ namespace ia
       }
       return fail("Failed to write to file: {}", path.string());
     }
-    const usize result = fwrite(contents.data(), 1, contents.size(), f);
-    fclose(f);
-    return result;
+    return fd;
+#endif
   }
 
-  auto FileOps::normalize_executable_path(Ref<Path> path) -> Path
+  // Returns 0 where the size cannot be trusted, such as for pseudo files in /proc that report zero.
+  static auto get_regular_file_size(const NativeFileHandle handle) -> usize
   {
-    Mut<Path> result = path;
-
 #if IA_PLATFORM_WINDOWS
-    if (!result.has_extension())
+    Mut<LARGE_INTEGER> file_size;
+    if (GetFileType(handle) != FILE_TYPE_DISK || !GetFileSizeEx(handle, &file_size))
     {
-      result.replace_extension(".exe");
+      return 0;
     }
+    return static_cast<usize>(file_size.QuadPart);
 #elif IA_PLATFORM_UNIX
-    if (result.extension() == ".exe")
+    Mut<struct stat> sb;
+    if (fstat(handle, &sb) == -1 || !S_ISREG(sb.st_mode))
     {
-      result.replace_extension("");
+      return 0;
     }
+    return static_cast<usize>(sb.st_size);
+#endif
+  }
 
-    if (result.is_relative())
+  // Reads from `offset` until `size` bytes are in or the file ends, and returns the count.
+  static auto read_fully_at(const NativeFileHandle handle, Mut<u8 *> buffer, const usize size, const u64 offset)
+      -> Result<usize>
+  {
+    Mut<usize> filled = 0;
+    while (filled < size)
+    {
+#if IA_PLATFORM_WINDOWS
+      Mut<OVERLAPPED> overlapped{};
+      overlapped.Offset = static_cast<DWORD>((offset + filled) & 0xFFFFFFFF);
+      overlapped.OffsetHigh = static_cast<DWORD>((offset + filled) >> 32);
+
+      const DWORD chunk = static_cast<DWORD>(std::min<usize>(size - filled, MAXDWORD));
+      Mut<DWORD> read_length = 0;
+      if (!ReadFile(handle, buffer + filled, chunk, &read_length, &overlapped))
+      {
+        if (GetLastError() == ERROR_HANDLE_EOF)
+        {
+          break;
+        }
+        return fail("{}", GetLastError());
+      }
+#elif IA_PLATFORM_UNIX
+      const isize read_length = pread(handle, buffer + filled, size - filled, static_cast<off_t>(offset + filled));
+      if (read_length < 0)
+      {
+        if (errno == EINTR)
+        {
+          continue;
+        }
+        return fail("{}", errno);
+      }
+#endif
+      if (read_length == 0)
+      {
+        break;
+      }
+      filled += static_cast<usize>(read_length);
+    }
+    return filled;
+  }
+
+#if IA_PLATFORM_WINDOWS
+  // Writes every byte at `offset`, resuming after partial writes, and returns the count.
+  static auto write_fully_at(const NativeFileHandle handle, const Span<const u8> data, const u64 offset)
+      -> Result<usize>
+  {
+    Mut<usize> written = 0;
+    while (written < data.size())
+    {
+      Mut<OVERLAPPED> overlapped{};
+      overlapped.Offset = static_cast<DWORD>((offset + written) & 0xFFFFFFFF);
+      overlapped.OffsetHigh = static_cast<DWORD>((offset + written) >> 32);
+
+      const DWORD chunk = static_cast<DWORD>(std::min<usize>(data.size() - written, MAXDWORD));
+      Mut<DWORD> write_length = 0;
+      if (!WriteFile(handle, data.data() + written, chunk, &write_length, &overlapped))
+      {
+        return fail("{}", GetLastError());
+      }
+      if (write_length == 0)
+      {
+        return fail("Write made no progress after {} of {} bytes", written, data.size());
+      }
+      written += write_length;
+    }
+    return written;
+  }
+
+#elif IA_PLATFORM_UNIX
+  // IOV_MAX on Linux and the BSDs. Longer part lists are split across several calls.
+  static constexpr const usize MAX_IO_VECTORS = 1024;
+
+  // Moves `parts` to or from the file at `offset` with preadv/pwritev, resuming wherever a call stopped short.
+  // Pipes, FIFOs and sockets cannot be positioned, so those fall back to readv/writev and ignore `offset`.
+  template<bool IS_READ, typename Byte>
+  static auto transfer_vectored(const NativeFileHandle handle, const Span<const Span<Byte>> parts, const u64 offset)
+      -> Result<usize>
+  {
+    Mut<Array<iovec, MAX_IO_VECTORS>> vectors;
+    Mut<usize> total = 0;
+    Mut<usize> part_index = 0;
+    Mut<usize> part_offset = 0;
+    Mut<bool> is_seekable = true;
+
+    while (true)
+    {
+      Mut<int> vector_count = 0;
+      for (Mut<usize> i = part_index; i < parts.size() && vector_count < static_cast<int>(vectors.size()); ++i)
+      {
+        const usize skip = i == part_index ? part_offset : 0;
+        if (parts[i].size() > skip)
+        {
+          vectors[vector_count].iov_base = const_cast<u8 *>(parts[i].data()) + skip;
+          vectors[vector_count].iov_len = parts[i].size() - skip;
+          ++vector_count;
+        }
+      }
+      if (vector_count == 0)
+      {
+        break;
+      }
+
+      const off_t position = static_cast<off_t>(offset + total);
+      Mut<isize> transferred = 0;
+      if (is_seekable)
+      {
+        transferred = IS_READ ? preadv(handle, vectors.data(), vector_count, position)
+                              : pwritev(handle, vectors.data(), vector_count, position);
+      }
+      else
+      {
+        transferred =
+            IS_READ ? readv(handle, vectors.data(), vector_count) : writev(handle, vectors.data(), vector_count);
+      }
+      if (transferred < 0)
+      {
+        if (errno == EINTR)
+        {
+          continue;
+        }
+        if (errno == ESPIPE && is_seekable)
+        {
+          is_seekable = false;
+          continue;
+        }
+        return fail("{}", errno);
+      }
+      if (transferred == 0)
+      {
+        if (IS_READ)
+        {
+          break;
+        }
+        // Retrying a write that makes no progress would spin forever.
+        return fail("Write made no progress after {} bytes", total);
+      }
+      total += static_cast<usize>(transferred);
+
+      Mut<usize> remaining = static_cast<usize>(transferred);
+      while (part_index < parts.size())
+      {
+        const usize left = parts[part_index].size() - part_offset;
+        if (remaining < left)
+        {
+          part_offset += remaining;
+          break;
+        }
+        remaining -= left;
+        ++part_index;
+        part_offset = 0;
+      }
+    }
+    return total;
+  }
+#endif
+
+  static auto gather_write_at(const NativeFileHandle handle, const Span<const Span<const u8>> parts, const u64 offset)
+      -> Result<usize>
+  {
+#if IA_PLATFORM_WINDOWS
+    Mut<usize> total = 0;
+    for (const Span<const u8> part : parts)
+    {
+      Mut<Result<usize>> written = write_fully_at(handle, part, offset + total);
+      if (!written)
+      {
+        return fail(std::move(written.error()));
+      }
+      total += *written;
+    }
+    return total;
+#elif IA_PLATFORM_UNIX
+    return transfer_vectored<false>(handle, parts, offset);
+#endif
+  }
+
+  static auto scatter_read_at(const NativeFileHandle handle, const Span<const Span<u8>> parts, const u64 offset)
+      -> Result<usize>
+  {
+#if IA_PLATFORM_WINDOWS
+    Mut<usize> total = 0;
+    for (const Span<u8> part : parts)
+    {
+      Mut<Result<usize>> read_length = read_fully_at(handle, part.data(), part.size(), offset + total);
+      if (!read_length)
+      {
+        return fail(std::move(read_length.error()));
+      }
+      total += *read_length;
+      if (*read_length < part.size())
+      {
+        break;
+      }
+    }
+    return total;
+#elif IA_PLATFORM_UNIX
+    return transfer_vectored<true>(handle, parts, offset);
+#endif
+  }
+
+  static auto copy_from_mapping(const NativeFileHandle handle, const usize size, Mut<u8 *> destination) -> bool
+  {
+#if IA_PLATFORM_WINDOWS
+    const HANDLE h_map = CreateFileMappingW(handle, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (h_map == NULL)
+    {
+      return false;
+    }
+    Mut<const void *> view = MapViewOfFile(h_map, FILE_MAP_READ, 0, 0, 0);
+    if (view)
+    {
+      std::memcpy(destination, view, size);
+      UnmapViewOfFile(view);
+    }
+    CloseHandle(h_map);
+    return view != nullptr;
+#elif IA_PLATFORM_UNIX
+    Mut<void *> addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, handle, 0);
+    if (addr == MAP_FAILED)
+    {
+      return false;
+    }
+    madvise(addr, size, MADV_SEQUENTIAL);
+    std::memcpy(destination, addr, size);
+    munmap(addr, size);
+    return true;
+#endif
+  }
+
+  // Replaces the contents of `out` with the whole file, reusing its capacity.
+  template<typename Buffer>
+  static auto read_whole_file(Ref<Path> path, const bool no_access_time, MutRef<Buffer> out) -> Result<usize>
+  {
+    Mut<Result<NativeFileHandle>> handle = open_for_reading(path, no_access_time);
+    if (!handle)
+    {
+      return fail(std::move(handle.error()));
+    }
+
+    const usize known_size = get_regular_file_size(*handle);
+    if (known_size >= FileOps::MAPPED_READ_THRESHOLD)
+    {
+      resize_for_overwrite(out, known_size);
+      if (copy_from_mapping(*handle, known_size, reinterpret_cast<u8 *>(out.data())))
+      {
+        FileOps::native_close_file(*handle);
+        return known_size;
+      }
+    }
+
+    Mut<usize> capacity = known_size > 0 ? known_size : UNKNOWN_SIZE_READ_CHUNK;
+    Mut<usize> filled = 0;
+    while (true)
+    {
+      resize_for_overwrite(out, capacity);
+      Mut<Result<usize>> read_length =
+          read_fully_at(*handle, reinterpret_cast<u8 *>(out.data()) + filled, capacity - filled, filled);
+      if (!read_length)
+      {
+        FileOps::native_close_file(*handle);
+        return fail("Failed to read file '{}': {}", path.string(), read_length.error());
+      }
+      filled += *read_length;
+
+      // A regular file is done once its reported size is in; skip the extra read that would confirm EOF.
+      if (filled < capacity || known_size > 0)
+      {
+        break;
+      }
+      capacity *= 2;
+    }
+
+    out.resize(filled);
+    FileOps::native_close_file(*handle);
+    return filled;
+  }
+
+  auto FileOps::read_text_file(Ref<Path> path, const bool no_access_time) -> Result<String>
+  {
+    Mut<String> result;
+    Mut<Result<usize>> read = read_whole_file(path, no_access_time, result);
+    if (!read)
+    {
+      return fail(std::move(read.error()));
+    }
+
+#if IA_PLATFORM_WINDOWS
+    // Keep the CRLF translation the text-mode stdio reader used to apply.
+    Mut<usize> write_index = 0;
+    for (Mut<usize> i = 0; i < result.size(); ++i)
+    {
+      if (result[i] == '\r' && i + 1 < result.size() && result[i + 1] == '\n')
+      {
+        continue;
+      }
+      result[write_index++] = result[i];
+    }
+    result.resize(write_index);
+#endif
+    return result;
+  }
+
+  auto FileOps::read_binary_file(Ref<Path> path, const bool no_access_time) -> Result<Vec<u8>>
+  {
+    Mut<Vec<u8>> result;
+    Mut<Result<usize>> read = read_whole_file(path, no_access_time, result);
+    if (!read)
+    {
+      return fail(std::move(read.error()));
+    }
+    return result;
+  }
+
+  auto FileOps::read_into(Ref<Path> path, MutRef<Vec<u8>> buffer, const bool no_access_time) -> Result<usize>
+  {
+    return read_whole_file(path, no_access_time, buffer);
+  }
+
+  auto FileOps::read_into(Ref<Path> path, MutRef<String> buffer, const bool no_access_time) -> Result<usize>
+  {
+    return read_whole_file(path, no_access_time, buffer);
+  }
+
+  auto FileOps::read_into(Ref<Path> path, const Span<u8> buffer, const bool no_access_time) -> Result<usize>
+  {
+    Mut<Result<NativeFileHandle>> handle = open_for_reading(path, no_access_time);
+    if (!handle)
+    {
+      return fail(std::move(handle.error()));
+    }
+
+    Mut<Result<usize>> read_length = read_fully_at(*handle, buffer.data(), buffer.size(), 0);
+    native_close_file(*handle);
+    if (!read_length)
+    {
+      return fail("Failed to read file '{}': {}", path.string(), read_length.error());
+    }
+    return read_length;
+  }
+
+  auto FileOps::write_from(Ref<Path> path, const Span<const Span<const u8>> parts, const bool overwrite)
+      -> Result<usize>
+  {
+    return write_gather(path, parts, overwrite);
+  }
+
+  auto FileOps::write_gather(Ref<Path> path, const Span<const Span<const u8>> parts, const bool overwrite)
+      -> Result<usize>
+  {
+    Mut<Result<NativeFileHandle>> handle = open_for_writing(path, overwrite);
+    if (!handle)
+    {
+      return fail(std::move(handle.error()));
+    }
+
+    Mut<Result<usize>> written = gather_write_at(*handle, parts, 0);
+    native_close_file(*handle);
+    if (!written)
+    {
+      return fail("Failed to write to file '{}': {}", path.string(), written.error());
+    }
+    return written;
+  }
+
+  auto FileOps::write_gather(const NativeFileHandle handle, const Span<const Span<const u8>> parts, const u64 offset)
+      -> Result<usize>
+  {
+    Mut<Result<usize>> written = gather_write_at(handle, parts, offset);
+    if (!written)
+    {
+      return fail("Failed to write at offset {}: {}", offset, written.error());
+    }
+    return written;
+  }
+
+  auto FileOps::read_scatter(Ref<Path> path, const Span<const Span<u8>> parts, const bool no_access_time)
+      -> Result<usize>
+  {
+    Mut<Result<NativeFileHandle>> handle = open_for_reading(path, no_access_time);
+    if (!handle)
+    {
+      return fail(std::move(handle.error()));
+    }
+
+    Mut<Result<usize>> read_length = scatter_read_at(*handle, parts, 0);
+    native_close_file(*handle);
+    if (!read_length)
+    {
+      return fail("Failed to read file '{}': {}", path.string(), read_length.error());
+    }
+    return read_length;
+  }
+
+  auto FileOps::read_scatter(const NativeFileHandle handle, const Span<const Span<u8>> parts, const u64 offset)
+      -> Result<usize>
+  {
+    Mut<Result<usize>> read_length = scatter_read_at(handle, parts, offset);
+    if (!read_length)
+    {
+      return fail("Failed to read at offset {}: {}", offset, read_length.error());
+    }
+    return read_length;
+  }
+
+  auto FileOps::write_text_file(Ref<Path> path, Ref<String> contents, const bool overwrite) -> Result<usize>
+  {
+    const char *mode = overwrite ? "w" : "wx";
+    Mut<FILE *> f = fopen(path.string().c_str(), mode);
+    if (!f)
+    {
+      if (!overwrite && errno == EEXIST)
+      {
+        return fail("File already exists: {}", path.string());
+      }
+      return fail("Failed to write to file: {}", path.string());
+    }
+    const usize result = fwrite(contents.data(), 1, contents.size(), f);
+    fclose(f);
+    return result;
+  }
+
+  auto FileOps::write_binary_file(Ref<Path> path, const Span<const u8> contents, const bool overwrite) -> Result<usize>
+  {
+    return write_from(path, Span<const Span<const u8>>(&contents, 1), overwrite);
+  }
+
+#if IA_PLATFORM_UNIX
+  // Buffer size for the buffered fallback.
+  static constexpr const usize COPY_CHUNK_SIZE = 1024 * 1024;
+
+  // The most one in-kernel copy call is asked to move, so a huge file is copied in interruptible steps.
+  static constexpr const usize MAX_KERNEL_COPY_SIZE = 1024 * 1024 * 1024;
+
+  // Copies [offset, offset + size) to the same offset, moving `method` down the list whenever the current one
+  // turns out to be unsupported for this pair of files.
+  static auto copy_byte_range(const int source, const int destination, const u64 offset, const u64 size,
+                              MutRef<FileOps::CopyMethod> method, MutRef<Vec<u8>> buffer) -> Result<void>
+  {
+    Mut<u64> copied = 0;
+
+#  if defined(__linux__)
+    while (copied < size && method == FileOps::CopyMethod::CopyRange)
+    {
+      Mut<off_t> source_offset = static_cast<off_t>(offset + copied);
+      Mut<off_t> destination_offset = source_offset;
+      const isize result = copy_file_range(source, &source_offset, destination, &destination_offset,
+                                           std::min<u64>(size - copied, MAX_KERNEL_COPY_SIZE), 0);
+      if (result > 0)
+      {
+        copied += static_cast<u64>(result);
+      }
+      else if (result == 0)
+      {
+        return fail("Source file shrank during the copy");
+      }
+      else if (errno == EXDEV || errno == EINVAL || errno == ENOSYS || errno == EOPNOTSUPP)
+      {
+        method = FileOps::CopyMethod::SendFile;
+      }
+      else if (errno != EINTR)
+      {
+        return fail("copy_file_range failed: {}", errno);
+      }
+    }
+
+    // sendfile writes at the destination's file position.
+    if (copied < size && method == FileOps::CopyMethod::SendFile &&
+        lseek(destination, static_cast<off_t>(offset + copied), SEEK_SET) == -1)
+    {
+      method = FileOps::CopyMethod::Buffered;
+    }
+    while (copied < size && method == FileOps::CopyMethod::SendFile)
+    {
+      Mut<off_t> source_offset = static_cast<off_t>(offset + copied);
+      const isize result =
+          sendfile(destination, source, &source_offset, std::min<u64>(size - copied, MAX_KERNEL_COPY_SIZE));
+      if (result > 0)
+      {
+        copied += static_cast<u64>(result);
+      }
+      else if (result == 0)
+      {
+        return fail("Source file shrank during the copy");
+      }
+      else if (errno == EINVAL || errno == ENOSYS)
+      {
+        method = FileOps::CopyMethod::Buffered;
+      }
+      else if (errno != EINTR)
+      {
+        return fail("sendfile failed: {}", errno);
+      }
+    }
+#  endif
+
+    if (copied < size)
+    {
+      method = FileOps::CopyMethod::Buffered;
+      buffer.resize(COPY_CHUNK_SIZE);
+    }
+    while (copied < size)
+    {
+      const usize chunk = static_cast<usize>(std::min<u64>(size - copied, buffer.size()));
+      Mut<Result<usize>> read = read_fully_at(source, buffer.data(), chunk, offset + copied);
+      if (!read)
+      {
+        return fail("Failed to read source file: {}", read.error());
+      }
+      if (*read == 0)
+      {
+        return fail("Source file shrank during the copy");
+      }
+
+      Mut<usize> written = 0;
+      while (written < *read)
+      {
+        const isize result = pwrite(destination, buffer.data() + written, *read - written,
+                                    static_cast<off_t>(offset + copied + written));
+        if (result < 0)
+        {
+          if (errno == EINTR)
+          {
+            continue;
+          }
+          return fail("Failed to write destination file: {}", errno);
+        }
+        written += static_cast<usize>(result);
+      }
+      copied += *read;
+    }
+    return {};
+  }
+
+  // Copies every byte range of the source that holds data, or the whole file if holes are not to be kept or
+  // cannot be found. The destination is already `size` bytes long, so skipped ranges stay holes.
+  static auto copy_file_data(const int source, const int destination, const u64 size, const bool preserve_holes,
+                             MutRef<FileOps::CopyMethod> method) -> Result<void>
+  {
+    Mut<Vec<u8>> buffer;
+    Mut<bool> can_find_holes = preserve_holes;
+    Mut<u64> offset = 0;
+    while (offset < size)
+    {
+      Mut<u64> data_start = offset;
+      Mut<u64> data_end = size;
+#  if defined(SEEK_DATA) && defined(SEEK_HOLE)
+      if (can_find_holes)
+      {
+        const off_t data = lseek(source, static_cast<off_t>(offset), SEEK_DATA);
+        if (data == -1 && errno == ENXIO)
+        {
+          // Nothing but a hole up to the end.
+          break;
+        }
+        if (data == -1)
+        {
+          can_find_holes = false;
+        }
+        else
+        {
+          const off_t hole = lseek(source, data, SEEK_HOLE);
+          data_start = static_cast<u64>(data);
+          data_end = hole == -1 ? size : std::min<u64>(static_cast<u64>(hole), size);
+        }
+      }
+#  endif
+      if (data_start >= size)
+      {
+        break;
+      }
+
+      Mut<Result<void>> copied =
+          copy_byte_range(source, destination, data_start, data_end - data_start, method, buffer);
+      if (!copied)
+      {
+        return copied;
+      }
+      offset = data_end;
+    }
+    return {};
+  }
+#endif
+
+  auto FileOps::copy_file(Ref<Path> source, Ref<Path> destination) -> Result<CopyResult>
+  {
+    return copy_file(source, destination, CopyOptions{});
+  }
+
+  auto FileOps::copy_file(Ref<Path> source, Ref<Path> destination, Ref<CopyOptions> options) -> Result<CopyResult>
+  {
+#if IA_PLATFORM_WINDOWS
+    // CopyFileExW already uses block cloning and server-side copies where the volume offers them, and keeps
+    // sparse files sparse.
+    if (!CopyFileExW(source.wstring().c_str(), destination.wstring().c_str(), NULL, NULL, NULL,
+                     options.overwrite ? 0 : COPY_FILE_FAIL_IF_EXISTS))
+    {
+      if (!options.overwrite && GetLastError() == ERROR_FILE_EXISTS)
+      {
+        return fail("File already exists: {}", destination.string());
+      }
+      return fail("Failed to copy {} to {}: {}", source.string(), destination.string(), GetLastError());
+    }
+
+    Mut<WIN32_FILE_ATTRIBUTE_DATA> attributes;
+    if (!GetFileAttributesExW(destination.wstring().c_str(), GetFileExInfoStandard, &attributes))
+    {
+      return fail("Failed to get size of {}: {}", destination.string(), GetLastError());
+    }
+    Mut<CopyResult> result;
+    result.size = (static_cast<u64>(attributes.nFileSizeHigh) << 32) | attributes.nFileSizeLow;
+    result.method = CopyMethod::System;
+    return result;
+
+#elif IA_PLATFORM_UNIX
+    Mut<Result<NativeFileHandle>> source_handle = open_for_reading(source, false);
+    if (!source_handle)
+    {
+      return fail(std::move(source_handle.error()));
+    }
+    const int source_fd = *source_handle;
+
+    Mut<struct stat> source_stat;
+    if (fstat(source_fd, &source_stat) == -1 || !S_ISREG(source_stat.st_mode))
+    {
+      close(source_fd);
+      return fail("Not a regular file: {}", source.string());
+    }
+
+    // Opening with O_TRUNC would destroy the source before a single byte was copied.
+    Mut<struct stat> destination_stat;
+    if (stat(destination.string().c_str(), &destination_stat) == 0 && destination_stat.st_dev == source_stat.st_dev &&
+        destination_stat.st_ino == source_stat.st_ino)
+    {
+      close(source_fd);
+      return fail("Cannot copy {} onto itself", source.string());
+    }
+
+    const int destination_fd =
+        open(destination.string().c_str(), O_WRONLY | O_CREAT | O_CLOEXEC | (options.overwrite ? O_TRUNC : O_EXCL),
+             source_stat.st_mode & 0777);
+    if (destination_fd == -1)
+    {
+      const int error = errno;
+      close(source_fd);
+      if (!options.overwrite && error == EEXIST)
+      {
+        return fail("File already exists: {}", destination.string());
+      }
+      return fail("Failed to write to file: {}", destination.string());
+    }
+
+    Mut<CopyResult> result;
+    result.size = static_cast<u64>(source_stat.st_size);
+    result.method = CopyMethod::Buffered;
+
+    Mut<bool> is_cloned = false;
+#  if defined(__linux__) && defined(FICLONE)
+    is_cloned = options.allow_clone && ioctl(destination_fd, FICLONE, source_fd) == 0;
+    result.method = is_cloned ? CopyMethod::Clone : CopyMethod::CopyRange;
+#  endif
+
+    Mut<Result<void>> copied;
+    if (!is_cloned)
+    {
+      if (ftruncate(destination_fd, static_cast<off_t>(result.size)) == -1)
+      {
+        copied = fail("Failed to size {}: {}", destination.string(), errno);
+      }
+      else
+      {
+        copied = copy_file_data(source_fd, destination_fd, result.size, options.preserve_holes, result.method);
+      }
+    }
+
+    close(source_fd);
+    if (close(destination_fd) == -1 && copied)
+    {
+      copied = fail("Failed to close {}: {}", destination.string(), errno);
+    }
+    if (!copied)
+    {
+      unlink(destination.string().c_str());
+      return fail("Failed to copy {} to {}: {}", source.string(), destination.string(), copied.error());
+    }
+    return result;
+#endif
+  }
+
+  // Files per window when load_files spreads its work. Below this, scheduling costs more than it saves.
+  static constexpr const usize LOAD_MIN_WINDOW_SIZE = 32;
+
+  // LoadOrder::Inode keeps a whole window open at once, and large descriptor tables make every open slower.
+  static constexpr const usize LOAD_MAX_OPEN_WINDOW_SIZE = 256;
+
+  // A file load_files has opened and sized.
+  struct OpenedFile
+  {
+    Mut<usize> index = 0;
+    Mut<NativeFileHandle> handle = INVALID_FILE_HANDLE;
+    Mut<u64> size = 0;
+    Mut<u64> device = 0;
+    Mut<u64> inode = 0;
+    Mut<bool> is_sized = false; // A non-empty regular file. Others, such as procfs files, are read until EOF
+  };
+
+  static auto describe_read_failure(Ref<Path> path, Ref<String> reason) -> String
+  {
+    return "Failed to read file '" + path.string() + "': " + reason;
+  }
+
+  // Opens the file and takes its size and identity from the handle, so the path is looked up only once.
+  static auto open_load_file(Ref<Path> path, const usize index, const bool no_access_time) -> Result<OpenedFile>
+  {
+    Mut<Result<NativeFileHandle>> handle = open_for_reading(path, no_access_time);
+    if (!handle)
+    {
+      return fail(std::move(handle.error()));
+    }
+
+    Mut<OpenedFile> file;
+    file.index = index;
+    file.handle = *handle;
+    Mut<String> error;
+#if IA_PLATFORM_WINDOWS
+    Mut<BY_HANDLE_FILE_INFORMATION> info{};
+    if (!GetFileInformationByHandle(file.handle, &info))
+    {
+      error = describe_read_failure(path, "error " + std::to_string(GetLastError()));
+    }
+    else if (info.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+    {
+      error = describe_read_failure(path, "it is a directory");
+    }
+    file.size = (static_cast<u64>(info.nFileSizeHigh) << 32) | info.nFileSizeLow;
+    file.device = info.dwVolumeSerialNumber;
+    file.inode = (static_cast<u64>(info.nFileIndexHigh) << 32) | info.nFileIndexLow;
+    file.is_sized = file.size > 0 && GetFileType(file.handle) == FILE_TYPE_DISK;
+#elif IA_PLATFORM_UNIX
+    Mut<struct stat> info{};
+    if (fstat(file.handle, &info) != 0)
+    {
+      error = describe_read_failure(path, std::strerror(errno));
+    }
+    else if (S_ISDIR(info.st_mode))
+    {
+      error = describe_read_failure(path, "it is a directory");
+    }
+    file.size = static_cast<u64>(info.st_size);
+    file.device = static_cast<u64>(info.st_dev);
+    file.inode = static_cast<u64>(info.st_ino);
+    file.is_sized = S_ISREG(info.st_mode) && file.size > 0;
+#endif
+    if (!error.empty())
+    {
+      FileOps::native_close_file(file.handle);
+      return fail(std::move(error));
+    }
+    return file;
+  }
+
+  // Opens paths[begin, end) and passes each file that opened to `on_opened`, which must close it, and the others
+  // to `on_error`. For LoadOrder::Inode the whole range is opened before the first is passed on, sorted by
+  // (device, inode): filesystems tend to hand out inodes, and place data, in creation order.
+  template<typename OnOpened, typename OnError>
+  static auto open_load_window(const Span<const Path> paths, const usize begin, const usize end,
+                               Ref<FileOps::LoadOptions> options, Mut<OnOpened> on_opened, Mut<OnError> on_error)
+      -> void
+  {
+    Mut<Vec<OpenedFile>> opened;
+    if (options.order == FileOps::LoadOrder::Inode)
+    {
+      opened.reserve(end - begin);
+    }
+
+    for (Mut<usize> index = begin; index < end; ++index)
+    {
+      Mut<Result<OpenedFile>> file = open_load_file(paths[index], index, options.no_access_time);
+      if (!file)
+      {
+        on_error(index, std::move(file.error()));
+      }
+      else if (options.order == FileOps::LoadOrder::Inode)
+      {
+        opened.push_back(*file);
+      }
+      else
+      {
+        on_opened(*file);
+      }
+    }
+
+    std::sort(opened.begin(), opened.end(), [](Ref<OpenedFile> a, Ref<OpenedFile> b) {
+      return std::tie(a.device, a.inode, a.index) < std::tie(b.device, b.inode, b.index);
+    });
+    for (Ref<OpenedFile> file : opened)
+    {
+      on_opened(file);
+    }
+  }
+
+  // A few windows per worker keep them all busy when file sizes vary. Windows that hold all their files open at
+  // once also stay within a slice of the descriptor limit, which is shared with the rest of the process and
+  // with the other windows running at the same time.
+  static auto get_load_window_size(const usize path_count, Ref<FileOps::LoadOptions> options) -> usize
+  {
+    const usize task_count = std::max<usize>(AsyncOps::get_worker_count(), 1);
+    Mut<usize> window_size = std::max<usize>(path_count, 1);
+    if (AsyncOps::get_worker_count() > 0)
+    {
+      window_size = std::max(LOAD_MIN_WINDOW_SIZE, (path_count + task_count * 4 - 1) / (task_count * 4));
+    }
+
+    if (options.order == FileOps::LoadOrder::Inode)
+    {
+      Mut<usize> budget = LOAD_MAX_OPEN_WINDOW_SIZE;
+#if IA_PLATFORM_UNIX
+      Mut<struct rlimit> limit{};
+      if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur != RLIM_INFINITY)
+      {
+        budget = static_cast<usize>(limit.rlim_cur) / 8 / task_count;
+      }
+#endif
+      window_size = std::min(window_size, std::clamp(budget, LOAD_MIN_WINDOW_SIZE, LOAD_MAX_OPEN_WINDOW_SIZE));
+    }
+    return window_size;
+  }
+
+  // Calls `fn(begin, end)` for consecutive windows covering [0, count), on the AsyncOps workers when a scheduler
+  // is running.
+  static auto run_load_windows(const usize count, const usize window_size,
+                               Ref<std::function<void(usize, usize)>> fn) -> void
+  {
+    if (count <= window_size || AsyncOps::get_worker_count() == 0)
+    {
+      for (Mut<usize> begin = 0; begin < count; begin += window_size)
+      {
+        fn(begin, std::min(count, begin + window_size));
+      }
+      return;
+    }
+
+    Mut<AsyncOps::Schedule> schedule;
+    for (Mut<usize> begin = 0; begin < count; begin += window_size)
+    {
+      const usize end = std::min(count, begin + window_size);
+      AsyncOps::schedule_task([begin, end, &fn](const AsyncOps::WorkerId) { fn(begin, end); }, 0, &schedule);
+    }
+    AsyncOps::wait_for_schedule_completion(&schedule);
+  }
+
+  // Reads a file of unknown size until EOF, replacing the buffer's contents.
+  static auto read_until_end(const NativeFileHandle handle, MutRef<Vec<u8>> buffer) -> Result<usize>
+  {
+    Mut<usize> filled = 0;
+    while (true)
+    {
+      buffer.resize(std::max(buffer.size(), filled + UNKNOWN_SIZE_READ_CHUNK));
+      Mut<Result<usize>> read_length = read_fully_at(handle, buffer.data() + filled, buffer.size() - filled, filled);
+      if (!read_length)
+      {
+        return read_length;
+      }
+      filled += *read_length;
+      if (filled < buffer.size())
+      {
+        return filled;
+      }
+    }
+  }
+
+  // Bump allocation from arenas of LoadedFiles::ARENA_SIZE. Files too large to share one get an arena of their own.
+  class LoadArena
+  {
+public:
+    auto allocate(const usize size) -> u8 *
+    {
+      if (size > FileOps::LoadedFiles::ARENA_SIZE / 4)
+      {
+        return m_arenas.emplace_back(std::make_unique_for_overwrite<u8[]>(size)).get();
+      }
+
+      m_used = (m_used + FileOps::LoadedFiles::ALIGNMENT - 1) & ~(FileOps::LoadedFiles::ALIGNMENT - 1);
+      if (!m_current || m_used + size > FileOps::LoadedFiles::ARENA_SIZE)
+      {
+        m_current = m_arenas.emplace_back(std::make_unique_for_overwrite<u8[]>(FileOps::LoadedFiles::ARENA_SIZE)).get();
+        m_used = 0;
+      }
+      u8 *result = m_current + m_used;
+      m_used += size;
+      return result;
+    }
+
+    [[nodiscard]] auto take_arenas() -> Vec<Box<u8[]>>
+    {
+      m_current = nullptr;
+      return std::move(m_arenas);
+    }
+
+private:
+    Mut<Vec<Box<u8[]>>> m_arenas;
+    Mut<u8 *> m_current = nullptr;
+    Mut<usize> m_used = 0;
+  };
+
+  // Arenas come from operator new[], so their start is already aligned enough.
+  static_assert(__STDCPP_DEFAULT_NEW_ALIGNMENT__ >= FileOps::LoadedFiles::ALIGNMENT);
+
+  auto FileOps::load_files(const Span<const Path> paths) -> LoadedFiles
+  {
+    return load_files(paths, LoadOptions{});
+  }
+
+  auto FileOps::load_files(const Span<const Path> paths, Ref<LoadOptions> options) -> LoadedFiles
+  {
+    Mut<LoadedFiles> loaded;
+    loaded.m_slots.resize(paths.size());
+    Mut<std::mutex> arenas_mutex;
+
+    const usize window_size = get_load_window_size(paths.size(), options);
+    run_load_windows(paths.size(), window_size, [&](const usize begin, const usize end) {
+      Mut<LoadArena> arena;
+      Mut<Vec<u8>> unsized_buffer;
+      const auto load = [&](Ref<OpenedFile> file) {
+        MutRef<LoadedFiles::Slot> slot = loaded.m_slots[file.index];
+        Mut<u8 *> data = nullptr;
+        Mut<Result<usize>> read = 0;
+        if (file.is_sized)
+        {
+          data = arena.allocate(file.size);
+          read = read_fully_at(file.handle, data, file.size, 0);
+        }
+        else
+        {
+          // Read aside first, so the arena space can be sized exactly.
+          read = read_until_end(file.handle, unsized_buffer);
+          if (read && *read > 0)
+          {
+            data = arena.allocate(*read);
+            std::memcpy(data, unsized_buffer.data(), *read);
+          }
+        }
+        native_close_file(file.handle);
+
+        if (!read)
+        {
+          slot.error = describe_read_failure(paths[file.index], read.error());
+          return;
+        }
+        slot.data = data;
+        slot.size = *read;
+      };
+      open_load_window(paths, begin, end, options, load, [&loaded](const usize index, Mut<String> error) {
+        loaded.m_slots[index].error = std::move(error);
+      });
+
+      Mut<Vec<Box<u8[]>>> arenas = arena.take_arenas();
+      const std::lock_guard<std::mutex> lock(arenas_mutex);
+      for (MutRef<Box<u8[]>> window_arena : arenas)
+      {
+        loaded.m_arenas.push_back(std::move(window_arena));
+      }
+    });
+
+    for (Ref<LoadedFiles::Slot> slot : loaded.m_slots)
+    {
+      loaded.m_failed_count += !slot.error.empty();
+      loaded.m_total_size += slot.size;
+    }
+    return loaded;
+  }
+
+  auto FileOps::load_each_file(const Span<const Path> paths, Ref<LoadCallback> on_loaded) -> void
+  {
+    load_each_file(paths, LoadOptions{}, on_loaded);
+  }
+
+  auto FileOps::load_each_file(const Span<const Path> paths, Ref<LoadOptions> options, Ref<LoadCallback> on_loaded)
+      -> void
+  {
+    const usize window_size = get_load_window_size(paths.size(), options);
+    run_load_windows(paths.size(), window_size, [&](const usize begin, const usize end) {
+      // One buffer per window, grown to the largest file in it.
+      Mut<Vec<u8>> buffer;
+      const auto load = [&](Ref<OpenedFile> file) {
+        if (file.is_sized && buffer.size() < file.size)
+        {
+          buffer.resize(file.size);
+        }
+        Mut<Result<usize>> read = file.is_sized ? read_fully_at(file.handle, buffer.data(), file.size, 0)
+                                                : read_until_end(file.handle, buffer);
+        native_close_file(file.handle);
+        if (!read)
+        {
+          on_loaded(file.index, fail(describe_read_failure(paths[file.index], read.error())));
+          return;
+        }
+        on_loaded(file.index, Span<const u8>(buffer.data(), *read));
+      };
+      open_load_window(paths, begin, end, options, load, [&on_loaded](const usize index, Mut<String> error) {
+        on_loaded(index, fail(std::move(error)));
+      });
+    });
+  }
+
+  auto FileOps::normalize_executable_path(Ref<Path> path) -> Path
+  {
+    Mut<Path> result = path;
+
+#if IA_PLATFORM_WINDOWS
+    if (!result.has_extension())
+    {
+      result.replace_extension(".exe");
+    }
+#elif IA_PLATFORM_UNIX
+    if (result.extension() == ".exe")
+    {
+      result.replace_extension("");
+    }
+
+    if (result.is_relative())
+    {
+      Mut<String> path_str = result.string();
+      if (!path_str.starts_with("./") && !path_str.starts_with("../"))
+      {
+        result = "./" + path_str;
+      }
+    }
+#endif
+    return result;
+  }
+
+  auto FileOps::native_open_file(Ref<Path> path, const FileAccess access, const FileMode mode, const u32 permissions,
+                                 const FileCaching caching) -> Result<NativeFileHandle>
+  {
+#if IA_PLATFORM_WINDOWS
+    AU_UNUSED(permissions);
+
+    Mut<DWORD> dw_access = 0;
+    Mut<DWORD> dw_share = FILE_SHARE_READ;
+    Mut<DWORD> dw_disposition = 0;
+    Mut<DWORD> dw_flags_and_attributes = FILE_ATTRIBUTE_NORMAL;
+
+    if (caching == FileCaching::Direct)
+    {
+      dw_flags_and_attributes |= FILE_FLAG_NO_BUFFERING;
+    }
+
+    switch (access)
+    {
+    case FileAccess::Read:
+      dw_access = GENERIC_READ;
+      break;
+    case FileAccess::Write:
+      dw_access = GENERIC_WRITE;
+      break;
+    case FileAccess::ReadWrite:
+      dw_access = GENERIC_READ | GENERIC_WRITE;
+      break;
+    }
+
+    switch (mode)
+    {
+    case FileMode::OpenExisting:
+      dw_disposition = OPEN_EXISTING;
+      break;
+    case FileMode::OpenAlways:
+      dw_disposition = OPEN_ALWAYS;
+      break;
+    case FileMode::CreateNew:
+      dw_disposition = CREATE_NEW;
+      break;
+    case FileMode::CreateAlways:
+      dw_disposition = CREATE_ALWAYS;
+      break;
+    case FileMode::TruncateExisting:
+      dw_disposition = TRUNCATE_EXISTING;
+      break;
+    }
+
+    Mut<HANDLE> h_file =
+        CreateFileA(path.string().c_str(), dw_access, dw_share, NULL, dw_disposition, dw_flags_and_attributes, NULL);
+
+    if (h_file == INVALID_HANDLE_VALUE)
+    {
+      return fail("Failed to open file '{}': {}", path.string(), GetLastError());
+    }
+
+    return h_file;
+
+#elif IA_PLATFORM_UNIX
+    Mut<int> flags = 0;
+
+    switch (access)
+    {
+    case FileAccess::Read:
+      flags = O_RDONLY;
+      break;
+    case FileAccess::Write:
+      flags = O_WRONLY;
+      break;
+    case FileAccess::ReadWrite:
+      flags = O_RDWR;
+      break;
+    }
+
+    switch (mode)
+    {
+    case FileMode::OpenExisting:
+      break;
+    case FileMode::OpenAlways:
+      flags |= O_CREAT;
+      break;
+    case FileMode::CreateNew:
+      flags |= O_CREAT | O_EXCL;
+      break;
+    case FileMode::CreateAlways:
+      flags |= O_CREAT | O_TRUNC;
+      break;
+    case FileMode::TruncateExisting:
+      flags |= O_TRUNC;
+      break;
+    }
+
+#  if defined(O_DIRECT)
+    if (caching == FileCaching::Direct)
+    {
+      flags |= O_DIRECT;
+    }
+#  endif
+
+    Mut<int> fd = open(path.string().c_str(), flags, permissions);
+
+    if (fd == -1)
+    {
+      if (caching == FileCaching::Direct && errno == EINVAL)
+      {
+        return fail("Failed to open file '{}': the filesystem does not support direct I/O", path.string());
+      }
+      return fail("Failed to open file '{}': {}", path.string(), errno);
+    }
+
+#  if !defined(O_DIRECT)
+    if (caching == FileCaching::Direct)
+    {
+#    if defined(F_NOCACHE)
+      fcntl(fd, F_NOCACHE, 1);
+#    else
+      close(fd);
+      return fail("Failed to open file '{}': direct I/O is not supported on this platform", path.string());
+#    endif
+    }
+#  endif
+
+    return fd;
+#endif
+  }
+
+  auto FileOps::native_close_file(const NativeFileHandle handle) -> void
+  {
+    if (handle == INVALID_FILE_HANDLE)
+    {
+      return;
+    }
+
+#if IA_PLATFORM_WINDOWS
+    CloseHandle(handle);
+#elif IA_PLATFORM_UNIX
+    close(handle);
+#endif
+  }
+
+  auto FileOps::get_file_size(const NativeFileHandle handle) -> Result<u64>
+  {
+#if IA_PLATFORM_WINDOWS
+    Mut<LARGE_INTEGER> size;
+    if (!GetFileSizeEx(handle, &size))
+    {
+      return fail("Failed to get file size: {}", GetLastError());
+    }
+    return static_cast<u64>(size.QuadPart);
+#elif IA_PLATFORM_UNIX
+    Mut<struct stat> sb;
+    if (fstat(handle, &sb) == -1)
+    {
+      return fail("Failed to get file size: {}", errno);
+    }
+    return static_cast<u64>(sb.st_size);
+#endif
+  }
+
+  auto FileOps::set_file_size(const NativeFileHandle handle, const u64 size) -> Result<void>
+  {
+#if IA_PLATFORM_WINDOWS
+    Mut<FILE_END_OF_FILE_INFO> end_of_file;
+    end_of_file.EndOfFile.QuadPart = static_cast<LONGLONG>(size);
+    if (!SetFileInformationByHandle(handle, FileEndOfFileInfo, &end_of_file, sizeof(end_of_file)))
+    {
+      return fail("Failed to set file size: {}", GetLastError());
+    }
+#elif IA_PLATFORM_UNIX
+    if (ftruncate(handle, static_cast<off_t>(size)) == -1)
+    {
+      return fail("Failed to set file size: {}", errno);
+    }
+#endif
+    return {};
+  }
+
+  auto FileOps::get_direct_io_alignment(const NativeFileHandle handle) -> Result<DirectIoAlignment>
+  {
+#if IA_PLATFORM_WINDOWS
+    Mut<FILE_STORAGE_INFO> info{};
+    if (!GetFileInformationByHandleEx(handle, FileStorageInfo, &info, sizeof(info)))
+    {
+      return fail("Failed to query the storage alignment: {}", GetLastError());
+    }
+    // Unbuffered transfers need whole logical sectors, in sector-aligned memory.
+    const usize sector = std::max<usize>(info.LogicalBytesPerSector, 512);
+    return DirectIoAlignment{sector, sector};
+#elif IA_PLATFORM_UNIX
+#  if defined(__linux__) && defined(STATX_DIOALIGN)
+    Mut<struct statx> extended{};
+    if (::statx(handle, "", AT_EMPTY_PATH, STATX_DIOALIGN, &extended) == 0 &&
+        (extended.stx_mask & STATX_DIOALIGN) != 0)
+    {
+      if (extended.stx_dio_offset_align == 0)
+      {
+        return fail("The filesystem does not support direct I/O on this file");
+      }
+      return DirectIoAlignment{extended.stx_dio_mem_align, extended.stx_dio_offset_align};
+    }
+#  endif
+    // No direct I/O alignment reported: the filesystem block size is a multiple of whatever the device needs.
+    Mut<struct stat> info{};
+    if (fstat(handle, &info) == -1)
+    {
+      return fail("Failed to stat file: {}", errno);
+    }
+    const usize block_size = std::max<usize>(static_cast<usize>(info.st_blksize), 512);
+    return DirectIoAlignment{block_size, block_size};
+#endif
+  }
+
+  auto FileOps::preallocate(const NativeFileHandle handle, const u64 size, const bool keep_size) -> Result<void>
+  {
+    return preallocate(handle, 0, size, keep_size);
+  }
+
+  auto FileOps::preallocate(const NativeFileHandle handle, const u64 offset, const u64 size, const bool keep_size)
+      -> Result<void>
+  {
+    if (handle == INVALID_FILE_HANDLE)
+    {
+      return fail("Invalid file handle provided to preallocate");
+    }
+    if (size == 0)
+    {
+      return {};
+    }
+
+#if IA_PLATFORM_WINDOWS
+    const u64 end_offset = offset + size;
+    Mut<LARGE_INTEGER> file_size;
+    if (!GetFileSizeEx(handle, &file_size))
+    {
+      return fail("Failed to get file size: {}", GetLastError());
+    }
+
+    // Setting a smaller allocation size would truncate the file.
+    if (end_offset > static_cast<u64>(file_size.QuadPart))
+    {
+      Mut<FILE_ALLOCATION_INFO> allocation;
+      allocation.AllocationSize.QuadPart = static_cast<LONGLONG>(end_offset);
+      if (!SetFileInformationByHandle(handle, FileAllocationInfo, &allocation, sizeof(allocation)))
+      {
+        return fail("Failed to preallocate {} bytes: {}", end_offset, GetLastError());
+      }
+
+      if (!keep_size)
+      {
+        Mut<FILE_END_OF_FILE_INFO> end_of_file;
+        end_of_file.EndOfFile.QuadPart = static_cast<LONGLONG>(end_offset);
+        if (!SetFileInformationByHandle(handle, FileEndOfFileInfo, &end_of_file, sizeof(end_of_file)))
+        {
+          return fail("Failed to extend file to {} bytes: {}", end_offset, GetLastError());
+        }
+      }
+    }
+    return {};
+
+#elif IA_PLATFORM_UNIX
+#  if defined(__linux__)
+    const int mode = keep_size ? FALLOC_FL_KEEP_SIZE : 0;
+    if (fallocate(handle, mode, static_cast<off_t>(offset), static_cast<off_t>(size)) == 0)
+    {
+      return {};
+    }
+    if (errno != EOPNOTSUPP || keep_size)
+    {
+      return fail("Failed to preallocate {} bytes at offset {}: {}", size, offset, errno);
+    }
+#  elif defined(__APPLE__)
+    // Ask for contiguous blocks first, then settle for any. The length counts from the current end of file.
+    Mut<struct stat> sb;
+    if (fstat(handle, &sb) == -1)
     {
-      Mut<String> path_str = result.string();
-      if (!path_str.starts_with("./") && !path_str.starts_with("../"))
+      return fail("Failed to get file size: {}", errno);
+    }
+    const u64 end_offset = offset + size;
+    if (end_offset > static_cast<u64>(sb.st_size))
+    {
+      Mut<fstore_t> store = {F_ALLOCATECONTIG | F_ALLOCATEALL, F_PEOFPOSMODE, 0,
+                             static_cast<off_t>(end_offset - static_cast<u64>(sb.st_size)), 0};
+      if (fcntl(handle, F_PREALLOCATE, &store) == -1)
       {
-        result = "./" + path_str;
+        store.fst_flags = F_ALLOCATEALL;
+        if (fcntl(handle, F_PREALLOCATE, &store) == -1)
+        {
+          return fail("Failed to preallocate {} bytes: {}", end_offset, errno);
+        }
+      }
+      if (!keep_size && ftruncate(handle, static_cast<off_t>(end_offset)) == -1)
+      {
+        return fail("Failed to extend file to {} bytes: {}", end_offset, errno);
       }
     }
+    return {};
+#  endif
+    if (keep_size)
+    {
+      return fail("Preallocating without changing the file size is not supported here");
+    }
+
+    // Where the filesystem cannot reserve blocks itself, this writes them out instead. Only the range is touched,
+    // so data being written elsewhere in the file is safe.
+    const int result = posix_fallocate(handle, static_cast<off_t>(offset), static_cast<off_t>(size));
+    if (result != 0)
+    {
+      return fail("Failed to preallocate {} bytes at offset {}: {}", size, offset, result);
+    }
+    return {};
 #endif
-    return result;
   }
 
-  auto FileOps::native_open_file(Ref<Path> path, const FileAccess access, const FileMode mode, const u32 permissions)
-      -> Result<NativeFileHandle>
+  // A duplicate of the caller's handle, so flushing keeps working after the caller closes theirs.
+  static auto duplicate_file_handle(const NativeFileHandle handle) -> Result<NativeFileHandle>
   {
 #if IA_PLATFORM_WINDOWS
-    AU_UNUSED(permissions);
-
-    Mut<DWORD> dw_access = 0;
-    Mut<DWORD> dw_share = FILE_SHARE_READ;
-    Mut<DWORD> dw_disposition = 0;
-    Mut<DWORD> dw_flags_and_attributes = FILE_ATTRIBUTE_NORMAL;
+    Mut<HANDLE> duplicate = NULL;
+    if (!DuplicateHandle(GetCurrentProcess(), handle, GetCurrentProcess(), &duplicate, 0, FALSE,
+                         DUPLICATE_SAME_ACCESS))
+    {
+      return fail("Failed to duplicate file handle: {}", GetLastError());
+    }
+    return duplicate;
+#elif IA_PLATFORM_UNIX
+    const int duplicate = fcntl(handle, F_DUPFD_CLOEXEC, 0);
+    if (duplicate == -1)
+    {
+      return fail("Failed to duplicate file handle: {}", errno);
+    }
+    return duplicate;
+#endif
+  }
 
-    switch (access)
+  class FileOps::MemoryMappedRegion::FlushState
+  {
+public:
+    FlushState(Mut<u8 *> base, const usize size, const u64 file_offset, const NativeFileHandle handle,
+               const bool owns_handle, const usize page_size)
+        : m_base(base), m_size(size), m_file_offset(file_offset), m_handle(handle), m_owns_handle(owns_handle),
+          m_page_size(page_size), m_word_count((size + page_size - 1) / page_size / 64 + 1),
+          m_dirty_words(std::make_unique<std::atomic<u64>[]>(m_word_count))
     {
-    case FileAccess::Read:
-      dw_access = GENERIC_READ;
-      break;
-    case FileAccess::Write:
-      dw_access = GENERIC_WRITE;
-      break;
-    case FileAccess::ReadWrite:
-      dw_access = GENERIC_READ | GENERIC_WRITE;
-      break;
     }
 
-    switch (mode)
+    ~FlushState()
     {
-    case FileMode::OpenExisting:
-      dw_disposition = OPEN_EXISTING;
-      break;
-    case FileMode::OpenAlways:
-      dw_disposition = OPEN_ALWAYS;
-      break;
-    case FileMode::CreateNew:
-      dw_disposition = CREATE_NEW;
-      break;
-    case FileMode::CreateAlways:
-      dw_disposition = CREATE_ALWAYS;
-      break;
-    case FileMode::TruncateExisting:
-      dw_disposition = TRUNCATE_EXISTING;
-      break;
+      // A queued background flush still uses the mapping, the handle and the schedule.
+      if (m_has_background_flush)
+      {
+        AsyncOps::wait_for_schedule_completion(&m_schedule);
+      }
+      if (m_owns_handle)
+      {
+        FileOps::native_close_file(m_handle);
+      }
     }
 
-    Mut<HANDLE> h_file =
-        CreateFileA(path.string().c_str(), dw_access, dw_share, NULL, dw_disposition, dw_flags_and_attributes, NULL);
+    FlushState(Ref<FlushState>) = delete;
+    auto operator=(Ref<FlushState>) -> FlushState & = delete;
 
-    if (h_file == INVALID_HANDLE_VALUE)
+    auto flush_range(const usize offset, const usize size, const bool async) -> Result<void>
     {
-      return fail("Failed to open file '{}': {}", path.string(), GetLastError());
+      if (size == 0)
+      {
+        return {};
+      }
+      const auto [begin, length] = widen_to_pages(m_base + offset, size);
+
+#if IA_PLATFORM_WINDOWS
+      // FlushViewOfFile only queues the writes. Waiting for them takes a flush of the whole file.
+      if (!FlushViewOfFile(begin, length))
+      {
+        return fail("FlushViewOfFile failed: {}", GetLastError());
+      }
+      if (!async && !FlushFileBuffers(m_handle))
+      {
+        return fail("FlushFileBuffers failed: {}", GetLastError());
+      }
+#elif IA_PLATFORM_UNIX
+#  if defined(__linux__)
+      if (async)
+      {
+        const u64 file_offset = m_file_offset + static_cast<u64>(static_cast<u8 *>(begin) - m_base);
+        if (sync_file_range(m_handle, static_cast<off_t>(file_offset), static_cast<off_t>(length),
+                            SYNC_FILE_RANGE_WRITE) == -1)
+        {
+          return fail("sync_file_range failed: {}", errno);
+        }
+        return {};
+      }
+#  endif
+      if (msync(begin, length, async ? MS_ASYNC : MS_SYNC) == -1)
+      {
+        return fail("msync failed: {}", errno);
+      }
+#endif
+      return {};
     }
 
-    return h_file;
+    auto mark_dirty(const usize offset, const usize size) -> void
+    {
+      if (size == 0)
+      {
+        return;
+      }
 
-#elif IA_PLATFORM_UNIX
-    Mut<int> flags = 0;
+      const isize dirty_pages = mark_pages(offset / m_page_size, (offset + size - 1) / m_page_size);
+      const usize max_dirty_bytes = m_max_dirty_bytes.load(std::memory_order_relaxed);
+      if (max_dirty_bytes != 0 && dirty_pages > 0 && static_cast<usize>(dirty_pages) * m_page_size > max_dirty_bytes &&
+          !m_is_flush_queued.exchange(true, std::memory_order_acq_rel))
+      {
+        AsyncOps::schedule_task(
+            [this](const AsyncOps::WorkerId) {
+              if (!write_back_dirty(false))
+              {
+                m_background_failed.store(true, std::memory_order_relaxed);
+              }
+              m_is_flush_queued.store(false, std::memory_order_release);
+            },
+            0, &m_schedule, AsyncOps::Priority::Background);
+      }
+    }
 
-    switch (access)
+    auto flush_dirty(const bool async) -> Result<void>
     {
-    case FileAccess::Read:
-      flags = O_RDONLY;
-      break;
-    case FileAccess::Write:
-      flags = O_WRONLY;
-      break;
-    case FileAccess::ReadWrite:
-      flags = O_RDWR;
-      break;
+      Mut<Result<void>> result = write_back_dirty(async);
+      if (m_background_failed.exchange(false, std::memory_order_relaxed) && result)
+      {
+        return fail("A background flush of the mapped region failed");
+      }
+      return result;
     }
 
-    switch (mode)
+    auto clear_dirty() -> void
     {
-    case FileMode::OpenExisting:
-      break;
-    case FileMode::OpenAlways:
-      flags |= O_CREAT;
-      break;
-    case FileMode::CreateNew:
-      flags |= O_CREAT | O_EXCL;
-      break;
-    case FileMode::CreateAlways:
-      flags |= O_CREAT | O_TRUNC;
-      break;
-    case FileMode::TruncateExisting:
-      flags |= O_TRUNC;
-      break;
+      for (Mut<usize> word = 0; word < m_word_count; ++word)
+      {
+        const u64 bits = m_dirty_words[word].exchange(0, std::memory_order_acq_rel);
+        m_dirty_pages.fetch_sub(std::popcount(bits), std::memory_order_relaxed);
+      }
     }
 
-    Mut<int> fd = open(path.string().c_str(), flags, permissions);
+    [[nodiscard]] auto get_dirty_size() const -> usize
+    {
+      // Briefly negative while a flush takes pages whose marker has not counted them yet.
+      return static_cast<usize>(std::max<isize>(m_dirty_pages.load(std::memory_order_relaxed), 0)) * m_page_size;
+    }
 
-    if (fd == -1)
+    auto set_background_flush(const usize max_dirty_bytes) -> void
     {
-      return fail("Failed to open file '{}': {}", path.string(), errno);
+      if (max_dirty_bytes != 0)
+      {
+        ensure(AsyncOps::get_worker_count() > 0, "Background flushing needs the AsyncOps scheduler");
+        m_has_background_flush = true;
+      }
+      m_max_dirty_bytes.store(max_dirty_bytes, std::memory_order_relaxed);
     }
 
-    return fd;
-#endif
-  }
+private:
+    // Marks the pages in [first, last] and returns the dirty page count after, or 0 if none were new.
+    auto mark_pages(const usize first, const usize last) -> isize
+    {
+      Mut<isize> newly_dirty = 0;
+      for (Mut<usize> page = first; page <= last;)
+      {
+        const usize bit = page % 64;
+        const usize count = std::min<usize>(64 - bit, last - page + 1);
+        const u64 mask = (count == 64 ? ~u64{0} : (u64{1} << count) - 1) << bit;
+        MutRef<std::atomic<u64>> word = m_dirty_words[page / 64];
 
-  auto FileOps::native_close_file(const NativeFileHandle handle) -> void
-  {
-    if (handle == INVALID_FILE_HANDLE)
+        // Pages written over and over are usually marked already, and then the word is not written at all.
+        if ((word.load(std::memory_order_relaxed) & mask) != mask)
+        {
+          const u64 previous = word.fetch_or(mask, std::memory_order_acq_rel);
+          newly_dirty += std::popcount(mask & ~previous);
+        }
+        page += count;
+      }
+
+      if (newly_dirty == 0)
+      {
+        return 0;
+      }
+      return m_dirty_pages.fetch_add(newly_dirty, std::memory_order_relaxed) + newly_dirty;
+    }
+
+    // Takes the dirty pages and flushes each run of them. Runs that fail are marked again to be retried.
+    auto write_back_dirty(const bool async) -> Result<void>
     {
-      return;
+      Mut<Result<void>> result = {};
+      Mut<usize> run_start = 0;
+      Mut<usize> run_length = 0;
+
+      const auto flush_run = [&]() {
+        if (run_length == 0)
+        {
+          return;
+        }
+        const usize offset = run_start * m_page_size;
+        Mut<Result<void>> flushed = flush_range(offset, std::min(run_length * m_page_size, m_size - offset), async);
+        if (!flushed)
+        {
+          mark_pages(run_start, run_start + run_length - 1);
+          if (result)
+          {
+            result = fail(std::move(flushed.error()));
+          }
+        }
+        run_length = 0;
+      };
+
+      for (Mut<usize> word = 0; word < m_word_count; ++word)
+      {
+        Mut<u64> bits = m_dirty_words[word].exchange(0, std::memory_order_acq_rel);
+        m_dirty_pages.fetch_sub(std::popcount(bits), std::memory_order_relaxed);
+        while (bits != 0)
+        {
+          const usize page = word * 64 + static_cast<usize>(std::countr_zero(bits));
+          bits &= bits - 1;
+          if (run_length != 0 && run_start + run_length == page)
+          {
+            ++run_length;
+            continue;
+          }
+          flush_run();
+          run_start = page;
+          run_length = 1;
+        }
+      }
+      flush_run();
+      return result;
     }
 
-#if IA_PLATFORM_WINDOWS
-    CloseHandle(handle);
-#elif IA_PLATFORM_UNIX
-    close(handle);
-#endif
-  }
+private:
+    Mut<u8 *> m_base = nullptr;
+    Mut<usize> m_size = 0;
+    Mut<u64> m_file_offset = 0;
+    Mut<NativeFileHandle> m_handle = INVALID_FILE_HANDLE;
+    Mut<bool> m_owns_handle = false;
+    Mut<usize> m_page_size = 0;
+
+    // One bit per page.
+    Mut<usize> m_word_count = 0;
+    Mut<std::unique_ptr<std::atomic<u64>[]>> m_dirty_words;
+    Mut<std::atomic<isize>> m_dirty_pages = 0;
+
+    Mut<std::atomic<usize>> m_max_dirty_bytes = 0;
+    Mut<std::atomic<bool>> m_is_flush_queued = false;
+    Mut<std::atomic<bool>> m_background_failed = false;
+    Mut<bool> m_has_background_flush = false;
+    Mut<AsyncOps::Schedule> m_schedule;
+  };
+
+  FileOps::MemoryMappedRegion::MemoryMappedRegion() = default;
 
   FileOps::MemoryMappedRegion::~MemoryMappedRegion()
   {
@@ -446,18 +2410,24 @@ namespace ia
       unmap();
       m_ptr = other.m_ptr;
       m_size = other.m_size;
+      m_page_size = other.m_page_size;
+      m_is_locked = other.m_is_locked;
+      m_flush_state = std::move(other.m_flush_state);
 #if IA_PLATFORM_WINDOWS
       m_map_handle = other.m_map_handle;
       other.m_map_handle = NULL;
 #endif
       other.m_ptr = nullptr;
       other.m_size = 0;
+      other.m_page_size = 0;
+      other.m_is_locked = false;
     }
     return *this;
   }
 
-  auto FileOps::MemoryMappedRegion::map(const NativeFileHandle handle, const u64 offset, const usize size)
-      -> Result<void>
+  auto FileOps::MemoryMappedRegion::map(const NativeFileHandle handle, const u64 offset, const usize size,
+                                        const HugePages huge_pages, const AccessHint hint, const Prefault prefault,
+                                        const FileGrowth growth, const RegionHandle region_handle) -> Result<void>
   {
     unmap();
 
@@ -471,6 +2441,16 @@ namespace ia
       return fail("Cannot map region of size 0");
     }
 
+    // With the file covering the region after this, the extension below has nothing to do.
+    if (growth == FileGrowth::Preallocate)
+    {
+      Mut<Result<void>> allocated = preallocate(handle, offset, size);
+      if (!allocated)
+      {
+        return allocated;
+      }
+    }
+
 #if IA_PLATFORM_WINDOWS
     Mut<LARGE_INTEGER> file_size;
     if (!GetFileSizeEx(handle, &file_size))
@@ -511,6 +2491,8 @@ namespace ia
       return fail("MapViewOfFile failed (Offset: {}, Size: {}): {}", offset, size, GetLastError());
     }
     m_size = size;
+    m_page_size = get_system_page_size();
+    AU_UNUSED(huge_pages);
 
 #elif IA_PLATFORM_UNIX
     Mut<struct stat> sb;
@@ -536,10 +2518,34 @@ namespace ia
 
     m_ptr = static_cast<u8 *>(ptr);
     m_size = size;
+    m_page_size = get_system_page_size();
 
-    madvise(m_ptr, m_size, MADV_SEQUENTIAL);
+    Mut<bool> is_hugetlbfs = false;
+#  if defined(__linux__)
+    Mut<struct statfs> fs;
+    if (fstatfs(handle, &fs) == 0 && fs.f_type == HUGETLBFS_MAGIC_NUMBER)
+    {
+      m_page_size = static_cast<usize>(fs.f_bsize);
+      is_hugetlbfs = true;
+    }
+#  endif
+    if (!is_hugetlbfs && huge_pages != HugePages::None)
+    {
+      advise_transparent_huge_pages(m_ptr, m_size);
+    }
 #endif
 
+    const bool owns_handle = region_handle == RegionHandle::Duplicate;
+    Mut<Result<NativeFileHandle>> flush_handle = owns_handle ? duplicate_file_handle(handle) : handle;
+    if (!flush_handle)
+    {
+      unmap();
+      return fail(std::move(flush_handle.error()));
+    }
+    m_flush_state = make_box<FlushState>(m_ptr, m_size, offset, *flush_handle, owns_handle, m_page_size);
+
+    apply_access_hint(m_ptr, m_size, hint);
+    m_is_locked = prefault_range(m_ptr, m_size, prefault);
     return {};
   }
 
@@ -550,6 +2556,9 @@ namespace ia
       return;
     }
 
+    // Waits for a background flush, which needs the mapping.
+    m_flush_state.reset();
+
 #if IA_PLATFORM_WINDOWS
     UnmapViewOfFile(m_ptr);
     if (m_map_handle)
@@ -562,6 +2571,19 @@ namespace ia
 #endif
     m_ptr = nullptr;
     m_size = 0;
+    m_page_size = 0;
+    m_is_locked = false;
+  }
+
+  auto FileOps::MemoryMappedRegion::advise_range(const usize offset, const usize size, const AccessHint hint) const
+      -> void
+  {
+    apply_access_hint(m_ptr + offset, clamp_range(m_size, offset, size), hint);
+  }
+
+  auto FileOps::MemoryMappedRegion::prefetch_range(const usize offset, const usize size) const -> void
+  {
+    advise_range(offset, size, AccessHint::WillNeed);
   }
 
   auto FileOps::MemoryMappedRegion::flush() -> void
@@ -571,10 +2593,127 @@ namespace ia
       return;
     }
 
+    m_flush_state->clear_dirty();
+
 #if IA_PLATFORM_WINDOWS
     FlushViewOfFile(m_ptr, m_size);
 #elif IA_PLATFORM_UNIX
     msync(m_ptr, m_size, MS_SYNC);
 #endif
   }
+
+  auto FileOps::MemoryMappedRegion::flush_range(const usize offset, const usize size, const bool async)
+      -> Result<void>
+  {
+    if (!m_flush_state)
+    {
+      return fail("Cannot flush a region that is not mapped");
+    }
+    return m_flush_state->flush_range(offset, clamp_range(m_size, offset, size), async);
+  }
+
+  auto FileOps::MemoryMappedRegion::mark_dirty(const usize offset, const usize size) -> void
+  {
+    if (m_flush_state)
+    {
+      m_flush_state->mark_dirty(offset, clamp_range(m_size, offset, size));
+    }
+  }
+
+  auto FileOps::MemoryMappedRegion::flush_dirty(const bool async) -> Result<void>
+  {
+    if (!m_flush_state)
+    {
+      return fail("Cannot flush a region that is not mapped");
+    }
+    return m_flush_state->flush_dirty(async);
+  }
+
+  auto FileOps::MemoryMappedRegion::get_dirty_size() const -> usize
+  {
+    return m_flush_state ? m_flush_state->get_dirty_size() : 0;
+  }
+
+  auto FileOps::MemoryMappedRegion::set_background_flush(const usize max_dirty_bytes) -> void
+  {
+    ensure(is_valid(), "Region must be mapped before enabling background flushing");
+    m_flush_state->set_background_flush(max_dirty_bytes);
+  }
+
+  FileOps::MappedFile::~MappedFile()
+  {
+    unmap();
+  }
+
+  FileOps::MappedFile::MappedFile(ForwardRef<MappedFile> other) noexcept
+  {
+    *this = std::move(other);
+  }
+
+  auto FileOps::MappedFile::operator=(ForwardRef<MappedFile> other) noexcept -> MutRef<MappedFile>
+  {
+    if (this != &other)
+    {
+      unmap();
+      m_data = std::exchange(other.m_data, nullptr);
+      m_size = std::exchange(other.m_size, 0);
+      m_is_locked = std::exchange(other.m_is_locked, false);
+#if IA_PLATFORM_WINDOWS
+      m_file_handle = std::exchange(other.m_file_handle, INVALID_HANDLE_VALUE);
+      m_map_handle = std::exchange(other.m_map_handle, static_cast<HANDLE>(NULL));
+#endif
+    }
+    return *this;
+  }
+
+  auto FileOps::MappedFile::map(Ref<Path> path, const AccessHint hint, const Prefault prefault) -> Result<void>
+  {
+    unmap();
+
+    Mut<MappingHandles> handles;
+    Mut<Result<void>> mapped = map_whole_file(path, hint, prefault, handles, m_is_locked);
+    if (!mapped)
+    {
+      return mapped;
+    }
+
+    m_data = static_cast<const u8 *>(handles.address);
+    m_size = handles.size;
+#if IA_PLATFORM_WINDOWS
+    m_file_handle = handles.file_handle;
+    m_map_handle = handles.map_handle;
+#endif
+    return {};
+  }
+
+  auto FileOps::MappedFile::unmap() -> void
+  {
+    if (!m_data)
+    {
+      return;
+    }
+
+    Mut<MappingHandles> handles;
+    handles.address = const_cast<u8 *>(m_data);
+    handles.size = m_size;
+#if IA_PLATFORM_WINDOWS
+    handles.file_handle = std::exchange(m_file_handle, INVALID_HANDLE_VALUE);
+    handles.map_handle = std::exchange(m_map_handle, static_cast<HANDLE>(NULL));
+#endif
+    release_mapping(handles);
+
+    m_data = nullptr;
+    m_size = 0;
+    m_is_locked = false;
+  }
+
+  auto FileOps::MappedFile::advise_range(const usize offset, const usize size, const AccessHint hint) const -> void
+  {
+    apply_access_hint(m_data + offset, clamp_range(m_size, offset, size), hint);
+  }
+
+  auto FileOps::MappedFile::prefetch_range(const usize offset, const usize size) const -> void
+  {
+    advise_range(offset, size, AccessHint::WillNeed);
+  }
 } // namespace ia
\ No newline at end of file
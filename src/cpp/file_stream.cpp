@@ -0,0 +1,802 @@
+// IA-PlatformOps; C++ 20 Async, Process and File Operations.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <platform_ops/async_file.hpp>
+#include <platform_ops/file_stream.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <new>
+
+#if IA_PLATFORM_UNIX
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
+
+namespace ia
+{
+  static auto round_up_to_alignment(const usize size, const usize alignment = AlignedBuffer::DEFAULT_ALIGNMENT)
+      -> usize
+  {
+    return (std::max<usize>(size, 1) + alignment - 1) / alignment * alignment;
+  }
+
+  // Memory alignment and block size for a stream's buffers. Alignments are powers of two, so the larger one is a
+  // multiple of the smaller.
+  struct StreamAlignment
+  {
+    Mut<usize> memory = AlignedBuffer::DEFAULT_ALIGNMENT;
+    Mut<usize> block_size = 0;
+  };
+
+  static auto get_stream_alignment(const NativeFileHandle handle, const FileOps::FileCaching caching)
+      -> Result<StreamAlignment>
+  {
+    Mut<StreamAlignment> result;
+    if (caching == FileOps::FileCaching::Buffered)
+    {
+      return result;
+    }
+
+    Mut<Result<FileOps::DirectIoAlignment>> direct = FileOps::get_direct_io_alignment(handle);
+    if (!direct)
+    {
+      return fail(std::move(direct.error()));
+    }
+    result.memory = std::max({result.memory, direct->memory, direct->offset});
+    result.block_size = std::max<usize>(direct->offset, 1);
+    return result;
+  }
+
+  // Reads with direct I/O until the buffer is full or a read comes up short. A short read means end of file, and
+  // unlike FileOps::read_scatter this never retries from the unaligned offset it leaves, which would fail.
+  static auto read_direct(const NativeFileHandle handle, const Span<u8> buffer, const u64 offset,
+                          const usize block_size) -> Result<usize>
+  {
+    Mut<usize> total = 0;
+    while (total < buffer.size())
+    {
+      const u64 position = offset + total;
+#if IA_PLATFORM_WINDOWS
+      Mut<OVERLAPPED> overlapped{};
+      overlapped.Offset = static_cast<DWORD>(position & 0xFFFFFFFF);
+      overlapped.OffsetHigh = static_cast<DWORD>(position >> 32);
+      const DWORD size = static_cast<DWORD>(std::min<usize>(buffer.size() - total, 1u << 30));
+      Mut<DWORD> transferred = 0;
+      if (!ReadFile(handle, buffer.data() + total, size, &transferred, &overlapped))
+      {
+        const DWORD error = GetLastError();
+        if (error == ERROR_HANDLE_EOF)
+        {
+          break;
+        }
+        return fail("Failed to read at offset {}: {}", position, error);
+      }
+#elif IA_PLATFORM_UNIX
+      const isize transferred =
+          pread(handle, buffer.data() + total, buffer.size() - total, static_cast<off_t>(position));
+      if (transferred < 0)
+      {
+        if (errno == EINTR)
+        {
+          continue;
+        }
+        return fail("Failed to read at offset {}: {}", position, errno);
+      }
+#endif
+      total += static_cast<usize>(transferred);
+      if (transferred == 0 || static_cast<usize>(transferred) % block_size != 0)
+      {
+        break;
+      }
+    }
+    return total;
+  }
+
+  static auto is_async_file_io_available() -> bool
+  {
+    return AsyncFileOps::get_backend() != AsyncFileOps::Backend::None;
+  }
+
+  static auto advise(const NativeFileHandle handle, const u64 offset, const usize size, const int advice) -> void
+  {
+#if IA_PLATFORM_UNIX && defined(POSIX_FADV_NORMAL)
+    // Only a hint; failure changes nothing but speed.
+    (void) posix_fadvise(handle, static_cast<off_t>(offset), static_cast<off_t>(size), advice);
+#else
+    AU_UNUSED(handle);
+    AU_UNUSED(offset);
+    AU_UNUSED(size);
+    AU_UNUSED(advice);
+#endif
+  }
+
+#if IA_PLATFORM_UNIX && defined(POSIX_FADV_NORMAL)
+  static constexpr const int ADVICE_SEQUENTIAL = POSIX_FADV_SEQUENTIAL;
+  static constexpr const int ADVICE_DONT_NEED = POSIX_FADV_DONTNEED;
+#else
+  static constexpr const int ADVICE_SEQUENTIAL = 0;
+  static constexpr const int ADVICE_DONT_NEED = 0;
+#endif
+
+  AlignedBuffer::~AlignedBuffer()
+  {
+    release();
+  }
+
+  AlignedBuffer::AlignedBuffer(ForwardRef<AlignedBuffer> other) noexcept
+      : m_data(std::exchange(other.m_data, nullptr)), m_size(std::exchange(other.m_size, 0)),
+        m_alignment(std::exchange(other.m_alignment, 0))
+  {
+  }
+
+  auto AlignedBuffer::operator=(ForwardRef<AlignedBuffer> other) noexcept -> AlignedBuffer &
+  {
+    if (this != &other)
+    {
+      release();
+      m_data = std::exchange(other.m_data, nullptr);
+      m_size = std::exchange(other.m_size, 0);
+      m_alignment = std::exchange(other.m_alignment, 0);
+    }
+    return *this;
+  }
+
+  auto AlignedBuffer::allocate(const usize size, const usize alignment) -> void
+  {
+    release();
+    if (size == 0)
+    {
+      return;
+    }
+    m_data = static_cast<u8 *>(::operator new(size, std::align_val_t{alignment}));
+    m_size = size;
+    m_alignment = alignment;
+  }
+
+  auto AlignedBuffer::release() -> void
+  {
+    if (m_data)
+    {
+      ::operator delete(m_data, std::align_val_t{m_alignment});
+    }
+    m_data = nullptr;
+    m_size = 0;
+    m_alignment = 0;
+  }
+
+  AlignedBufferPool::AlignedBufferPool(const usize buffer_size, const usize alignment, const usize max_cached)
+      : m_buffer_size(round_up_to_alignment(buffer_size, alignment)), m_alignment(alignment),
+        m_max_cached(max_cached)
+  {
+    m_free.reserve(max_cached);
+  }
+
+  AlignedBufferPool::AlignedBufferPool(const usize buffer_size, Ref<FileOps::DirectIoAlignment> alignment,
+                                       const usize max_cached)
+      : AlignedBufferPool(round_up_to_alignment(buffer_size, std::max<usize>(alignment.offset, 1)),
+                          std::max({AlignedBuffer::DEFAULT_ALIGNMENT, alignment.memory, alignment.offset}),
+                          max_cached)
+  {
+  }
+
+  auto AlignedBufferPool::acquire() -> AlignedBuffer
+  {
+    {
+      const std::lock_guard<std::mutex> lock(m_mutex);
+      if (!m_free.empty())
+      {
+        Mut<AlignedBuffer> buffer = std::move(m_free.back());
+        m_free.pop_back();
+        return buffer;
+      }
+    }
+
+    Mut<AlignedBuffer> buffer;
+    buffer.allocate(m_buffer_size, m_alignment);
+    return buffer;
+  }
+
+  auto AlignedBufferPool::release(ForwardRef<AlignedBuffer> buffer) -> void
+  {
+    if (buffer.get_size() != m_buffer_size || buffer.get_alignment() != m_alignment)
+    {
+      buffer.release();
+      return;
+    }
+
+    {
+      const std::lock_guard<std::mutex> lock(m_mutex);
+      if (m_free.size() < m_max_cached)
+      {
+        m_free.push_back(std::move(buffer));
+        return;
+      }
+    }
+    buffer.release();
+  }
+
+  auto AlignedBufferPool::get_cached_count() -> usize
+  {
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    return m_free.size();
+  }
+
+  FileReader::~FileReader()
+  {
+    close();
+  }
+
+  auto FileReader::open(Ref<Path> path, const usize buffer_size, const bool drop_behind,
+                        const FileOps::FileCaching caching) -> Result<void>
+  {
+    Mut<Result<NativeFileHandle>> handle =
+        FileOps::native_open_file(path, FileOps::FileAccess::Read, FileOps::FileMode::OpenExisting, 0644, caching);
+    if (!handle)
+    {
+      return fail(std::move(handle.error()));
+    }
+
+    Mut<Result<void>> opened = open(*handle, 0, buffer_size, drop_behind, caching);
+    if (!opened)
+    {
+      FileOps::native_close_file(*handle);
+      return opened;
+    }
+    m_owns_handle = true;
+    return {};
+  }
+
+  auto FileReader::open(const NativeFileHandle handle, const u64 offset, const usize buffer_size,
+                        const bool drop_behind, const FileOps::FileCaching caching) -> Result<void>
+  {
+    close();
+    if (handle == INVALID_FILE_HANDLE)
+    {
+      return fail("Cannot stream from an invalid file handle");
+    }
+
+    Mut<Result<StreamAlignment>> alignment = get_stream_alignment(handle, caching);
+    if (!alignment)
+    {
+      return fail(std::move(alignment.error()));
+    }
+
+    // Direct reads start at the block holding `offset`.
+    m_block_size = alignment->block_size;
+    m_head_skip = m_block_size > 0 ? static_cast<usize>(offset % m_block_size) : 0;
+    const u64 start = offset - m_head_skip;
+
+    m_handle = handle;
+    m_owns_handle = false;
+    m_read_ahead = is_async_file_io_available();
+    m_drop_behind = drop_behind && m_block_size == 0;
+    m_end_reached = false;
+    m_next_offset = start;
+    for (MutRef<detail::StreamSlot> slot : m_slots)
+    {
+      slot.buffer.allocate(round_up_to_alignment(buffer_size, alignment->memory), alignment->memory);
+      slot.length = 0;
+      slot.offset = start;
+      slot.is_pending = false;
+    }
+
+    if (m_block_size == 0)
+    {
+      advise(m_handle, offset, 0, ADVICE_SEQUENTIAL);
+    }
+
+    // Slot 1 starts out as an empty, fully consumed buffer, so the first peek moves onto slot 0.
+    start_fill(m_slots[0]);
+    m_current = 1;
+    m_cursor = 0;
+    return {};
+  }
+
+  auto FileReader::close() -> void
+  {
+    if (!is_open())
+    {
+      return;
+    }
+
+    for (MutRef<detail::StreamSlot> slot : m_slots)
+    {
+      if (slot.is_pending && slot.is_async)
+      {
+        AsyncOps::wait_for_schedule_completion(&slot.schedule);
+      }
+      slot.is_pending = false;
+      slot.length = 0;
+      slot.buffer.release();
+    }
+
+    if (m_owns_handle)
+    {
+      FileOps::native_close_file(m_handle);
+    }
+    m_handle = INVALID_FILE_HANDLE;
+    m_owns_handle = false;
+  }
+
+  auto FileReader::peek() -> Result<Span<const u8>>
+  {
+    ensure(is_open(), "FileReader is not open");
+
+    if (m_cursor == m_slots[m_current].length)
+    {
+      // A slot still pending here had its fill fail on the last call, so retry that instead of skipping it.
+      Mut<Result<void>> filled = m_slots[m_current].is_pending ? finish_fill(m_slots[m_current]) : advance();
+      if (!filled)
+      {
+        return fail(std::move(filled.error()));
+      }
+    }
+
+    Ref<detail::StreamSlot> slot = m_slots[m_current];
+    return Span<const u8>(slot.buffer.get_data() + m_cursor, slot.length - m_cursor);
+  }
+
+  auto FileReader::consume(const usize count) -> void
+  {
+    ensure(count <= m_slots[m_current].length - m_cursor, "Cannot consume more bytes than were peeked");
+    m_cursor += count;
+  }
+
+  auto FileReader::read(const Span<u8> out) -> Result<usize>
+  {
+    Mut<usize> copied = 0;
+    while (copied < out.size())
+    {
+      Mut<Result<Span<const u8>>> available = peek();
+      if (!available)
+      {
+        return fail(std::move(available.error()));
+      }
+      if (available->empty())
+      {
+        break;
+      }
+
+      const usize count = std::min(available->size(), out.size() - copied);
+      std::memcpy(out.data() + copied, available->data(), count);
+      consume(count);
+      copied += count;
+    }
+    return copied;
+  }
+
+  auto FileReader::start_fill(MutRef<detail::StreamSlot> slot) -> void
+  {
+    slot.offset = m_next_offset;
+    slot.length = 0;
+    slot.is_pending = true;
+    slot.is_async = m_read_ahead;
+    m_next_offset += slot.buffer.get_size();
+
+    if (slot.is_async)
+    {
+      slot.result = 0;
+      AsyncFileOps::read_at(m_handle, slot.buffer.get_span(), slot.offset, &slot.schedule, &slot.result);
+    }
+  }
+
+  auto FileReader::finish_fill(MutRef<detail::StreamSlot> slot) -> Result<void>
+  {
+    if (!slot.is_pending)
+    {
+      return {};
+    }
+
+    Mut<usize> filled = 0;
+    if (slot.is_async)
+    {
+      AsyncOps::wait_for_schedule_completion(&slot.schedule);
+      if (!slot.result)
+      {
+        // Leave it pending, to be retried synchronously.
+        slot.is_async = false;
+        return fail(std::move(slot.result.error()));
+      }
+      filled = *slot.result;
+    }
+
+    // A synchronous fill, or an asynchronous one that came up short of both the buffer and end of file. A direct
+    // read that stopped off a block boundary has already reached end of file.
+    const usize size = slot.buffer.get_size();
+    const bool is_short = filled > 0 && filled < size && (m_block_size == 0 || filled % m_block_size == 0);
+    if (!slot.is_async || is_short)
+    {
+      const Span<u8> rest = Span<u8>(slot.buffer.get_data() + filled, size - filled);
+      Mut<Result<usize>> read_length = m_block_size > 0
+                                           ? read_direct(m_handle, rest, slot.offset + filled, m_block_size)
+                                           : FileOps::read_scatter(m_handle, Span<const Span<u8>>(&rest, 1),
+                                                                   slot.offset + filled);
+      if (!read_length)
+      {
+        slot.is_async = false;
+        return fail(std::move(read_length.error()));
+      }
+      filled += *read_length;
+    }
+
+    slot.length = filled;
+    slot.is_pending = false;
+    if (filled < size)
+    {
+      m_end_reached = true;
+    }
+    return {};
+  }
+
+  auto FileReader::advance() -> Result<void>
+  {
+    MutRef<detail::StreamSlot> consumed = m_slots[m_current];
+    const u64 end_offset = consumed.offset + consumed.length;
+    if (m_drop_behind && consumed.length > 0)
+    {
+      advise(m_handle, consumed.offset, consumed.length, ADVICE_DONT_NEED);
+    }
+    consumed.length = 0;
+    if (!m_end_reached)
+    {
+      start_fill(consumed);
+    }
+
+    m_current ^= 1;
+    m_cursor = 0;
+
+    MutRef<detail::StreamSlot> next = m_slots[m_current];
+    Mut<Result<void>> filled = finish_fill(next);
+    if (filled && next.length == 0)
+    {
+      // Past end of file. Reads issued ahead there may have been placed beyond it.
+      next.offset = end_offset;
+    }
+    if (filled && m_head_skip > 0)
+    {
+      m_cursor = std::min(m_head_skip, next.length);
+      m_head_skip = 0;
+    }
+    return filled;
+  }
+
+  FileWriter::~FileWriter()
+  {
+    (void) close();
+  }
+
+  auto FileWriter::open(Ref<Path> path, const bool overwrite, const usize buffer_size,
+                        const FileOps::FileCaching caching) -> Result<void>
+  {
+    // Direct mode reads back the partial last block on flush.
+    const FileOps::FileAccess access =
+        caching == FileOps::FileCaching::Direct ? FileOps::FileAccess::ReadWrite : FileOps::FileAccess::Write;
+    Mut<Result<NativeFileHandle>> handle = FileOps::native_open_file(
+        path, access, overwrite ? FileOps::FileMode::CreateAlways : FileOps::FileMode::CreateNew, 0644, caching);
+    if (!handle)
+    {
+      return fail(std::move(handle.error()));
+    }
+
+    Mut<Result<void>> opened = open(*handle, 0, buffer_size, caching);
+    if (!opened)
+    {
+      FileOps::native_close_file(*handle);
+      return opened;
+    }
+    m_owns_handle = true;
+    return {};
+  }
+
+  auto FileWriter::open(const NativeFileHandle handle, const u64 offset, const usize buffer_size,
+                        const FileOps::FileCaching caching) -> Result<void>
+  {
+    Mut<Result<void>> closed = close();
+    if (!closed)
+    {
+      return closed;
+    }
+    if (handle == INVALID_FILE_HANDLE)
+    {
+      return fail("Cannot stream to an invalid file handle");
+    }
+
+    Mut<Result<StreamAlignment>> alignment = get_stream_alignment(handle, caching);
+    if (!alignment)
+    {
+      return fail(std::move(alignment.error()));
+    }
+
+    // Direct writes start at the block holding `offset`, with the bytes already before it read into the buffer.
+    m_block_size = alignment->block_size;
+    const usize head = m_block_size > 0 ? static_cast<usize>(offset % m_block_size) : 0;
+    const u64 start = offset - head;
+
+    // Room for a whole block on top of a partial one, so reserve can always make progress.
+    const usize size = round_up_to_alignment(std::max(buffer_size, 2 * m_block_size), alignment->memory);
+    for (MutRef<detail::StreamSlot> slot : m_slots)
+    {
+      slot.buffer.allocate(size, alignment->memory);
+      slot.length = 0;
+      slot.offset = start;
+      slot.is_pending = false;
+    }
+
+    if (head > 0)
+    {
+      MutRef<detail::StreamSlot> slot = m_slots[0];
+      Mut<Result<usize>> read_length =
+          read_direct(handle, Span<u8>(slot.buffer.get_data(), m_block_size), start, m_block_size);
+      if (!read_length)
+      {
+        for (MutRef<detail::StreamSlot> released : m_slots)
+        {
+          released.buffer.release();
+        }
+        return fail(std::move(read_length.error()));
+      }
+      if (*read_length < head)
+      {
+        std::memset(slot.buffer.get_data() + *read_length, 0, head - *read_length);
+      }
+      slot.length = head;
+    }
+
+    m_handle = handle;
+    m_owns_handle = false;
+    m_write_behind = is_async_file_io_available();
+    m_next_offset = start;
+    m_current = 0;
+    return {};
+  }
+
+  auto FileWriter::close() -> Result<void>
+  {
+    if (!is_open())
+    {
+      return {};
+    }
+
+    Mut<Result<void>> flushed = flush();
+    for (MutRef<detail::StreamSlot> slot : m_slots)
+    {
+      slot.buffer.release();
+    }
+
+    if (m_owns_handle)
+    {
+      FileOps::native_close_file(m_handle);
+    }
+    m_handle = INVALID_FILE_HANDLE;
+    m_owns_handle = false;
+    return flushed;
+  }
+
+  auto FileWriter::write(const Span<const u8> data) -> Result<void>
+  {
+    ensure(is_open(), "FileWriter is not open");
+
+    Mut<usize> written = 0;
+    while (written < data.size())
+    {
+      MutRef<detail::StreamSlot> slot = m_slots[m_current];
+      const usize space = slot.buffer.get_size() - slot.length;
+      if (space == 0)
+      {
+        Mut<Result<void>> rotated = rotate();
+        if (!rotated)
+        {
+          return rotated;
+        }
+        continue;
+      }
+
+      const usize count = std::min(space, data.size() - written);
+      std::memcpy(slot.buffer.get_data() + slot.length, data.data() + written, count);
+      slot.length += count;
+      written += count;
+    }
+    return {};
+  }
+
+  auto FileWriter::reserve(const usize min_size) -> Result<Span<u8>>
+  {
+    ensure(is_open(), "FileWriter is not open");
+    ensure(min_size + m_block_size <= m_slots[m_current].buffer.get_size(),
+           "Cannot reserve more than the buffer size");
+
+    if (m_slots[m_current].buffer.get_size() - m_slots[m_current].length < min_size)
+    {
+      Mut<Result<void>> rotated = rotate();
+      if (!rotated)
+      {
+        return fail(std::move(rotated.error()));
+      }
+    }
+
+    Ref<detail::StreamSlot> slot = m_slots[m_current];
+    return Span<u8>(slot.buffer.get_data() + slot.length, slot.buffer.get_size() - slot.length);
+  }
+
+  auto FileWriter::commit(const usize count) -> void
+  {
+    MutRef<detail::StreamSlot> slot = m_slots[m_current];
+    ensure(count <= slot.buffer.get_size() - slot.length, "Cannot commit more bytes than were reserved");
+    slot.length += count;
+  }
+
+  auto FileWriter::flush() -> Result<void>
+  {
+    ensure(is_open(), "FileWriter is not open");
+
+    if (m_block_size > 0)
+    {
+      return flush_direct();
+    }
+
+    MutRef<detail::StreamSlot> current = m_slots[m_current];
+    if (current.length > 0)
+    {
+      start_write(current);
+    }
+
+    // The other slot's write was issued first, so finish it first.
+    Mut<Result<void>> earlier = finish_write(m_slots[m_current ^ 1]);
+    Mut<Result<void>> later = finish_write(current);
+    return earlier ? later : earlier;
+  }
+
+  auto FileWriter::start_write(MutRef<detail::StreamSlot> slot) -> void
+  {
+    slot.offset = m_next_offset;
+    slot.is_pending = true;
+    slot.is_async = m_write_behind;
+    m_next_offset += slot.length;
+
+    if (slot.is_async)
+    {
+      slot.result = 0;
+      AsyncFileOps::write_at(m_handle, Span<const u8>(slot.buffer.get_data(), slot.length), slot.offset,
+                             &slot.schedule, &slot.result);
+    }
+  }
+
+  // A failed write is reported once and its bytes are dropped, so the buffer can be reused.
+  auto FileWriter::finish_write(MutRef<detail::StreamSlot> slot) -> Result<void>
+  {
+    if (!slot.is_pending)
+    {
+      return {};
+    }
+    slot.is_pending = false;
+
+    Mut<usize> written = 0;
+    if (slot.is_async)
+    {
+      AsyncOps::wait_for_schedule_completion(&slot.schedule);
+      if (!slot.result)
+      {
+        slot.length = 0;
+        return fail(std::move(slot.result.error()));
+      }
+      written = *slot.result;
+    }
+
+    if (written < slot.length)
+    {
+      const Span<const u8> rest[] = {Span<const u8>(slot.buffer.get_data() + written, slot.length - written)};
+      Mut<Result<usize>> write_length = FileOps::write_gather(m_handle, rest, slot.offset + written);
+      if (!write_length)
+      {
+        slot.length = 0;
+        return fail(std::move(write_length.error()));
+      }
+    }
+
+    slot.length = 0;
+    return {};
+  }
+
+  auto FileWriter::rotate() -> Result<void>
+  {
+    // Direct writes go out in whole blocks. The partial block at the end moves to the front of the other buffer.
+    MutRef<detail::StreamSlot> full = m_slots[m_current];
+    const usize tail = m_block_size > 0 ? full.length % m_block_size : 0;
+    full.length -= tail;
+    start_write(full);
+    m_current ^= 1;
+
+    MutRef<detail::StreamSlot> next = m_slots[m_current];
+    Mut<Result<void>> finished = finish_write(next);
+    if (tail > 0)
+    {
+      // The write in flight only reads the bytes before the tail.
+      std::memcpy(next.buffer.get_data(), full.buffer.get_data() + full.length, tail);
+      next.length = tail;
+    }
+    return finished;
+  }
+
+  auto FileWriter::flush_direct() -> Result<void>
+  {
+    MutRef<detail::StreamSlot> current = m_slots[m_current];
+    MutRef<detail::StreamSlot> other = m_slots[m_current ^ 1];
+    const usize tail = current.length % m_block_size;
+    const usize whole = current.length - tail;
+
+    Mut<Result<void>> earlier = finish_write(other);
+    if (tail == 0)
+    {
+      if (current.length > 0)
+      {
+        start_write(current);
+      }
+      Mut<Result<void>> later = finish_write(current);
+      return earlier ? later : earlier;
+    }
+    if (!earlier)
+    {
+      return earlier;
+    }
+
+    // Pad the partial block with whatever the file holds after it, so rewriting the whole block loses nothing.
+    const u64 block_offset = m_next_offset + whole;
+    Mut<Result<u64>> file_size = FileOps::get_file_size(m_handle);
+    if (!file_size)
+    {
+      return fail(std::move(file_size.error()));
+    }
+    Mut<usize> existing = 0;
+    if (*file_size > block_offset + tail)
+    {
+      Mut<Result<usize>> read_length =
+          read_direct(m_handle, Span<u8>(other.buffer.get_data(), m_block_size), block_offset, m_block_size);
+      if (!read_length)
+      {
+        return fail(std::move(read_length.error()));
+      }
+      existing = std::max(*read_length, tail);
+      std::memcpy(current.buffer.get_data() + whole + tail, other.buffer.get_data() + tail, existing - tail);
+    }
+    std::memset(current.buffer.get_data() + whole + std::max(existing, tail), 0,
+                m_block_size - std::max(existing, tail));
+
+    const Span<const u8> blocks[] = {Span<const u8>(current.buffer.get_data(), whole + m_block_size)};
+    Mut<Result<usize>> written = FileOps::write_gather(m_handle, blocks, m_next_offset);
+    if (!written)
+    {
+      return fail(std::move(written.error()));
+    }
+
+    // Trim the padding back off, unless the file already reached past it.
+    const u64 end_offset = std::max<u64>(*file_size, block_offset + tail);
+    if (end_offset < block_offset + m_block_size)
+    {
+      Mut<Result<void>> trimmed = FileOps::set_file_size(m_handle, end_offset);
+      if (!trimmed)
+      {
+        return trimmed;
+      }
+    }
+
+    // Keep the partial block buffered, so the next flush writes it again whole.
+    std::memmove(current.buffer.get_data(), current.buffer.get_data() + whole, tail);
+    current.length = tail;
+    m_next_offset = block_offset;
+    return {};
+  }
+} // namespace ia
@@ -0,0 +1,111 @@
+// IA-PlatformOps; C++ 20 Async, Process and File Operations.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <futex.hpp>
+
+#include <algorithm>
+#include <thread>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#  include <immintrin.h>
+#endif
+
+#if IA_PLATFORM_UNIX && defined(__linux__)
+#  include <cerrno>
+#  include <climits>
+#  include <ctime>
+#  include <linux/futex.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#endif
+
+namespace ia
+{
+  static_assert(sizeof(std::atomic<u32>) == sizeof(u32) && std::atomic<u32>::is_always_lock_free,
+                "Futex words must be plain lock-free 32-bit integers");
+
+  auto Futex::get_spin_count() -> u32
+  {
+    static const u32 s_spin_count = std::thread::hardware_concurrency() > 1 ? 256 : 0;
+    return s_spin_count;
+  }
+
+  auto Futex::relax() -> void
+  {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+  }
+
+#if IA_PLATFORM_UNIX && defined(__linux__)
+  auto Futex::wait(Ref<std::atomic<u32>> word, const u32 expected, const std::chrono::nanoseconds timeout) -> bool
+  {
+    Mut<struct timespec> relative;
+    Mut<struct timespec *> relative_ptr = nullptr;
+    if (timeout != INFINITE_TIMEOUT)
+    {
+      const i64 nanoseconds = std::max<i64>(timeout.count(), 0);
+      relative.tv_sec = static_cast<time_t>(nanoseconds / 1'000'000'000);
+      relative.tv_nsec = static_cast<long>(nanoseconds % 1'000'000'000);
+      relative_ptr = &relative;
+    }
+
+    // EAGAIN (the word already changed) and EINTR both count as a wakeup.
+    const long result = syscall(SYS_futex, reinterpret_cast<const u32 *>(&word), FUTEX_WAIT, expected, relative_ptr,
+                                nullptr, 0);
+    return result == 0 || errno != ETIMEDOUT;
+  }
+
+  auto Futex::wake_one(MutRef<std::atomic<u32>> word) -> void
+  {
+    syscall(SYS_futex, reinterpret_cast<u32 *>(&word), FUTEX_WAKE, 1, nullptr, nullptr, 0);
+  }
+
+  auto Futex::wake_all(MutRef<std::atomic<u32>> word) -> void
+  {
+    syscall(SYS_futex, reinterpret_cast<u32 *>(&word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+  }
+#else
+  // Short enough to keep latency tolerable, long enough not to burn a core while idle.
+  static constexpr const std::chrono::microseconds POLL_INTERVAL{100};
+
+  auto Futex::wait(Ref<std::atomic<u32>> word, const u32 expected, const std::chrono::nanoseconds timeout) -> bool
+  {
+    if (word.load(std::memory_order_acquire) != expected)
+    {
+      return true;
+    }
+    if (timeout <= std::chrono::nanoseconds::zero())
+    {
+      return false;
+    }
+
+    std::this_thread::sleep_for(std::min<std::chrono::nanoseconds>(timeout, POLL_INTERVAL));
+    return timeout > POLL_INTERVAL || word.load(std::memory_order_acquire) != expected;
+  }
+
+  auto Futex::wake_one(MutRef<std::atomic<u32>> word) -> void
+  {
+    AU_UNUSED(word);
+  }
+
+  auto Futex::wake_all(MutRef<std::atomic<u32>> word) -> void
+  {
+    AU_UNUSED(word);
+  }
+#endif
+} // namespace ia
@@ -0,0 +1,213 @@
+// IA-PlatformOps; C++ 20 Async, Process and File Operations.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <io_uring.hpp>
+
+#if IA_HAS_IO_URING
+#  include <algorithm>
+#  include <cerrno>
+#  include <cstring>
+#  include <sys/mman.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+
+namespace ia
+{
+  static auto map_ring(const usize size, const i32 fd, const u64 offset) -> void *
+  {
+    Mut<void *> mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd,
+                               static_cast<off_t>(offset));
+    return mapping == MAP_FAILED ? nullptr : mapping;
+  }
+
+  template<typename T> static auto ring_field(Mut<void *> mapping, const u32 offset) -> T *
+  {
+    return reinterpret_cast<T *>(static_cast<u8 *>(mapping) + offset);
+  }
+
+  auto IoUring::create(const u32 entries) -> Result<Box<IoUring>>
+  {
+    Mut<io_uring_params> params{};
+    const i32 fd = static_cast<i32>(syscall(__NR_io_uring_setup, entries, &params));
+    if (fd < 0)
+    {
+      return fail("io_uring_setup failed: {}", errno);
+    }
+
+    Mut<Box<IoUring>> ring(new IoUring());
+    ring->m_fd = fd;
+
+    if ((params.features & IORING_FEAT_RW_CUR_POS) == 0)
+    {
+      return fail("io_uring does not support IORING_OP_READ/WRITE on this kernel");
+    }
+
+    const usize sq_size = params.sq_off.array + params.sq_entries * sizeof(u32);
+    const usize cq_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool single_mapping = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+
+    ring->m_sq_mapping_size = single_mapping ? std::max(sq_size, cq_size) : sq_size;
+    ring->m_sq_mapping = map_ring(ring->m_sq_mapping_size, fd, IORING_OFF_SQ_RING);
+    if (!ring->m_sq_mapping)
+    {
+      return fail("Failed to map io_uring submission ring: {}", errno);
+    }
+
+    if (single_mapping)
+    {
+      ring->m_cq_mapping = ring->m_sq_mapping;
+    }
+    else
+    {
+      ring->m_cq_mapping_size = cq_size;
+      ring->m_cq_mapping = map_ring(cq_size, fd, IORING_OFF_CQ_RING);
+      if (!ring->m_cq_mapping)
+      {
+        return fail("Failed to map io_uring completion ring: {}", errno);
+      }
+    }
+
+    ring->m_sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+    ring->m_sqes = static_cast<io_uring_sqe *>(map_ring(ring->m_sqes_size, fd, IORING_OFF_SQES));
+    if (!ring->m_sqes)
+    {
+      return fail("Failed to map io_uring submission entries: {}", errno);
+    }
+
+    ring->m_sq_head = ring_field<u32>(ring->m_sq_mapping, params.sq_off.head);
+    ring->m_sq_tail = ring_field<u32>(ring->m_sq_mapping, params.sq_off.tail);
+    ring->m_sq_array = ring_field<u32>(ring->m_sq_mapping, params.sq_off.array);
+    ring->m_sq_mask = *ring_field<u32>(ring->m_sq_mapping, params.sq_off.ring_mask);
+    ring->m_sq_entries = *ring_field<u32>(ring->m_sq_mapping, params.sq_off.ring_entries);
+    ring->m_sq_local_tail = *ring->m_sq_tail;
+
+    ring->m_cq_head = ring_field<u32>(ring->m_cq_mapping, params.cq_off.head);
+    ring->m_cq_tail = ring_field<u32>(ring->m_cq_mapping, params.cq_off.tail);
+    ring->m_cqes = ring_field<io_uring_cqe>(ring->m_cq_mapping, params.cq_off.cqes);
+    ring->m_cq_mask = *ring_field<u32>(ring->m_cq_mapping, params.cq_off.ring_mask);
+    ring->m_cq_entries = *ring_field<u32>(ring->m_cq_mapping, params.cq_off.ring_entries);
+
+    return ring;
+  }
+
+  IoUring::~IoUring()
+  {
+    if (m_sqes)
+    {
+      munmap(m_sqes, m_sqes_size);
+    }
+    if (m_cq_mapping && m_cq_mapping != m_sq_mapping)
+    {
+      munmap(m_cq_mapping, m_cq_mapping_size);
+    }
+    if (m_sq_mapping)
+    {
+      munmap(m_sq_mapping, m_sq_mapping_size);
+    }
+    if (m_fd != -1)
+    {
+      close(m_fd);
+    }
+  }
+
+  auto IoUring::get_submission_entry() -> io_uring_sqe *
+  {
+    const u32 head = std::atomic_ref<u32>(*m_sq_head).load(std::memory_order_acquire);
+    if (m_sq_local_tail - head >= m_sq_entries)
+    {
+      return nullptr;
+    }
+
+    const u32 index = m_sq_local_tail & m_sq_mask;
+    Mut<io_uring_sqe *> entry = &m_sqes[index];
+    std::memset(entry, 0, sizeof(io_uring_sqe));
+    m_sq_array[index] = index;
+    m_sq_local_tail++;
+    return entry;
+  }
+
+  auto IoUring::submit() -> Result<void>
+  {
+    std::atomic_ref<u32>(*m_sq_tail).store(m_sq_local_tail, std::memory_order_release);
+
+    // Counted from what the kernel has consumed, so entries a failed call left behind go out with this one.
+    Mut<u32> remaining = m_sq_local_tail - std::atomic_ref<u32>(*m_sq_head).load(std::memory_order_acquire);
+    while (remaining > 0)
+    {
+      const i32 submitted = enter(remaining, 0, 0);
+      if (submitted < 0)
+      {
+        if (errno == EINTR)
+        {
+          continue;
+        }
+        return fail("io_uring_enter failed to submit: {}", errno);
+      }
+      if (submitted == 0)
+      {
+        return fail("io_uring_enter accepted none of {} entries", remaining);
+      }
+      remaining = m_sq_local_tail - std::atomic_ref<u32>(*m_sq_head).load(std::memory_order_acquire);
+    }
+    return {};
+  }
+
+  auto IoUring::wait_for_completion() -> Result<void>
+  {
+    while (*m_cq_head == std::atomic_ref<u32>(*m_cq_tail).load(std::memory_order_acquire))
+    {
+      if (enter(0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR)
+      {
+        return fail("io_uring_enter failed to wait: {}", errno);
+      }
+    }
+    return {};
+  }
+
+  auto IoUring::register_buffers(const Span<const iovec> buffers) -> Result<void>
+  {
+    if (syscall(__NR_io_uring_register, m_fd, IORING_REGISTER_BUFFERS, buffers.data(),
+                static_cast<u32>(buffers.size())) < 0)
+    {
+      return fail("Failed to register io_uring buffers: {}", errno);
+    }
+    return {};
+  }
+
+  auto IoUring::unregister_buffers() -> void
+  {
+    syscall(__NR_io_uring_register, m_fd, IORING_UNREGISTER_BUFFERS, nullptr, 0);
+  }
+
+  auto IoUring::register_files(const Span<const i32> fds) -> Result<void>
+  {
+    if (syscall(__NR_io_uring_register, m_fd, IORING_REGISTER_FILES, fds.data(), static_cast<u32>(fds.size())) < 0)
+    {
+      return fail("Failed to register io_uring files: {}", errno);
+    }
+    return {};
+  }
+
+  auto IoUring::unregister_files() -> void
+  {
+    syscall(__NR_io_uring_register, m_fd, IORING_UNREGISTER_FILES, nullptr, 0);
+  }
+
+  auto IoUring::enter(const u32 submit_count, const u32 wait_count, const u32 flags) -> i32
+  {
+    return static_cast<i32>(syscall(__NR_io_uring_enter, m_fd, submit_count, wait_count, flags, nullptr, 0));
+  }
+} // namespace ia
+#endif
@@ -0,0 +1,227 @@
+// IA-PlatformOps; C++ 20 Async, Process and File Operations.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <platform_ops/line_iterator.hpp>
+
+#include <algorithm>
+#include <bit>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#  include <immintrin.h>
+#  define IA_HAS_SSE2_LINE_SCAN 1
+#  if defined(__GNUC__) || defined(__clang__)
+// Compiled for AVX2 regardless of the target flags and chosen at run time on CPUs that have it.
+#    define IA_HAS_AVX2_LINE_SCAN 1
+#  endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#  include <arm_neon.h>
+#  define IA_HAS_NEON_LINE_SCAN 1
+#endif
+
+namespace ia
+{
+  static auto find_line_break_scalar(Mut<const char *> it, const char *end) -> const char *
+  {
+    for (; it != end; ++it)
+    {
+      if (*it == '\n' || *it == '\r')
+      {
+        break;
+      }
+    }
+    return it;
+  }
+
+#if IA_HAS_SSE2_LINE_SCAN
+  static auto find_line_break_sse2(Mut<const char *> it, const char *end) -> const char *
+  {
+    const __m128i lf = _mm_set1_epi8('\n');
+    const __m128i cr = _mm_set1_epi8('\r');
+    for (; end - it >= 16; it += 16)
+    {
+      const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(it));
+      const u32 mask =
+          static_cast<u32>(_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chunk, lf), _mm_cmpeq_epi8(chunk, cr))));
+      if (mask != 0)
+      {
+        return it + std::countr_zero(mask);
+      }
+    }
+    return find_line_break_scalar(it, end);
+  }
+#endif
+
+#if IA_HAS_AVX2_LINE_SCAN
+  __attribute__((target("avx2"))) static auto find_line_break_avx2(Mut<const char *> it, const char *end)
+      -> const char *
+  {
+    const __m256i lf = _mm256_set1_epi8('\n');
+    const __m256i cr = _mm256_set1_epi8('\r');
+    for (; end - it >= 32; it += 32)
+    {
+      const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(it));
+      const u32 mask = static_cast<u32>(
+          _mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(chunk, lf), _mm256_cmpeq_epi8(chunk, cr))));
+      if (mask != 0)
+      {
+        return it + std::countr_zero(mask);
+      }
+    }
+    return find_line_break_sse2(it, end);
+  }
+#endif
+
+#if IA_HAS_NEON_LINE_SCAN
+  static auto find_line_break_neon(Mut<const char *> it, const char *end) -> const char *
+  {
+    const uint8x16_t lf = vdupq_n_u8('\n');
+    const uint8x16_t cr = vdupq_n_u8('\r');
+    for (; end - it >= 16; it += 16)
+    {
+      const uint8x16_t chunk = vld1q_u8(reinterpret_cast<const u8 *>(it));
+      const uint8x16_t matches = vorrq_u8(vceqq_u8(chunk, lf), vceqq_u8(chunk, cr));
+
+      // Narrowing shift packs the 16 byte masks into 16 nibbles, since NEON has no movemask.
+      const u64 mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(matches), 4)), 0);
+      if (mask != 0)
+      {
+        return it + std::countr_zero(mask) / 4;
+      }
+    }
+    return find_line_break_scalar(it, end);
+  }
+#endif
+
+  static auto select_line_break_finder() -> LineIterator::Finder
+  {
+#if IA_HAS_AVX2_LINE_SCAN
+    if (__builtin_cpu_supports("avx2"))
+    {
+      return find_line_break_avx2;
+    }
+#endif
+#if IA_HAS_SSE2_LINE_SCAN
+    return find_line_break_sse2;
+#elif IA_HAS_NEON_LINE_SCAN
+    return find_line_break_neon;
+#else
+    return find_line_break_scalar;
+#endif
+  }
+
+  static auto get_line_break_finder() -> LineIterator::Finder
+  {
+    static const LineIterator::Finder s_finder = select_line_break_finder();
+    return s_finder;
+  }
+
+  LineIterator::LineIterator(const StringView text)
+      : m_cursor(text.data()), m_end(text.data() + text.size()), m_find_line_break(get_line_break_finder())
+  {
+  }
+
+  LineIterator::LineIterator(const Span<const u8> data)
+      : LineIterator(StringView(reinterpret_cast<const char *>(data.data()), data.size()))
+  {
+  }
+
+  auto LineIterator::next(MutRef<StringView> line) -> bool
+  {
+    while (m_cursor != m_end)
+    {
+      const char *start = m_cursor;
+      const char *line_break = m_find_line_break(m_cursor, m_end);
+
+      m_cursor = line_break;
+      if (m_cursor != m_end)
+      {
+        ++m_cursor;
+        if (*line_break == '\r' && m_cursor != m_end && *m_cursor == '\n')
+        {
+          ++m_cursor;
+        }
+      }
+
+      if (line_break != start)
+      {
+        line = StringView(start, static_cast<usize>(line_break - start));
+        return true;
+      }
+    }
+    return false;
+  }
+
+  auto LineIterator::find_line_break(const char *begin, const char *end) -> const char *
+  {
+    return get_line_break_finder()(begin, end);
+  }
+
+  auto LineIterator::split(const StringView text, const usize max_parts) -> Vec<StringView>
+  {
+    Mut<Vec<StringView>> parts;
+    if (text.empty())
+    {
+      return parts;
+    }
+
+    const usize part_count = std::clamp<usize>(max_parts, 1, text.size());
+    const usize target_size = text.size() / part_count;
+    const char *end = text.data() + text.size();
+
+    parts.reserve(part_count);
+    Mut<const char *> start = text.data();
+    while (start != end)
+    {
+      Mut<const char *> cut = end;
+      if (parts.size() + 1 < part_count && static_cast<usize>(end - start) > target_size)
+      {
+        cut = find_line_break(start + target_size, end);
+        if (cut != end)
+        {
+          // Keep a "\r\n" pair together in the piece it ends.
+          cut += (*cut == '\r' && cut + 1 != end && cut[1] == '\n') ? 2 : 1;
+        }
+      }
+      parts.emplace_back(start, static_cast<usize>(cut - start));
+      start = cut;
+    }
+    return parts;
+  }
+
+  auto LineIterator::for_each_line_parallel(const StringView text,
+                                            Ref<std::function<void(StringView, AsyncOps::WorkerId)>> fn,
+                                            const usize min_chunk_size) -> void
+  {
+    // A few pieces per worker keep them all busy when line density varies across the text.
+    const usize worker_count = AsyncOps::get_worker_count();
+    const usize part_count = std::min(worker_count * 4, text.size() / std::max<usize>(min_chunk_size, 1));
+    if (part_count < 2)
+    {
+      for_each_line(text, [&fn](const StringView line) { fn(line, AsyncOps::MAIN_THREAD_WORKER_ID); });
+      return;
+    }
+
+    Mut<AsyncOps::Schedule> schedule;
+    for (const StringView part : split(text, part_count))
+    {
+      AsyncOps::schedule_task(
+          [part, &fn](const AsyncOps::WorkerId worker_id) {
+            for_each_line(part, [&fn, worker_id](const StringView line) { fn(line, worker_id); });
+          },
+          0, &schedule);
+    }
+    AsyncOps::wait_for_schedule_completion(&schedule);
+  }
+} // namespace ia
@@ -0,0 +1,234 @@
+// IA-PlatformOps; C++ 20 Async, Process and File Operations.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <platform_ops/mapped_log.hpp>
+
+#include <cstring>
+
+#if IA_PLATFORM_UNIX
+#  include <sys/mman.h>
+#endif
+
+namespace ia
+{
+  // Both page sizes and Windows' 64 KiB view alignment divide this.
+  static constexpr const usize EXTENT_ALIGNMENT = 64 * 1024;
+
+  // Faulting a fresh extent in writable with one call costs far less than taking a write fault per page while
+  // appending. Only a speed-up, so failure is ignored.
+  static auto populate_for_writing(Mut<u8 *> data, const usize size) -> void
+  {
+#if IA_PLATFORM_UNIX && defined(MADV_POPULATE_WRITE)
+    (void) madvise(data, size, MADV_POPULATE_WRITE);
+#else
+    AU_UNUSED(data);
+    AU_UNUSED(size);
+#endif
+  }
+
+  MappedLog::~MappedLog()
+  {
+    (void) close();
+  }
+
+  auto MappedLog::open(Ref<Path> path, const usize extent_size, const u64 max_size) -> Result<void>
+  {
+    Mut<Result<void>> closed = close();
+    if (!closed)
+    {
+      return closed;
+    }
+
+    Mut<Result<NativeFileHandle>> handle =
+        FileOps::native_open_file(path, FileOps::FileAccess::ReadWrite, FileOps::FileMode::OpenAlways);
+    if (!handle)
+    {
+      return fail(std::move(handle.error()));
+    }
+
+    Mut<Result<u64>> size = FileOps::get_file_size(*handle);
+    if (!size)
+    {
+      FileOps::native_close_file(*handle);
+      return fail(std::move(size.error()));
+    }
+
+    m_extent_size = (std::max<usize>(extent_size, 1) + EXTENT_ALIGNMENT - 1) / EXTENT_ALIGNMENT * EXTENT_ALIGNMENT;
+    m_extent_capacity = static_cast<usize>((std::max(max_size, *size) + m_extent_size - 1) / m_extent_size);
+    m_max_size = static_cast<u64>(m_extent_capacity) * m_extent_size;
+    m_extent_data = std::make_unique<std::atomic<u8 *>[]>(m_extent_capacity);
+    m_extents.clear();
+    m_extents.reserve(std::min<usize>(m_extent_capacity, 64));
+    m_mapped_count.store(0, std::memory_order_relaxed);
+    m_size.store(*size, std::memory_order_relaxed);
+    m_map_ahead = AsyncOps::get_worker_count() > 0;
+    m_handle = *handle;
+    return {};
+  }
+
+  auto MappedLog::close() -> Result<void>
+  {
+    if (!is_open())
+    {
+      return {};
+    }
+
+    if (m_map_ahead)
+    {
+      AsyncOps::wait_for_schedule_completion(&m_schedule);
+    }
+
+    // Views must be gone before Windows lets the file shrink.
+    m_extents.clear();
+    m_extent_data.reset();
+
+    Mut<Result<void>> trimmed = FileOps::set_file_size(m_handle, get_size());
+    FileOps::native_close_file(m_handle);
+    m_handle = INVALID_FILE_HANDLE;
+    return trimmed;
+  }
+
+  auto MappedLog::append(const Span<const u8> data) -> Result<u64>
+  {
+    Mut<Result<u64>> offset = reserve(data.size());
+    if (!offset)
+    {
+      return offset;
+    }
+
+    Mut<Result<void>> written = write(*offset, data);
+    if (!written)
+    {
+      return fail(std::move(written.error()));
+    }
+    return offset;
+  }
+
+  auto MappedLog::reserve(const usize size) -> Result<u64>
+  {
+    ensure(is_open(), "MappedLog is not open");
+
+    // A compare-exchange rather than a plain add, so a reservation that does not fit leaves the size alone.
+    Mut<u64> offset = m_size.load(std::memory_order_relaxed);
+    do
+    {
+      if (size > m_max_size - offset)
+      {
+        return fail("Log is full: {} more bytes would pass its maximum size of {}", size, m_max_size);
+      }
+    } while (!m_size.compare_exchange_weak(offset, offset + size, std::memory_order_relaxed));
+    return offset;
+  }
+
+  auto MappedLog::write(const u64 offset, const Span<const u8> data) -> Result<void>
+  {
+    ensure(offset + data.size() <= get_size(), "Writes must stay within reserved space");
+
+    // A range can straddle extents, which are not adjacent in memory, so copy it one extent at a time.
+    Mut<usize> written = 0;
+    while (written < data.size())
+    {
+      const usize index = static_cast<usize>((offset + written) / m_extent_size);
+      const usize within = static_cast<usize>((offset + written) % m_extent_size);
+      const usize count = std::min(m_extent_size - within, data.size() - written);
+
+      Mut<Result<u8 *>> extent = get_extent(index);
+      if (!extent)
+      {
+        return fail(std::move(extent.error()));
+      }
+      std::memcpy(*extent + within, data.data() + written, count);
+
+      written += count;
+    }
+    return {};
+  }
+
+  auto MappedLog::flush(const bool async) -> Result<void>
+  {
+    ensure(is_open(), "MappedLog is not open");
+
+    const std::lock_guard<std::mutex> lock(m_grow_mutex);
+    for (MutRef<FileOps::MemoryMappedRegion> extent : m_extents)
+    {
+      Mut<Result<void>> flushed = extent.flush_range(0, extent.get_size(), async);
+      if (!flushed)
+      {
+        return flushed;
+      }
+    }
+    return {};
+  }
+
+  auto MappedLog::get_extent(const usize index) -> Result<u8 *>
+  {
+    Mut<u8 *> data = m_extent_data[index].load(std::memory_order_acquire);
+    if (data == nullptr)
+    {
+      Mut<Result<void>> mapped = map_extents_through(index);
+      if (!mapped)
+      {
+        return fail(std::move(mapped.error()));
+      }
+      data = m_extent_data[index].load(std::memory_order_acquire);
+    }
+
+    // Once appends reach the last mapped extent, have a worker map the next one before anybody needs it. If that
+    // fails, the append that reaches it maps it again and reports the error.
+    const usize next = index + 1;
+    if (m_map_ahead && next == m_mapped_count.load(std::memory_order_relaxed) && next < m_extent_capacity &&
+        !m_is_mapping_ahead.load(std::memory_order_relaxed) &&
+        !m_is_mapping_ahead.exchange(true, std::memory_order_acquire))
+    {
+      AsyncOps::schedule_task(
+          [this, next](const AsyncOps::WorkerId) {
+            (void) map_extents_through(next);
+            m_is_mapping_ahead.store(false, std::memory_order_release);
+          },
+          0, &m_schedule, AsyncOps::Priority::Background);
+    }
+    return data;
+  }
+
+  auto MappedLog::map_extents_through(const usize index) -> Result<void>
+  {
+    const std::lock_guard<std::mutex> lock(m_grow_mutex);
+
+    // Extents are mapped in order, so whichever appender gets here first maps for the others too.
+    while (m_extents.size() <= index)
+    {
+      const u64 offset = static_cast<u64>(m_extents.size()) * m_extent_size;
+
+      // Preallocated, since writing through a mapping into a hole the disk has no room for raises SIGBUS instead
+      // of returning an error. Not Sequential: read-ahead on a mapping that is only written slows every write
+      // fault down. Every extent flushes through the log's own handle, which outlives them, so a long log does
+      // not hold a descriptor per extent.
+      Mut<FileOps::MemoryMappedRegion> extent;
+      Mut<Result<void>> mapped =
+          extent.map(m_handle, offset, m_extent_size, FileOps::HugePages::None, FileOps::AccessHint::Normal,
+                     FileOps::Prefault::None, FileOps::FileGrowth::Preallocate, FileOps::RegionHandle::Borrow);
+      if (!mapped)
+      {
+        return mapped;
+      }
+      populate_for_writing(extent.get_ptr(), m_extent_size);
+
+      m_extent_data[m_extents.size()].store(extent.get_ptr(), std::memory_order_release);
+      m_extents.push_back(std::move(extent));
+      m_mapped_count.store(m_extents.size(), std::memory_order_relaxed);
+    }
+    return {};
+  }
+} // namespace ia
@@ -0,0 +1,64 @@
+// IA-PlatformOps; C++ 20 Async, Process and File Operations.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <platform_ops/scheduler.hpp>
+
+namespace ia
+{
+  auto sched::PriorityStats::get_mean_wait_ns() const -> u64
+  {
+    if (executed_count == 0)
+    {
+      return 0;
+    }
+    return total_wait_ns / executed_count;
+  }
+
+  auto sched::PriorityStats::get_wait_percentile_ns(const f64 percentile) const -> u64
+  {
+    if (executed_count == 0)
+    {
+      return 0;
+    }
+
+    const f64 clamped = std::clamp(percentile, 0.0, 100.0);
+    const u64 target = std::max<u64>(1, static_cast<u64>(static_cast<f64>(executed_count) * clamped / 100.0));
+
+    Mut<u64> cumulative = 0;
+    for (Mut<usize> i = 0; i < WAIT_HISTOGRAM_BUCKETS; ++i)
+    {
+      cumulative += wait_histogram[i];
+      if (cumulative >= target)
+      {
+        return std::min<u64>((1ull << i) * 1000, max_wait_ns);
+      }
+    }
+    return max_wait_ns;
+  }
+
+  auto sched::PriorityStats::record_wait(const u64 wait_ns, const bool promoted) -> void
+  {
+    const usize bucket = std::min<usize>(std::bit_width(wait_ns / 1000), WAIT_HISTOGRAM_BUCKETS - 1);
+
+    executed_count++;
+    total_wait_ns += wait_ns;
+    max_wait_ns = std::max(max_wait_ns, wait_ns);
+    wait_histogram[bucket]++;
+    if (promoted)
+    {
+      promoted_count++;
+    }
+  }
+} // namespace ia
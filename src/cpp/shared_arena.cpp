@@ -0,0 +1,241 @@
+// IA-PlatformOps; C++ 20 Async, Process and File Operations.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <platform_ops/shared_arena.hpp>
+
+#include <algorithm>
+#include <bit>
+
+namespace ia
+{
+  // Sits in front of every block. It keeps the block's size class for deallocate, and the link while the block is
+  // free. The link is atomic because a thread popping a free list may read it while another thread pops the same
+  // block first and pushes it back.
+  struct BlockHeader
+  {
+    static constexpr const u32 MAGIC = 0x424C4B21; // "BLK!"
+
+    Mut<u32> magic;
+    Mut<u32> size_class;
+    Mut<std::atomic<u32>> next;
+    Mut<u32> reserved;
+  };
+
+  static_assert(sizeof(BlockHeader) == SharedAllocator::ALIGNMENT, "Block header must keep payloads aligned");
+  static_assert(sizeof(SharedAllocator) <= SharedArena::HEADER_SIZE, "Arena header outgrew its reserved space");
+  static_assert(std::atomic<u64>::is_always_lock_free && std::atomic<u32>::is_always_lock_free,
+                "Atomics shared between processes must not hide a lock inside the process");
+
+  // The smallest block holds its header and one aligned payload.
+  static constexpr const u32 MIN_BLOCK_SHIFT = 5;
+
+  static constexpr auto get_block_size(const u32 size_class) -> u64
+  {
+    return u64{1} << (size_class + MIN_BLOCK_SHIFT);
+  }
+
+  static auto pack_list_head(const u32 index, const u32 counter) -> u64
+  {
+    return (u64{counter} << 32) | index;
+  }
+
+  SharedAllocator::SharedAllocator(const u64 capacity) : m_capacity(capacity), m_end(SharedArena::HEADER_SIZE)
+  {
+  }
+
+  auto SharedAllocator::allocate(const usize size) -> Result<u8 *>
+  {
+    if (size > m_capacity)
+    {
+      return fail("A {} byte allocation exceeds the shared arena's capacity of {}", size, m_capacity);
+    }
+    const u64 block_size = std::bit_ceil(std::max<u64>(u64{size} + sizeof(BlockHeader), get_block_size(0)));
+    const u32 size_class = static_cast<u32>(std::countr_zero(block_size)) - MIN_BLOCK_SHIFT;
+
+    // Rounding up can outgrow the arena, and past the largest size class there is no free list to index.
+    if (block_size > m_capacity || size_class >= CLASS_COUNT)
+    {
+      return fail("A {} byte allocation needs a {} byte block, more than the shared arena's capacity of {}", size,
+                  block_size, m_capacity);
+    }
+    u8 *const base = reinterpret_cast<u8 *>(this);
+
+    // Reuse a freed block of this size if there is one.
+    MutRef<std::atomic<u64>> free_list = m_free_lists[size_class];
+    Mut<u64> head = free_list.load(std::memory_order_acquire);
+    while (static_cast<u32>(head) != 0)
+    {
+      Mut<BlockHeader *> block = reinterpret_cast<BlockHeader *>(base + u64{static_cast<u32>(head)} * ALIGNMENT);
+      const u32 next = block->next.load(std::memory_order_relaxed);
+      if (free_list.compare_exchange_weak(head, pack_list_head(next, static_cast<u32>(head >> 32) + 1),
+                                          std::memory_order_acquire, std::memory_order_acquire))
+      {
+        m_used_size.fetch_add(block_size, std::memory_order_relaxed);
+        return reinterpret_cast<u8 *>(block + 1);
+      }
+    }
+
+    // Otherwise carve a new one.
+    Mut<u64> end = m_end.load(std::memory_order_relaxed);
+    do
+    {
+      if (block_size > m_capacity - end)
+      {
+        return fail("Shared arena is out of memory: {} of {} bytes in use, {} more requested", get_used_size(),
+                    m_capacity, size);
+      }
+    } while (!m_end.compare_exchange_weak(end, end + block_size, std::memory_order_relaxed));
+
+    Mut<BlockHeader *> block = new (base + end) BlockHeader();
+    block->magic = BlockHeader::MAGIC;
+    block->size_class = size_class;
+    m_used_size.fetch_add(block_size, std::memory_order_relaxed);
+    return reinterpret_cast<u8 *>(block + 1);
+  }
+
+  auto SharedAllocator::deallocate(Mut<void *> pointer) -> void
+  {
+    if (!pointer)
+    {
+      return;
+    }
+
+    Mut<BlockHeader *> block = static_cast<BlockHeader *>(pointer) - 1;
+    ensure(block->magic == BlockHeader::MAGIC && block->size_class < CLASS_COUNT,
+           "Pointer was not allocated from this shared arena");
+    const u32 index = static_cast<u32>((reinterpret_cast<u8 *>(block) - reinterpret_cast<u8 *>(this)) / ALIGNMENT);
+    m_used_size.fetch_sub(get_block_size(block->size_class), std::memory_order_relaxed);
+
+    MutRef<std::atomic<u64>> free_list = m_free_lists[block->size_class];
+    Mut<u64> head = free_list.load(std::memory_order_relaxed);
+    do
+    {
+      block->next.store(static_cast<u32>(head), std::memory_order_relaxed);
+    } while (!free_list.compare_exchange_weak(head, pack_list_head(index, static_cast<u32>(head >> 32) + 1),
+                                              std::memory_order_release, std::memory_order_relaxed));
+  }
+
+  auto SharedAllocator::set_root_offset(const u64 offset) -> void
+  {
+    m_root.store(offset, std::memory_order_release);
+  }
+
+  auto SharedAllocator::get_root_offset() const -> u64
+  {
+    return m_root.load(std::memory_order_acquire);
+  }
+
+  auto SharedArena::create(Ref<String> name, const usize capacity) -> Result<SharedArena>
+  {
+    if (capacity <= HEADER_SIZE || capacity > SharedAllocator::MAX_CAPACITY)
+    {
+      return fail("A shared arena of {} bytes is outside the supported range of {} to {}", capacity,
+                  HEADER_SIZE + 1, SharedAllocator::MAX_CAPACITY);
+    }
+
+    Mut<Result<u8 *>> segment = FileOps::map_shared_memory(name, capacity, true);
+    if (!segment)
+    {
+      return fail(std::move(segment.error()));
+    }
+
+    Mut<SharedAllocator *> allocator = new (*segment) SharedAllocator(capacity);
+    // Last, so a peer that sees the magic also sees the rest.
+    allocator->m_magic.store(SharedAllocator::MAGIC, std::memory_order_release);
+
+    Mut<SharedArena> arena;
+    arena.m_allocator = allocator;
+    arena.m_name = name;
+    arena.m_is_owner = true;
+    return arena;
+  }
+
+  auto SharedArena::open(Ref<String> name) -> Result<SharedArena>
+  {
+    // The segment size is only known once the header is readable.
+    Mut<Result<u8 *>> probe = FileOps::map_shared_memory(name, HEADER_SIZE, false);
+    if (!probe)
+    {
+      return fail(std::move(probe.error()));
+    }
+    Ref<SharedAllocator> probed = *reinterpret_cast<const SharedAllocator *>(*probe);
+    const bool is_initialized = probed.m_magic.load(std::memory_order_acquire) == SharedAllocator::MAGIC;
+    const u32 version = probed.m_version;
+    const u64 capacity = probed.m_capacity;
+    FileOps::unmap_file(*probe);
+
+    if (!is_initialized)
+    {
+      return fail("Shared arena '{}' is not initialized", name);
+    }
+    if (version != SharedAllocator::VERSION)
+    {
+      return fail("Shared arena '{}' has layout version {}, expected {}", name, version, SharedAllocator::VERSION);
+    }
+    if (capacity <= HEADER_SIZE || capacity > SharedAllocator::MAX_CAPACITY)
+    {
+      return fail("Shared arena '{}' has an invalid capacity of {}", name, capacity);
+    }
+
+    Mut<Result<u8 *>> segment = FileOps::map_shared_memory(name, static_cast<usize>(capacity), false);
+    if (!segment)
+    {
+      return fail(std::move(segment.error()));
+    }
+
+    Mut<SharedArena> arena;
+    arena.m_allocator = reinterpret_cast<SharedAllocator *>(*segment);
+    arena.m_name = name;
+    return arena;
+  }
+
+  SharedArena::~SharedArena()
+  {
+    close();
+  }
+
+  SharedArena::SharedArena(ForwardRef<SharedArena> other) noexcept
+  {
+    *this = std::move(other);
+  }
+
+  auto SharedArena::operator=(ForwardRef<SharedArena> other) noexcept -> MutRef<SharedArena>
+  {
+    if (this != &other)
+    {
+      close();
+      m_allocator = std::exchange(other.m_allocator, nullptr);
+      m_name = std::move(other.m_name);
+      m_is_owner = std::exchange(other.m_is_owner, false);
+    }
+    return *this;
+  }
+
+  auto SharedArena::close() -> void
+  {
+    if (!m_allocator)
+    {
+      return;
+    }
+
+    FileOps::unmap_file(reinterpret_cast<const u8 *>(m_allocator));
+    if (m_is_owner)
+    {
+      FileOps::unlink_shared_memory(m_name);
+    }
+    m_allocator = nullptr;
+    m_is_owner = false;
+  }
+} // namespace ia
@@ -0,0 +1,429 @@
+// IA-PlatformOps; C++ 20 Async, Process and File Operations.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <platform_ops/shared_channel.hpp>
+
+#include <futex.hpp>
+
+#include <bit>
+#include <cstring>
+#include <new>
+#include <utility>
+
+namespace ia
+{
+  using Header = detail::SharedChannelHeader;
+  using Clock = std::chrono::steady_clock;
+
+  static_assert(sizeof(Header) <= SharedChannel::HEADER_SIZE, "Channel header outgrew its reserved space");
+  static_assert(std::atomic<u64>::is_always_lock_free && std::atomic<u32>::is_always_lock_free,
+                "Atomics shared between processes must not hide a lock inside the process");
+
+  // Stands in for a record's size to say the rest of the ring is padding and the next record is at the start.
+  static constexpr const u32 WRAP_MARKER = 0xFFFFFFFF;
+
+  static constexpr const usize MIN_CAPACITY = 1024;
+
+  static auto get_record_size(const usize payload_size) -> u64
+  {
+    const usize alignment = SharedChannel::RECORD_ALIGNMENT;
+    return (sizeof(u32) + payload_size + alignment - 1) / alignment * alignment;
+  }
+
+  static auto get_deadline(const std::chrono::nanoseconds timeout) -> Clock::time_point
+  {
+    const Clock::time_point now = Clock::now();
+    if (timeout >= Clock::time_point::max() - now)
+    {
+      return Clock::time_point::max();
+    }
+    return now + std::chrono::duration_cast<Clock::duration>(timeout);
+  }
+
+  // Publishes a new position and wakes the peer if it said it was going to sleep. Both this and sleep_until_moved
+  // use sequentially consistent accesses, so either the peer sees the new position before sleeping or this sees
+  // that the peer is asleep. Clearing the flag here means one wake call per sleep, however many messages follow
+  // before the peer actually runs.
+  static auto publish(MutRef<std::atomic<u64>> position, const u64 value, MutRef<std::atomic<u32>> signal,
+                      MutRef<std::atomic<u32>> is_peer_waiting) -> void
+  {
+    position.store(value, std::memory_order_seq_cst);
+    if (is_peer_waiting.load(std::memory_order_seq_cst) != 0 &&
+        is_peer_waiting.exchange(0, std::memory_order_seq_cst) != 0)
+    {
+      signal.fetch_add(1, std::memory_order_release);
+      Futex::wake_one(signal);
+    }
+  }
+
+  // Waits, at most until `deadline`, for the peer to move `position` away from `seen` or to shut the channel down.
+  static auto sleep_until_moved(Ref<std::atomic<u64>> position, const u64 seen, MutRef<std::atomic<u32>> signal,
+                                MutRef<std::atomic<u32>> is_waiting, Ref<std::atomic<u32>> is_shut_down,
+                                const Clock::time_point deadline) -> void
+  {
+    for (Mut<u32> i = 0; i < Futex::get_spin_count(); ++i)
+    {
+      if (position.load(std::memory_order_acquire) != seen)
+      {
+        return;
+      }
+      Futex::relax();
+    }
+
+    const u32 signal_value = signal.load(std::memory_order_acquire);
+    is_waiting.store(1, std::memory_order_seq_cst);
+    if (position.load(std::memory_order_seq_cst) == seen && is_shut_down.load(std::memory_order_seq_cst) == 0)
+    {
+      const Clock::time_point now = Clock::now();
+      if (deadline == Clock::time_point::max())
+      {
+        Futex::wait(signal, signal_value);
+      }
+      else if (now < deadline)
+      {
+        Futex::wait(signal, signal_value, deadline - now);
+      }
+    }
+    is_waiting.store(0, std::memory_order_relaxed);
+  }
+
+  auto SharedChannel::create(Ref<String> name, const usize capacity) -> Result<SharedChannel>
+  {
+    const usize ring_size = std::bit_ceil(std::max(capacity, MIN_CAPACITY));
+    Mut<Result<u8 *>> segment = FileOps::map_shared_memory(name, HEADER_SIZE + ring_size, true);
+    if (!segment)
+    {
+      return fail(std::move(segment.error()));
+    }
+
+    Mut<Header *> header = new (*segment) Header();
+    header->version = Header::VERSION;
+    header->capacity = ring_size;
+    // Last, so a peer that sees the magic also sees the rest.
+    header->magic.store(Header::MAGIC, std::memory_order_release);
+
+    Mut<SharedChannel> channel;
+    channel.m_header = header;
+    channel.m_ring = *segment + HEADER_SIZE;
+    channel.m_capacity = ring_size;
+    channel.m_name = name;
+    channel.m_is_owner = true;
+    return channel;
+  }
+
+  auto SharedChannel::open(Ref<String> name) -> Result<SharedChannel>
+  {
+    // The ring size is only known once the header is readable.
+    Mut<Result<u8 *>> probe = FileOps::map_shared_memory(name, HEADER_SIZE, false);
+    if (!probe)
+    {
+      return fail(std::move(probe.error()));
+    }
+    Ref<Header> probed = *reinterpret_cast<const Header *>(*probe);
+    const bool is_initialized = probed.magic.load(std::memory_order_acquire) == Header::MAGIC;
+    const u32 version = probed.version;
+    const u64 capacity = probed.capacity;
+    FileOps::unmap_file(*probe);
+
+    if (!is_initialized)
+    {
+      return fail("Shared channel '{}' is not initialized", name);
+    }
+    if (version != Header::VERSION)
+    {
+      return fail("Shared channel '{}' has layout version {}, expected {}", name, version, Header::VERSION);
+    }
+    if (capacity < MIN_CAPACITY || !std::has_single_bit(capacity))
+    {
+      return fail("Shared channel '{}' has an invalid capacity of {}", name, capacity);
+    }
+
+    Mut<Result<u8 *>> segment = FileOps::map_shared_memory(name, HEADER_SIZE + static_cast<usize>(capacity), false);
+    if (!segment)
+    {
+      return fail(std::move(segment.error()));
+    }
+
+    Mut<SharedChannel> channel;
+    channel.m_header = reinterpret_cast<Header *>(*segment);
+    channel.m_ring = *segment + HEADER_SIZE;
+    channel.m_capacity = static_cast<usize>(capacity);
+    channel.m_name = name;
+    channel.m_cached_head = channel.m_header->head.load(std::memory_order_acquire);
+    channel.m_cached_tail = channel.m_header->tail.load(std::memory_order_acquire);
+    return channel;
+  }
+
+  SharedChannel::~SharedChannel()
+  {
+    close();
+  }
+
+  SharedChannel::SharedChannel(ForwardRef<SharedChannel> other) noexcept
+  {
+    *this = std::move(other);
+  }
+
+  auto SharedChannel::operator=(ForwardRef<SharedChannel> other) noexcept -> MutRef<SharedChannel>
+  {
+    if (this != &other)
+    {
+      close();
+      m_header = std::exchange(other.m_header, nullptr);
+      m_ring = std::exchange(other.m_ring, nullptr);
+      m_capacity = std::exchange(other.m_capacity, 0);
+      m_name = std::move(other.m_name);
+      m_is_owner = std::exchange(other.m_is_owner, false);
+      m_cached_tail = other.m_cached_tail;
+      m_cached_head = other.m_cached_head;
+      m_reserved_at = other.m_reserved_at;
+      m_reserved_size = other.m_reserved_size;
+      m_has_reservation = std::exchange(other.m_has_reservation, false);
+      m_received_end = other.m_received_end;
+      m_has_received = std::exchange(other.m_has_received, false);
+    }
+    return *this;
+  }
+
+  auto SharedChannel::close() -> void
+  {
+    if (!m_header)
+    {
+      return;
+    }
+
+    FileOps::unmap_file(reinterpret_cast<const u8 *>(m_header));
+    if (m_is_owner)
+    {
+      FileOps::unlink_shared_memory(m_name);
+    }
+    m_header = nullptr;
+    m_ring = nullptr;
+    m_capacity = 0;
+    m_is_owner = false;
+    m_has_reservation = false;
+    m_has_received = false;
+  }
+
+  auto SharedChannel::send(const Span<const u8> message) -> Result<void>
+  {
+    Mut<Result<bool>> sent = send_for(message, Futex::INFINITE_TIMEOUT);
+    if (!sent)
+    {
+      return fail(std::move(sent.error()));
+    }
+    return {};
+  }
+
+  auto SharedChannel::send_for(const Span<const u8> message, const std::chrono::nanoseconds timeout)
+      -> Result<bool>
+  {
+    ensure(is_valid(), "SharedChannel is not open");
+    ensure(!m_has_reservation, "Commit the reserved message before sending another");
+    if (message.size() > get_max_message_size())
+    {
+      return fail("A {} byte message exceeds the channel limit of {}", message.size(), get_max_message_size());
+    }
+
+    Mut<Result<bool>> claimed = wait_for_space(message.size(), get_deadline(timeout));
+    if (!claimed || !*claimed)
+    {
+      return claimed;
+    }
+    std::memcpy(m_ring + (m_reserved_at & (m_capacity - 1)) + sizeof(u32), message.data(), message.size());
+    commit(message.size());
+    return true;
+  }
+
+  auto SharedChannel::try_send(const Span<const u8> message) -> Result<bool>
+  {
+    return send_for(message, std::chrono::nanoseconds::zero());
+  }
+
+  auto SharedChannel::reserve(const usize size) -> Result<Span<u8>>
+  {
+    ensure(is_valid(), "SharedChannel is not open");
+    ensure(!m_has_reservation, "Commit the reserved message before reserving another");
+    if (size > get_max_message_size())
+    {
+      return fail("A {} byte message exceeds the channel limit of {}", size, get_max_message_size());
+    }
+
+    Mut<Result<bool>> claimed = wait_for_space(size, Clock::time_point::max());
+    if (!claimed)
+    {
+      return fail(std::move(claimed.error()));
+    }
+    return Span<u8>(m_ring + (m_reserved_at & (m_capacity - 1)) + sizeof(u32), size);
+  }
+
+  auto SharedChannel::commit(const usize size) -> void
+  {
+    ensure(m_has_reservation, "No message is reserved");
+    ensure(size <= m_reserved_size, "Cannot commit more than was reserved");
+
+    const u32 record_header = static_cast<u32>(size);
+    std::memcpy(m_ring + (m_reserved_at & (m_capacity - 1)), &record_header, sizeof(record_header));
+    m_has_reservation = false;
+    publish(m_header->head, m_reserved_at + get_record_size(size), m_header->data_signal,
+            m_header->is_consumer_waiting);
+  }
+
+  auto SharedChannel::try_claim(const usize size) -> std::optional<u64>
+  {
+    const u64 head = m_header->head.load(std::memory_order_relaxed);
+    const u64 offset = head & (m_capacity - 1);
+    const u64 record_size = get_record_size(size);
+    const u64 room_to_end = m_capacity - offset;
+
+    // A record never wraps. If it does not fit before the end, the rest of the ring is skipped.
+    const u64 needed = record_size <= room_to_end ? record_size : room_to_end + record_size;
+    if (head + needed - m_cached_tail > m_capacity)
+    {
+      m_cached_tail = m_header->tail.load(std::memory_order_acquire);
+      if (head + needed - m_cached_tail > m_capacity)
+      {
+        return std::nullopt;
+      }
+    }
+
+    if (record_size <= room_to_end)
+    {
+      return head;
+    }
+    std::memcpy(m_ring + offset, &WRAP_MARKER, sizeof(WRAP_MARKER));
+    return head + room_to_end;
+  }
+
+  auto SharedChannel::wait_for_space(const usize size, const Clock::time_point deadline) -> Result<bool>
+  {
+    while (true)
+    {
+      if (is_shut_down())
+      {
+        return fail("Shared channel '{}' is shut down", m_name);
+      }
+
+      const std::optional<u64> claimed = try_claim(size);
+      if (claimed)
+      {
+        m_reserved_at = *claimed;
+        m_reserved_size = size;
+        m_has_reservation = true;
+        return true;
+      }
+      if (Clock::now() >= deadline)
+      {
+        return false;
+      }
+      sleep_until_moved(m_header->tail, m_cached_tail, m_header->space_signal, m_header->is_producer_waiting,
+                        m_header->is_shut_down, deadline);
+    }
+  }
+
+  auto SharedChannel::receive() -> std::optional<Span<const u8>>
+  {
+    return receive_for(Futex::INFINITE_TIMEOUT);
+  }
+
+  auto SharedChannel::receive_for(const std::chrono::nanoseconds timeout) -> std::optional<Span<const u8>>
+  {
+    const Clock::time_point deadline = get_deadline(timeout);
+    while (true)
+    {
+      const std::optional<Span<const u8>> message = try_receive();
+      if (message)
+      {
+        return message;
+      }
+      // Whatever was sent before the shutdown is visible by now, so one more look drains it.
+      if (is_shut_down())
+      {
+        return try_receive();
+      }
+      if (Clock::now() >= deadline)
+      {
+        return std::nullopt;
+      }
+      sleep_until_moved(m_header->head, m_cached_head, m_header->data_signal, m_header->is_consumer_waiting,
+                        m_header->is_shut_down, deadline);
+    }
+  }
+
+  auto SharedChannel::try_receive() -> std::optional<Span<const u8>>
+  {
+    ensure(is_valid(), "SharedChannel is not open");
+
+    while (true)
+    {
+      const u64 tail = m_header->tail.load(std::memory_order_relaxed);
+      if (m_has_received)
+      {
+        // Same message again until it is released.
+        Mut<u32> size = 0;
+        std::memcpy(&size, m_ring + (tail & (m_capacity - 1)), sizeof(size));
+        return Span<const u8>(m_ring + (tail & (m_capacity - 1)) + sizeof(u32), size);
+      }
+
+      if (tail == m_cached_head)
+      {
+        m_cached_head = m_header->head.load(std::memory_order_acquire);
+        if (tail == m_cached_head)
+        {
+          return std::nullopt;
+        }
+      }
+
+      const u64 offset = tail & (m_capacity - 1);
+      Mut<u32> size = 0;
+      std::memcpy(&size, m_ring + offset, sizeof(size));
+      if (size == WRAP_MARKER)
+      {
+        publish(m_header->tail, tail + (m_capacity - offset), m_header->space_signal, m_header->is_producer_waiting);
+        continue;
+      }
+
+      m_received_end = tail + get_record_size(size);
+      m_has_received = true;
+      return Span<const u8>(m_ring + offset + sizeof(u32), size);
+    }
+  }
+
+  auto SharedChannel::release() -> void
+  {
+    if (!m_has_received)
+    {
+      return;
+    }
+    m_has_received = false;
+    publish(m_header->tail, m_received_end, m_header->space_signal, m_header->is_producer_waiting);
+  }
+
+  auto SharedChannel::shut_down() -> void
+  {
+    ensure(is_valid(), "SharedChannel is not open");
+
+    m_header->is_shut_down.store(1, std::memory_order_seq_cst);
+    m_header->data_signal.fetch_add(1, std::memory_order_release);
+    m_header->space_signal.fetch_add(1, std::memory_order_release);
+    Futex::wake_all(m_header->data_signal);
+    Futex::wake_all(m_header->space_signal);
+  }
+
+  auto SharedChannel::is_shut_down() const -> bool
+  {
+    return m_header->is_shut_down.load(std::memory_order_seq_cst) != 0;
+  }
+} // namespace ia
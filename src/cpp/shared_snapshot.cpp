@@ -0,0 +1,254 @@
+// IA-PlatformOps; C++ 20 Async, Process and File Operations.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <platform_ops/shared_snapshot.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <utility>
+
+namespace ia
+{
+  using Header = detail::SharedSnapshotHeader;
+  using Slot = detail::SharedSnapshotSlot;
+
+  static_assert(sizeof(Header) <= SharedSnapshot::HEADER_SIZE, "Snapshot header outgrew its reserved space");
+  static_assert(sizeof(Slot) <= SharedSnapshot::SLOT_HEADER_SIZE, "Slot header outgrew its reserved space");
+  static_assert(std::atomic<u64>::is_always_lock_free && std::atomic<u32>::is_always_lock_free,
+                "Atomics shared between processes must not hide a lock inside the process");
+
+  static constexpr const usize MIN_SLOT_COUNT = 2;
+  static constexpr const usize MAX_SLOT_COUNT = 64;
+
+  static auto get_slot_stride(const usize slot_size) -> usize
+  {
+    const usize alignment = SharedSnapshot::SLOT_HEADER_SIZE;
+    return (SharedSnapshot::SLOT_HEADER_SIZE + slot_size + alignment - 1) / alignment * alignment;
+  }
+
+  auto SharedSnapshot::create(Ref<String> name, const usize max_size, const usize slot_count)
+      -> Result<SharedSnapshot>
+  {
+    if (max_size == 0)
+    {
+      return fail("Shared snapshot '{}' needs a nonzero size", name);
+    }
+    if (slot_count < MIN_SLOT_COUNT || slot_count > MAX_SLOT_COUNT)
+    {
+      return fail("Shared snapshot '{}' needs between {} and {} slots, not {}", name, MIN_SLOT_COUNT,
+                  MAX_SLOT_COUNT, slot_count);
+    }
+
+    const usize stride = get_slot_stride(max_size);
+    Mut<Result<u8 *>> segment = FileOps::map_shared_memory(name, HEADER_SIZE + stride * slot_count, true);
+    if (!segment)
+    {
+      return fail(std::move(segment.error()));
+    }
+
+    Mut<Header *> header = new (*segment) Header();
+    header->version = Header::VERSION;
+    header->slot_size = max_size;
+    header->slot_count = static_cast<u32>(slot_count);
+    for (Mut<usize> i = 0; i < slot_count; ++i)
+    {
+      new (*segment + HEADER_SIZE + i * stride) Slot();
+    }
+    // Last, so a peer that sees the magic also sees the rest.
+    header->magic.store(Header::MAGIC, std::memory_order_release);
+
+    Mut<SharedSnapshot> snapshot;
+    snapshot.m_header = header;
+    snapshot.m_slot_size = max_size;
+    snapshot.m_slot_stride = stride;
+    snapshot.m_slot_count = slot_count;
+    snapshot.m_name = name;
+    snapshot.m_is_owner = true;
+    return snapshot;
+  }
+
+  auto SharedSnapshot::open(Ref<String> name) -> Result<SharedSnapshot>
+  {
+    // The slot layout is only known once the header is readable.
+    Mut<Result<u8 *>> probe = FileOps::map_shared_memory(name, HEADER_SIZE, false);
+    if (!probe)
+    {
+      return fail(std::move(probe.error()));
+    }
+    Ref<Header> probed = *reinterpret_cast<const Header *>(*probe);
+    const bool is_initialized = probed.magic.load(std::memory_order_acquire) == Header::MAGIC;
+    const u32 version = probed.version;
+    const u64 slot_size = probed.slot_size;
+    const u32 slot_count = probed.slot_count;
+    FileOps::unmap_file(*probe);
+
+    if (!is_initialized)
+    {
+      return fail("Shared snapshot '{}' is not initialized", name);
+    }
+    if (version != Header::VERSION)
+    {
+      return fail("Shared snapshot '{}' has layout version {}, expected {}", name, version, Header::VERSION);
+    }
+    if (slot_size == 0 || slot_count < MIN_SLOT_COUNT || slot_count > MAX_SLOT_COUNT)
+    {
+      return fail("Shared snapshot '{}' has an invalid layout of {} slots of {} bytes", name, slot_count, slot_size);
+    }
+
+    const usize stride = get_slot_stride(static_cast<usize>(slot_size));
+    Mut<Result<u8 *>> segment = FileOps::map_shared_memory(name, HEADER_SIZE + stride * slot_count, false);
+    if (!segment)
+    {
+      return fail(std::move(segment.error()));
+    }
+
+    Mut<SharedSnapshot> snapshot;
+    snapshot.m_header = reinterpret_cast<Header *>(*segment);
+    snapshot.m_slot_size = static_cast<usize>(slot_size);
+    snapshot.m_slot_stride = stride;
+    snapshot.m_slot_count = slot_count;
+    snapshot.m_name = name;
+    return snapshot;
+  }
+
+  SharedSnapshot::~SharedSnapshot()
+  {
+    close();
+  }
+
+  SharedSnapshot::SharedSnapshot(ForwardRef<SharedSnapshot> other) noexcept
+  {
+    *this = std::move(other);
+  }
+
+  auto SharedSnapshot::operator=(ForwardRef<SharedSnapshot> other) noexcept -> MutRef<SharedSnapshot>
+  {
+    if (this != &other)
+    {
+      close();
+      m_header = std::exchange(other.m_header, nullptr);
+      m_slot_size = std::exchange(other.m_slot_size, 0);
+      m_slot_stride = std::exchange(other.m_slot_stride, 0);
+      m_slot_count = std::exchange(other.m_slot_count, 0);
+      m_name = std::move(other.m_name);
+      m_is_owner = std::exchange(other.m_is_owner, false);
+      m_writing_version = std::exchange(other.m_writing_version, 0);
+    }
+    return *this;
+  }
+
+  auto SharedSnapshot::close() -> void
+  {
+    if (!m_header)
+    {
+      return;
+    }
+
+    FileOps::unmap_file(reinterpret_cast<const u8 *>(m_header));
+    if (m_is_owner)
+    {
+      FileOps::unlink_shared_memory(m_name);
+    }
+    m_header = nullptr;
+    m_is_owner = false;
+    m_writing_version = 0;
+  }
+
+  auto SharedSnapshot::get_slot(const u64 version) const -> Slot *
+  {
+    u8 *const base = reinterpret_cast<u8 *>(m_header) + HEADER_SIZE;
+    return reinterpret_cast<Slot *>(base + static_cast<usize>(version % m_slot_count) * m_slot_stride);
+  }
+
+  auto SharedSnapshot::publish(const Span<const u8> data) -> Result<u64>
+  {
+    ensure(is_valid(), "SharedSnapshot is not open");
+    if (data.size() > m_slot_size)
+    {
+      return fail("A {} byte snapshot exceeds the limit of {}", data.size(), m_slot_size);
+    }
+
+    const Span<u8> slot = begin_write();
+    std::memcpy(slot.data(), data.data(), data.size());
+    return commit(data.size());
+  }
+
+  auto SharedSnapshot::begin_write() -> Span<u8>
+  {
+    ensure(is_valid(), "SharedSnapshot is not open");
+    ensure(m_writing_version == 0, "Commit the snapshot being written before starting another");
+
+    // Only the writer stores to latest, so its own last store is what it reads here.
+    m_writing_version = m_header->latest.load(std::memory_order_relaxed) + 1;
+    Mut<Slot *> slot = get_slot(m_writing_version);
+
+    // Marks the slot as being rewritten before any of its data changes. The fence keeps the data stores after
+    // the mark, for a reader whose is_intact check comes after its data loads.
+    slot->sequence.store(m_writing_version * 2 + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    return Span<u8>(reinterpret_cast<u8 *>(slot) + SLOT_HEADER_SIZE, m_slot_size);
+  }
+
+  auto SharedSnapshot::commit(const usize size) -> u64
+  {
+    ensure(m_writing_version != 0, "No snapshot is being written");
+    ensure(size <= m_slot_size, "Cannot commit more than a slot holds");
+
+    const u64 version = std::exchange(m_writing_version, 0);
+    Mut<Slot *> slot = get_slot(version);
+    slot->size.store(size, std::memory_order_relaxed);
+    slot->sequence.store(version * 2, std::memory_order_release);
+    m_header->latest.store(version, std::memory_order_release);
+    return version;
+  }
+
+  auto SharedSnapshot::view() const -> std::optional<View>
+  {
+    ensure(is_valid(), "SharedSnapshot is not open");
+
+    while (true)
+    {
+      const u64 latest = m_header->latest.load(std::memory_order_acquire);
+      if (latest == 0)
+      {
+        return std::nullopt;
+      }
+
+      // The slot can already hold a newer version than latest said, which is just as good. If it is being
+      // rewritten, latest has moved on since it was read, so the retry finds a newer slot.
+      Ref<Slot> slot = *get_slot(latest);
+      const u64 sequence = slot.sequence.load(std::memory_order_acquire);
+      if (sequence % 2 != 0)
+      {
+        continue;
+      }
+      const usize size = std::min(static_cast<usize>(slot.size.load(std::memory_order_relaxed)), m_slot_size);
+      return View{Span<const u8>(reinterpret_cast<const u8 *>(&slot) + SLOT_HEADER_SIZE, size), sequence / 2};
+    }
+  }
+
+  auto SharedSnapshot::is_intact(Ref<View> view) const -> bool
+  {
+    // Keeps the caller's reads of the data before the sequence check.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return get_slot(view.version)->sequence.load(std::memory_order_relaxed) == view.version * 2;
+  }
+
+  auto SharedSnapshot::read_into(MutRef<Vec<u8>> out) const -> u64
+  {
+    return read([&out](const Span<const u8> data) { out.assign(data.begin(), data.end()); });
+  }
+} // namespace ia
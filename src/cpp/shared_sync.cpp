@@ -0,0 +1,160 @@
+// IA-PlatformOps; C++ 20 Async, Process and File Operations.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <platform_ops/shared_sync.hpp>
+
+#include <futex.hpp>
+
+namespace ia
+{
+  using Clock = std::chrono::steady_clock;
+
+  static_assert(std::atomic<u32>::is_always_lock_free,
+                "Atomics shared between processes must not hide a lock inside the process");
+
+  // Waits until `try_take` succeeds or `timeout` passes. Both this and the wakers use sequentially consistent
+  // accesses, so either a waker sees the waiter count go up before it checks it, or the futex sees the changed
+  // word and does not sleep.
+  template<typename TryTake>
+  static auto wait_until_taken(MutRef<std::atomic<u32>> word, MutRef<std::atomic<u32>> waiter_count,
+                               const std::chrono::nanoseconds timeout, Mut<TryTake> try_take) -> bool
+  {
+    for (Mut<u32> i = 0; i < Futex::get_spin_count(); ++i)
+    {
+      if (try_take())
+      {
+        return true;
+      }
+      Futex::relax();
+    }
+
+    const bool is_infinite = timeout == Futex::INFINITE_TIMEOUT;
+    const Clock::time_point start = Clock::now();
+    waiter_count.fetch_add(1, std::memory_order_seq_cst);
+    Mut<bool> is_taken = false;
+    while (!(is_taken = try_take()))
+    {
+      if (is_infinite)
+      {
+        Futex::wait(word, 0);
+        continue;
+      }
+      const std::chrono::nanoseconds remaining = timeout - (Clock::now() - start);
+      if (remaining <= std::chrono::nanoseconds::zero())
+      {
+        break;
+      }
+      Futex::wait(word, 0, remaining);
+    }
+    waiter_count.fetch_sub(1, std::memory_order_relaxed);
+    return is_taken;
+  }
+
+  SharedEvent::SharedEvent(const EventReset reset_mode, const bool is_set)
+      : m_state(is_set ? 1 : 0), m_reset_mode(reset_mode)
+  {
+  }
+
+  auto SharedEvent::set() -> void
+  {
+    if (m_state.exchange(1, std::memory_order_seq_cst) != 0)
+    {
+      return;
+    }
+    if (m_waiter_count.load(std::memory_order_seq_cst) != 0)
+    {
+      if (m_reset_mode == EventReset::Auto)
+      {
+        Futex::wake_one(m_state);
+      }
+      else
+      {
+        Futex::wake_all(m_state);
+      }
+    }
+  }
+
+  auto SharedEvent::reset() -> void
+  {
+    m_state.store(0, std::memory_order_relaxed);
+  }
+
+  auto SharedEvent::try_wait() -> bool
+  {
+    if (m_reset_mode == EventReset::Auto)
+    {
+      Mut<u32> expected = 1;
+      return m_state.compare_exchange_strong(expected, 0, std::memory_order_seq_cst);
+    }
+    return m_state.load(std::memory_order_seq_cst) != 0;
+  }
+
+  auto SharedEvent::wait() -> void
+  {
+    wait_for(Futex::INFINITE_TIMEOUT);
+  }
+
+  auto SharedEvent::wait_for(const std::chrono::nanoseconds timeout) -> bool
+  {
+    return wait_until_taken(m_state, m_waiter_count, timeout, [this]() { return try_wait(); });
+  }
+
+  SharedSemaphore::SharedSemaphore(const u32 initial_count) : m_count(initial_count)
+  {
+  }
+
+  auto SharedSemaphore::release(const u32 count) -> void
+  {
+    if (count == 0)
+    {
+      return;
+    }
+    m_count.fetch_add(count, std::memory_order_seq_cst);
+    if (m_waiter_count.load(std::memory_order_seq_cst) != 0)
+    {
+      if (count == 1)
+      {
+        Futex::wake_one(m_count);
+      }
+      else
+      {
+        Futex::wake_all(m_count);
+      }
+    }
+  }
+
+  auto SharedSemaphore::try_acquire() -> bool
+  {
+    Mut<u32> count = m_count.load(std::memory_order_relaxed);
+    while (count != 0)
+    {
+      if (m_count.compare_exchange_weak(count, count - 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  auto SharedSemaphore::acquire() -> void
+  {
+    acquire_for(Futex::INFINITE_TIMEOUT);
+  }
+
+  auto SharedSemaphore::acquire_for(const std::chrono::nanoseconds timeout) -> bool
+  {
+    return wait_until_taken(m_count, m_waiter_count, timeout, [this]() { return try_acquire(); });
+  }
+} // namespace ia
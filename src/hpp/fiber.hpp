@@ -0,0 +1,78 @@
+// IA-PlatformOps; C++ 20 Async, Process and File Operations.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <crux/crux.hpp>
+
+#if IA_PLATFORM_UNIX
+#  include <ucontext.h>
+#endif
+
+namespace ia
+{
+  // A fixed-size stack and the execution context running on it. The entry point must never return; it hands
+  // control back with `suspend()` and is continued by the next `resume()`, possibly from another thread.
+  class Fiber
+  {
+public:
+    using EntryPoint = void (*)(Mut<Fiber *> fiber);
+
+    static auto create(const usize stack_size, const EntryPoint entry, Mut<void *> user_data) -> Result<Box<Fiber>>;
+
+    // Must be called on a thread before it resumes any fiber, and paired with `release_thread()`.
+    static auto prepare_thread() -> Result<void>;
+    static auto release_thread() -> void;
+
+    ~Fiber();
+
+    Fiber(Ref<Fiber>) = delete;
+    auto operator=(Ref<Fiber>) -> Fiber & = delete;
+
+    // Switches from the calling thread into the fiber until it suspends.
+    auto resume() -> void;
+
+    // Called from inside the fiber to switch back to whichever thread resumed it last.
+    auto suspend() -> void;
+
+    [[nodiscard]] auto get_user_data() const -> void *
+    {
+      return m_user_data;
+    }
+
+private:
+    Fiber() = default;
+
+#if IA_PLATFORM_WINDOWS
+    static auto __stdcall trampoline(Mut<void *> parameter) -> void;
+#elif IA_PLATFORM_UNIX
+    static auto trampoline(const u32 fiber_low, const u32 fiber_high) -> void;
+#endif
+
+private:
+    Mut<EntryPoint> m_entry = nullptr;
+    Mut<void *> m_user_data = nullptr;
+
+#if IA_PLATFORM_WINDOWS
+    Mut<void *> m_handle = nullptr;
+    Mut<void *> m_return_handle = nullptr;
+#elif IA_PLATFORM_UNIX
+    Mut<u8 *> m_mapping = nullptr; // Guard page followed by the stack
+    Mut<usize> m_mapping_size = 0;
+    Mut<ucontext_t> m_context{};
+    Mut<ucontext_t> m_return_context{};
+#endif
+  };
+} // namespace ia
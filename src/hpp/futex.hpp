@@ -0,0 +1,49 @@
+// IA-PlatformOps; C++ 20 Async, Process and File Operations.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <crux/crux.hpp>
+
+#include <atomic>
+#include <chrono>
+
+namespace ia
+{
+  // Sleeping on a 32-bit word that may live in memory shared between processes. Linux uses futexes without
+  // FUTEX_PRIVATE_FLAG, so waiters and wakers may map the word at different addresses. Elsewhere there is no
+  // portable cross-process equivalent, so waits back off with short sleeps and wakes do nothing. Wakeups can be
+  // spurious everywhere, so callers re-check their condition in a loop.
+  class Futex
+  {
+public:
+    static constexpr const std::chrono::nanoseconds INFINITE_TIMEOUT = std::chrono::nanoseconds::max();
+
+    // Sleeps while the word holds `expected`. Returns false only if `timeout` passed first.
+    static auto wait(Ref<std::atomic<u32>> word, const u32 expected,
+                     const std::chrono::nanoseconds timeout = INFINITE_TIMEOUT) -> bool;
+
+    static auto wake_one(MutRef<std::atomic<u32>> word) -> void;
+    static auto wake_all(MutRef<std::atomic<u32>> word) -> void;
+
+    // How often to re-check a condition before sleeping on it. A peer that is about to change it usually gets
+    // there in far less time than a futex sleep and wake take, unless it has no core to run on while this one
+    // spins, so single-core machines skip spinning.
+    static auto get_spin_count() -> u32;
+
+    // Tells the core this thread is spinning, between re-checks.
+    static auto relax() -> void;
+  };
+} // namespace ia
@@ -0,0 +1,117 @@
+// IA-PlatformOps; C++ 20 Async, Process and File Operations.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <crux/crux.hpp>
+
+#if IA_PLATFORM_UNIX && defined(__linux__)
+#  define IA_HAS_IO_URING 1
+#  include <atomic>
+#  include <linux/io_uring.h>
+#  include <sys/uio.h>
+#else
+#  define IA_HAS_IO_URING 0
+#endif
+
+#if IA_HAS_IO_URING
+namespace ia
+{
+  // An io_uring instance driven through raw system calls. Callers serialize the submission side among
+  // themselves and the completion side among themselves; the two sides may run concurrently.
+  class IoUring
+  {
+public:
+    struct Completion
+    {
+      Mut<u64> user_data{};
+      Mut<i32> result{}; // Bytes transferred, or a negated errno
+    };
+
+    // Fails on kernels without io_uring or without IORING_OP_READ/WRITE (5.6), and where it is disabled.
+    static auto create(const u32 entries) -> Result<Box<IoUring>>;
+
+    ~IoUring();
+
+    IoUring(Ref<IoUring>) = delete;
+    auto operator=(Ref<IoUring>) -> IoUring & = delete;
+
+    // Returns a zeroed entry to fill in, or nullptr if the submission queue is full.
+    [[nodiscard]] auto get_submission_entry() -> io_uring_sqe *;
+
+    // Hands every entry obtained so far to the kernel, including any a failed call left queued.
+    auto submit() -> Result<void>;
+
+    // Blocks until at least one completion is available.
+    auto wait_for_completion() -> Result<void>;
+
+    // Calls `fn(completion)` for every available completion and returns how many there were.
+    template<typename Fn> auto drain_completions(Mut<Fn> fn) -> u32
+    {
+      Mut<u32> head = *m_cq_head;
+      const u32 tail = std::atomic_ref<u32>(*m_cq_tail).load(std::memory_order_acquire);
+
+      Mut<u32> count = 0;
+      for (; head != tail; ++head, ++count)
+      {
+        Ref<io_uring_cqe> cqe = m_cqes[head & m_cq_mask];
+        fn(Completion{cqe.user_data, cqe.res});
+      }
+
+      std::atomic_ref<u32>(*m_cq_head).store(head, std::memory_order_release);
+      return count;
+    }
+
+    auto register_buffers(const Span<const iovec> buffers) -> Result<void>;
+    auto unregister_buffers() -> void;
+
+    auto register_files(const Span<const i32> fds) -> Result<void>;
+    auto unregister_files() -> void;
+
+    [[nodiscard]] auto get_completion_capacity() const -> u32
+    {
+      return m_cq_entries;
+    }
+
+private:
+    IoUring() = default;
+
+    auto enter(const u32 submit_count, const u32 wait_count, const u32 flags) -> i32;
+
+private:
+    Mut<i32> m_fd = -1;
+
+    Mut<void *> m_sq_mapping = nullptr;
+    Mut<usize> m_sq_mapping_size = 0;
+    Mut<void *> m_cq_mapping = nullptr; // Same as `m_sq_mapping` with IORING_FEAT_SINGLE_MMAP
+    Mut<usize> m_cq_mapping_size = 0;
+    Mut<io_uring_sqe *> m_sqes = nullptr;
+    Mut<usize> m_sqes_size = 0;
+
+    Mut<u32 *> m_sq_head = nullptr;
+    Mut<u32 *> m_sq_tail = nullptr;
+    Mut<u32 *> m_sq_array = nullptr;
+    Mut<u32> m_sq_mask = 0;
+    Mut<u32> m_sq_entries = 0;
+    Mut<u32> m_sq_local_tail = 0; // Entries up to here are filled in but not yet published
+
+    Mut<u32 *> m_cq_head = nullptr;
+    Mut<u32 *> m_cq_tail = nullptr;
+    Mut<io_uring_cqe *> m_cqes = nullptr;
+    Mut<u32> m_cq_mask = 0;
+    Mut<u32> m_cq_entries = 0;
+  };
+} // namespace ia
+#endif
@@ -21,10 +21,10 @@ using namespace ia;
 
 struct SchedulerGuard
 {
-  SchedulerGuard(u8 worker_count = 2)
+  SchedulerGuard(u8 worker_count = 2, bool use_fibers = false)
   {
 
-    (void) AsyncOps::initialize_scheduler(worker_count);
+    (void) AsyncOps::initialize_scheduler(worker_count, use_fibers);
   }
 
   ~SchedulerGuard()
@@ -45,6 +45,11 @@ auto test_initialization() -> bool
 
   IAT_CHECK_EQ(AsyncOps::get_worker_count(), static_cast<u16>(4));
 
+  // A second initialize fails without switching the running workers into fiber mode.
+  IAT_CHECK(!AsyncOps::initialize_scheduler(2, true).has_value());
+  IAT_CHECK(!AsyncOps::is_fiber_mode());
+  IAT_CHECK_EQ(AsyncOps::get_worker_count(), static_cast<u16>(4));
+
   AsyncOps::terminate_scheduler();
 
   const auto res2 = AsyncOps::initialize_scheduler(1);
@@ -115,6 +120,285 @@ auto test_priorities() -> bool
   return true;
 }
 
+auto wait_until_drained(AsyncOps::Schedule &schedule) -> void
+{
+  while (schedule.counter.load() > 0)
+  {
+    std::this_thread::sleep_for(std::chrono::microseconds(50));
+  }
+}
+
+auto test_deadline_ordering() -> bool
+{
+  SchedulerGuard guard(1);
+  AsyncOps::Schedule schedule;
+  std::atomic<bool> blocker_started{false};
+  std::atomic<bool> release_blocker{false};
+  std::mutex order_mutex;
+  Vec<i32> order;
+
+  AsyncOps::schedule_task(
+      [&](AsyncOps::WorkerId) {
+        blocker_started = true;
+        while (!release_blocker.load())
+        {
+          std::this_thread::yield();
+        }
+      },
+      0, &schedule);
+
+  while (!blocker_started.load())
+  {
+    std::this_thread::yield();
+  }
+
+  const auto now = AsyncOps::Clock::now();
+  for (i32 i = 4; i >= 0; --i)
+  {
+    AsyncOps::schedule_task(
+        [&, i](AsyncOps::WorkerId) {
+          const std::lock_guard<std::mutex> lock(order_mutex);
+          order.push_back(i);
+        },
+        0, &schedule, AsyncOps::Priority::Normal, now + std::chrono::seconds(1 + i));
+  }
+
+  release_blocker = true;
+  wait_until_drained(schedule);
+
+  IAT_CHECK_EQ(order.size(), static_cast<usize>(5));
+  for (i32 i = 0; i < 5; ++i)
+  {
+    IAT_CHECK_EQ(order[i], i);
+  }
+
+  return true;
+}
+
+auto test_aging_prevents_starvation() -> bool
+{
+  SchedulerGuard guard(1);
+  AsyncOps::set_aging_interval(std::chrono::milliseconds(1));
+
+  AsyncOps::Schedule schedule;
+  std::atomic<bool> blocker_started{false};
+  std::atomic<bool> release_blocker{false};
+  std::atomic<i32> run_index{0};
+  std::atomic<i32> low_run_index{-1};
+
+  AsyncOps::schedule_task(
+      [&](AsyncOps::WorkerId) {
+        blocker_started = true;
+        while (!release_blocker.load())
+        {
+          std::this_thread::yield();
+        }
+      },
+      0, &schedule, AsyncOps::Priority::Critical);
+
+  while (!blocker_started.load())
+  {
+    std::this_thread::yield();
+  }
+
+  AsyncOps::schedule_task([&](AsyncOps::WorkerId) { low_run_index = run_index++; }, 0, &schedule,
+                          AsyncOps::Priority::Low);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+  for (i32 i = 0; i < 20; ++i)
+  {
+    AsyncOps::schedule_task([&](AsyncOps::WorkerId) { run_index++; }, 0, &schedule, AsyncOps::Priority::Critical);
+  }
+
+  release_blocker = true;
+  wait_until_drained(schedule);
+
+  AsyncOps::set_aging_interval(AsyncOps::DEFAULT_AGING_INTERVAL);
+
+  IAT_CHECK_EQ(low_run_index.load(), 0);
+
+  const auto stats = AsyncOps::get_priority_stats(AsyncOps::Priority::Low);
+  IAT_CHECK_EQ(stats.executed_count, static_cast<u64>(1));
+  IAT_CHECK_EQ(stats.promoted_count, static_cast<u64>(1));
+
+  return true;
+}
+
+auto test_priority_stats() -> bool
+{
+  SchedulerGuard guard(2);
+  AsyncOps::Schedule schedule;
+  const i32 total_tasks = 50;
+
+  for (i32 i = 0; i < total_tasks; ++i)
+  {
+    AsyncOps::schedule_task([](AsyncOps::WorkerId) {}, 0, &schedule, AsyncOps::Priority::Background);
+  }
+
+  AsyncOps::wait_for_schedule_completion(&schedule);
+
+  const auto stats = AsyncOps::get_priority_stats(AsyncOps::Priority::Background);
+  IAT_CHECK_EQ(stats.executed_count, static_cast<u64>(total_tasks));
+  IAT_CHECK(stats.get_mean_wait_ns() <= stats.max_wait_ns);
+  IAT_CHECK(stats.get_wait_percentile_ns(99.0) <= stats.max_wait_ns);
+
+  u64 histogram_total = 0;
+  for (const u64 count : stats.wait_histogram)
+  {
+    histogram_total += count;
+  }
+  IAT_CHECK_EQ(histogram_total, static_cast<u64>(total_tasks));
+
+  AsyncOps::reset_priority_stats();
+  IAT_CHECK_EQ(AsyncOps::get_priority_stats(AsyncOps::Priority::Background).executed_count, static_cast<u64>(0));
+
+  return true;
+}
+
+auto test_future_submit() -> bool
+{
+  SchedulerGuard guard(2);
+
+  auto value = AsyncOps::submit([] { return 40 + 2; });
+  auto worker = AsyncOps::submit([](AsyncOps::WorkerId worker_id) { return worker_id; });
+
+  std::atomic<bool> executed{false};
+  auto nothing = AsyncOps::submit([&] { executed = true; });
+
+  IAT_CHECK_EQ(value.get(), 42);
+  IAT_CHECK(worker.get() <= AsyncOps::get_worker_count());
+
+  nothing.wait();
+  IAT_CHECK(nothing.is_ready());
+  IAT_CHECK(executed.load());
+
+  return true;
+}
+
+auto test_future_then() -> bool
+{
+  SchedulerGuard guard(2);
+
+  auto chained = AsyncOps::submit([] { return 10; })
+                     .then([](i32 value) { return value * 3; })
+                     .then([](i32 value) { return String(static_cast<usize>(value), 'x'); });
+
+  IAT_CHECK_EQ(chained.get(), String(30, 'x'));
+
+  std::atomic<i32> observed{0};
+  auto after_void = AsyncOps::submit([] {}).then([&] { observed = 7; });
+  after_void.get();
+  IAT_CHECK_EQ(observed.load(), 7);
+
+  return true;
+}
+
+auto test_future_when_all() -> bool
+{
+  SchedulerGuard guard(4);
+
+  Vec<Future<i32>> futures;
+  for (i32 i = 0; i < 32; ++i)
+  {
+    futures.push_back(AsyncOps::submit([i] { return i; }));
+  }
+
+  auto all = AsyncOps::when_all(std::move(futures)).then([](Vec<Future<i32>> ready) {
+    i32 sum = 0;
+    for (auto &future : ready)
+    {
+      sum += future.get();
+    }
+    return sum;
+  });
+
+  IAT_CHECK_EQ(all.get(), 31 * 32 / 2);
+
+  auto none = AsyncOps::when_all(Vec<Future<void>>{});
+  IAT_CHECK(none.get().empty());
+
+  return true;
+}
+
+auto test_future_when_any() -> bool
+{
+  SchedulerGuard guard(2);
+
+  Vec<Future<i32>> futures;
+  futures.push_back(AsyncOps::submit([] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    return 1;
+  }));
+  futures.push_back(AsyncOps::submit([] { return 2; }));
+
+  auto any = AsyncOps::when_any(std::move(futures));
+  auto result = any.get();
+
+  IAT_CHECK_EQ(result.index, static_cast<usize>(1));
+  IAT_CHECK_EQ(result.futures.size(), static_cast<usize>(2));
+  IAT_CHECK_EQ(result.futures[1].get(), 2);
+  IAT_CHECK_EQ(result.futures[0].get(), 1);
+
+  return true;
+}
+
+auto spawn_nested(AsyncOps::Schedule &parent, std::atomic<i32> &leaf_count, i32 depth) -> void
+{
+  AsyncOps::schedule_task(
+      [&leaf_count, depth](AsyncOps::WorkerId) {
+        if (depth == 0)
+        {
+          leaf_count++;
+          return;
+        }
+
+        AsyncOps::Schedule children;
+        for (i32 i = 0; i < 4; ++i)
+        {
+          spawn_nested(children, leaf_count, depth - 1);
+        }
+        AsyncOps::wait_for_schedule_completion(&children);
+      },
+      0, &parent);
+}
+
+auto test_fiber_nested_wait() -> bool
+{
+  SchedulerGuard guard(1, true);
+  IAT_CHECK(AsyncOps::is_fiber_mode());
+  IAT_CHECK(!AsyncOps::is_running_in_fiber());
+
+  AsyncOps::Schedule schedule;
+  std::atomic<i32> leaf_count{0};
+  std::atomic<bool> ran_in_fiber{false};
+
+  AsyncOps::schedule_task([&](AsyncOps::WorkerId) { ran_in_fiber = AsyncOps::is_running_in_fiber(); }, 0,
+                          &schedule);
+  spawn_nested(schedule, leaf_count, 3);
+
+  AsyncOps::wait_for_schedule_completion(&schedule);
+
+  IAT_CHECK(ran_in_fiber.load());
+  IAT_CHECK_EQ(leaf_count.load(), 4 * 4 * 4);
+
+  return true;
+}
+
+auto test_fiber_future_wait() -> bool
+{
+  SchedulerGuard guard(1, true);
+
+  auto outer = AsyncOps::submit([] {
+    auto inner = AsyncOps::submit([] { return 21; });
+    return inner.get() * 2;
+  });
+
+  IAT_CHECK_EQ(outer.get(), 42);
+
+  return true;
+}
+
 auto test_run_task_fire_and_forget() -> bool
 {
   SchedulerGuard guard(2);
@@ -159,6 +443,15 @@ IAT_ADD_TEST(test_initialization);
 IAT_ADD_TEST(test_basic_execution);
 IAT_ADD_TEST(test_concurrency);
 IAT_ADD_TEST(test_priorities);
+IAT_ADD_TEST(test_deadline_ordering);
+IAT_ADD_TEST(test_aging_prevents_starvation);
+IAT_ADD_TEST(test_priority_stats);
+IAT_ADD_TEST(test_future_submit);
+IAT_ADD_TEST(test_future_then);
+IAT_ADD_TEST(test_future_when_all);
+IAT_ADD_TEST(test_future_when_any);
+IAT_ADD_TEST(test_fiber_nested_wait);
+IAT_ADD_TEST(test_fiber_future_wait);
 IAT_ADD_TEST(test_run_task_fire_and_forget);
 IAT_ADD_TEST(test_cancellation_safety);
 IAT_END_TEST_LIST()
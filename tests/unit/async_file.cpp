@@ -0,0 +1,267 @@
+// IA-PlatformOps; C++ 20 Async, Process and File Operations.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <platform_ops/async_file.hpp>
+
+#include <iatest/iatest.hpp>
+
+using namespace ia;
+
+struct AsyncFileGuard
+{
+  AsyncFileGuard(bool allow_io_uring = true)
+  {
+    (void) AsyncOps::initialize_scheduler(2);
+    (void) AsyncFileOps::initialize(AsyncFileOps::DEFAULT_QUEUE_DEPTH, allow_io_uring);
+  }
+
+  ~AsyncFileGuard()
+  {
+    AsyncFileOps::terminate();
+    AsyncOps::terminate_scheduler();
+  }
+};
+
+IAT_BEGIN_BLOCK(Core, AsyncFileOps)
+
+void cleanup_file(const Path &path)
+{
+  std::error_code ec;
+  std::filesystem::remove(path, ec);
+}
+
+auto round_trip(const Path &path) -> bool
+{
+  const auto handle = FileOps::native_open_file(path, FileOps::FileAccess::ReadWrite, FileOps::FileMode::CreateAlways);
+  IAT_CHECK(handle.has_value());
+
+  const String content = "Hello AsyncFileOps!";
+  Result<usize> write_result = 0;
+  AsyncOps::Schedule write_schedule;
+  AsyncFileOps::write_at(*handle, Span<const u8>(reinterpret_cast<const u8 *>(content.data()), content.size()), 4,
+                         &write_schedule, &write_result);
+  AsyncOps::wait_for_schedule_completion(&write_schedule);
+  IAT_CHECK(write_result.has_value());
+  IAT_CHECK_EQ(*write_result, content.size());
+
+  Result<usize> sync_result = 1;
+  AsyncOps::Schedule sync_schedule;
+  AsyncFileOps::fsync(*handle, true, &sync_schedule, &sync_result);
+  AsyncOps::wait_for_schedule_completion(&sync_schedule);
+  IAT_CHECK(sync_result.has_value());
+
+  String buffer(content.size(), '\0');
+  Result<usize> read_result = 0;
+  AsyncOps::Schedule read_schedule;
+  AsyncFileOps::read_at(*handle, Span<u8>(reinterpret_cast<u8 *>(buffer.data()), buffer.size()), 4, &read_schedule,
+                        &read_result);
+  AsyncOps::wait_for_schedule_completion(&read_schedule);
+  IAT_CHECK(read_result.has_value());
+  IAT_CHECK_EQ(*read_result, content.size());
+  IAT_CHECK_EQ(buffer, content);
+
+  FileOps::native_close_file(*handle);
+  cleanup_file(path);
+  return true;
+}
+
+auto test_round_trip() -> bool
+{
+  AsyncFileGuard guard;
+  IAT_CHECK(AsyncFileOps::get_backend() != AsyncFileOps::Backend::None);
+
+  return round_trip("iatest_async_file_rt.bin");
+}
+
+auto test_blocking_pool_fallback() -> bool
+{
+  AsyncFileGuard guard(false);
+  IAT_CHECK(AsyncFileOps::get_backend() == AsyncFileOps::Backend::BlockingPool);
+
+  return round_trip("iatest_async_file_pool.bin");
+}
+
+auto test_completion_callback() -> bool
+{
+  AsyncFileGuard guard;
+  const Path path = "iatest_async_file_cb.bin";
+  const Vec<u8> content = {1, 2, 3, 4, 5, 6, 7, 8};
+  (void) FileOps::write_binary_file(path, content, true);
+
+  const auto handle = FileOps::native_open_file(path, FileOps::FileAccess::Read, FileOps::FileMode::OpenExisting);
+  IAT_CHECK(handle.has_value());
+
+  Vec<u8> buffer(4);
+  std::atomic<bool> done{false};
+  usize bytes_read = 0;
+  bool ran_on_pool = false;
+
+  AsyncFileOps::read_at(*handle, buffer, 2, [&](Result<usize> result) {
+    bytes_read = result.has_value() ? *result : 0;
+    ran_on_pool = AsyncOps::get_worker_count() > 0;
+    done = true;
+    done.notify_all();
+  });
+
+  done.wait(false);
+  IAT_CHECK(ran_on_pool);
+  IAT_CHECK_EQ(bytes_read, static_cast<usize>(4));
+  IAT_CHECK_EQ(buffer[0], static_cast<u8>(3));
+  IAT_CHECK_EQ(buffer[3], static_cast<u8>(6));
+
+  FileOps::native_close_file(*handle);
+  cleanup_file(path);
+  return true;
+}
+
+auto test_batched_submit() -> bool
+{
+  AsyncFileGuard guard;
+  const Path path = "iatest_async_file_batch.bin";
+
+  const auto handle = FileOps::native_open_file(path, FileOps::FileAccess::ReadWrite, FileOps::FileMode::CreateAlways);
+  IAT_CHECK(handle.has_value());
+
+  const usize block_size = 4096;
+  const usize block_count = 64;
+  Vec<u8> data(block_size * block_count);
+  for (usize i = 0; i < data.size(); ++i)
+  {
+    data[i] = static_cast<u8>(i / block_size);
+  }
+
+  AsyncOps::Schedule schedule;
+  Vec<AsyncFileOps::Request> requests(block_count);
+  for (usize i = 0; i < block_count; ++i)
+  {
+    requests[i].operation = AsyncFileOps::Operation::Write;
+    requests[i].handle = *handle;
+    requests[i].buffer = data.data() + i * block_size;
+    requests[i].size = block_size;
+    requests[i].offset = i * block_size;
+    requests[i].schedule = &schedule;
+  }
+  AsyncFileOps::submit(requests);
+  AsyncOps::wait_for_schedule_completion(&schedule);
+
+  const auto read_back = FileOps::read_binary_file(path);
+  IAT_CHECK(read_back.has_value());
+  IAT_CHECK_EQ(read_back->size(), data.size());
+  IAT_CHECK((*read_back)[block_size * 63] == 63);
+
+  FileOps::native_close_file(*handle);
+  cleanup_file(path);
+  return true;
+}
+
+auto test_registered_buffers_and_files() -> bool
+{
+  AsyncFileGuard guard;
+  const Path path = "iatest_async_file_fixed.bin";
+  const Vec<u8> content(8192, 0x5A);
+  (void) FileOps::write_binary_file(path, content, true);
+
+  const auto handle = FileOps::native_open_file(path, FileOps::FileAccess::Read, FileOps::FileMode::OpenExisting);
+  IAT_CHECK(handle.has_value());
+
+  Vec<u8> buffer(8192);
+  const Span<u8> buffers[] = {buffer};
+  const NativeFileHandle handles[] = {*handle};
+  IAT_CHECK(AsyncFileOps::register_buffers(buffers).has_value());
+  IAT_CHECK(AsyncFileOps::register_files(handles).has_value());
+
+  AsyncOps::Schedule schedule;
+  Result<usize> result = 0;
+  AsyncFileOps::Request request;
+  request.file_index = 0;
+  request.buffer = buffer.data();
+  request.size = buffer.size();
+  request.buffer_index = 0;
+  request.schedule = &schedule;
+  request.result = &result;
+  AsyncFileOps::submit(Span<AsyncFileOps::Request>(&request, 1));
+  AsyncOps::wait_for_schedule_completion(&schedule);
+
+  IAT_CHECK(result.has_value());
+  IAT_CHECK_EQ(*result, buffer.size());
+  IAT_CHECK_EQ(buffer[8191], static_cast<u8>(0x5A));
+
+  AsyncFileOps::unregister_files();
+  AsyncFileOps::unregister_buffers();
+  FileOps::native_close_file(*handle);
+  cleanup_file(path);
+  return true;
+}
+
+auto test_copy_file() -> bool
+{
+  AsyncFileGuard guard;
+  const Path source = "iatest_async_file_copy_source.bin";
+  const Path destination = "iatest_async_file_copy_destination.bin";
+  const Vec<u8> content(256 * 1024 + 5, 0x3C);
+  IAT_CHECK(FileOps::write_binary_file(source, content, true).has_value());
+  cleanup_file(destination);
+
+  Result<usize> result = 0;
+  AsyncOps::Schedule schedule;
+  AsyncFileOps::copy_file(source, destination, {}, &schedule, &result);
+  AsyncOps::wait_for_schedule_completion(&schedule);
+  IAT_CHECK(result.has_value());
+  IAT_CHECK_EQ(*result, content.size());
+  IAT_CHECK(*FileOps::read_binary_file(destination) == content);
+
+  // Failures arrive through the completion too.
+  std::atomic<bool> done{false};
+  bool failed = false;
+  AsyncFileOps::copy_file(source, destination, {}, [&](Result<usize> copied) {
+    failed = !copied.has_value();
+    done = true;
+    done.notify_all();
+  });
+  done.wait(false);
+  IAT_CHECK(failed);
+
+  cleanup_file(source);
+  cleanup_file(destination);
+  return true;
+}
+
+auto test_error_reporting() -> bool
+{
+  AsyncFileGuard guard;
+
+  u8 byte = 0;
+  Result<usize> result = 0;
+  AsyncOps::Schedule schedule;
+  AsyncFileOps::read_at(INVALID_FILE_HANDLE, Span<u8>(&byte, 1), 0, &schedule, &result);
+  AsyncOps::wait_for_schedule_completion(&schedule);
+  IAT_CHECK(!result.has_value());
+
+  return true;
+}
+
+IAT_BEGIN_TEST_LIST()
+IAT_ADD_TEST(test_round_trip);
+IAT_ADD_TEST(test_blocking_pool_fallback);
+IAT_ADD_TEST(test_completion_callback);
+IAT_ADD_TEST(test_batched_submit);
+IAT_ADD_TEST(test_registered_buffers_and_files);
+IAT_ADD_TEST(test_error_reporting);
+IAT_ADD_TEST(test_copy_file);
+IAT_END_TEST_LIST()
+
+IAT_END_BLOCK()
+
+IAT_REGISTER_ENTRY(Core, AsyncFileOps)
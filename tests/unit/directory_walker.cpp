@@ -0,0 +1,248 @@
+// IA-PlatformOps; C++ 20 Async, Process and File Operations.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <platform_ops/directory_walker.hpp>
+#include <platform_ops/file.hpp>
+
+#include <iatest/iatest.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <mutex>
+
+using namespace ia;
+
+struct WalkerSchedulerGuard
+{
+  WalkerSchedulerGuard(u8 worker_count = 2)
+  {
+    (void) AsyncOps::initialize_scheduler(worker_count);
+  }
+
+  ~WalkerSchedulerGuard()
+  {
+    AsyncOps::terminate_scheduler();
+  }
+};
+
+IAT_BEGIN_BLOCK(Core, DirectoryWalker)
+
+const Path s_root = "iatest_walker_tree";
+
+// Three levels of four directories, each holding three files whose size is their index, plus a symlink at the top.
+// Every directory name starts with "d", so the filters below can tell them apart from files.
+auto make_tree() -> usize
+{
+  std::error_code ec;
+  std::filesystem::remove_all(s_root, ec);
+  std::filesystem::create_directories(s_root);
+
+  usize entry_count = 0;
+  Vec<Path> level = {s_root};
+  for (u32 depth = 0; depth < 3; ++depth)
+  {
+    Vec<Path> next;
+    for (Ref<Path> directory : level)
+    {
+      for (u32 i = 0; i < 3; ++i)
+      {
+        const String contents(i, 'x');
+        (void) FileOps::write_text_file(directory / ("f" + std::to_string(i)), contents, true);
+        ++entry_count;
+      }
+      for (u32 i = 0; i < 4; ++i)
+      {
+        const Path child = directory / ("d" + std::to_string(i));
+        std::filesystem::create_directory(child);
+        next.push_back(child);
+        ++entry_count;
+      }
+    }
+    level = std::move(next);
+  }
+
+  std::filesystem::create_directory_symlink(std::filesystem::absolute(s_root / "d0"), s_root / "link");
+  return entry_count + 1;
+}
+
+// A copy of an entry that outlives the callback.
+struct WalkedEntry
+{
+  String path;
+  DirectoryWalker::EntryType type;
+  u32 depth;
+  u64 inode;
+  u64 size;
+  i64 modified_ns;
+};
+
+auto collect(Ref<DirectoryWalker::Options> options, DirectoryWalker::Stats &stats) -> Vec<WalkedEntry>
+{
+  std::mutex mutex;
+  Vec<WalkedEntry> collected;
+  const auto res = DirectoryWalker::walk(s_root, options,
+                                         [&](const Span<const DirectoryWalker::Entry> entries, AsyncOps::WorkerId) {
+                                           const std::lock_guard lock(mutex);
+                                           for (Ref<DirectoryWalker::Entry> entry : entries)
+                                           {
+                                             collected.push_back({entry.get_path().string(), entry.type, entry.depth,
+                                                                  entry.inode, entry.size, entry.modified_ns});
+                                           }
+                                         });
+  stats = res.value_or(DirectoryWalker::Stats{});
+  std::sort(collected.begin(), collected.end(),
+            [](Ref<WalkedEntry> a, Ref<WalkedEntry> b) { return a.path < b.path; });
+  return collected;
+}
+
+auto has_duplicates(Ref<Vec<WalkedEntry>> entries) -> bool
+{
+  return std::adjacent_find(entries.begin(), entries.end(), [](Ref<WalkedEntry> a, Ref<WalkedEntry> b) {
+           return a.path == b.path;
+         }) != entries.end();
+}
+
+auto test_walk_tree() -> bool
+{
+  const usize expected = make_tree();
+
+  DirectoryWalker::Stats stats;
+  const Vec<WalkedEntry> entries = collect({}, stats);
+  IAT_CHECK_EQ(entries.size(), expected);
+  IAT_CHECK_EQ(stats.entry_count, static_cast<u64>(expected));
+  IAT_CHECK_EQ(stats.directory_count, static_cast<u64>(1 + 4 + 16 + 64));
+  IAT_CHECK_EQ(stats.error_count, static_cast<u64>(0));
+
+  usize symlink_count = 0;
+  usize file_count = 0;
+  for (Ref<WalkedEntry> entry : entries)
+  {
+    symlink_count += entry.type == DirectoryWalker::EntryType::Symlink;
+    file_count += entry.type == DirectoryWalker::EntryType::File;
+    IAT_CHECK(entry.depth < 3);
+    IAT_CHECK(entry.inode != 0);
+    IAT_CHECK_EQ(entry.size, static_cast<u64>(0)); // Not stat'ed
+  }
+  IAT_CHECK_EQ(symlink_count, static_cast<usize>(1));
+  IAT_CHECK_EQ(file_count, static_cast<usize>(3 * (1 + 4 + 16)));
+
+  // The symlink is not followed, so nothing is listed twice.
+  IAT_CHECK(!has_duplicates(entries));
+  const String nested = (s_root / "d1" / "d2" / "f1").string();
+  IAT_CHECK(std::any_of(entries.begin(), entries.end(), [&](Ref<WalkedEntry> entry) {
+    return entry.path == nested && entry.depth == 2;
+  }));
+
+  const auto missing = DirectoryWalker::walk("iatest_walker_missing", {}, [](auto, auto) {});
+  IAT_CHECK(!missing.has_value());
+
+  return true;
+}
+
+auto test_stat_entries() -> bool
+{
+  DirectoryWalker::Options options;
+  options.stat = true;
+  DirectoryWalker::Stats stats;
+  const Vec<WalkedEntry> entries = collect(options, stats);
+  IAT_CHECK_EQ(stats.error_count, static_cast<u64>(0));
+
+  usize checked = 0;
+  for (Ref<WalkedEntry> entry : entries)
+  {
+    IAT_CHECK(entry.modified_ns > 0);
+    if (entry.type == DirectoryWalker::EntryType::File)
+    {
+      IAT_CHECK_EQ(entry.size, static_cast<u64>(entry.path.back() - '0'));
+      ++checked;
+    }
+  }
+  IAT_CHECK_EQ(checked, static_cast<usize>(3 * (1 + 4 + 16)));
+
+  return true;
+}
+
+auto test_filter_and_depth() -> bool
+{
+  // Pruning "d0" everywhere leaves three of four subtrees at each level.
+  DirectoryWalker::Options options;
+  std::atomic<u32> filter_calls{0};
+  options.filter = [&](Ref<DirectoryWalker::Entry> entry) {
+    filter_calls.fetch_add(1);
+    return entry.name != "d0";
+  };
+  DirectoryWalker::Stats stats;
+  Vec<WalkedEntry> entries = collect(options, stats);
+  IAT_CHECK_EQ(stats.directory_count, static_cast<u64>(1 + 3 + 9 + 27));
+  IAT_CHECK_EQ(entries.size(), static_cast<usize>(7 + 3 * 6 + 9 * 6));
+  IAT_CHECK(std::none_of(entries.begin(), entries.end(), [](Ref<WalkedEntry> entry) {
+    return entry.path.find("d0") != String::npos;
+  }));
+  IAT_CHECK(filter_calls.load() >= entries.size());
+
+  DirectoryWalker::Options shallow;
+  shallow.max_depth = 1;
+  entries = collect(shallow, stats);
+  IAT_CHECK_EQ(stats.directory_count, static_cast<u64>(1 + 4));
+  IAT_CHECK_EQ(entries.size(), static_cast<usize>(8 + 4 * 7));
+  IAT_CHECK(std::all_of(entries.begin(), entries.end(), [](Ref<WalkedEntry> entry) {
+    return entry.depth <= 1;
+  }));
+
+  return true;
+}
+
+auto test_parallel_walk() -> bool
+{
+  const WalkerSchedulerGuard guard(3);
+
+  DirectoryWalker::Options options;
+  options.stat = true;
+  DirectoryWalker::Stats stats;
+  const Vec<WalkedEntry> parallel = collect(options, stats);
+  IAT_CHECK_EQ(parallel.size(), static_cast<usize>(8 + 4 * 7 + 16 * 7));
+  IAT_CHECK_EQ(stats.directory_count, static_cast<u64>(1 + 4 + 16 + 64));
+  IAT_CHECK(!has_duplicates(parallel));
+
+  const auto listed = DirectoryWalker::list(s_root);
+  IAT_CHECK(listed.has_value());
+  IAT_CHECK_EQ(listed->size(), parallel.size());
+
+  // Same entries and stats as a serial walk.
+  options.parallel = false;
+  const Vec<WalkedEntry> serial = collect(options, stats);
+  IAT_CHECK_EQ(serial.size(), parallel.size());
+  for (usize i = 0; i < serial.size(); ++i)
+  {
+    IAT_CHECK_EQ(serial[i].path, parallel[i].path);
+    IAT_CHECK_EQ(serial[i].inode, parallel[i].inode);
+    IAT_CHECK_EQ(serial[i].size, parallel[i].size);
+  }
+
+  std::error_code ec;
+  std::filesystem::remove_all(s_root, ec);
+  return true;
+}
+
+IAT_BEGIN_TEST_LIST()
+IAT_ADD_TEST(test_walk_tree);
+IAT_ADD_TEST(test_stat_entries);
+IAT_ADD_TEST(test_filter_and_depth);
+IAT_ADD_TEST(test_parallel_walk);
+IAT_END_TEST_LIST()
+
+IAT_END_BLOCK()
+
+IAT_REGISTER_ENTRY(Core, DirectoryWalker)
@@ -13,10 +13,24 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <platform_ops/async.hpp>
 #include <platform_ops/file.hpp>
 
 #include <iatest/iatest.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+
+#if IA_PLATFORM_UNIX
+#  include <fcntl.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
 using namespace ia;
 
 IAT_BEGIN_BLOCK(Core, FileOps)
@@ -113,6 +127,9 @@ auto test_shared_memory() -> bool
   String read_msg(reinterpret_cast<const char *>(client_ptr), msg.size());
   IAT_CHECK_EQ(read_msg, msg);
 
+  // A consumer asking for more than the owner sized is refused, rather than faulting past the end.
+  IAT_CHECK(!FileOps::map_shared_memory(shm_name, shm_size * 2, false).has_value());
+
   FileOps::unmap_file(owner_ptr);
   FileOps::unmap_file(client_ptr);
   FileOps::unlink_shared_memory(shm_name);
@@ -120,11 +137,689 @@ auto test_shared_memory() -> bool
   return true;
 }
 
+auto test_read_edge_cases() -> bool
+{
+  const Path path = "iatest_fileops_empty.bin";
+  (void) FileOps::write_binary_file(path, Vec<u8>{}, true);
+
+  const auto empty_res = FileOps::read_binary_file(path, true);
+  IAT_CHECK(empty_res.has_value());
+  IAT_CHECK(empty_res->empty());
+
+  const auto missing_res = FileOps::read_text_file("iatest_fileops_missing.txt");
+  IAT_CHECK(!missing_res.has_value());
+
+  // Pseudo files report a size of zero but still have contents.
+  if (std::filesystem::exists("/proc/self/status"))
+  {
+    const auto proc_res = FileOps::read_text_file("/proc/self/status");
+    IAT_CHECK(proc_res.has_value());
+    IAT_CHECK(proc_res->starts_with("Name:"));
+  }
+
+  cleanup_file(path);
+  return true;
+}
+
+auto test_read_mapped_large_file() -> bool
+{
+  const Path path = "iatest_fileops_large.bin";
+  Vec<u8> content(FileOps::MAPPED_READ_THRESHOLD + 3);
+  for (usize i = 0; i < content.size(); ++i)
+  {
+    content[i] = static_cast<u8>(i * 7);
+  }
+  (void) FileOps::write_binary_file(path, content, true);
+
+  const auto read_res = FileOps::read_binary_file(path);
+  IAT_CHECK(read_res.has_value());
+  IAT_CHECK_EQ(read_res->size(), content.size());
+  IAT_CHECK(*read_res == content);
+
+  cleanup_file(path);
+  return true;
+}
+
+auto test_read_into_reuse() -> bool
+{
+  const Path path = "iatest_fileops_reuse.bin";
+  const String head = "reused ";
+  const String tail = "buffer contents";
+  const Span<const u8> parts[] = {
+      {reinterpret_cast<const u8 *>(head.data()), head.size()},
+      {reinterpret_cast<const u8 *>(tail.data()), tail.size()},
+  };
+
+  const auto write_res = FileOps::write_from(path, parts, true);
+  IAT_CHECK(write_res.has_value());
+  IAT_CHECK_EQ(*write_res, head.size() + tail.size());
+
+  const auto exists_res = FileOps::write_from(path, parts);
+  IAT_CHECK(!exists_res.has_value());
+
+  String text;
+  text.reserve(4096);
+  const char *data = text.data();
+  const auto text_res = FileOps::read_into(path, text);
+  IAT_CHECK(text_res.has_value());
+  IAT_CHECK_EQ(*text_res, head.size() + tail.size());
+  IAT_CHECK_EQ(text, head + tail);
+  IAT_CHECK(text.data() == data);
+
+  Vec<u8> bytes(8192, 0xFF);
+  const u8 *bytes_data = bytes.data();
+  const auto bytes_res = FileOps::read_into(path, bytes);
+  IAT_CHECK(bytes_res.has_value());
+  IAT_CHECK_EQ(bytes.size(), head.size() + tail.size());
+  IAT_CHECK(bytes.data() == bytes_data);
+  IAT_CHECK_EQ(bytes[0], static_cast<u8>('r'));
+
+  // A fixed span is filled as far as it goes and the rest of the file is ignored.
+  Array<u8, 6> prefix{};
+  const auto prefix_res = FileOps::read_into(path, Span<u8>(prefix));
+  IAT_CHECK(prefix_res.has_value());
+  IAT_CHECK_EQ(*prefix_res, prefix.size());
+  IAT_CHECK(std::memcmp(prefix.data(), "reused", prefix.size()) == 0);
+
+  Array<u8, 64> whole{};
+  const auto whole_res = FileOps::read_into(path, Span<u8>(whole));
+  IAT_CHECK(whole_res.has_value());
+  IAT_CHECK_EQ(*whole_res, head.size() + tail.size());
+
+  cleanup_file(path);
+  return true;
+}
+
+auto test_vectored_io() -> bool
+{
+  const Path path = "iatest_fileops_vectored.bin";
+  const String header = "HEAD";
+  const String footer = "FOOT";
+  Vec<u8> payload(3000);
+  for (usize i = 0; i < payload.size(); ++i)
+  {
+    payload[i] = static_cast<u8>(i);
+  }
+
+  // More parts than one vectored call accepts, with empty ones mixed in.
+  Vec<Span<const u8>> parts;
+  parts.push_back({reinterpret_cast<const u8 *>(header.data()), header.size()});
+  for (usize i = 0; i < payload.size(); ++i)
+  {
+    parts.push_back({payload.data() + i, 1});
+    parts.push_back({});
+  }
+  parts.push_back({reinterpret_cast<const u8 *>(footer.data()), footer.size()});
+
+  const usize total = header.size() + payload.size() + footer.size();
+  const auto write_res = FileOps::write_gather(path, parts, true);
+  IAT_CHECK(write_res.has_value());
+  IAT_CHECK_EQ(*write_res, total);
+
+  Array<u8, 4> head{};
+  Vec<u8> body(payload.size());
+  Array<u8, 16> tail{};
+  const Span<u8> targets[] = {head, body, tail};
+  const auto read_res = FileOps::read_scatter(path, targets);
+  IAT_CHECK(read_res.has_value());
+  IAT_CHECK_EQ(*read_res, total);
+  IAT_CHECK(std::memcmp(head.data(), "HEAD", head.size()) == 0);
+  IAT_CHECK(body == payload);
+  IAT_CHECK(std::memcmp(tail.data(), "FOOT", 4) == 0);
+
+  // Handle overloads work at explicit offsets and leave the rest of the file alone.
+  const auto handle_res =
+      FileOps::native_open_file(path, FileOps::FileAccess::ReadWrite, FileOps::FileMode::OpenExisting);
+  IAT_CHECK(handle_res.has_value());
+
+  const String patch = "head";
+  const Span<const u8> patch_parts[] = {{reinterpret_cast<const u8 *>(patch.data()), patch.size()}};
+  const auto patch_res = FileOps::write_gather(*handle_res, patch_parts, 0);
+  IAT_CHECK(patch_res.has_value());
+  IAT_CHECK_EQ(*patch_res, patch.size());
+
+  Array<u8, 2> first{};
+  Array<u8, 8> second{};
+  const Span<u8> window[] = {first, second};
+  const auto window_res = FileOps::read_scatter(*handle_res, window, 2);
+  IAT_CHECK(window_res.has_value());
+  IAT_CHECK_EQ(*window_res, first.size() + second.size());
+  IAT_CHECK(std::memcmp(first.data(), "ad", first.size()) == 0);
+  IAT_CHECK_EQ(second[0], static_cast<u8>(0));
+
+  FileOps::native_close_file(*handle_res);
+
+  cleanup_file(path);
+
+#if IA_PLATFORM_UNIX
+  // FIFOs cannot be positioned, so writes to them fall back to plain writev.
+  const Path fifo_path = "iatest_fileops_vectored.fifo";
+  cleanup_file(fifo_path);
+  IAT_CHECK(mkfifo(fifo_path.string().c_str(), 0644) == 0);
+
+  Vec<u8> received;
+  std::thread consumer([&fifo_path, &received]() {
+    const int fd = open(fifo_path.string().c_str(), O_RDONLY);
+    Array<u8, 512> chunk{};
+    isize count = 0;
+    while (fd != -1 && (count = read(fd, chunk.data(), chunk.size())) > 0)
+    {
+      received.insert(received.end(), chunk.begin(), chunk.begin() + count);
+    }
+    if (fd != -1)
+    {
+      close(fd);
+    }
+  });
+  const auto fifo_res = FileOps::write_binary_file(fifo_path, payload, true);
+  consumer.join();
+  IAT_CHECK(fifo_res.has_value());
+  IAT_CHECK_EQ(*fifo_res, payload.size());
+  IAT_CHECK(received == payload);
+  cleanup_file(fifo_path);
+#endif
+  return true;
+}
+
+auto test_concurrent_mapping() -> bool
+{
+  constexpr usize THREAD_COUNT = 8;
+  constexpr usize ROUNDS = 200;
+
+  Vec<Path> paths;
+  for (usize i = 0; i < THREAD_COUNT; ++i)
+  {
+    paths.push_back("iatest_fileops_concurrent_" + std::to_string(i) + ".bin");
+    const Vec<u8> content(4096 + i, static_cast<u8>(i));
+    (void) FileOps::write_binary_file(paths.back(), content, true);
+  }
+
+  std::atomic<usize> failures = 0;
+  {
+    Vec<std::jthread> threads;
+    for (usize i = 0; i < THREAD_COUNT; ++i)
+    {
+      threads.emplace_back([&, i] {
+        for (usize round = 0; round < ROUNDS; ++round)
+        {
+          usize size = 0;
+          const auto map_res = FileOps::map_file(paths[i], size);
+          if (!map_res || size != 4096 + i || (*map_res)[size - 1] != static_cast<u8>(i))
+          {
+            failures.fetch_add(1);
+            continue;
+          }
+          FileOps::unmap_file(*map_res);
+        }
+      });
+    }
+  }
+  IAT_CHECK_EQ(failures.load(), static_cast<usize>(0));
+
+  // Unknown and already released pointers are ignored.
+  FileOps::unmap_file(nullptr);
+
+  for (Ref<Path> path : paths)
+  {
+    cleanup_file(path);
+  }
+  return true;
+}
+
+auto test_mapped_file() -> bool
+{
+  const Path path = "iatest_fileops_mapped_file.txt";
+  const String content = "Mapped without the registry";
+  (void) FileOps::write_text_file(path, content, true);
+
+  FileOps::MappedFile mapped;
+  IAT_CHECK(!mapped.is_valid());
+  IAT_CHECK(mapped.map(path).has_value());
+  IAT_CHECK(mapped.is_valid());
+  IAT_CHECK_EQ(mapped.get_size(), content.size());
+
+  FileOps::MappedFile moved = std::move(mapped);
+  IAT_CHECK(!mapped.is_valid());
+  IAT_CHECK(moved.is_valid());
+  const Span<const u8> bytes = moved.get_span();
+  IAT_CHECK_EQ(String(reinterpret_cast<const char *>(bytes.data()), bytes.size()), content);
+
+  moved.unmap();
+  IAT_CHECK(!moved.is_valid());
+  IAT_CHECK(!moved.map("iatest_fileops_missing.txt").has_value());
+
+  cleanup_file(path);
+  return true;
+}
+
+auto test_access_hints() -> bool
+{
+  const Path path = "iatest_fileops_hints.bin";
+  const usize size = 3 * FileOps::get_system_page_size() + 123;
+  Mut<Vec<u8>> data(size);
+  for (Mut<usize> i = 0; i < size; ++i)
+  {
+    data[i] = static_cast<u8>(i * 7);
+  }
+  IAT_CHECK(FileOps::write_binary_file(path, data, true).has_value());
+
+  usize mapped_size = 0;
+  const auto mapped = FileOps::map_file(path, mapped_size, FileOps::AccessHint::Random, FileOps::Prefault::Populate);
+  IAT_CHECK(mapped.has_value());
+  IAT_CHECK_EQ(mapped_size, size);
+  // Unaligned ranges are widened to whole pages.
+  FileOps::prefetch_range(*mapped + 100, 5000);
+  FileOps::advise_range(*mapped + 1, size - 1, FileOps::AccessHint::Sequential);
+  IAT_CHECK(std::memcmp(*mapped, data.data(), size) == 0);
+  FileOps::unmap_file(*mapped);
+
+  // Locking may be refused by RLIMIT_MEMLOCK. The mapping must work either way.
+  FileOps::MappedFile locked;
+  IAT_CHECK(locked.map(path, FileOps::AccessHint::WillNeed, FileOps::Prefault::Lock).has_value());
+  IAT_CHECK(std::memcmp(locked.get_data(), data.data(), size) == 0);
+  locked.prefetch_range(size - 10, 1000);
+  locked.advise_range(size + 10, 10, FileOps::AccessHint::Random);
+  // Dropping pages of a read-only file mapping only costs a re-read.
+  locked.advise_range(0, size, FileOps::AccessHint::DontNeed);
+  IAT_CHECK_EQ(locked.get_data()[size - 1], data[size - 1]);
+  locked.unmap();
+  IAT_CHECK(!locked.is_locked());
+
+  const auto handle = FileOps::native_open_file(path, FileOps::FileAccess::ReadWrite, FileOps::FileMode::OpenExisting);
+  IAT_CHECK(handle.has_value());
+  FileOps::MemoryMappedRegion region;
+  IAT_CHECK(region
+                .map(*handle, 0, size, FileOps::HugePages::None, FileOps::AccessHint::WillNeed,
+                     FileOps::Prefault::Populate)
+                .has_value());
+  IAT_CHECK(!region.is_locked());
+  region.prefetch_range(FileOps::get_system_page_size(), size);
+  IAT_CHECK_EQ(region.get_ptr()[size / 2], data[size / 2]);
+  region.unmap();
+  FileOps::native_close_file(*handle);
+
+  cleanup_file(path);
+  return true;
+}
+
+auto test_region_flushing() -> bool
+{
+  const Path path = "iatest_fileops_flush.bin";
+  const usize page_size = FileOps::get_system_page_size();
+  const usize size = 64 * page_size;
+  const auto handle = FileOps::native_open_file(path, FileOps::FileAccess::ReadWrite, FileOps::FileMode::CreateAlways);
+  IAT_CHECK(handle.has_value());
+
+  FileOps::MemoryMappedRegion region;
+  IAT_CHECK(!region.flush_range(0, size).has_value());
+  IAT_CHECK(region.map(*handle, 0, size).has_value());
+  FileOps::native_close_file(*handle);
+
+  // Marks are page-granular, and marking a page twice counts it once.
+  std::memset(region.get_ptr() + page_size + 10, 0x11, 20);
+  region.mark_dirty(page_size + 10, 20);
+  region.mark_dirty(page_size, 1);
+  std::memset(region.get_ptr() + 3 * page_size - 1, 0x22, 2);
+  region.mark_dirty(3 * page_size - 1, 2);
+  IAT_CHECK_EQ(region.get_dirty_size(), 3 * page_size);
+  IAT_CHECK(region.flush_dirty(true).has_value());
+  IAT_CHECK_EQ(region.get_dirty_size(), static_cast<usize>(0));
+
+  // Runs crossing a bitmap word, and ranges clamped to the region.
+  std::memset(region.get_ptr() + 60 * page_size, 0x33, 4 * page_size);
+  region.mark_dirty(60 * page_size, size);
+  region.mark_dirty(size, 10);
+  IAT_CHECK_EQ(region.get_dirty_size(), 4 * page_size);
+  IAT_CHECK(region.flush_dirty().has_value());
+  IAT_CHECK(region.flush_range(page_size / 2, 3 * page_size, true).has_value());
+  IAT_CHECK(region.flush_range(size + 1, 10).has_value());
+
+  const auto bytes = FileOps::read_binary_file(path);
+  IAT_CHECK(bytes.has_value());
+  IAT_CHECK_EQ(bytes->size(), size);
+  IAT_CHECK_EQ((*bytes)[page_size + 10], static_cast<u8>(0x11));
+  IAT_CHECK_EQ((*bytes)[3 * page_size], static_cast<u8>(0x22));
+  IAT_CHECK_EQ((*bytes)[size - 1], static_cast<u8>(0x33));
+
+  // Writers on several threads, with a background flush keeping at most 8 pages dirty between flushes.
+  (void) AsyncOps::initialize_scheduler(2);
+  region.set_background_flush(8 * page_size);
+  Mut<Vec<std::jthread>> writers;
+  for (Mut<usize> t = 0; t < 4; ++t)
+  {
+    writers.emplace_back([&region, t, size, page_size]() {
+      for (Mut<usize> offset = t * page_size; offset < size; offset += 4 * page_size)
+      {
+        region.get_ptr()[offset] = static_cast<u8>(t + 1);
+        region.mark_dirty(offset, 1);
+      }
+    });
+  }
+  writers.clear();
+  IAT_CHECK(region.get_dirty_size() <= size);
+  IAT_CHECK(region.flush_dirty().has_value());
+
+  FileOps::MemoryMappedRegion moved = std::move(region);
+  moved.flush();
+  IAT_CHECK_EQ(moved.get_dirty_size(), static_cast<usize>(0));
+  moved.unmap();
+  AsyncOps::terminate_scheduler();
+
+  const auto written = FileOps::read_binary_file(path);
+  IAT_CHECK(written.has_value());
+  IAT_CHECK_EQ((*written)[5 * page_size], static_cast<u8>(2));
+
+  cleanup_file(path);
+  return true;
+}
+
+auto test_file_size() -> bool
+{
+  const Path path = "iatest_fileops_file_size.bin";
+  const auto handle = FileOps::native_open_file(path, FileOps::FileAccess::ReadWrite, FileOps::FileMode::CreateAlways);
+  IAT_CHECK(handle.has_value());
+  IAT_CHECK(!FileOps::get_file_size(INVALID_FILE_HANDLE).has_value());
+
+  IAT_CHECK_EQ(*FileOps::get_file_size(*handle), static_cast<u64>(0));
+  IAT_CHECK(FileOps::set_file_size(*handle, 4096).has_value());
+  IAT_CHECK_EQ(*FileOps::get_file_size(*handle), static_cast<u64>(4096));
+  IAT_CHECK(FileOps::set_file_size(*handle, 10).has_value());
+  IAT_CHECK_EQ(*FileOps::get_file_size(*handle), static_cast<u64>(10));
+
+  FileOps::native_close_file(*handle);
+  cleanup_file(path);
+  return true;
+}
+
+auto test_preallocate() -> bool
+{
+  const Path path = "iatest_fileops_preallocate.bin";
+  const usize size = 1024 * 1024;
+  const auto handle = FileOps::native_open_file(path, FileOps::FileAccess::ReadWrite, FileOps::FileMode::CreateAlways);
+  IAT_CHECK(handle.has_value());
+  IAT_CHECK(!FileOps::preallocate(INVALID_FILE_HANDLE, size).has_value());
+
+  // Where it is supported, keep_size reserves blocks past the end without moving the end.
+  if (FileOps::preallocate(*handle, size, true).has_value())
+  {
+    IAT_CHECK_EQ(std::filesystem::file_size(path), static_cast<std::uintmax_t>(0));
+  }
+  IAT_CHECK(FileOps::preallocate(*handle, size).has_value());
+  IAT_CHECK_EQ(std::filesystem::file_size(path), static_cast<std::uintmax_t>(size));
+  IAT_CHECK(FileOps::preallocate(*handle, size / 2).has_value());
+  IAT_CHECK_EQ(std::filesystem::file_size(path), static_cast<std::uintmax_t>(size));
+
+#if IA_PLATFORM_UNIX
+  struct stat sb;
+  IAT_CHECK(fstat(*handle, &sb) == 0);
+  IAT_CHECK(static_cast<usize>(sb.st_blocks) * 512 >= size);
+#endif
+
+  // A region past the end is backed by reserved blocks as well as a longer file.
+  FileOps::MemoryMappedRegion region;
+  IAT_CHECK(region
+                .map(*handle, size, size, FileOps::HugePages::None, FileOps::AccessHint::Sequential,
+                     FileOps::Prefault::None, FileOps::FileGrowth::Preallocate)
+                .has_value());
+  IAT_CHECK_EQ(std::filesystem::file_size(path), static_cast<std::uintmax_t>(2 * size));
+#if IA_PLATFORM_UNIX
+  IAT_CHECK(fstat(*handle, &sb) == 0);
+  IAT_CHECK(static_cast<usize>(sb.st_blocks) * 512 >= 2 * size);
+#endif
+  region.get_ptr()[size - 1] = 0x7F;
+  region.unmap();
+  FileOps::native_close_file(*handle);
+
+  const auto bytes = FileOps::read_binary_file(path);
+  IAT_CHECK(bytes.has_value());
+  IAT_CHECK_EQ(bytes->back(), static_cast<u8>(0x7F));
+
+  cleanup_file(path);
+
+#if IA_PLATFORM_UNIX && defined(__linux__)
+  // A window deep into a sparse file reserves blocks for the window alone, not the hole before it.
+  const Path sparse_path = "iatest_fileops_preallocate_sparse.bin";
+  const auto sparse =
+      FileOps::native_open_file(sparse_path, FileOps::FileAccess::ReadWrite, FileOps::FileMode::CreateAlways);
+  IAT_CHECK(sparse.has_value());
+  FileOps::MemoryMappedRegion window;
+  IAT_CHECK(window
+                .map(*sparse, 64 * size, size, FileOps::HugePages::None, FileOps::AccessHint::Normal,
+                     FileOps::Prefault::None, FileOps::FileGrowth::Preallocate)
+                .has_value());
+  IAT_CHECK_EQ(std::filesystem::file_size(sparse_path), static_cast<std::uintmax_t>(65 * size));
+  IAT_CHECK(fstat(*sparse, &sb) == 0);
+  IAT_CHECK(static_cast<usize>(sb.st_blocks) * 512 >= size);
+  IAT_CHECK(static_cast<usize>(sb.st_blocks) * 512 < 2 * size);
+  window.unmap();
+  FileOps::native_close_file(*sparse);
+  cleanup_file(sparse_path);
+#endif
+  return true;
+}
+
+auto test_copy_file() -> bool
+{
+  const Path source = "iatest_fileops_copy_source.bin";
+  const Path destination = "iatest_fileops_copy_destination.bin";
+  cleanup_file(destination);
+
+  Vec<u8> content(3 * 1024 * 1024 + 123);
+  for (usize i = 0; i < content.size(); ++i)
+  {
+    content[i] = static_cast<u8>(i * 7 + i / 4096);
+  }
+  IAT_CHECK(FileOps::write_binary_file(source, content, true).has_value());
+
+  auto copied = FileOps::copy_file(source, destination);
+  IAT_CHECK(copied.has_value());
+  IAT_CHECK_EQ(copied->size, static_cast<u64>(content.size()));
+  IAT_CHECK(*FileOps::read_binary_file(destination) == content);
+
+  // An existing destination is only replaced when asked, and never by the source itself.
+  IAT_CHECK(!FileOps::copy_file(source, destination).has_value());
+  IAT_CHECK(!FileOps::copy_file(source, source, {.overwrite = true}).has_value());
+  IAT_CHECK_EQ(std::filesystem::file_size(source), static_cast<std::uintmax_t>(content.size()));
+  IAT_CHECK(!FileOps::copy_file("iatest_fileops_copy_missing.bin", destination, {.overwrite = true}).has_value());
+
+  // Every method gives the same bytes, whether or not holes are kept.
+  content.resize(content.size() / 3);
+  IAT_CHECK(FileOps::write_binary_file(source, content, true).has_value());
+  copied = FileOps::copy_file(source, destination, {.overwrite = true, .allow_clone = false, .preserve_holes = false});
+  IAT_CHECK(copied.has_value());
+  IAT_CHECK(copied->method != FileOps::CopyMethod::Clone);
+  IAT_CHECK(*FileOps::read_binary_file(destination) == content);
+
+#if IA_PLATFORM_UNIX
+  // Holes in the source stay holes, including one at the end.
+  const usize sparse_size = 64 * 1024 * 1024;
+  {
+    const auto handle = FileOps::native_open_file(source, FileOps::FileAccess::Write, FileOps::FileMode::CreateAlways);
+    IAT_CHECK(handle.has_value());
+    IAT_CHECK(pwrite(*handle, "head", 4, 0) == 4);
+    IAT_CHECK(pwrite(*handle, "middle", 6, sparse_size / 2) == 6);
+    IAT_CHECK(ftruncate(*handle, sparse_size) == 0);
+    FileOps::native_close_file(*handle);
+  }
+  copied = FileOps::copy_file(source, destination, {.overwrite = true});
+  IAT_CHECK(copied.has_value());
+  IAT_CHECK_EQ(std::filesystem::file_size(destination), static_cast<std::uintmax_t>(sparse_size));
+  struct stat sb;
+  IAT_CHECK(stat(destination.string().c_str(), &sb) == 0);
+  IAT_CHECK(static_cast<usize>(sb.st_blocks) * 512 < sparse_size / 4);
+  const auto sparse = FileOps::read_binary_file(destination);
+  IAT_CHECK(sparse.has_value());
+  IAT_CHECK_EQ(std::memcmp(sparse->data(), "head", 4), 0);
+  IAT_CHECK_EQ(std::memcmp(sparse->data() + sparse_size / 2, "middle", 6), 0);
+  IAT_CHECK_EQ(sparse->back(), static_cast<u8>(0));
+#endif
+
+  cleanup_file(source);
+  cleanup_file(destination);
+  return true;
+}
+
+auto test_huge_page_mappings() -> bool
+{
+  // Whatever the machine provides, the segment must work and report a page size at least as large as normal.
+  const String shm_name = "iatest_shm_huge";
+  const usize shm_size = 4 * 1024 * 1024;
+
+  usize owner_page_size = 0;
+  const auto owner_res =
+      FileOps::map_shared_memory(shm_name, shm_size, true, FileOps::HugePages::Explicit2M, owner_page_size);
+  IAT_CHECK(owner_res.has_value());
+  IAT_CHECK(owner_page_size >= FileOps::get_system_page_size());
+  std::memset(*owner_res, 0x5A, shm_size);
+
+  usize client_page_size = 0;
+  const auto client_res =
+      FileOps::map_shared_memory(shm_name, shm_size, false, FileOps::HugePages::Explicit2M, client_page_size);
+  IAT_CHECK(client_res.has_value());
+  IAT_CHECK_EQ(client_page_size, owner_page_size);
+  IAT_CHECK_EQ((*client_res)[shm_size - 1], static_cast<u8>(0x5A));
+
+  // Explicit huge pages are backed from the start.
+  const usize backed = FileOps::get_huge_page_backed_size(*owner_res, shm_size);
+  IAT_CHECK(backed <= shm_size);
+  if (owner_page_size > FileOps::get_system_page_size())
+  {
+    IAT_CHECK_EQ(backed, shm_size);
+  }
+
+  FileOps::unmap_file(*owner_res);
+  FileOps::unmap_file(*client_res);
+  FileOps::unlink_shared_memory(shm_name);
+
+  const Path path = "iatest_fileops_thp.bin";
+  const auto handle = FileOps::native_open_file(path, FileOps::FileAccess::ReadWrite, FileOps::FileMode::CreateAlways);
+  IAT_CHECK(handle.has_value());
+  FileOps::MemoryMappedRegion region;
+  IAT_CHECK(region.map(*handle, 0, shm_size, FileOps::HugePages::Transparent).has_value());
+  IAT_CHECK_EQ(region.get_page_size(), FileOps::get_system_page_size());
+  region.unmap();
+  IAT_CHECK_EQ(region.get_page_size(), static_cast<usize>(0));
+  FileOps::native_close_file(*handle);
+
+  cleanup_file(path);
+  return true;
+}
+
+auto test_load_files() -> bool
+{
+  const Path directory = "iatest_fileops_load";
+  std::error_code ec;
+  std::filesystem::remove_all(directory, ec);
+  std::filesystem::create_directory(directory);
+
+  // Sizes from empty to a few pages, then a missing file and a directory at known indices.
+  Vec<Path> paths;
+  Vec<Vec<u8>> contents;
+  for (usize i = 0; i < 200; ++i)
+  {
+    Vec<u8> content((i * 97) % 9000);
+    for (usize j = 0; j < content.size(); ++j)
+    {
+      content[j] = static_cast<u8>(i + j * 13);
+    }
+    paths.push_back(directory / ("file_" + std::to_string(i) + ".bin"));
+    IAT_CHECK(FileOps::write_binary_file(paths.back(), content, true).has_value());
+    contents.push_back(std::move(content));
+  }
+  paths.push_back(directory / "missing.bin");
+  paths.push_back(directory);
+
+  const auto check_loaded = [&](Ref<FileOps::LoadedFiles> loaded) -> bool {
+    IAT_CHECK_EQ(loaded.get_count(), paths.size());
+    IAT_CHECK_EQ(loaded.get_failed_count(), static_cast<usize>(2));
+    usize total_size = 0;
+    for (usize i = 0; i < contents.size(); ++i)
+    {
+      IAT_CHECK(loaded.is_loaded(i));
+      IAT_CHECK(loaded.get_error(i).empty());
+      const Span<const u8> data = loaded.get_data(i);
+      IAT_CHECK_EQ(data.size(), contents[i].size());
+      IAT_CHECK(data.empty() || std::memcmp(data.data(), contents[i].data(), data.size()) == 0);
+      IAT_CHECK_EQ(reinterpret_cast<uintptr_t>(data.data()) % FileOps::LoadedFiles::ALIGNMENT, 0u);
+      IAT_CHECK_EQ(loaded.get_text(i).size(), data.size());
+      total_size += data.size();
+    }
+    IAT_CHECK_EQ(loaded.get_total_size(), total_size);
+    IAT_CHECK(!loaded.is_loaded(contents.size()));
+    IAT_CHECK(!loaded.get_error(contents.size() + 1).empty());
+    IAT_CHECK(loaded.get_data(contents.size() + 1).empty());
+    return true;
+  };
+
+  // The largest files take an arena of their own.
+  contents[199].assign(FileOps::LoadedFiles::ARENA_SIZE, 0x5a);
+  IAT_CHECK(FileOps::write_binary_file(paths[199], contents[199], true).has_value());
+
+  FileOps::LoadOptions by_inode;
+  by_inode.order = FileOps::LoadOrder::Inode;
+  by_inode.no_access_time = true;
+  IAT_CHECK(check_loaded(FileOps::load_files(paths)));
+  IAT_CHECK(check_loaded(FileOps::load_files(paths, by_inode)));
+
+  (void) AsyncOps::initialize_scheduler(2);
+  IAT_CHECK(check_loaded(FileOps::load_files(paths)));
+  IAT_CHECK(check_loaded(FileOps::load_files(paths, by_inode)));
+
+  // The streaming form sees every file exactly once.
+  std::mutex mutex;
+  Vec<u32> seen(paths.size(), 0);
+  usize failed = 0;
+  bool matches = true;
+  FileOps::load_each_file(paths, by_inode, [&](const usize index, Result<Span<const u8>> data) {
+    const std::lock_guard lock(mutex);
+    ++seen[index];
+    if (!data)
+    {
+      ++failed;
+      return;
+    }
+    matches &= data->size() == contents[index].size() &&
+               std::equal(data->begin(), data->end(), contents[index].begin());
+  });
+  AsyncOps::terminate_scheduler();
+  IAT_CHECK(matches);
+  IAT_CHECK_EQ(failed, static_cast<usize>(2));
+  IAT_CHECK(std::all_of(seen.begin(), seen.end(), [](const u32 count) { return count == 1; }));
+
+#if IA_PLATFORM_UNIX && defined(__linux__)
+  // procfs reports a size of 0, so the file is read until EOF and appended after the others.
+  const Path proc_paths[] = {paths[5], "/proc/self/status"};
+  const FileOps::LoadedFiles proc = FileOps::load_files(proc_paths);
+  IAT_CHECK_EQ(proc.get_failed_count(), static_cast<usize>(0));
+  IAT_CHECK(proc.get_text(1).starts_with("Name:"));
+  IAT_CHECK_EQ(proc.get_data(0).size(), contents[5].size());
+  IAT_CHECK(std::memcmp(proc.get_data(0).data(), contents[5].data(), contents[5].size()) == 0);
+#endif
+
+  IAT_CHECK_EQ(FileOps::load_files({}).get_count(), static_cast<usize>(0));
+
+  std::filesystem::remove_all(directory, ec);
+  return true;
+}
+
 IAT_BEGIN_TEST_LIST()
 IAT_ADD_TEST(test_text_io);
 IAT_ADD_TEST(test_binary_io);
 IAT_ADD_TEST(test_file_mapping);
 IAT_ADD_TEST(test_shared_memory);
+IAT_ADD_TEST(test_huge_page_mappings);
+IAT_ADD_TEST(test_read_edge_cases);
+IAT_ADD_TEST(test_read_mapped_large_file);
+IAT_ADD_TEST(test_read_into_reuse);
+IAT_ADD_TEST(test_vectored_io);
+IAT_ADD_TEST(test_concurrent_mapping);
+IAT_ADD_TEST(test_mapped_file);
+IAT_ADD_TEST(test_access_hints);
+IAT_ADD_TEST(test_region_flushing);
+IAT_ADD_TEST(test_file_size);
+IAT_ADD_TEST(test_preallocate);
+IAT_ADD_TEST(test_copy_file);
+IAT_ADD_TEST(test_load_files);
 IAT_END_TEST_LIST()
 
 IAT_END_BLOCK()
@@ -0,0 +1,362 @@
+// IA-PlatformOps; C++ 20 Async, Process and File Operations.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <platform_ops/async_file.hpp>
+#include <platform_ops/file_stream.hpp>
+
+#include <iatest/iatest.hpp>
+
+#include <cstring>
+#include <filesystem>
+
+using namespace ia;
+
+struct StreamAsyncGuard
+{
+  StreamAsyncGuard(bool allow_io_uring)
+  {
+    (void) AsyncOps::initialize_scheduler(2);
+    (void) AsyncFileOps::initialize(AsyncFileOps::DEFAULT_QUEUE_DEPTH, allow_io_uring);
+  }
+
+  ~StreamAsyncGuard()
+  {
+    AsyncFileOps::terminate();
+    AsyncOps::terminate_scheduler();
+  }
+};
+
+IAT_BEGIN_BLOCK(Core, FileStream)
+
+void cleanup_file(const Path &path)
+{
+  std::error_code ec;
+  std::filesystem::remove(path, ec);
+}
+
+// Small buffers, so the content spans many refills and writes straddle buffer boundaries.
+static constexpr usize TEST_BUFFER_SIZE = 4096;
+
+auto stream_round_trip(const Path &path,
+                       FileOps::FileCaching caching = FileOps::FileCaching::Buffered) -> bool
+{
+  const bool is_direct = caching == FileOps::FileCaching::Direct;
+
+  Vec<u8> content(TEST_BUFFER_SIZE * 37 + 123);
+  for (usize i = 0; i < content.size(); ++i)
+  {
+    content[i] = static_cast<u8>(i * 13 + (i >> 8));
+  }
+
+  {
+    FileWriter writer;
+    IAT_CHECK(writer.open(path, true, TEST_BUFFER_SIZE, caching).has_value());
+
+    // Alternate copied writes of uneven sizes with writes made in place.
+    usize offset = 0;
+    usize step = 1;
+    bool in_place = false;
+    while (offset < content.size())
+    {
+      const usize count = std::min(step, content.size() - offset);
+      if (in_place)
+      {
+        // Direct mode may be carrying a partial block, so asks for less.
+        const usize reserved = std::min(count, is_direct ? TEST_BUFFER_SIZE / 2 : TEST_BUFFER_SIZE);
+        const auto space = writer.reserve(reserved);
+        IAT_CHECK(space.has_value());
+        std::memcpy(space->data(), content.data() + offset, reserved);
+        writer.commit(reserved);
+        offset += reserved;
+      }
+      else
+      {
+        IAT_CHECK(writer.write(Span<const u8>(content.data() + offset, count)).has_value());
+        offset += count;
+      }
+      IAT_CHECK_EQ(writer.get_position(), offset);
+
+      in_place = !in_place;
+      step = step > TEST_BUFFER_SIZE ? 1 : step * 3 + 1;
+    }
+    IAT_CHECK(writer.close().has_value());
+  }
+  IAT_CHECK_EQ(std::filesystem::file_size(path), content.size());
+
+  FileReader reader;
+  IAT_CHECK(reader.open(path, TEST_BUFFER_SIZE, true, caching).has_value());
+
+  Vec<u8> read_back;
+  read_back.reserve(content.size());
+
+  // Take a prefix with read, then the rest straight out of the buffers.
+  Vec<u8> head(TEST_BUFFER_SIZE + 17);
+  const auto head_res = reader.read(head);
+  IAT_CHECK(head_res.has_value());
+  IAT_CHECK_EQ(*head_res, head.size());
+  read_back.insert(read_back.end(), head.begin(), head.end());
+  IAT_CHECK_EQ(reader.get_position(), head.size());
+
+  while (true)
+  {
+    const auto available = reader.peek();
+    IAT_CHECK(available.has_value());
+    if (available->empty())
+    {
+      break;
+    }
+    const usize count = std::min<usize>(available->size(), 1000);
+    read_back.insert(read_back.end(), available->begin(), available->begin() + count);
+    reader.consume(count);
+  }
+
+  IAT_CHECK_EQ(reader.get_position(), content.size());
+  IAT_CHECK(read_back == content);
+
+  const auto past_end = reader.peek();
+  IAT_CHECK(past_end.has_value());
+  IAT_CHECK(past_end->empty());
+
+  reader.close();
+  cleanup_file(path);
+  return true;
+}
+
+auto test_synchronous_streams() -> bool
+{
+  return stream_round_trip("iatest_stream_sync.bin");
+}
+
+auto test_io_uring_streams() -> bool
+{
+  StreamAsyncGuard guard(true);
+  return stream_round_trip("iatest_stream_uring.bin");
+}
+
+auto test_blocking_pool_streams() -> bool
+{
+  StreamAsyncGuard guard(false);
+  return stream_round_trip("iatest_stream_pool.bin");
+}
+
+// Direct I/O needs filesystem support, which tmpfs and some network filesystems lack.
+auto is_direct_io_supported(const Path &path) -> bool
+{
+  const auto handle = FileOps::native_open_file(path, FileOps::FileAccess::ReadWrite, FileOps::FileMode::CreateAlways,
+                                                0644, FileOps::FileCaching::Direct);
+  if (!handle)
+  {
+    return false;
+  }
+  FileOps::native_close_file(*handle);
+  cleanup_file(path);
+  return true;
+}
+
+auto test_direct_streams() -> bool
+{
+  if (!is_direct_io_supported("iatest_stream_direct.bin"))
+  {
+    return true;
+  }
+  IAT_CHECK(stream_round_trip("iatest_stream_direct.bin", FileOps::FileCaching::Direct));
+
+  StreamAsyncGuard guard(true);
+  return stream_round_trip("iatest_stream_direct_async.bin", FileOps::FileCaching::Direct);
+}
+
+auto test_direct_io_alignment() -> bool
+{
+  const Path path = "iatest_stream_alignment.bin";
+  if (!is_direct_io_supported(path))
+  {
+    return true;
+  }
+
+  const auto handle = FileOps::native_open_file(path, FileOps::FileAccess::ReadWrite, FileOps::FileMode::CreateAlways,
+                                                0644, FileOps::FileCaching::Direct);
+  IAT_CHECK(handle.has_value());
+  const auto alignment = FileOps::get_direct_io_alignment(*handle);
+  IAT_CHECK(alignment.has_value());
+  IAT_CHECK(alignment->offset > 0 && (alignment->offset & (alignment->offset - 1)) == 0);
+  IAT_CHECK(alignment->memory > 0 && (alignment->memory & (alignment->memory - 1)) == 0);
+
+  // Pool buffers can be handed straight to the handle.
+  AlignedBufferPool pool(alignment->offset + 1, *alignment, 2);
+  IAT_CHECK_EQ(pool.get_buffer_size() % alignment->offset, static_cast<usize>(0));
+  AlignedBuffer buffer = pool.acquire();
+  IAT_CHECK_EQ(buffer.get_size(), pool.get_buffer_size());
+  IAT_CHECK_EQ(reinterpret_cast<uintptr_t>(buffer.get_data()) % alignment->memory, static_cast<uintptr_t>(0));
+  std::memset(buffer.get_data(), 'x', buffer.get_size());
+  const Span<const u8> blocks[] = {Span<const u8>(buffer.get_data(), buffer.get_size())};
+  const auto written = FileOps::write_gather(*handle, blocks, 0);
+  IAT_CHECK(written.has_value());
+  IAT_CHECK_EQ(*written, buffer.get_size());
+  FileOps::native_close_file(*handle);
+
+  // Buffers come back for reuse, up to the cache limit, and foreign ones are freed.
+  const u8 *first = buffer.get_data();
+  pool.release(std::move(buffer));
+  IAT_CHECK_EQ(pool.get_cached_count(), static_cast<usize>(1));
+  AlignedBuffer again = pool.acquire();
+  IAT_CHECK(again.get_data() == first);
+  IAT_CHECK_EQ(pool.get_cached_count(), static_cast<usize>(0));
+
+  AlignedBuffer foreign;
+  foreign.allocate(64);
+  pool.release(std::move(foreign));
+  IAT_CHECK_EQ(pool.get_cached_count(), static_cast<usize>(0));
+
+  AlignedBuffer extra_1 = pool.acquire();
+  AlignedBuffer extra_2 = pool.acquire();
+  pool.release(std::move(again));
+  pool.release(std::move(extra_1));
+  pool.release(std::move(extra_2));
+  IAT_CHECK_EQ(pool.get_cached_count(), static_cast<usize>(2));
+
+  cleanup_file(path);
+  return true;
+}
+
+// Direct streams at offsets and lengths that are not block aligned must leave the bytes around them alone.
+auto test_direct_unaligned_ranges() -> bool
+{
+  const Path path = "iatest_stream_direct_ranges.bin";
+  if (!is_direct_io_supported(path))
+  {
+    return true;
+  }
+
+  Vec<u8> expected(3 * TEST_BUFFER_SIZE + 321);
+  for (usize i = 0; i < expected.size(); ++i)
+  {
+    expected[i] = static_cast<u8>(i * 7 + 1);
+  }
+  IAT_CHECK(FileOps::write_binary_file(path, expected, true).has_value());
+
+  const auto handle = FileOps::native_open_file(path, FileOps::FileAccess::ReadWrite, FileOps::FileMode::OpenExisting,
+                                                0644, FileOps::FileCaching::Direct);
+  IAT_CHECK(handle.has_value());
+
+  // Overwrite a range in the middle, flushing part way so a partial block is written and then written again.
+  Vec<u8> patch(TEST_BUFFER_SIZE + 1000);
+  for (usize i = 0; i < patch.size(); ++i)
+  {
+    patch[i] = static_cast<u8>(255 - i);
+  }
+  const usize patch_offset = 1001;
+  {
+    FileWriter writer;
+    IAT_CHECK(writer.open(*handle, patch_offset, TEST_BUFFER_SIZE, FileOps::FileCaching::Direct).has_value());
+    IAT_CHECK(writer.write(Span<const u8>(patch.data(), 700)).has_value());
+    IAT_CHECK(writer.flush().has_value());
+    IAT_CHECK_EQ(writer.get_position(), static_cast<u64>(patch_offset + 700));
+    IAT_CHECK(writer.write(Span<const u8>(patch.data() + 700, patch.size() - 700)).has_value());
+    IAT_CHECK(writer.close().has_value());
+  }
+  std::memcpy(expected.data() + patch_offset, patch.data(), patch.size());
+
+  // Extend past the end from an unaligned offset.
+  const String tail = "direct tail";
+  {
+    FileWriter writer;
+    IAT_CHECK(writer.open(*handle, expected.size(), TEST_BUFFER_SIZE, FileOps::FileCaching::Direct).has_value());
+    IAT_CHECK(writer.write(Span<const u8>(reinterpret_cast<const u8 *>(tail.data()), tail.size())).has_value());
+    IAT_CHECK(writer.close().has_value());
+  }
+  expected.insert(expected.end(), tail.begin(), tail.end());
+  IAT_CHECK_EQ(std::filesystem::file_size(path), expected.size());
+
+  const auto contents = FileOps::read_binary_file(path);
+  IAT_CHECK(contents.has_value());
+  IAT_CHECK(*contents == expected);
+
+  // Read back from an unaligned offset.
+  const usize read_offset = 777;
+  FileReader reader;
+  IAT_CHECK(reader.open(*handle, read_offset, TEST_BUFFER_SIZE, false, FileOps::FileCaching::Direct).has_value());
+  IAT_CHECK_EQ(reader.get_position(), static_cast<u64>(read_offset));
+  Vec<u8> read_back(expected.size());
+  const auto read_res = reader.read(read_back);
+  IAT_CHECK(read_res.has_value());
+  IAT_CHECK_EQ(*read_res, expected.size() - read_offset);
+  IAT_CHECK(std::memcmp(read_back.data(), expected.data() + read_offset, *read_res) == 0);
+  IAT_CHECK_EQ(reader.get_position(), static_cast<u64>(expected.size()));
+  reader.close();
+
+  FileOps::native_close_file(*handle);
+  cleanup_file(path);
+  return true;
+}
+
+auto test_stream_edge_cases() -> bool
+{
+  const Path path = "iatest_stream_edges.bin";
+  FileReader reader;
+  IAT_CHECK(!reader.open("iatest_stream_missing.bin").has_value());
+  IAT_CHECK(!reader.is_open());
+
+  {
+    FileWriter writer;
+    IAT_CHECK(writer.open(path, true, TEST_BUFFER_SIZE).has_value());
+    IAT_CHECK(writer.close().has_value());
+  }
+
+  IAT_CHECK(reader.open(path, TEST_BUFFER_SIZE).has_value());
+  const auto empty = reader.peek();
+  IAT_CHECK(empty.has_value());
+  IAT_CHECK(empty->empty());
+  reader.close();
+
+  // Refuses to replace an existing file unless asked to.
+  FileWriter writer;
+  IAT_CHECK(!writer.open(path, false).has_value());
+
+  // Handle streams start at the given offset and leave the handle open.
+  const auto handle =
+      FileOps::native_open_file(path, FileOps::FileAccess::ReadWrite, FileOps::FileMode::OpenExisting);
+  IAT_CHECK(handle.has_value());
+
+  const String text = "0123456789";
+  IAT_CHECK(writer.open(*handle, 3, TEST_BUFFER_SIZE).has_value());
+  IAT_CHECK(writer.write(Span<const u8>(reinterpret_cast<const u8 *>(text.data()), text.size())).has_value());
+  IAT_CHECK(writer.close().has_value());
+
+  IAT_CHECK(reader.open(*handle, 5, TEST_BUFFER_SIZE).has_value());
+  Array<u8, 32> buffer{};
+  const auto read_res = reader.read(buffer);
+  IAT_CHECK(read_res.has_value());
+  IAT_CHECK_EQ(*read_res, static_cast<usize>(8));
+  IAT_CHECK(std::memcmp(buffer.data(), "23456789", 8) == 0);
+  reader.close();
+
+  FileOps::native_close_file(*handle);
+  cleanup_file(path);
+  return true;
+}
+
+IAT_BEGIN_TEST_LIST()
+IAT_ADD_TEST(test_synchronous_streams);
+IAT_ADD_TEST(test_io_uring_streams);
+IAT_ADD_TEST(test_blocking_pool_streams);
+IAT_ADD_TEST(test_stream_edge_cases);
+IAT_ADD_TEST(test_direct_streams);
+IAT_ADD_TEST(test_direct_io_alignment);
+IAT_ADD_TEST(test_direct_unaligned_ranges);
+IAT_END_TEST_LIST()
+
+IAT_END_BLOCK()
+
+IAT_REGISTER_ENTRY(Core, FileStream)
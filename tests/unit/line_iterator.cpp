@@ -0,0 +1,220 @@
+// IA-PlatformOps; C++ 20 Async, Process and File Operations.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <platform_ops/line_iterator.hpp>
+
+#include <iatest/iatest.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
+using namespace ia;
+
+struct LineSchedulerGuard
+{
+  LineSchedulerGuard(u8 worker_count = 2)
+  {
+    (void) AsyncOps::initialize_scheduler(worker_count);
+  }
+
+  ~LineSchedulerGuard()
+  {
+    AsyncOps::terminate_scheduler();
+  }
+};
+
+IAT_BEGIN_BLOCK(Core, LineIterator)
+
+auto collect_lines(StringView text) -> Vec<String>
+{
+  Vec<String> lines;
+  LineIterator::for_each_line(text, [&](StringView line) { lines.emplace_back(line); });
+  return lines;
+}
+
+// Byte-at-a-time reference with the same rules, to check the vectorized scan against.
+auto collect_lines_scalar(StringView text) -> Vec<String>
+{
+  Vec<String> lines;
+  String current;
+  for (usize i = 0; i < text.size(); ++i)
+  {
+    if (text[i] == '\n' || text[i] == '\r')
+    {
+      if (!current.empty())
+      {
+        lines.push_back(current);
+      }
+      current.clear();
+      continue;
+    }
+    current += text[i];
+  }
+  if (!current.empty())
+  {
+    lines.push_back(current);
+  }
+  return lines;
+}
+
+// Lines of varied length with every terminator style, so breaks land at every offset within a vector.
+auto make_log_text(const usize line_count) -> String
+{
+  String text;
+  for (usize i = 0; i < line_count; ++i)
+  {
+    text.append((i * 37) % 101, static_cast<char>('a' + i % 26));
+    static const char *const terminators[] = {"\n", "\r\n", "\r", "\n\n", "\r\n\r\n"};
+    text += terminators[i % 5];
+  }
+  return text;
+}
+
+auto test_line_terminators() -> bool
+{
+  const Vec<String> lines = collect_lines("alpha\nbeta\r\ngamma\rdelta\n\n\r\nepsilon");
+  IAT_CHECK_EQ(lines.size(), static_cast<usize>(5));
+  IAT_CHECK_EQ(lines[0], String("alpha"));
+  IAT_CHECK_EQ(lines[1], String("beta"));
+  IAT_CHECK_EQ(lines[2], String("gamma"));
+  IAT_CHECK_EQ(lines[3], String("delta"));
+  IAT_CHECK_EQ(lines[4], String("epsilon"));
+
+  IAT_CHECK(collect_lines("").empty());
+  IAT_CHECK(collect_lines("\r\n\n\r").empty());
+
+  const u8 bytes[] = {'x', '\r', '\n', 'y'};
+  LineIterator it{Span<const u8>(bytes)};
+  StringView line;
+  IAT_CHECK(it.next(line));
+  IAT_CHECK_EQ(line, StringView("x"));
+  IAT_CHECK(it.next(line));
+  IAT_CHECK_EQ(line, StringView("y"));
+  IAT_CHECK(!it.next(line));
+
+  return true;
+}
+
+auto test_vectorized_scan() -> bool
+{
+  // A single break at every position of a buffer a few vectors wide.
+  String buffer(100, 'x');
+  for (usize i = 0; i < buffer.size(); ++i)
+  {
+    buffer[i] = (i % 2 == 0) ? '\n' : '\r';
+    const char *found = LineIterator::find_line_break(buffer.data(), buffer.data() + buffer.size());
+    IAT_CHECK_EQ(static_cast<usize>(found - buffer.data()), i);
+    buffer[i] = 'x';
+  }
+  const char *none = LineIterator::find_line_break(buffer.data(), buffer.data() + buffer.size());
+  IAT_CHECK(none == buffer.data() + buffer.size());
+
+  const String text = make_log_text(500);
+  IAT_CHECK(collect_lines(text) == collect_lines_scalar(text));
+
+  return true;
+}
+
+auto test_split_at_line_breaks() -> bool
+{
+  const String text = make_log_text(2000);
+  const Vec<StringView> parts = LineIterator::split(text, 7);
+  IAT_CHECK(!parts.empty());
+  IAT_CHECK(parts.size() <= 7);
+
+  String joined;
+  Vec<String> lines;
+  for (usize i = 0; i < parts.size(); ++i)
+  {
+    joined.append(parts[i]);
+    if (i + 1 < parts.size())
+    {
+      IAT_CHECK(parts[i].ends_with('\n') || parts[i].ends_with('\r'));
+      IAT_CHECK(!(parts[i].ends_with('\r') && parts[i + 1].starts_with('\n')));
+    }
+    for (Ref<String> line : collect_lines(parts[i]))
+    {
+      lines.push_back(line);
+    }
+  }
+  IAT_CHECK_EQ(joined, text);
+  IAT_CHECK(lines == collect_lines(text));
+
+  IAT_CHECK(LineIterator::split("", 4).empty());
+  IAT_CHECK_EQ(LineIterator::split("no terminator", 4).size(), static_cast<usize>(1));
+
+  return true;
+}
+
+auto parallel_matches_sequential(Ref<String> text) -> bool
+{
+  std::atomic<usize> line_count = 0;
+  std::atomic<usize> byte_count = 0;
+  LineIterator::for_each_line_parallel(
+      text,
+      [&](StringView line, AsyncOps::WorkerId) {
+        line_count.fetch_add(1, std::memory_order_relaxed);
+        byte_count.fetch_add(line.size(), std::memory_order_relaxed);
+      },
+      4096);
+
+  const Vec<String> expected = collect_lines(text);
+  usize expected_bytes = 0;
+  for (Ref<String> line : expected)
+  {
+    expected_bytes += line.size();
+  }
+  IAT_CHECK_EQ(line_count.load(), expected.size());
+  IAT_CHECK_EQ(byte_count.load(), expected_bytes);
+  return true;
+}
+
+auto test_parallel_lines() -> bool
+{
+  const String text = make_log_text(20000);
+  IAT_CHECK(parallel_matches_sequential(text));
+
+  LineSchedulerGuard guard(3);
+  IAT_CHECK(parallel_matches_sequential(text));
+
+  // Every line is seen exactly once across the workers.
+  std::mutex mutex;
+  Vec<String> lines;
+  LineIterator::for_each_line_parallel(
+      text,
+      [&](StringView line, AsyncOps::WorkerId) {
+        std::lock_guard lock(mutex);
+        lines.emplace_back(line);
+      },
+      4096);
+  Vec<String> expected = collect_lines(text);
+  std::sort(lines.begin(), lines.end());
+  std::sort(expected.begin(), expected.end());
+  IAT_CHECK(lines == expected);
+
+  return true;
+}
+
+IAT_BEGIN_TEST_LIST()
+IAT_ADD_TEST(test_line_terminators);
+IAT_ADD_TEST(test_vectorized_scan);
+IAT_ADD_TEST(test_split_at_line_breaks);
+IAT_ADD_TEST(test_parallel_lines);
+IAT_END_TEST_LIST()
+
+IAT_END_BLOCK()
+
+IAT_REGISTER_ENTRY(Core, LineIterator)
@@ -0,0 +1,237 @@
+// IA-PlatformOps; C++ 20 Async, Process and File Operations.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <platform_ops/mapped_log.hpp>
+
+#include <iatest/iatest.hpp>
+
+#include <cstring>
+#include <filesystem>
+#include <thread>
+
+using namespace ia;
+
+IAT_BEGIN_BLOCK(Core, MappedLog)
+
+void cleanup_file(const Path &path)
+{
+  std::error_code ec;
+  std::filesystem::remove(path, ec);
+}
+
+// The smallest extent, so the records below straddle many extent boundaries.
+static constexpr usize TEST_EXTENT_SIZE = 64 * 1024;
+
+struct RecordHeader
+{
+  u32 size;
+  u32 writer;
+  u32 sequence;
+};
+
+auto get_payload_byte(const u32 writer, const u32 sequence, const usize index) -> u8
+{
+  return static_cast<u8>(writer * 31 + sequence * 7 + index);
+}
+
+auto run_concurrent_appends(const Path &path) -> bool
+{
+  cleanup_file(path);
+
+  static constexpr u32 WRITER_COUNT = 4;
+  static constexpr u32 RECORDS_PER_WRITER = 2000;
+
+  MappedLog log;
+  IAT_CHECK(log.open(path, TEST_EXTENT_SIZE).has_value());
+  IAT_CHECK_EQ(log.get_extent_size(), TEST_EXTENT_SIZE);
+
+  std::atomic<usize> failures = 0;
+  {
+    Vec<std::jthread> writers;
+    for (u32 writer = 0; writer < WRITER_COUNT; ++writer)
+    {
+      writers.emplace_back([&log, &failures, writer]() {
+        Vec<u8> record;
+        for (u32 sequence = 0; sequence < RECORDS_PER_WRITER; ++sequence)
+        {
+          const RecordHeader header{static_cast<u32>(sizeof(RecordHeader) + (sequence * 37) % 300), writer, sequence};
+          record.resize(header.size);
+          std::memcpy(record.data(), &header, sizeof(header));
+          for (usize i = sizeof(header); i < record.size(); ++i)
+          {
+            record[i] = get_payload_byte(writer, sequence, i);
+          }
+          if (!log.append(record).has_value())
+          {
+            failures.fetch_add(1);
+          }
+        }
+      });
+    }
+  }
+  IAT_CHECK_EQ(failures.load(), static_cast<usize>(0));
+
+  const u64 size = log.get_size();
+  IAT_CHECK(log.flush(true).has_value());
+  IAT_CHECK(log.close().has_value());
+  IAT_CHECK(!log.is_open());
+
+  // Every record must be intact, and each writer's records must appear in the order it appended them.
+  const auto bytes = FileOps::read_binary_file(path);
+  IAT_CHECK(bytes.has_value());
+  IAT_CHECK_EQ(static_cast<u64>(bytes->size()), size);
+
+  Vec<u32> next_sequence(WRITER_COUNT, 0);
+  usize offset = 0;
+  while (offset < bytes->size())
+  {
+    RecordHeader header;
+    IAT_CHECK(offset + sizeof(header) <= bytes->size());
+    std::memcpy(&header, bytes->data() + offset, sizeof(header));
+    IAT_CHECK(header.writer < WRITER_COUNT);
+    IAT_CHECK_EQ(header.sequence, next_sequence[header.writer]);
+    IAT_CHECK(offset + header.size <= bytes->size());
+    for (usize i = sizeof(header); i < header.size; ++i)
+    {
+      IAT_CHECK_EQ((*bytes)[offset + i], get_payload_byte(header.writer, header.sequence, i));
+    }
+    ++next_sequence[header.writer];
+    offset += header.size;
+  }
+  for (const u32 count : next_sequence)
+  {
+    IAT_CHECK_EQ(count, RECORDS_PER_WRITER);
+  }
+
+  cleanup_file(path);
+  return true;
+}
+
+auto test_concurrent_appends() -> bool
+{
+  return run_concurrent_appends("iatest_mapped_log_concurrent.bin");
+}
+
+// With the scheduler running, extents are mapped ahead on a worker while the appenders fill the current one.
+auto test_concurrent_appends_map_ahead() -> bool
+{
+  (void) AsyncOps::initialize_scheduler(2);
+  const bool passed = run_concurrent_appends("iatest_mapped_log_map_ahead.bin");
+  AsyncOps::terminate_scheduler();
+  return passed;
+}
+
+auto test_reopen_and_limits() -> bool
+{
+  const Path path = "iatest_mapped_log_reopen.bin";
+  IAT_CHECK(FileOps::write_text_file(path, "existing|", true).has_value());
+
+  MappedLog log;
+  IAT_CHECK(log.open(path, 1, 2 * TEST_EXTENT_SIZE).has_value());
+  IAT_CHECK_EQ(log.get_size(), static_cast<u64>(9));
+
+  const String text = "appended|";
+  const auto appended = log.append(Span<const u8>(reinterpret_cast<const u8 *>(text.data()), text.size()));
+  IAT_CHECK(appended.has_value());
+  IAT_CHECK_EQ(*appended, static_cast<u64>(9));
+
+  // A reserved record filled back to front, across the boundary between the two extents.
+  const u64 record_size = TEST_EXTENT_SIZE;
+  const auto reserved = log.reserve(record_size);
+  IAT_CHECK(reserved.has_value());
+  Vec<u8> half(record_size / 2, 'b');
+  IAT_CHECK(log.write(*reserved + record_size / 2, half).has_value());
+  std::memset(half.data(), 'a', half.size());
+  IAT_CHECK(log.write(*reserved, half).has_value());
+
+  // Past the maximum size, a reservation fails and leaves the log as it was.
+  const u64 size = log.get_size();
+  IAT_CHECK(!log.reserve(2 * TEST_EXTENT_SIZE).has_value());
+  IAT_CHECK_EQ(log.get_size(), size);
+  IAT_CHECK(log.flush().has_value());
+  IAT_CHECK(log.close().has_value());
+
+  const auto content = FileOps::read_text_file(path);
+  IAT_CHECK(content.has_value());
+  IAT_CHECK_EQ(static_cast<u64>(content->size()), size);
+  IAT_CHECK_EQ(content->substr(0, 18), String("existing|appended|"));
+  IAT_CHECK_EQ((*content)[18], 'a');
+  IAT_CHECK_EQ(content->back(), 'b');
+
+  // Reopening picks up at the trimmed end, not the end of the last extent.
+  IAT_CHECK(log.open(path).has_value());
+  const u8 mark = '!';
+  const auto marked = log.append(Span<const u8>(&mark, 1));
+  IAT_CHECK(marked.has_value());
+  IAT_CHECK_EQ(*marked, size);
+  IAT_CHECK(log.close().has_value());
+  const auto reopened = FileOps::read_text_file(path);
+  IAT_CHECK(reopened.has_value());
+  IAT_CHECK_EQ(static_cast<u64>(reopened->size()), size + 1);
+  IAT_CHECK_EQ(reopened->back(), '!');
+
+  cleanup_file(path);
+  return true;
+}
+
+#if IA_PLATFORM_UNIX && defined(__linux__)
+auto count_open_descriptors() -> usize
+{
+  usize count = 0;
+  for ([[maybe_unused]] const auto &entry : std::filesystem::directory_iterator("/proc/self/fd"))
+  {
+    ++count;
+  }
+  return count;
+}
+
+// Extents flush through the log's handle, so mapping more of them opens no more descriptors.
+auto test_extents_share_handle() -> bool
+{
+  const Path path = "iatest_mapped_log_descriptors.bin";
+  cleanup_file(path);
+
+  MappedLog log;
+  IAT_CHECK(log.open(path, TEST_EXTENT_SIZE).has_value());
+  const Vec<u8> record(TEST_EXTENT_SIZE, 'x');
+  IAT_CHECK(log.append(record).has_value());
+  const usize descriptors = count_open_descriptors();
+
+  for (usize i = 0; i < 64; ++i)
+  {
+    IAT_CHECK(log.append(record).has_value());
+  }
+  IAT_CHECK_EQ(count_open_descriptors(), descriptors);
+  IAT_CHECK(log.flush().has_value());
+  IAT_CHECK(log.close().has_value());
+  IAT_CHECK_EQ(std::filesystem::file_size(path), static_cast<uintmax_t>(65 * TEST_EXTENT_SIZE));
+
+  cleanup_file(path);
+  return true;
+}
+#endif
+
+IAT_BEGIN_TEST_LIST()
+IAT_ADD_TEST(test_concurrent_appends);
+IAT_ADD_TEST(test_concurrent_appends_map_ahead);
+IAT_ADD_TEST(test_reopen_and_limits);
+#if IA_PLATFORM_UNIX && defined(__linux__)
+IAT_ADD_TEST(test_extents_share_handle);
+#endif
+IAT_END_TEST_LIST()
+
+IAT_END_BLOCK()
+
+IAT_REGISTER_ENTRY(Core, MappedLog)
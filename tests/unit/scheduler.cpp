@@ -0,0 +1,150 @@
+// IA-PlatformOps; C++ 20 Async, Process and File Operations.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <platform_ops/scheduler.hpp>
+
+#include <iatest/iatest.hpp>
+
+#include <memory>
+
+using namespace ia;
+
+using LeanScheduler = BasicScheduler<sched::FifoQueue, sched::NoTags, sched::SpinIdle<>, sched::InlineTask<32>>;
+using TaggedScheduler = BasicScheduler<sched::PriorityQueue<3>, sched::WithTags>;
+
+IAT_BEGIN_BLOCK(Core, BasicScheduler)
+
+auto test_policy_selection() -> bool
+{
+  using Defaults = BasicScheduler<>;
+  IAT_CHECK(!Defaults::HAS_TAGS);
+  IAT_CHECK_EQ(Defaults::PRIORITY_LEVELS, static_cast<usize>(1));
+
+  // Order of policies does not matter.
+  using Reordered = BasicScheduler<sched::WithTags, sched::DeadlineAgingQueue<4>>;
+  IAT_CHECK(Reordered::HAS_TAGS);
+  IAT_CHECK_EQ(Reordered::PRIORITY_LEVELS, static_cast<usize>(4));
+
+  // Dropping tags shrinks every queued item.
+  using Tagged = BasicScheduler<sched::WithTags>;
+  using Untagged = BasicScheduler<sched::NoTags>;
+  IAT_CHECK(sizeof(Untagged::Item) < sizeof(Tagged::Item));
+
+  return true;
+}
+
+auto test_lean_execution() -> bool
+{
+  LeanScheduler scheduler;
+  IAT_CHECK(scheduler.start(2).has_value());
+  IAT_CHECK(!scheduler.start(2).has_value());
+
+  std::atomic<i32> counter{0};
+  sched::Schedule schedule;
+
+  for (i32 i = 0; i < 1000; ++i)
+  {
+    scheduler.submit([&counter](sched::WorkerId) { counter++; }, &schedule);
+  }
+
+  scheduler.wait(&schedule);
+  IAT_CHECK_EQ(counter.load(), 1000);
+
+  scheduler.stop();
+  IAT_CHECK(!scheduler.is_running());
+
+  return true;
+}
+
+auto test_priority_order() -> bool
+{
+  TaggedScheduler scheduler;
+  sched::Schedule schedule;
+  Mut<Vec<i32>> order;
+
+  // Queue everything before any worker exists, so the order is decided by the queue policy alone.
+  scheduler.submit_tagged([&order](sched::WorkerId) { order.push_back(2); }, 1, &schedule, 2);
+  scheduler.submit_tagged([&order](sched::WorkerId) { order.push_back(1); }, 1, &schedule, 1);
+  scheduler.submit_tagged([&order](sched::WorkerId) { order.push_back(0); }, 1, &schedule, 0);
+
+  // scheduler.wait would help run the tasks. Waiting on the counter instead leaves the single worker as the only
+  // thread popping, and its last decrement publishes the appends.
+  IAT_CHECK(scheduler.start(1).has_value());
+  for (Mut<i32> pending = schedule.counter.load(); pending > 0; pending = schedule.counter.load())
+  {
+    schedule.counter.wait(pending);
+  }
+
+  IAT_CHECK_EQ(order.size(), static_cast<usize>(3));
+  IAT_CHECK_EQ(order[0], 0);
+  IAT_CHECK_EQ(order[1], 1);
+  IAT_CHECK_EQ(order[2], 2);
+
+  return true;
+}
+
+auto test_tagged_cancel() -> bool
+{
+  TaggedScheduler scheduler;
+  std::atomic<i32> counter{0};
+  sched::Schedule schedule;
+
+  for (i32 i = 0; i < 10; ++i)
+  {
+    scheduler.submit_tagged([&counter](sched::WorkerId) { counter++; }, static_cast<sched::TaskTag>(i % 2), &schedule);
+  }
+
+  scheduler.cancel(1);
+  IAT_CHECK_EQ(schedule.counter.load(), 5);
+
+  IAT_CHECK(scheduler.start(1).has_value());
+  scheduler.wait(&schedule);
+  IAT_CHECK_EQ(counter.load(), 5);
+
+  return true;
+}
+
+auto test_inline_function() -> bool
+{
+  auto shared = std::make_shared<i32>(0);
+
+  sched::InlineFunction<32> fn([shared](sched::WorkerId worker_id) { *shared += worker_id; });
+  IAT_CHECK(static_cast<bool>(fn));
+  IAT_CHECK_EQ(shared.use_count(), 2L);
+
+  sched::InlineFunction<32> moved(std::move(fn));
+  IAT_CHECK(!static_cast<bool>(fn));
+  IAT_CHECK_EQ(shared.use_count(), 2L);
+
+  moved(3);
+  IAT_CHECK_EQ(*shared, 3);
+
+  moved = sched::InlineFunction<32>();
+  IAT_CHECK_EQ(shared.use_count(), 1L);
+
+  return true;
+}
+
+IAT_BEGIN_TEST_LIST()
+IAT_ADD_TEST(test_policy_selection);
+IAT_ADD_TEST(test_lean_execution);
+IAT_ADD_TEST(test_priority_order);
+IAT_ADD_TEST(test_tagged_cancel);
+IAT_ADD_TEST(test_inline_function);
+IAT_END_TEST_LIST()
+
+IAT_END_BLOCK()
+
+IAT_REGISTER_ENTRY(Core, BasicScheduler)
@@ -0,0 +1,330 @@
+// IA-PlatformOps; C++ 20 Async, Process and File Operations.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <platform_ops/shared_arena.hpp>
+
+#include <iatest/iatest.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+#if IA_PLATFORM_UNIX
+#  include <sys/wait.h>
+#  include <unistd.h>
+#endif
+
+using namespace ia;
+
+IAT_BEGIN_BLOCK(Core, SharedArena)
+
+// What the tests build in an arena: an index from keys to lists, reached through the root.
+struct Index
+{
+  explicit Index(SharedAllocator &allocator) : lists(allocator), names(allocator)
+  {
+  }
+
+  SharedHashMap<u64, SharedVec<u32>> lists;
+  SharedVec<OffsetPtr<const char>> names;
+};
+
+auto build_index(SharedAllocator &allocator, const u64 key_count) -> bool
+{
+  auto index = allocator.create<Index>(allocator);
+  if (!index.has_value())
+  {
+    return false;
+  }
+  for (u64 key = 0; key < key_count; ++key)
+  {
+    auto list = (*index)->lists.try_emplace(key, allocator);
+    if (!list.has_value() || !list->second)
+    {
+      return false;
+    }
+    for (u32 i = 0; i < key % 50; ++i)
+    {
+      if (!list->first->push(static_cast<u32>(key * 1000 + i)).has_value())
+      {
+        return false;
+      }
+    }
+  }
+
+  auto name = allocator.allocate(6);
+  if (!name.has_value() || !(*index)->names.push(reinterpret_cast<const char *>(*name)).has_value())
+  {
+    return false;
+  }
+  std::memcpy(*name, "hello", 6);
+  allocator.set_root(*index);
+  return true;
+}
+
+auto check_index(const SharedAllocator &allocator, const u64 key_count) -> bool
+{
+  const Index *index = allocator.get_root<Index>();
+  if (index == nullptr || index->lists.get_size() != key_count || index->names.get_size() != 1 ||
+      std::strcmp(index->names[0].get(), "hello") != 0)
+  {
+    return false;
+  }
+  for (u64 key = 0; key < key_count; ++key)
+  {
+    const SharedVec<u32> *list = index->lists.find(key);
+    if (list == nullptr || list->get_size() != key % 50)
+    {
+      return false;
+    }
+    for (u32 i = 0; i < list->get_size(); ++i)
+    {
+      if ((*list)[i] != key * 1000 + i)
+      {
+        return false;
+      }
+    }
+  }
+  return !index->lists.contains(key_count);
+}
+
+auto test_offset_ptr() -> bool
+{
+  OffsetPtr<int> empty;
+  IAT_CHECK(!empty);
+  IAT_CHECK(empty.get() == nullptr);
+
+  int values[2] = {1, 2};
+  OffsetPtr<int> pointer = &values[0];
+  IAT_CHECK(pointer);
+  IAT_CHECK_EQ(*pointer, 1);
+  IAT_CHECK_EQ(pointer[1], 2);
+
+  // A copy points at the same place, though it is stored as a different offset.
+  OffsetPtr<int> copy = pointer;
+  IAT_CHECK(copy == pointer);
+  copy = &values[1];
+  IAT_CHECK_EQ(*copy, 2);
+  copy = nullptr;
+  IAT_CHECK(!copy);
+
+  // Pointing at itself is a valid, non-null pointer.
+  struct Node
+  {
+    OffsetPtr<Node> next;
+  } node;
+  node.next = &node;
+  IAT_CHECK(node.next);
+  IAT_CHECK(node.next.get() == &node);
+  return true;
+}
+
+auto test_allocator() -> bool
+{
+  const String name = "iatest_arena_allocator";
+  IAT_CHECK(!SharedArena::open(name).has_value());
+  IAT_CHECK(!SharedArena::create(name, SharedArena::HEADER_SIZE).has_value());
+
+  auto arena = SharedArena::create(name, 64 * 1024);
+  IAT_CHECK(arena.has_value());
+  SharedAllocator &allocator = arena->get_allocator();
+  IAT_CHECK_EQ(allocator.get_capacity(), static_cast<u64>(64 * 1024));
+  IAT_CHECK_EQ(allocator.get_used_size(), static_cast<u64>(0));
+
+  // Aligned, reused once freed, and only for blocks of the same size.
+  auto first = allocator.allocate(1);
+  IAT_CHECK(first.has_value());
+  IAT_CHECK_EQ(reinterpret_cast<std::uintptr_t>(*first) % SharedAllocator::ALIGNMENT, static_cast<std::uintptr_t>(0));
+  IAT_CHECK_EQ(allocator.get_used_size(), static_cast<u64>(32));
+  allocator.deallocate(*first);
+  IAT_CHECK_EQ(allocator.get_used_size(), static_cast<u64>(0));
+  auto larger = allocator.allocate(100);
+  IAT_CHECK(larger.has_value());
+  IAT_CHECK(*larger != *first);
+  auto again = allocator.allocate(16);
+  IAT_CHECK(again.has_value());
+  IAT_CHECK(*again == *first);
+  allocator.deallocate(*again);
+  allocator.deallocate(*larger);
+
+  // Running out fails without breaking anything, and freeing makes room again.
+  IAT_CHECK(!allocator.allocate(64 * 1024).has_value());
+  IAT_CHECK(!allocator.allocate(64 * 1024 - sizeof(u64)).has_value());
+  IAT_CHECK_EQ(allocator.get_used_size(), static_cast<u64>(0));
+  Vec<u8 *> blocks;
+  while (auto block = allocator.allocate(1000))
+  {
+    blocks.push_back(*block);
+  }
+  IAT_CHECK(!blocks.empty());
+  IAT_CHECK(!allocator.allocate(1000).has_value());
+  allocator.deallocate(blocks.back());
+  IAT_CHECK(allocator.allocate(1000).has_value());
+
+  // A second mapping sees the same allocator at another address.
+  auto peer = SharedArena::open(name);
+  IAT_CHECK(peer.has_value());
+  IAT_CHECK(&peer->get_allocator() != &allocator);
+  IAT_CHECK_EQ(peer->get_allocator().get_used_size(), allocator.get_used_size());
+  IAT_CHECK(peer->get_allocator().get_root<int>() == nullptr);
+  auto value = allocator.create<int>(42);
+  IAT_CHECK(value.has_value());
+  allocator.set_root(*value);
+  IAT_CHECK_EQ(*peer->get_allocator().get_root<int>(), 42);
+  return true;
+}
+
+auto test_containers() -> bool
+{
+  const String name = "iatest_arena_containers";
+  static constexpr u64 KEY_COUNT = 2000;
+
+  auto writer = SharedArena::create(name, 4 * 1024 * 1024);
+  IAT_CHECK(writer.has_value());
+  auto reader = SharedArena::open(name);
+  IAT_CHECK(reader.has_value());
+
+  // Built through one mapping and read through another, as two processes would.
+  IAT_CHECK(build_index(writer->get_allocator(), KEY_COUNT));
+  IAT_CHECK(check_index(reader->get_allocator(), KEY_COUNT));
+
+  // Erasing leaves tombstones that lookups probe past and inserts reuse.
+  Index *index = reader->get_allocator().get_root<Index>();
+  for (u64 key = 0; key < KEY_COUNT; key += 2)
+  {
+    IAT_CHECK(index->lists.erase(key));
+  }
+  IAT_CHECK(!index->lists.erase(0));
+  IAT_CHECK_EQ(index->lists.get_size(), static_cast<usize>(KEY_COUNT / 2));
+  IAT_CHECK(index->lists.find(KEY_COUNT - 1) != nullptr);
+  auto replaced = index->lists.insert_or_assign(1, SharedVec<u32>(reader->get_allocator()));
+  IAT_CHECK(replaced.has_value());
+  IAT_CHECK((*replaced)->is_empty());
+
+  u64 visited = 0;
+  index->lists.for_each([&visited](const u64 &key, const SharedVec<u32> &) {
+    visited += key % 2;
+  });
+  IAT_CHECK_EQ(visited, KEY_COUNT / 2);
+
+  // Everything goes back to the arena.
+  reader->get_allocator().destroy(index);
+  writer->get_allocator().set_root<Index>(nullptr);
+  IAT_CHECK_EQ(writer->get_allocator().get_used_size(), static_cast<u64>(32));
+  return true;
+}
+
+auto test_concurrent_allocation() -> bool
+{
+  const String name = "iatest_arena_concurrent";
+  static constexpr u32 THREAD_COUNT = 4;
+  static constexpr u32 ROUND_COUNT = 20000;
+
+  auto arena = SharedArena::create(name, 16 * 1024 * 1024);
+  IAT_CHECK(arena.has_value());
+
+  // Each thread uses its own mapping, and writes its id over every block it holds to catch overlaps.
+  std::atomic<bool> is_intact = true;
+  {
+    Vec<std::jthread> threads;
+    for (u32 t = 0; t < THREAD_COUNT; ++t)
+    {
+      threads.emplace_back([&name, &is_intact, t]() {
+        auto mapping = SharedArena::open(name);
+        if (!mapping.has_value())
+        {
+          is_intact = false;
+          return;
+        }
+        SharedAllocator &allocator = mapping->get_allocator();
+        Vec<std::pair<u8 *, usize>> held;
+        for (u32 i = 0; i < ROUND_COUNT; ++i)
+        {
+          const usize size = 1 + (i * 7 + t) % 200;
+          auto block = allocator.allocate(size);
+          if (!block.has_value())
+          {
+            is_intact = false;
+            return;
+          }
+          std::memset(*block, static_cast<int>(t), size);
+          held.emplace_back(*block, size);
+          if (held.size() > 16)
+          {
+            const auto [oldest, oldest_size] = held.front();
+            for (usize b = 0; b < oldest_size; ++b)
+            {
+              if (oldest[b] != t)
+              {
+                is_intact = false;
+              }
+            }
+            allocator.deallocate(oldest);
+            held.erase(held.begin());
+          }
+        }
+        for (const auto &[block, size] : held)
+        {
+          allocator.deallocate(block);
+        }
+      });
+    }
+  }
+
+  IAT_CHECK(is_intact.load());
+  IAT_CHECK_EQ(arena->get_allocator().get_used_size(), static_cast<u64>(0));
+  return true;
+}
+
+#if IA_PLATFORM_UNIX
+auto test_processes() -> bool
+{
+  const String name = "iatest_arena_processes";
+  static constexpr u64 KEY_COUNT = 500;
+
+  auto arena = SharedArena::create(name, 1024 * 1024);
+  IAT_CHECK(arena.has_value());
+
+  // Otherwise the child inherits, and prints again, whatever the parent still has buffered.
+  std::fflush(nullptr);
+  const pid_t child = fork();
+  IAT_CHECK(child != -1);
+  if (child == 0)
+  {
+    auto mapping = SharedArena::open(name);
+    _exit(mapping.has_value() && build_index(mapping->get_allocator(), KEY_COUNT) ? 0 : 1);
+  }
+
+  int status = 0;
+  IAT_CHECK_EQ(waitpid(child, &status, 0), child);
+  IAT_CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+  IAT_CHECK(check_index(arena->get_allocator(), KEY_COUNT));
+  return true;
+}
+#endif
+
+IAT_BEGIN_TEST_LIST()
+IAT_ADD_TEST(test_offset_ptr);
+IAT_ADD_TEST(test_allocator);
+IAT_ADD_TEST(test_containers);
+IAT_ADD_TEST(test_concurrent_allocation);
+#if IA_PLATFORM_UNIX
+IAT_ADD_TEST(test_processes);
+#endif
+IAT_END_TEST_LIST()
+
+IAT_END_BLOCK()
+
+IAT_REGISTER_ENTRY(Core, SharedArena)
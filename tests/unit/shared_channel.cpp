@@ -0,0 +1,231 @@
+// IA-PlatformOps; C++ 20 Async, Process and File Operations.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <platform_ops/shared_channel.hpp>
+
+#include <iatest/iatest.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+#if IA_PLATFORM_UNIX
+#  include <sys/wait.h>
+#  include <unistd.h>
+#endif
+
+using namespace ia;
+
+IAT_BEGIN_BLOCK(Core, SharedChannel)
+
+auto as_bytes(const char *text) -> Span<const u8>
+{
+  return Span<const u8>(reinterpret_cast<const u8 *>(text), std::strlen(text));
+}
+
+auto as_string(const Span<const u8> bytes) -> String
+{
+  return String(reinterpret_cast<const char *>(bytes.data()), bytes.size());
+}
+
+// Message `index` has a size that cycles through 0..299, so records land at every alignment and keep wrapping.
+auto fill_message(Vec<u8> &message, const u32 index) -> void
+{
+  message.resize(sizeof(index) + index % 300);
+  std::memcpy(message.data(), &index, sizeof(index));
+  for (usize i = sizeof(index); i < message.size(); ++i)
+  {
+    message[i] = static_cast<u8>(index + i);
+  }
+}
+
+auto check_message(const Span<const u8> message, const u32 index) -> bool
+{
+  Vec<u8> expected;
+  fill_message(expected, index);
+  return message.size() == expected.size() && std::memcmp(message.data(), expected.data(), expected.size()) == 0;
+}
+
+auto test_round_trip() -> bool
+{
+  const String name = "iatest_channel_round_trip";
+  IAT_CHECK(!SharedChannel::open(name).has_value());
+
+  auto producer = SharedChannel::create(name, 1000);
+  IAT_CHECK(producer.has_value());
+  IAT_CHECK_EQ(producer->get_capacity(), static_cast<usize>(1024));
+  auto consumer = SharedChannel::open(name);
+  IAT_CHECK(consumer.has_value());
+  IAT_CHECK_EQ(consumer->get_capacity(), static_cast<usize>(1024));
+
+  IAT_CHECK(!consumer->try_receive().has_value());
+  IAT_CHECK(producer->send(as_bytes("hello")).has_value());
+  IAT_CHECK(producer->send(as_bytes("")).has_value());
+
+  // A message stays put, and is returned again, until it is released.
+  auto message = consumer->receive();
+  IAT_CHECK(message.has_value());
+  IAT_CHECK_EQ(as_string(*message), String("hello"));
+  IAT_CHECK_EQ(as_string(*consumer->try_receive()), String("hello"));
+  consumer->release();
+  message = consumer->receive();
+  IAT_CHECK(message.has_value());
+  IAT_CHECK(message->empty());
+  consumer->release();
+
+  // Oversized messages are refused outright. A full ring refuses until the consumer catches up.
+  const Vec<u8> too_large(producer->get_max_message_size() + 1, 0);
+  IAT_CHECK(!producer->try_send(too_large).has_value());
+  const Vec<u8> large(producer->get_max_message_size(), 0x42);
+  IAT_CHECK(*producer->try_send(large));
+  IAT_CHECK(!*producer->try_send(large));
+  IAT_CHECK(!*producer->send_for(large, std::chrono::milliseconds(1)));
+  IAT_CHECK_EQ(consumer->receive()->size(), large.size());
+  consumer->release();
+  IAT_CHECK(!consumer->receive_for(std::chrono::milliseconds(1)).has_value());
+
+  // Filled in place, and trimmed on commit.
+  auto space = producer->reserve(64);
+  IAT_CHECK(space.has_value());
+  IAT_CHECK_EQ(space->size(), static_cast<usize>(64));
+  std::memcpy(space->data(), "in place", 8);
+  producer->commit(8);
+  IAT_CHECK_EQ(as_string(*consumer->receive()), String("in place"));
+  consumer->release();
+
+  // Many sizes in a small ring, to exercise every wrap position.
+  Vec<u8> buffer;
+  for (u32 i = 0; i < 2000; ++i)
+  {
+    fill_message(buffer, i);
+    IAT_CHECK(*producer->try_send(buffer));
+    const auto received = consumer->try_receive();
+    IAT_CHECK(received.has_value());
+    IAT_CHECK(check_message(*received, i));
+    consumer->release();
+  }
+
+  // After a shutdown, sends fail and receives drain what is left.
+  IAT_CHECK(producer->send(as_bytes("last")).has_value());
+  producer->shut_down();
+  IAT_CHECK(consumer->is_shut_down());
+  IAT_CHECK(!producer->send(as_bytes("late")).has_value());
+  IAT_CHECK_EQ(as_string(*consumer->receive()), String("last"));
+  consumer->release();
+  IAT_CHECK(!consumer->receive().has_value());
+  return true;
+}
+
+auto test_threads() -> bool
+{
+  const String name = "iatest_channel_threads";
+  static constexpr u32 MESSAGE_COUNT = 200000;
+
+  auto producer = SharedChannel::create(name, 4096);
+  IAT_CHECK(producer.has_value());
+  auto consumer = SharedChannel::open(name);
+  IAT_CHECK(consumer.has_value());
+
+  // The two sides use separate mappings of the segment, as two processes would.
+  std::jthread sender([&producer]() {
+    Vec<u8> buffer;
+    for (u32 i = 0; i < MESSAGE_COUNT; ++i)
+    {
+      fill_message(buffer, i);
+      if (!producer->send(buffer).has_value())
+      {
+        return;
+      }
+    }
+    producer->shut_down();
+  });
+
+  u32 received = 0;
+  bool in_order = true;
+  while (const auto message = consumer->receive())
+  {
+    in_order = in_order && check_message(*message, received);
+    ++received;
+    consumer->release();
+  }
+  sender.join();
+
+  IAT_CHECK(in_order);
+  IAT_CHECK_EQ(received, MESSAGE_COUNT);
+  return true;
+}
+
+#if IA_PLATFORM_UNIX
+auto test_processes() -> bool
+{
+  const String name = "iatest_channel_processes";
+  static constexpr u32 MESSAGE_COUNT = 50000;
+
+  auto consumer = SharedChannel::create(name, 8192);
+  IAT_CHECK(consumer.has_value());
+
+  // Otherwise the child inherits, and prints again, whatever the parent still has buffered.
+  std::fflush(nullptr);
+  const pid_t child = fork();
+  IAT_CHECK(child != -1);
+  if (child == 0)
+  {
+    auto producer = SharedChannel::open(name);
+    if (!producer.has_value())
+    {
+      _exit(1);
+    }
+    Vec<u8> buffer;
+    for (u32 i = 0; i < MESSAGE_COUNT; ++i)
+    {
+      fill_message(buffer, i);
+      if (!producer->send(buffer).has_value())
+      {
+        _exit(2);
+      }
+    }
+    producer->shut_down();
+    _exit(0);
+  }
+
+  u32 received = 0;
+  bool in_order = true;
+  while (const auto message = consumer->receive())
+  {
+    in_order = in_order && check_message(*message, received);
+    ++received;
+    consumer->release();
+  }
+
+  int status = 0;
+  IAT_CHECK_EQ(waitpid(child, &status, 0), child);
+  IAT_CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+  IAT_CHECK(in_order);
+  IAT_CHECK_EQ(received, MESSAGE_COUNT);
+  return true;
+}
+#endif
+
+IAT_BEGIN_TEST_LIST()
+IAT_ADD_TEST(test_round_trip);
+IAT_ADD_TEST(test_threads);
+#if IA_PLATFORM_UNIX
+IAT_ADD_TEST(test_processes);
+#endif
+IAT_END_TEST_LIST()
+
+IAT_END_BLOCK()
+
+IAT_REGISTER_ENTRY(Core, SharedChannel)
@@ -0,0 +1,192 @@
+// IA-PlatformOps; C++ 20 Async, Process and File Operations.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <platform_ops/shared_snapshot.hpp>
+
+#include <iatest/iatest.hpp>
+
+#include <cstdio>
+#include <cstring>
+
+#if IA_PLATFORM_UNIX
+#  include <sys/wait.h>
+#  include <unistd.h>
+#endif
+
+using namespace ia;
+
+IAT_BEGIN_BLOCK(Core, SharedSnapshot)
+
+// Version `version` is (version % 500 + 1) words, each holding the version, so a torn read shows as a mismatch.
+auto fill_state(Vec<u8> &state, const u64 version) -> void
+{
+  state.resize((version % 500 + 1) * sizeof(u64));
+  for (usize i = 0; i < state.size(); i += sizeof(u64))
+  {
+    std::memcpy(state.data() + i, &version, sizeof(version));
+  }
+}
+
+auto check_state(const Span<const u8> state, const u64 version) -> bool
+{
+  if (state.size() != (version % 500 + 1) * sizeof(u64))
+  {
+    return false;
+  }
+  for (usize i = 0; i < state.size(); i += sizeof(u64))
+  {
+    u64 word = 0;
+    std::memcpy(&word, state.data() + i, sizeof(word));
+    if (word != version)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+auto test_publish_and_read() -> bool
+{
+  const String name = "iatest_snapshot_publish";
+  IAT_CHECK(!SharedSnapshot::open(name).has_value());
+  IAT_CHECK(!SharedSnapshot::create(name, 4096, 1).has_value());
+
+  auto writer = SharedSnapshot::create(name, 4096);
+  IAT_CHECK(writer.has_value());
+  auto reader = SharedSnapshot::open(name);
+  IAT_CHECK(reader.has_value());
+  IAT_CHECK_EQ(reader->get_max_size(), static_cast<usize>(4096));
+  IAT_CHECK_EQ(reader->get_slot_count(), SharedSnapshot::DEFAULT_SLOT_COUNT);
+
+  // Nothing to read before the first publish.
+  Vec<u8> state;
+  IAT_CHECK(!reader->view().has_value());
+  IAT_CHECK_EQ(reader->read_into(state), static_cast<u64>(0));
+
+  const char first[] = "first";
+  IAT_CHECK_EQ(*writer->publish(Span<const u8>(reinterpret_cast<const u8 *>(first), sizeof(first))),
+               static_cast<u64>(1));
+  IAT_CHECK_EQ(reader->get_version(), static_cast<u64>(1));
+  IAT_CHECK_EQ(reader->read_into(state), static_cast<u64>(1));
+  IAT_CHECK_EQ(String(reinterpret_cast<const char *>(state.data())), String("first"));
+
+  const Vec<u8> too_large(4097, 0);
+  IAT_CHECK(!writer->publish(too_large).has_value());
+
+  // Written in place, and invisible until committed.
+  Span<u8> slot = writer->begin_write();
+  IAT_CHECK_EQ(slot.size(), static_cast<usize>(4096));
+  std::memcpy(slot.data(), "second", 7);
+  IAT_CHECK_EQ(reader->view()->version, static_cast<u64>(1));
+  IAT_CHECK_EQ(writer->commit(7), static_cast<u64>(2));
+  auto view = reader->view();
+  IAT_CHECK(view.has_value());
+  IAT_CHECK_EQ(view->version, static_cast<u64>(2));
+  IAT_CHECK_EQ(String(reinterpret_cast<const char *>(view->data.data())), String("second"));
+  IAT_CHECK(reader->is_intact(*view));
+
+  // A view outlives its slot once the writer comes round to it again, and read retries on the newest.
+  for (u64 version = 3; version < 3 + SharedSnapshot::DEFAULT_SLOT_COUNT - 1; ++version)
+  {
+    fill_state(state, version);
+    IAT_CHECK_EQ(*writer->publish(state), version);
+    IAT_CHECK(reader->is_intact(*view));
+  }
+  writer->begin_write();
+  IAT_CHECK(!reader->is_intact(*view));
+  const u64 latest = reader->get_version();
+  IAT_CHECK_EQ(reader->read([&](const Span<const u8> data) { state.assign(data.begin(), data.end()); }), latest);
+  IAT_CHECK(check_state(state, latest));
+  writer->commit(0);
+  IAT_CHECK_EQ(reader->read_into(state), latest + 1);
+  IAT_CHECK(state.empty());
+  return true;
+}
+
+#if IA_PLATFORM_UNIX
+auto test_processes() -> bool
+{
+  const String name = "iatest_snapshot_processes";
+  static constexpr u64 VERSION_COUNT = 200000;
+
+  auto reader = SharedSnapshot::create(name, 500 * sizeof(u64));
+  IAT_CHECK(reader.has_value());
+
+  // Otherwise the child inherits, and prints again, whatever the parent still has buffered.
+  std::fflush(nullptr);
+  const pid_t child = fork();
+  IAT_CHECK(child != -1);
+  if (child == 0)
+  {
+    auto writer = SharedSnapshot::open(name);
+    if (!writer.has_value())
+    {
+      _exit(1);
+    }
+    Vec<u8> state;
+    for (u64 version = 1; version <= VERSION_COUNT; ++version)
+    {
+      fill_state(state, version);
+      if (writer->publish(state).value_or(0) != version)
+      {
+        _exit(2);
+      }
+    }
+    _exit(0);
+  }
+
+  // Poll while the writer runs. Every read must be consistent, and versions never go backwards.
+  Vec<u8> state;
+  u64 last_version = 0;
+  u64 read_count = 0;
+  bool is_consistent = true;
+  int status = 0;
+  bool has_exited = false;
+  while (last_version < VERSION_COUNT && !has_exited)
+  {
+    // Checked before reading, so the last read after the writer exits sees its final version.
+    has_exited = waitpid(child, &status, WNOHANG) == child;
+    const u64 version = reader->read_into(state);
+    if (version == 0)
+    {
+      continue;
+    }
+    is_consistent = is_consistent && version >= last_version && check_state(state, version);
+    last_version = version;
+    ++read_count;
+  }
+
+  if (!has_exited)
+  {
+    IAT_CHECK_EQ(waitpid(child, &status, 0), child);
+  }
+  IAT_CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+  IAT_CHECK(is_consistent);
+  IAT_CHECK_EQ(last_version, VERSION_COUNT);
+  IAT_CHECK(read_count > 0);
+  return true;
+}
+#endif
+
+IAT_BEGIN_TEST_LIST()
+IAT_ADD_TEST(test_publish_and_read);
+#if IA_PLATFORM_UNIX
+IAT_ADD_TEST(test_processes);
+#endif
+IAT_END_TEST_LIST()
+
+IAT_END_BLOCK()
+
+IAT_REGISTER_ENTRY(Core, SharedSnapshot)
@@ -0,0 +1,207 @@
+// IA-PlatformOps; C++ 20 Async, Process and File Operations.
+// Copyright (C) 2026 IAS (ias@iasoft.dev)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <platform_ops/file.hpp>
+#include <platform_ops/shared_sync.hpp>
+
+#include <iatest/iatest.hpp>
+
+#include <cstdio>
+#include <new>
+#include <thread>
+
+#if IA_PLATFORM_UNIX
+#  include <sys/wait.h>
+#  include <unistd.h>
+#endif
+
+using namespace ia;
+
+IAT_BEGIN_BLOCK(Core, SharedSync)
+
+struct PingPong
+{
+  SharedEvent ping{EventReset::Auto};
+  SharedEvent pong{EventReset::Auto};
+  SharedSemaphore items;
+};
+
+auto test_event() -> bool
+{
+  using namespace std::chrono_literals;
+
+  // A manual-reset event stays set until reset.
+  SharedEvent manual;
+  IAT_CHECK(!manual.is_set());
+  IAT_CHECK(!manual.try_wait());
+  const auto start = std::chrono::steady_clock::now();
+  IAT_CHECK(!manual.wait_for(20ms));
+  IAT_CHECK(std::chrono::steady_clock::now() - start >= 20ms);
+  manual.set();
+  IAT_CHECK(manual.wait_for(0ms));
+  manual.wait();
+  IAT_CHECK(manual.is_set());
+  manual.reset();
+  IAT_CHECK(!manual.try_wait());
+
+  // An auto-reset event lets one wait through per set.
+  SharedEvent automatic(EventReset::Auto, true);
+  IAT_CHECK(automatic.try_wait());
+  IAT_CHECK(!automatic.try_wait());
+  automatic.set();
+  automatic.set();
+  IAT_CHECK(automatic.wait_for(1ms));
+  IAT_CHECK(!automatic.wait_for(1ms));
+
+  // Every sleeping waiter wakes on a manual set.
+  SharedEvent gate;
+  std::atomic<u32> woken = 0;
+  {
+    Vec<std::jthread> waiters;
+    for (u32 i = 0; i < 4; ++i)
+    {
+      waiters.emplace_back([&gate, &woken]() {
+        gate.wait();
+        ++woken;
+      });
+    }
+    std::this_thread::sleep_for(10ms);
+    gate.set();
+  }
+  IAT_CHECK_EQ(woken.load(), 4u);
+  return true;
+}
+
+auto test_semaphore() -> bool
+{
+  using namespace std::chrono_literals;
+
+  SharedSemaphore semaphore(2);
+  IAT_CHECK(semaphore.try_acquire());
+  IAT_CHECK(semaphore.acquire_for(0ms));
+  IAT_CHECK(!semaphore.try_acquire());
+  IAT_CHECK(!semaphore.acquire_for(5ms));
+  semaphore.release(3);
+  IAT_CHECK_EQ(semaphore.get_count(), 3u);
+
+  // Counts are neither lost nor duplicated between concurrent producers and consumers.
+  static constexpr u32 PER_THREAD = 20000;
+  SharedSemaphore items;
+  std::atomic<u32> taken = 0;
+  {
+    Vec<std::jthread> threads;
+    for (u32 i = 0; i < 2; ++i)
+    {
+      threads.emplace_back([&items]() {
+        for (u32 j = 0; j < PER_THREAD; ++j)
+        {
+          items.release();
+        }
+      });
+      threads.emplace_back([&items, &taken]() {
+        for (u32 j = 0; j < PER_THREAD; ++j)
+        {
+          items.acquire();
+          ++taken;
+        }
+      });
+    }
+  }
+  IAT_CHECK_EQ(taken.load(), 2 * PER_THREAD);
+  IAT_CHECK_EQ(items.get_count(), 0u);
+  return true;
+}
+
+auto play(PingPong &shared, const u32 rounds, const bool is_first) -> void
+{
+  for (u32 i = 0; i < rounds; ++i)
+  {
+    if (is_first)
+    {
+      shared.ping.set();
+      shared.pong.wait();
+    }
+    else
+    {
+      shared.ping.wait();
+      shared.items.release();
+      shared.pong.set();
+    }
+  }
+}
+
+auto test_threads() -> bool
+{
+  static constexpr u32 ROUNDS = 20000;
+
+  PingPong shared;
+  {
+    std::jthread second([&shared]() { play(shared, ROUNDS, false); });
+    play(shared, ROUNDS, true);
+  }
+  IAT_CHECK_EQ(shared.items.get_count(), ROUNDS);
+  return true;
+}
+
+#if IA_PLATFORM_UNIX
+auto test_processes() -> bool
+{
+  const String name = "iatest_sync_processes";
+  static constexpr u32 ROUNDS = 5000;
+
+  auto segment = FileOps::map_shared_memory(name, sizeof(PingPong), true);
+  IAT_CHECK(segment.has_value());
+  PingPong *shared = new (*segment) PingPong();
+
+  // Otherwise the child inherits, and prints again, whatever the parent still has buffered.
+  std::fflush(nullptr);
+  const pid_t child = fork();
+  IAT_CHECK(child != -1);
+  if (child == 0)
+  {
+    // Its own mapping, at another address.
+    auto mapping = FileOps::map_shared_memory(name, sizeof(PingPong), false);
+    if (!mapping.has_value())
+    {
+      _exit(1);
+    }
+    play(*reinterpret_cast<PingPong *>(*mapping), ROUNDS, false);
+    _exit(0);
+  }
+
+  play(*shared, ROUNDS, true);
+  int status = 0;
+  IAT_CHECK_EQ(waitpid(child, &status, 0), child);
+  IAT_CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+  IAT_CHECK_EQ(shared->items.get_count(), ROUNDS);
+
+  FileOps::unmap_file(*segment);
+  FileOps::unlink_shared_memory(name);
+  return true;
+}
+#endif
+
+IAT_BEGIN_TEST_LIST()
+IAT_ADD_TEST(test_event);
+IAT_ADD_TEST(test_semaphore);
+IAT_ADD_TEST(test_threads);
+#if IA_PLATFORM_UNIX
+IAT_ADD_TEST(test_processes);
+#endif
+IAT_END_TEST_LIST()
+
+IAT_END_BLOCK()
+
+IAT_REGISTER_ENTRY(Core, SharedSync)